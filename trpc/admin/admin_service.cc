@@ -59,6 +59,8 @@ AdminService::AdminService() {
   RegisterCmd(http::OperationType::POST, "/cmds/watch", std::make_shared<admin::WatchHandler>());
   // Gets the stats
   RegisterCmd(http::OperationType::GET, "/cmds/stats", std::make_shared<admin::StatsHandler>());
+  // Gets the memory held by the fiber tcp connections.
+  RegisterCmd(http::OperationType::GET, "/cmds/stats/conn_memory", std::make_shared<admin::ConnMemoryHandler>());
   // Gets the vars.
   RegisterCmd(http::OperationType::GET, "/cmds/var", std::make_shared<admin::VarHandler>("/cmds/var"));
   RegisterCmd(http::OperationType::GET, "<regex(/cmds/var/.*)>", std::make_shared<admin::VarHandler>("/cmds/var"));
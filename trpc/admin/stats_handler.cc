@@ -21,6 +21,7 @@
 #include "trpc/admin/web_css_jquery.h"
 #include "trpc/common/config/trpc_config.h"
 #include "trpc/runtime/common/stats/frame_stats.h"
+#include "trpc/runtime/iomodel/reactor/fiber/fiber_tcp_connection.h"
 #include "trpc/tvar/common/tvar_group.h"
 #include "trpc/util/log/logging.h"
 #ifdef TRPC_BUILD_INCLUDE_RPCZ
@@ -67,6 +68,11 @@ void PrintStatsData(std::string* html) {
   html->append(std::to_string(FrameStats::GetInstance()->GetServerStats().GetLastFailedReqCount()));
   html->append("</td>\n</tr>\n");
 
+  html->append("<tr>\n");
+  html->append("<td>total_expired_req_count</td>\n<td>");
+  html->append(std::to_string(FrameStats::GetInstance()->GetServerStats().GetTotalExpiredReqCount()));
+  html->append("</td>\n</tr>\n");
+
   html->append("<tr>\n");
   html->append("<td>total_avg_delay</td>\n<td>");
   html->append(std::to_string(FrameStats::GetInstance()->GetServerStats().GetAvgTotalDelay()));
@@ -117,6 +123,8 @@ void StatsHandler::CommandHandle(http::HttpRequestPtr req, rapidjson::Value& res
                   alloc);
   stats.AddMember("now_failed_req_count", FrameStats::GetInstance()->GetServerStats().GetFailedReqCount(), alloc);
   stats.AddMember("last_failed_req_count", FrameStats::GetInstance()->GetServerStats().GetLastFailedReqCount(), alloc);
+  stats.AddMember("total_expired_req_count", FrameStats::GetInstance()->GetServerStats().GetTotalExpiredReqCount(),
+                  alloc);
   stats.AddMember("total_avg_delay", FrameStats::GetInstance()->GetServerStats().GetAvgTotalDelay(), alloc);
   stats.AddMember("now_avg_delay", FrameStats::GetInstance()->GetServerStats().GetAvgDelay(), alloc);
   stats.AddMember("last_avg_delay", FrameStats::GetInstance()->GetServerStats().GetAvgLastDelay(), alloc);
@@ -126,6 +134,23 @@ void StatsHandler::CommandHandle(http::HttpRequestPtr req, rapidjson::Value& res
   result.AddMember("stats", stats, alloc);
 }
 
+void ConnMemoryHandler::CommandHandle(http::HttpRequestPtr req, rapidjson::Value& result,
+                                      rapidjson::Document::AllocatorType& alloc) {
+  result.AddMember("errorcode", 0, alloc);
+  result.AddMember("message", "", alloc);
+
+  int64_t conn_count = FiberTcpConnection::GetConnectionCount();
+  int64_t object_bytes = conn_count * static_cast<int64_t>(sizeof(FiberTcpConnection));
+  int64_t read_buffer_bytes = FiberTcpConnection::GetReadBufferBytes();
+
+  rapidjson::Value conn_memory(rapidjson::kObjectType);
+  conn_memory.AddMember("conn_count", conn_count, alloc);
+  conn_memory.AddMember("object_bytes", object_bytes, alloc);
+  conn_memory.AddMember("read_buffer_bytes", read_buffer_bytes, alloc);
+
+  result.AddMember("conn_memory", conn_memory, alloc);
+}
+
 
 
 void WebStatsHandler::CommandHandle(http::HttpRequestPtr req, rapidjson::Value& result,
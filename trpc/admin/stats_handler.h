@@ -32,6 +32,18 @@ class StatsHandler : public AdminHandlerBase {
                      rapidjson::Document::AllocatorType& alloc) override;
 };
 
+/// @brief Handles the request for getting the memory held by the fiber tcp connections, then replies the bytes of the
+/// connection objects and the recv buffers. The connection handlers, io handlers and send buffers are not counted.
+class ConnMemoryHandler : public AdminHandlerBase {
+ public:
+  ConnMemoryHandler() { description_ = "[GET /cmds/stats/conn_memory] get memory held by fiber tcp connections"; }
+
+  ~ConnMemoryHandler() override = default;
+
+  void CommandHandle(http::HttpRequestPtr req, rapidjson::Value& result,
+                     rapidjson::Document::AllocatorType& alloc) override;
+};
+
 /// @brief Handles the request for getting status of connections, requests, then replies the count of connections,
 /// requests.
 class WebStatsHandler : public AdminHandlerBase {
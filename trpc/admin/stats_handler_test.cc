@@ -65,6 +65,17 @@ TEST_F(TestStatsHandler, CommonTest) {
   }
 }
 
+TEST_F(TestStatsHandler, ConnMemory) {
+  auto h = std::make_unique<admin::ConnMemoryHandler>();
+  rapidjson::Document doc;
+  rapidjson::Value result(rapidjson::kObjectType);
+  h->CommandHandle(std::make_shared<http::HttpRequest>(), result, doc.GetAllocator());
+
+  ASSERT_EQ(result["errorcode"].GetInt(), 0);
+  ASSERT_EQ(result["conn_memory"]["conn_count"].GetInt64(), 0);
+  ASSERT_EQ(result["conn_memory"]["read_buffer_bytes"].GetInt64(), 0);
+}
+
 #ifdef TRPC_BUILD_INCLUDE_RPCZ
 TEST(TestRpczHandler, url_test) {
   std::unique_ptr<admin::RpczHandler> h = std::make_unique<admin::RpczHandler>("/cmds/rpcz");
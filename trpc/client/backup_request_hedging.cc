@@ -0,0 +1,58 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/client/backup_request_hedging.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "trpc/util/time.h"
+
+namespace trpc {
+
+BackupRequestHedging::BackupRequestHedging(const Options& options)
+    : options_(options), latency_recorder_(options.window_size), budget_(options.budget_percent) {
+  options_.delay_percentile = std::clamp(options_.delay_percentile, 1u, 99u);
+}
+
+uint32_t BackupRequestHedging::GetDelay(uint32_t default_delay) {
+  if (sample_count_.load(std::memory_order_relaxed) < kMinSampleCount) {
+    return default_delay;
+  }
+
+  // Computing a percentile merges the samples of the window, so it is done at intervals rather than per request.
+  uint64_t now_ms = trpc::time::GetMilliSeconds();
+  uint64_t update_ms = delay_update_ms_.load(std::memory_order_relaxed);
+  if (now_ms >= update_ms + kDelayUpdateIntervalMs &&
+      delay_update_ms_.compare_exchange_strong(update_ms, now_ms, std::memory_order_relaxed)) {
+    uint32_t latency_us = latency_recorder_.LatencyPercentile(options_.delay_percentile / 100.0);
+    if (latency_us > 0) {
+      delay_.store((latency_us + 999) / 1000, std::memory_order_relaxed);
+    }
+  }
+
+  uint32_t delay = delay_.load(std::memory_order_relaxed);
+  return delay > 0 ? delay : default_delay;
+}
+
+void BackupRequestHedging::Report(uint64_t latency_us, bool succ) {
+  if (succ) {
+    uint64_t max_latency_us = std::numeric_limits<uint32_t>::max();
+    latency_recorder_.Update(static_cast<uint32_t>(std::min(latency_us, max_latency_us)));
+    if (sample_count_.load(std::memory_order_relaxed) < kMinSampleCount) {
+      sample_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+}
+
+}  // namespace trpc
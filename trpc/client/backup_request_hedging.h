@@ -0,0 +1,84 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "trpc/client/request_budget.h"
+#include "trpc/tvar/compound_ops/latency_recorder.h"
+
+namespace trpc {
+
+/// @brief Adaptive policy of the backup requests to a callee: the delay of the backup requests follows a percentile of
+/// the recent latencies of the callee, and the backup requests are limited to a percentage of the requests.
+/// @note Thread safe.
+class BackupRequestHedging {
+ public:
+  struct Options {
+    /// Percentile of the recent latencies used as the delay, e.g. 95 for P95. Must be in (0, 100).
+    uint32_t delay_percentile{95};
+
+    /// Backup requests allowed, in percent of the requests.
+    uint32_t budget_percent{5};
+
+    /// Window(seconds) of the recent latencies.
+    uint32_t window_size{10};
+  };
+
+  /// Latencies sampled before the delay follows them, the configured delay is used until then.
+  static constexpr uint32_t kMinSampleCount = 100;
+
+  /// Backup requests that can be saved up by the budget, so the bursts of slow responses can be hedged.
+  static constexpr uint32_t kMaxBurst = RequestBudget::kMaxBurst;
+
+  explicit BackupRequestHedging(const Options& options);
+
+  /// @brief Counts a request to the callee, which adds to the budget of the backup requests.
+  void AddRequest() { budget_.AddRequest(); }
+
+  /// @brief Whether a backup request can be issued within the budget.
+  bool HasBudget() const { return budget_.HasBudget(); }
+
+  /// @brief Gets the budget of the backup requests, which is taken right before a backup request is sent.
+  RequestBudget* GetBudget() { return &budget_; }
+
+  /// @brief Gets the delay(ms) of the backup requests.
+  /// @param default_delay The delay used before enough latencies are sampled.
+  uint32_t GetDelay(uint32_t default_delay);
+
+  /// @brief Reports the result of an invocation.
+  /// @param latency_us The latency of the invocation, sampled if succeeded only.
+  /// @param succ Whether the invocation succeeded.
+  void Report(uint64_t latency_us, bool succ);
+
+ private:
+  // How often(ms) the delay is computed from the latencies.
+  static constexpr uint64_t kDelayUpdateIntervalMs = 100;
+
+ private:
+  Options options_;
+
+  tvar::LatencyRecorder latency_recorder_;
+
+  std::atomic<uint32_t> sample_count_{0};
+
+  std::atomic<uint32_t> delay_{0};
+
+  std::atomic<uint64_t> delay_update_ms_{0};
+
+  RequestBudget budget_;
+};
+
+}  // namespace trpc
@@ -0,0 +1,79 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/client/backup_request_hedging.h"
+
+#include <chrono>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace trpc::testing {
+
+TEST(BackupRequestHedgingTest, Budget) {
+  BackupRequestHedging::Options options;
+  options.budget_percent = 5;
+  BackupRequestHedging hedging(options);
+
+  // A burst of backup requests is allowed at first.
+  for (uint32_t i = 0; i < BackupRequestHedging::kMaxBurst; ++i) {
+    ASSERT_TRUE(hedging.HasBudget());
+    ASSERT_TRUE(hedging.GetBudget()->TryAcquire());
+  }
+  ASSERT_FALSE(hedging.HasBudget());
+
+  // One backup request per 20 requests.
+  for (int i = 0; i < 19; ++i) {
+    hedging.AddRequest();
+  }
+  ASSERT_FALSE(hedging.HasBudget());
+  hedging.AddRequest();
+  ASSERT_TRUE(hedging.HasBudget());
+
+  // The budget saved up is capped.
+  for (int i = 0; i < 1000; ++i) {
+    hedging.AddRequest();
+  }
+  for (uint32_t i = 0; i < BackupRequestHedging::kMaxBurst; ++i) {
+    ASSERT_TRUE(hedging.GetBudget()->TryAcquire());
+  }
+  ASSERT_FALSE(hedging.HasBudget());
+}
+
+TEST(BackupRequestHedgingTest, Delay) {
+  BackupRequestHedging::Options options;
+  options.delay_percentile = 95;
+  BackupRequestHedging hedging(options);
+
+  // The latencies of the failed invocations are not sampled.
+  for (int i = 0; i < 1000; ++i) {
+    hedging.Report(1000000, false);
+  }
+  ASSERT_EQ(hedging.GetDelay(7), 7);
+
+  // Latencies of 1ms to 100ms.
+  for (int i = 0; i < 1000; ++i) {
+    hedging.Report((i % 100 + 1) * 1000, true);
+  }
+
+  // Wait for the latencies to be sampled into the window, which is done by the sampler every second.
+  uint32_t delay = hedging.GetDelay(7);
+  for (int i = 0; i < 50 && delay == 7; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    delay = hedging.GetDelay(7);
+  }
+  ASSERT_GE(delay, 85);
+  ASSERT_LE(delay, 100);
+}
+
+}  // namespace trpc::testing
@@ -38,6 +38,8 @@
 
 namespace trpc {
 
+struct LoadBalanceHandle;
+
 /// @brief Context for client-side rpc invoke, every request has its own context,
 /// use `MakeClientContext` to create it.
 /// @note It is not thread-safe.
@@ -471,6 +473,37 @@ class ClientContext : public RefCounted<ClientContext> {
   /// @private
   void SetServiceProxyOption(ServiceProxyOption* option) { extend_info_.service_proxy_option = option; }
 
+  /// @brief Get the handle of the callee in the load balancer, resolved by the service proxy.
+  /// @note It's used internally by the framework.
+  /// @private
+  const LoadBalanceHandle* GetLoadBalanceHandle() const { return extend_info_.load_balance_handle; }
+
+  /// @brief Set the handle of the callee in the load balancer.
+  /// @note It's used internally by the framework.
+  /// @private
+  void SetLoadBalanceHandle(const LoadBalanceHandle* handle) { extend_info_.load_balance_handle = handle; }
+
+  /// @brief Whether the invocation result is needed by the selector, e.g. by its load balancer.
+  /// @note It's used internally by the framework.
+  /// @private
+  bool IsInvokeResultNeeded() const { return extend_info_.invoke_result_needed; }
+
+  /// @brief Set whether the invocation result is needed by the selector.
+  /// @note It's used internally by the framework.
+  /// @private
+  void SetInvokeResultNeeded(bool needed) { extend_info_.invoke_result_needed = needed; }
+
+  /// @brief Whether the response is served without sending the request, e.g. from the response cache or by the leader
+  ///        of the coalesced invocations, so the node selected has not been called.
+  /// @note It's used internally by the framework.
+  /// @private
+  bool IsServedLocally() const { return GetStateFlag(kIsServedLocallyMask); }
+
+  /// @brief Set whether the response is served without sending the request.
+  /// @note It's used internally by the framework.
+  /// @private
+  void SetServedLocally(bool value) { SetStateFlag(value, kIsServedLocallyMask); }
+
   /// @brief Set the name of remote service.
   /// @param target name of the remote service
   /// @note If the user sets the service target in the context, the name resolution will prioritize this target value.
@@ -798,6 +831,7 @@ class ClientContext : public RefCounted<ClientContext> {
   static constexpr uint8_t kIsBackupRequestMask = 0b00010000;
   static constexpr uint8_t kIsIgnoreProxyTimeoutMask = 0b00100000;
   static constexpr uint8_t kIsSetRequestId = 0b01000000;
+  static constexpr uint8_t kIsServedLocallyMask = 0b10000000;
 
   struct alignas(8) InvokeInfo {
     // Unique ID of request.
@@ -820,7 +854,7 @@ class ClientContext : public RefCounted<ClientContext> {
     // 5: kIsBackupRequestMask, indicates whether backup-request is used by user.
     // 6: kIsIgnoreProxyTimeoutMask, indicates whether to ignore timeout option of proxy.
     // 7: kIsSetRequestId, used to indicate whether the request ID has been set.
-    // 8: reserved.
+    // 8: kIsServedLocallyMask, indicates whether the response is served without sending the request.
     uint8_t state_flag_ = 0b00000000;
 
     // Type of message.
@@ -875,6 +909,12 @@ class ClientContext : public RefCounted<ClientContext> {
     // option of service proxy
     ServiceProxyOption* service_proxy_option = nullptr;
 
+    // handle of the callee in the load balancer, owned by the service proxy
+    const LoadBalanceHandle* load_balance_handle = nullptr;
+
+    // whether the invocation result is needed by the selector, resolved by the service proxy
+    bool invoke_result_needed = false;
+
     // Input key for hashing to select the instances of remote service. It is set by user.
     std::string hash_key;
 
@@ -0,0 +1,43 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#include "trpc/client/request_budget.h"
+
+#include <algorithm>
+
+namespace trpc {
+
+RequestBudget::RequestBudget(uint32_t budget_percent) : budget_percent_(budget_percent) {}
+
+void RequestBudget::AddRequest() {
+  int64_t tokens = tokens_.load(std::memory_order_relaxed);
+  while (tokens < kMaxTokens) {
+    int64_t new_tokens = std::min<int64_t>(tokens + budget_percent_, kMaxTokens);
+    if (tokens_.compare_exchange_weak(tokens, new_tokens, std::memory_order_relaxed)) {
+      break;
+    }
+  }
+}
+
+bool RequestBudget::TryAcquire() {
+  int64_t tokens = tokens_.load(std::memory_order_relaxed);
+  while (tokens >= kTokensPerRequest) {
+    if (tokens_.compare_exchange_weak(tokens, tokens - kTokensPerRequest, std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace trpc
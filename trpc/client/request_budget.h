@@ -0,0 +1,55 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace trpc {
+
+/// @brief Budget of the extra requests sent on behalf of the requests to a callee, e.g. the retries or the backup
+///        requests, which is earned in percent of the requests so the extra load on the callee is bounded.
+class RequestBudget {
+ public:
+  /// Extra requests that can be saved up by the budget, so a burst of them is allowed.
+  static constexpr uint32_t kMaxBurst = 10;
+
+  /// @param budget_percent The extra requests allowed, in percent of the requests.
+  explicit RequestBudget(uint32_t budget_percent);
+
+  /// @brief Counts a request to the callee, which adds `budget_percent` of an extra request to the budget.
+  void AddRequest();
+
+  /// @brief Whether an extra request can be taken out of the budget.
+  bool HasBudget() const { return tokens_.load(std::memory_order_relaxed) >= kTokensPerRequest; }
+
+  /// @brief Takes an extra request out of the budget.
+  /// @return false if the budget runs out.
+  bool TryAcquire();
+
+ private:
+  // The budget is counted in 1/100 of an extra request.
+  static constexpr int64_t kTokensPerRequest = 100;
+
+  // The maximum tokens saved up.
+  static constexpr int64_t kMaxTokens = kMaxBurst * kTokensPerRequest;
+
+ private:
+  int64_t budget_percent_;
+
+  std::atomic<int64_t> tokens_{kMaxTokens};
+};
+
+}  // namespace trpc
@@ -0,0 +1,76 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#include "trpc/client/request_budget.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace trpc::testing {
+
+TEST(RequestBudgetTest, Budget) {
+  RequestBudget budget(20);
+
+  // A burst of extra requests is allowed at first.
+  for (uint32_t i = 0; i < RequestBudget::kMaxBurst; ++i) {
+    ASSERT_TRUE(budget.HasBudget());
+    ASSERT_TRUE(budget.TryAcquire());
+  }
+  ASSERT_FALSE(budget.HasBudget());
+  ASSERT_FALSE(budget.TryAcquire());
+
+  // One extra request per 5 requests.
+  for (int i = 0; i < 4; ++i) {
+    budget.AddRequest();
+  }
+  ASSERT_FALSE(budget.TryAcquire());
+  budget.AddRequest();
+  ASSERT_TRUE(budget.TryAcquire());
+
+  // The budget saved up is capped.
+  for (int i = 0; i < 1000; ++i) {
+    budget.AddRequest();
+  }
+  for (uint32_t i = 0; i < RequestBudget::kMaxBurst; ++i) {
+    ASSERT_TRUE(budget.TryAcquire());
+  }
+  ASSERT_FALSE(budget.TryAcquire());
+}
+
+TEST(RequestBudgetTest, ConcurrentAcquire) {
+  RequestBudget budget(20);
+
+  // The extra requests taken concurrently never overdraw the budget.
+  std::atomic<uint32_t> acquired{0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; ++i) {
+    threads.emplace_back([&budget, &acquired]() {
+      for (int j = 0; j < 100; ++j) {
+        if (budget.TryAcquire()) {
+          acquired.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  ASSERT_EQ(acquired.load(), RequestBudget::kMaxBurst);
+  ASSERT_FALSE(budget.HasBudget());
+}
+
+}  // namespace trpc::testing
@@ -0,0 +1,129 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/client/response_cache.h"
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+#include "trpc/util/time.h"
+
+namespace trpc {
+
+ResponseCache::ResponseCache(const Options& options) : options_(options) {
+  options_.shard_num = std::max<std::size_t>(options_.shard_num, 1);
+  shard_max_size_ = options_.max_size / options_.shard_num;
+  shards_ = std::make_unique<Shard[]>(options_.shard_num);
+}
+
+bool ResponseCache::Get(const std::string& key, Value* value) {
+  Shard& shard = shards_[std::hash<std::string>{}(key) % options_.shard_num];
+  uint64_t now_ms = trpc::time::GetMilliSeconds();
+
+  std::scoped_lock lock(shard.mutex);
+  auto iter = shard.index.find(key);
+  if (iter == shard.index.end()) {
+    return false;
+  }
+
+  Entry& entry = shard.slots[iter->second];
+  if (entry.expire_ms <= now_ms) {
+    Remove(shard, iter->second);
+    return false;
+  }
+
+  entry.referenced = true;
+  *value = entry.value;
+  return true;
+}
+
+void ResponseCache::Put(const std::string& key, Value&& value) {
+  std::size_t size = key.size() + value.rsp.ByteSize();
+  if (size > shard_max_size_) {
+    return;
+  }
+
+  Shard& shard = shards_[std::hash<std::string>{}(key) % options_.shard_num];
+  uint64_t now_ms = trpc::time::GetMilliSeconds();
+
+  std::scoped_lock lock(shard.mutex);
+  auto iter = shard.index.find(key);
+  if (iter != shard.index.end()) {
+    Remove(shard, iter->second);
+  }
+
+  while (shard.size + size > shard_max_size_) {
+    EvictOne(shard, now_ms);
+  }
+
+  std::size_t slot;
+  if (!shard.free_slots.empty()) {
+    slot = shard.free_slots.back();
+    shard.free_slots.pop_back();
+  } else {
+    slot = shard.slots.size();
+    shard.slots.emplace_back();
+  }
+
+  iter = shard.index.emplace(key, slot).first;
+  Entry& entry = shard.slots[slot];
+  entry.key = &iter->first;
+  entry.value = std::move(value);
+  entry.expire_ms = now_ms + options_.ttl;
+  entry.size = size;
+  // A new entry is not spared by the hand until it is read.
+  entry.referenced = false;
+  shard.size += size;
+}
+
+std::size_t ResponseCache::Size() const {
+  std::size_t size = 0;
+  for (std::size_t i = 0; i < options_.shard_num; ++i) {
+    std::scoped_lock lock(shards_[i].mutex);
+    size += shards_[i].size;
+  }
+  return size;
+}
+
+void ResponseCache::EvictOne(Shard& shard, uint64_t now_ms) {
+  // There is an entry to evict as the shard is not empty, it is found within two rounds of the hand.
+  while (true) {
+    if (shard.hand >= shard.slots.size()) {
+      shard.hand = 0;
+    }
+
+    std::size_t slot = shard.hand++;
+    Entry& entry = shard.slots[slot];
+    if (entry.key == nullptr) {
+      continue;
+    }
+    if (entry.referenced && entry.expire_ms > now_ms) {
+      entry.referenced = false;
+      continue;
+    }
+
+    Remove(shard, slot);
+    return;
+  }
+}
+
+void ResponseCache::Remove(Shard& shard, std::size_t slot) {
+  Entry& entry = shard.slots[slot];
+  shard.size -= entry.size;
+  shard.index.erase(shard.index.find(*entry.key));
+  entry = Entry();
+  shard.free_slots.push_back(slot);
+}
+
+}  // namespace trpc
@@ -0,0 +1,101 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+
+namespace trpc {
+
+/// @brief Cache of the serialized responses of a service, keyed by the requests. The entries expire after a TTL, and
+/// the cache is bounded by the bytes of the keys and the responses.
+///
+/// The cache is sharded by the hash of the keys, each shard evicts its entries in an approximate LRU order by the
+/// CLOCK algorithm: an entry read since the clock hand passed it last time is spared once.
+/// @note Thread safe.
+class ResponseCache {
+ public:
+  struct Options {
+    /// Time(ms) to live of the entries.
+    uint64_t ttl{1000};
+
+    /// Maximum bytes of the entries.
+    std::size_t max_size{64 * 1024 * 1024};
+
+    /// Number of the shards, the entries of a shard are bounded by `max_size / shard_num`.
+    std::size_t shard_num{16};
+  };
+
+  /// @brief A cached response.
+  struct Value {
+    /// The serialized response, the buffer is shared with the cache rather than copied.
+    NoncontiguousBuffer rsp;
+
+    /// The serialization type of `rsp`.
+    uint8_t encode_type{0};
+  };
+
+  explicit ResponseCache(const Options& options);
+
+  /// @brief Gets the unexpired response of the key.
+  /// @return false if not found.
+  bool Get(const std::string& key, Value* value);
+
+  /// @brief Puts the response of the key, replacing the existing one. The response is not cached if it is larger than
+  /// a shard.
+  void Put(const std::string& key, Value&& value);
+
+  /// @brief Gets the bytes of the entries.
+  std::size_t Size() const;
+
+ private:
+  struct Entry {
+    // Points to the key of the entry in `Shard::index`, null if the slot is free.
+    const std::string* key{nullptr};
+    Value value;
+    uint64_t expire_ms{0};
+    std::size_t size{0};
+    bool referenced{false};
+  };
+
+  struct Shard {
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, std::size_t> index;
+    std::vector<Entry> slots;
+    std::vector<std::size_t> free_slots;
+    std::size_t hand{0};
+    std::size_t size{0};
+  };
+
+  // Evicts an entry by the clock hand, an expired entry is evicted first when the hand passes it.
+  void EvictOne(Shard& shard, uint64_t now_ms);
+
+  void Remove(Shard& shard, std::size_t slot);
+
+ private:
+  Options options_;
+
+  std::size_t shard_max_size_;
+
+  std::unique_ptr<Shard[]> shards_;
+};
+
+}  // namespace trpc
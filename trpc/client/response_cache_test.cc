@@ -0,0 +1,95 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/client/response_cache.h"
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+
+namespace trpc::testing {
+
+namespace {
+
+ResponseCache::Value MakeValue(const std::string& rsp, uint8_t encode_type = 0) {
+  ResponseCache::Value value;
+  value.rsp = CreateBufferSlow(rsp);
+  value.encode_type = encode_type;
+  return value;
+}
+
+}  // namespace
+
+TEST(ResponseCacheTest, GetAndPut) {
+  ResponseCache cache(ResponseCache::Options{});
+  ResponseCache::Value value;
+  ASSERT_FALSE(cache.Get("key", &value));
+
+  cache.Put("key", MakeValue("rsp", 1));
+  ASSERT_TRUE(cache.Get("key", &value));
+  ASSERT_EQ(FlattenSlow(value.rsp), "rsp");
+  ASSERT_EQ(value.encode_type, 1);
+  ASSERT_EQ(cache.Size(), 6);
+
+  cache.Put("key", MakeValue("new_rsp"));
+  ASSERT_TRUE(cache.Get("key", &value));
+  ASSERT_EQ(FlattenSlow(value.rsp), "new_rsp");
+  ASSERT_EQ(cache.Size(), 10);
+}
+
+TEST(ResponseCacheTest, Expire) {
+  ResponseCache::Options options;
+  options.ttl = 10;
+  ResponseCache cache(options);
+  cache.Put("key", MakeValue("rsp"));
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  ResponseCache::Value value;
+  ASSERT_FALSE(cache.Get("key", &value));
+  ASSERT_EQ(cache.Size(), 0);
+}
+
+TEST(ResponseCacheTest, Evict) {
+  ResponseCache::Options options;
+  options.max_size = 40;
+  options.shard_num = 1;
+  ResponseCache cache(options);
+
+  // Each entry takes 10 bytes, the cache holds 4 of them.
+  for (int i = 0; i < 4; ++i) {
+    cache.Put("key" + std::to_string(i), MakeValue("rsp_00"));
+  }
+  ResponseCache::Value value;
+  ASSERT_TRUE(cache.Get("key0", &value));
+  ASSERT_TRUE(cache.Get("key2", &value));
+
+  // The entries read are spared, the others are evicted in turn.
+  cache.Put("key4", MakeValue("rsp_00"));
+  ASSERT_FALSE(cache.Get("key1", &value));
+  cache.Put("key5", MakeValue("rsp_00"));
+  ASSERT_FALSE(cache.Get("key3", &value));
+  ASSERT_TRUE(cache.Get("key0", &value));
+  ASSERT_TRUE(cache.Get("key2", &value));
+  ASSERT_EQ(cache.Size(), 40);
+
+  // The response larger than the cache is not cached.
+  cache.Put("key6", MakeValue(std::string(40, 'x')));
+  ASSERT_FALSE(cache.Get("key6", &value));
+  ASSERT_TRUE(cache.Get("key5", &value));
+}
+
+}  // namespace trpc::testing
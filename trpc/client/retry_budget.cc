@@ -0,0 +1,41 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/client/retry_budget.h"
+
+#include "trpc/codec/trpc/trpc.pb.h"
+
+namespace trpc {
+
+RetryBudget::RetryBudget(const Options& options) : options_(options), budget_(options.budget_percent) {}
+
+bool RetryBudget::IsRetryable(int framework_ret, bool idempotent) {
+  return framework_ret == TrpcRetCode::TRPC_CLIENT_CONNECT_ERR ||
+         (idempotent && framework_ret == TrpcRetCode::TRPC_CLIENT_NETWORK_ERR);
+}
+
+void RetryBudget::AddRequest() { budget_.AddRequest(); }
+
+bool RetryBudget::CanRetry(uint32_t retry_times) const {
+  return retry_times < options_.max_retry_times && budget_.HasBudget();
+}
+
+bool RetryBudget::TryAcquire(uint32_t retry_times) {
+  if (retry_times >= options_.max_retry_times) {
+    return false;
+  }
+
+  return budget_.TryAcquire();
+}
+
+}  // namespace trpc
@@ -0,0 +1,66 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <cstdint>
+
+#include "trpc/client/request_budget.h"
+
+namespace trpc {
+
+/// @brief Budget of the retries to a callee: the retries are limited to a percentage of the requests, so the retries
+/// during a partial outage of the callee do not amplify the load on its healthy nodes. Only the failures which are
+/// likely to succeed on another node are retryable, see `IsRetryable`.
+/// @note Thread safe, lock free.
+class RetryBudget {
+ public:
+  struct Options {
+    /// Retries allowed, in percent of the requests.
+    uint32_t budget_percent{10};
+
+    /// Maximum times a request is retried.
+    uint32_t max_retry_times{1};
+  };
+
+  /// Retries that can be saved up by the budget, so the requests failed by a sudden crash of a node can be retried.
+  static constexpr uint32_t kMaxBurst = RequestBudget::kMaxBurst;
+
+  explicit RetryBudget(const Options& options);
+
+  /// @brief Whether an invocation failed with the framework error code is retryable on another node. The request
+  /// failing to connect is never received by the callee, while the request losing its connection may have been
+  /// processed, so it's retried only if it's idempotent. The requests timed out or rejected by the callee are not.
+  /// @param framework_ret The framework error code of the invocation.
+  /// @param idempotent Whether the request can be processed more than once.
+  static bool IsRetryable(int framework_ret, bool idempotent);
+
+  /// @brief Counts a request to the callee, which adds to the budget of the retries.
+  void AddRequest();
+
+  /// @brief Whether the request is allowed to be retried once more within the budget, without taking it out.
+  /// @param retry_times The times the request has been retried.
+  bool CanRetry(uint32_t retry_times) const;
+
+  /// @brief Takes a retry out of the budget.
+  /// @param retry_times The times the request has been retried.
+  /// @return false if the request is not allowed to be retried any more, or the budget runs out.
+  bool TryAcquire(uint32_t retry_times);
+
+ private:
+  Options options_;
+
+  RequestBudget budget_;
+};
+
+}  // namespace trpc
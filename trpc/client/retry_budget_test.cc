@@ -0,0 +1,100 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/client/retry_budget.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "trpc/codec/trpc/trpc.pb.h"
+
+namespace trpc::testing {
+
+TEST(RetryBudgetTest, IsRetryable) {
+  ASSERT_TRUE(RetryBudget::IsRetryable(TrpcRetCode::TRPC_CLIENT_CONNECT_ERR, false));
+  ASSERT_TRUE(RetryBudget::IsRetryable(TrpcRetCode::TRPC_CLIENT_CONNECT_ERR, true));
+  // The request losing its connection may have been processed by the callee.
+  ASSERT_FALSE(RetryBudget::IsRetryable(TrpcRetCode::TRPC_CLIENT_NETWORK_ERR, false));
+  ASSERT_TRUE(RetryBudget::IsRetryable(TrpcRetCode::TRPC_CLIENT_NETWORK_ERR, true));
+  ASSERT_FALSE(RetryBudget::IsRetryable(TrpcRetCode::TRPC_INVOKE_SUCCESS, true));
+  ASSERT_FALSE(RetryBudget::IsRetryable(TrpcRetCode::TRPC_CLIENT_INVOKE_TIMEOUT_ERR, true));
+  ASSERT_FALSE(RetryBudget::IsRetryable(TrpcRetCode::TRPC_CLIENT_ENCODE_ERR, true));
+  ASSERT_FALSE(RetryBudget::IsRetryable(TrpcRetCode::TRPC_SERVER_OVERLOAD_ERR, true));
+}
+
+TEST(RetryBudgetTest, Budget) {
+  RetryBudget::Options options;
+  options.budget_percent = 10;
+  options.max_retry_times = 2;
+  RetryBudget budget(options);
+
+  // A request is retried `max_retry_times` at most.
+  ASSERT_FALSE(budget.CanRetry(2));
+  ASSERT_FALSE(budget.TryAcquire(2));
+
+  // A burst of retries is allowed at first.
+  for (uint32_t i = 0; i < RetryBudget::kMaxBurst; ++i) {
+    ASSERT_TRUE(budget.CanRetry(0));
+    ASSERT_TRUE(budget.TryAcquire(0));
+  }
+  ASSERT_FALSE(budget.CanRetry(0));
+  ASSERT_FALSE(budget.TryAcquire(0));
+
+  // One retry per 10 requests.
+  for (int i = 0; i < 9; ++i) {
+    budget.AddRequest();
+  }
+  ASSERT_FALSE(budget.TryAcquire(1));
+  budget.AddRequest();
+  ASSERT_TRUE(budget.TryAcquire(1));
+  ASSERT_FALSE(budget.TryAcquire(0));
+
+  // The budget saved up is capped.
+  for (int i = 0; i < 1000; ++i) {
+    budget.AddRequest();
+  }
+  for (uint32_t i = 0; i < RetryBudget::kMaxBurst; ++i) {
+    ASSERT_TRUE(budget.TryAcquire(0));
+  }
+  ASSERT_FALSE(budget.TryAcquire(0));
+}
+
+TEST(RetryBudgetTest, Concurrent) {
+  RetryBudget::Options options;
+  options.budget_percent = 10;
+  RetryBudget budget(options);
+
+  std::atomic<uint32_t> retry_count{0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&budget, &retry_count]() {
+      for (int j = 0; j < 10000; ++j) {
+        budget.AddRequest();
+        if (budget.TryAcquire(0)) {
+          retry_count.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // The retries never exceed the budget, whatever the interleaving.
+  ASSERT_LE(retry_count.load(), 40000 / 10 + RetryBudget::kMaxBurst);
+}
+
+}  // namespace trpc::testing
@@ -14,6 +14,7 @@
 #pragma once
 
 #include <string>
+#include <type_traits>
 #include <utility>
 
 #include "rapidjson/document.h"
@@ -25,11 +26,13 @@
 #include "trpc/codec/codec_helper.h"
 #include "trpc/codec/protocol.h"
 #include "trpc/common/status.h"
+#include "trpc/serialization/pb/pb_aliasing.h"
 #include "trpc/serialization/serialization_factory.h"
 #include "trpc/serialization/serialization_type.h"
 #include "trpc/stream/stream.h"
 #include "trpc/stream/stream_async.h"
 #include "trpc/stream/stream_handler.h"
+#include "trpc/util/deferred.h"
 #include "trpc/util/flatbuffers/message_fbs.h"
 #include "trpc/util/log/logging.h"
 #include "trpc/util/time.h"
@@ -104,6 +107,9 @@ class RpcServiceProxy : public ServiceProxy {
     if constexpr (std::is_convertible_v<Message*, google::protobuf::MessageLite*>) {
       data_type = serialization::kPbMessage;
       encode_type = serialization::kPbType;
+    } else if constexpr (std::is_convertible_v<Message*, serialization::PbAliasedMessage*>) {
+      data_type = serialization::kPbAliasedMessage;
+      encode_type = serialization::kPbType;
     } else if constexpr (std::is_convertible_v<Message*, flatbuffers::trpc::MessageFbs*>) {
       data_type = serialization::kFlatBuffers;
       encode_type = serialization::kFlatBuffersType;
@@ -230,6 +236,48 @@ void RpcServiceProxy::UnaryInvokeImp(const ClientContextPtr& context, const Requ
     return;
   }
 
+  std::string request_key;
+  bool is_cached = IsResponseCached(context);
+  bool is_single_flight = IsSingleFlight(context);
+  if ((is_cached || is_single_flight) && !GetRequestKey(context, &request_key)) {
+    is_cached = is_single_flight = false;
+  }
+
+  if (is_cached && GetCachedResponse(context, request_key, static_cast<void*>(rsp))) {
+    RunServedLocallyFilters(context);
+    return;
+  }
+
+  bool is_flight_leader = false;
+  if constexpr (std::is_copy_constructible_v<ResponseMessage>) {
+    if (is_single_flight) {
+      Future<SingleFlight::ResultPtr> waiter;
+      auto role = single_flight_->Join(request_key, trpc::time::GetMilliSeconds() + context->GetTimeout(), &waiter);
+      if (role == SingleFlight::Role::kWaiter) {
+        SingleFlight::ResultPtr result = SingleFlight::Wait(std::move(waiter), context->GetTimeout());
+        context->SetStatus(result->status);
+        if (result->status.OK()) {
+          *rsp = *static_cast<const ResponseMessage*>(result->rsp.get());
+        }
+        RunServedLocallyFilters(context);
+        return;
+      }
+      is_flight_leader = role == SingleFlight::Role::kLeader;
+    }
+  }
+
+  // The response is cached, and shared by the leader of the coalesced invocations, once the invocation is done.
+  ScopedDeferred share_result([this, &context, &request_key, is_cached, is_flight_leader, rsp]() {
+    if (is_cached && context->GetStatus().OK()) {
+      PutCachedResponse(context, request_key, static_cast<void*>(rsp));
+    }
+    if constexpr (std::is_copy_constructible_v<ResponseMessage>) {
+      if (is_flight_leader) {
+        single_flight_->Done(request_key, SingleFlight::MakeResult(context->GetStatus(), *rsp));
+      }
+    }
+  });
+
   ProtocolPtr& rsp_protocol = context->GetResponse();
   Status unary_invoke_status = ServiceProxy::UnaryInvoke(context, req_protocol, rsp_protocol);
 
@@ -308,7 +356,56 @@ Future<ResponseMessage> RpcServiceProxy::AsyncUnaryInvokeImp(const ClientContext
         CommonException(context->GetStatus().ErrorMessage().c_str(), TrpcRetCode::TRPC_CLIENT_ENCODE_ERR));
   }
 
-  return ServiceProxy::AsyncUnaryInvoke(context, req_protocol)
+  std::string request_key;
+  bool is_cached = IsResponseCached(context);
+  bool is_single_flight = IsSingleFlight(context);
+  if ((is_cached || is_single_flight) && !GetRequestKey(context, &request_key)) {
+    is_cached = is_single_flight = false;
+  }
+
+  if (is_cached) {
+    ResponseMessage rsp_obj;
+    if (GetCachedResponse(context, request_key, static_cast<void*>(&rsp_obj))) {
+      RunServedLocallyFilters(context);
+      if (context->GetStatus().OK()) {
+        context->SetResponseData(&rsp_obj);
+      }
+      RunFilters(FilterPoint::CLIENT_POST_RPC_INVOKE, context);
+      context->SetResponseData(nullptr);
+      context->SetEndTimestampUs(trpc::time::GetMicroSeconds());
+
+      if (!context->GetStatus().OK()) {
+        return MakeExceptionFuture<ResponseMessage>(UnaryRpcError(context->GetStatus()));
+      }
+      return MakeReadyFuture<ResponseMessage>(std::move(rsp_obj));
+    }
+  }
+
+  bool is_flight_leader = false;
+  if constexpr (std::is_copy_constructible_v<ResponseMessage>) {
+    if (is_single_flight) {
+      // The waiter waits no longer than its own timeout, as the leader is not allowed to outlive it.
+      Future<SingleFlight::ResultPtr> waiter;
+      auto role = single_flight_->Join(request_key, trpc::time::GetMilliSeconds() + context->GetTimeout(), &waiter);
+      if (role == SingleFlight::Role::kWaiter) {
+        return std::move(waiter).Then([this, context](SingleFlight::ResultPtr&& result) {
+          context->SetStatus(result->status);
+          RunServedLocallyFilters(context);
+          RunFilters(FilterPoint::CLIENT_POST_RPC_INVOKE, context);
+          context->SetEndTimestampUs(trpc::time::GetMicroSeconds());
+
+          if (!context->GetStatus().OK()) {
+            return MakeExceptionFuture<ResponseMessage>(UnaryRpcError(context->GetStatus()));
+          }
+          auto rsp = static_cast<const ResponseMessage*>(result->rsp.get());
+          return MakeReadyFuture<ResponseMessage>(ResponseMessage(*rsp));
+        });
+      }
+      is_flight_leader = role == SingleFlight::Role::kLeader;
+    }
+  }
+
+  auto fut = ServiceProxy::AsyncUnaryInvoke(context, req_protocol)
       .Then([this, context](Future<ProtocolPtr>&& rsp_protocol) {
         if (rsp_protocol.IsFailed()) {
           RunFilters(FilterPoint::CLIENT_POST_RPC_INVOKE, context);
@@ -352,6 +449,38 @@ Future<ResponseMessage> RpcServiceProxy::AsyncUnaryInvokeImp(const ClientContext
 
         return MakeReadyFuture<ResponseMessage>(std::move(rsp_obj));
       });
+
+  if (!is_cached && !is_flight_leader) {
+    return fut;
+  }
+
+  // The response is cached, and shared by the leader of the coalesced invocations, once the invocation is done.
+  return std::move(fut).Then([this, context, request_key = std::move(request_key), is_cached,
+                              is_flight_leader](Future<ResponseMessage>&& fut) {
+    if (fut.IsReady()) {
+      if (is_cached) {
+        PutCachedResponse(context, request_key, const_cast<ResponseMessage*>(&fut.GetConstValue()));
+      }
+      if constexpr (std::is_copy_constructible_v<ResponseMessage>) {
+        if (is_flight_leader) {
+          single_flight_->Done(request_key, SingleFlight::MakeResult(context->GetStatus(), fut.GetConstValue()));
+        }
+      }
+      return std::move(fut);
+    }
+
+    if (!is_flight_leader) {
+      return std::move(fut);
+    }
+
+    Exception exception = fut.GetException();
+    Status status = context->GetStatus();
+    if (status.OK()) {
+      status = Status(exception.GetExceptionCode(), 0, exception.what());
+    }
+    single_flight_->Done(request_key, SingleFlight::MakeResult(status));
+    return MakeExceptionFuture<ResponseMessage>(std::move(exception));
+  });
 }
 
 template <class RequestProtocol>
@@ -382,6 +382,72 @@ TEST_F(RpcServiceProxyTestFixture, AsyncUnaryInvokeFillResponseError) {
   future::BlockingGet(std::move(fut));
 }
 
+TEST_F(RpcServiceProxyTestFixture, UnaryInvokeResponseCache) {
+  const std::string func_name = "/trpc.test.helloworld.Greeter/SayHello";
+  auto option = std::make_shared<ServiceProxyOption>(*option_);
+  option->response_cache_ttl = 1000;
+  option->response_cache_methods = {func_name};
+  mock_rpc_service_proxy_->SetMockServiceProxyOption(option);
+
+  // The address set by the user is not a part of the key, the invocations to it are not cached.
+  auto get_client_context = [this, &func_name](bool set_addr) {
+    auto ctx = set_addr ? GetClientContext() : MakeClientContext(mock_rpc_service_proxy_);
+    ctx->SetFuncName(func_name);
+    return ctx;
+  };
+
+  EXPECT_CALL(*codec_, FillRequest(::testing::_, ::testing::_, ::testing::_))
+      .Times(5)
+      .WillRepeatedly(::testing::Invoke([](const ClientContextPtr& context, const ProtocolPtr& in, void* body) {
+        in->SetNonContiguousProtocolBody(CreateBufferSlow(static_cast<test::helloworld::HelloRequest*>(body)->msg()));
+        return true;
+      }));
+  EXPECT_CALL(*codec_, FillResponse(::testing::_, ::testing::_, ::testing::_))
+      .Times(4)
+      .WillRepeatedly(::testing::Invoke([](const ClientContextPtr& context, const ProtocolPtr& in, void* body) {
+        static_cast<test::helloworld::HelloReply*>(body)->set_msg("rsp");
+        return true;
+      }));
+  ProtocolPtr rsp_data = codec_->CreateResponsePtr();
+  EXPECT_CALL(*mock_rpc_service_proxy_, UnaryTransportInvoke(::testing::_, ::testing::_, ::testing::_))
+      .Times(4)
+      .WillRepeatedly(::testing::SetArgReferee<2>(rsp_data));
+
+  test::helloworld::HelloRequest hello_req;
+  hello_req.set_msg("req");
+  // The second invocation is served by the cache, without invoking the transport.
+  for (int i = 0; i < 2; ++i) {
+    auto client_context = get_client_context(false);
+    test::helloworld::HelloReply hello_rsp;
+    Status status = mock_rpc_service_proxy_->UnaryInvoke<test::helloworld::HelloRequest, test::helloworld::HelloReply>(
+        client_context, hello_req, &hello_rsp);
+    EXPECT_TRUE(status.OK());
+    EXPECT_EQ(hello_rsp.msg(), "rsp");
+    EXPECT_EQ(client_context->IsServedLocally(), i == 1);
+  }
+
+  // The invocations of the same request with another transinfo, or to an address set by the user, are not.
+  auto client_context = get_client_context(false);
+  client_context->AddReqTransInfo("key", "value");
+  test::helloworld::HelloReply hello_rsp;
+  Status status = mock_rpc_service_proxy_->UnaryInvoke<test::helloworld::HelloRequest, test::helloworld::HelloReply>(
+      client_context, hello_req, &hello_rsp);
+  EXPECT_TRUE(status.OK());
+  EXPECT_FALSE(client_context->IsServedLocally());
+
+  client_context = get_client_context(true);
+  status = mock_rpc_service_proxy_->UnaryInvoke<test::helloworld::HelloRequest, test::helloworld::HelloReply>(
+      client_context, hello_req, &hello_rsp);
+  EXPECT_TRUE(status.OK());
+  EXPECT_FALSE(client_context->IsServedLocally());
+
+  // The invocation of another request is not.
+  hello_req.set_msg("other_req");
+  status = mock_rpc_service_proxy_->UnaryInvoke<test::helloworld::HelloRequest, test::helloworld::HelloReply>(
+      get_client_context(false), hello_req, &hello_rsp);
+  EXPECT_TRUE(status.OK());
+}
+
 TEST_F(RpcServiceProxyTestFixture, AsyncStreamInvoke1) {
   auto client_context = GetClientContext();
   auto stream = dynamic_pointer_cast<testing::MockStreamReaderWriterProvider>(
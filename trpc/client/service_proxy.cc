@@ -17,7 +17,9 @@
 #include <cassert>
 #include <deque>
 #include <memory>
+#include <string_view>
 #include <utility>
+#include <vector>
 
 #include "trpc/codec/client_codec_factory.h"
 #include "trpc/codec/trpc/trpc_protocol.h"
@@ -32,7 +34,9 @@
 #include "trpc/runtime/merge_runtime.h"
 #include "trpc/runtime/separate_runtime.h"
 #include "trpc/runtime/threadmodel/thread_model_manager.h"
+#include "trpc/serialization/pb/pb_aliasing.h"
 #include "trpc/serialization/serialization_factory.h"
+#include "trpc/serialization/serialization_type.h"
 #include "trpc/stream/stream_handler.h"
 #include "trpc/transport/client/future/future_transport.h"
 #ifdef TRPC_BUILD_INCLUDE_SSL
@@ -49,6 +53,13 @@
 
 namespace trpc {
 
+namespace {
+
+// Selections tried for a node other than the failed one, before giving up the retry.
+constexpr uint32_t kRetrySelectTimes = 3;
+
+}  // namespace
+
 Status ServiceProxy::UnaryInvoke(const ClientContextPtr& context, const ProtocolPtr& req, ProtocolPtr& rsp) {
   TRPC_FMT_DEBUG("UnaryInvoke msg request_id: {}", context->GetRequestId());
 
@@ -62,7 +73,7 @@ Status ServiceProxy::UnaryInvoke(const ClientContextPtr& context, const Protocol
   if (filter_ret == 0) {
     UnaryTransportInvoke(context, req, rsp);
 
-    ProxyStatistics(context);
+    ProxyStatistics(context, context->GetStatus().OK());
   }
 
   // Run filters after client receives the RPC response message
@@ -179,6 +190,53 @@ void ServiceProxy::InitServiceNameInfo() {
   }
 }
 
+void ServiceProxy::InitLoadBalanceHandle() {
+  load_balance_handle_.reset();
+  invoke_result_needed_ = false;
+  auto selector = SelectorFactory::GetInstance()->Get(option_->selector_name);
+  if (!selector) {
+    return;
+  }
+
+  SelectorInfo info;
+  info.name = service_name_;
+  info.load_balance_name = option_->load_balance_name;
+  invoke_result_needed_ = selector->NeedInvokeResult(&info);
+  auto handle = std::make_unique<LoadBalanceHandle>();
+  if (selector->GetLoadBalanceHandle(&info, handle.get())) {
+    load_balance_handle_ = std::move(handle);
+  }
+}
+
+void ServiceProxy::InitEndpointWatch() {
+  if (option_->min_conn_num == 0 || endpoint_watch_id_ != 0) {
+    return;
+  }
+
+  auto selector = SelectorFactory::GetInstance()->Get(option_->selector_name);
+  if (!selector) {
+    return;
+  }
+
+  uint32_t conn_num = std::min(option_->min_conn_num, option_->max_conn_num);
+  endpoint_watch_id_ =
+      selector->WatchEndpoints(service_name_, [this, conn_num](const std::vector<TrpcEndpointInfo>& endpoints) {
+        std::vector<NodeAddr> nodes;
+        nodes.reserve(endpoints.size());
+        for (const auto& endpoint : endpoints) {
+          NodeAddr node;
+          node.ip = endpoint.host;
+          node.port = endpoint.port;
+          node.addr_type = endpoint.is_ipv6 ? NodeAddr::AddrType::kIpV6 : NodeAddr::AddrType::kIpV4;
+          nodes.emplace_back(std::move(node));
+        }
+        transport_->Prewarm(nodes, conn_num);
+      });
+  if (endpoint_watch_id_ != 0) {
+    watched_selector_ = std::move(selector);
+  }
+}
+
 void ServiceProxy::UnaryTransportInvoke(const ClientContextPtr& context, const ProtocolPtr& req, ProtocolPtr& rsp) {
   NoncontiguousBuffer req_msg_buf;
   if (TRPC_UNLIKELY(!codec_->ZeroCopyEncode(context, req, req_msg_buf))) {
@@ -200,8 +258,21 @@ void ServiceProxy::UnaryTransportInvoke(const ClientContextPtr& context, const P
   req_msg.send_data = std::move(req_msg_buf);
   req_msg.context = context;
 
+  // The encoded request is kept to be resent on another node, which shares the blocks of the buffer without copying.
+  NoncontiguousBuffer resend_data;
+  uint64_t deadline_us = 0;
+  if (retry_budget_) {
+    resend_data = req_msg.send_data;
+    deadline_us = trpc::time::GetMicroSeconds() + context->GetTimeout() * 1000ULL;
+  }
+
   CTransportRspMsg rsp_msg;
   int ret = transport_->SendRecv(&req_msg, &rsp_msg);
+  for (uint32_t retry_times = 0;
+       ret != 0 && retry_budget_ && RetryOnAnotherNode(context, ret, retry_times, deadline_us); ++retry_times) {
+    req_msg.send_data = resend_data;
+    ret = transport_->SendRecv(&req_msg, &rsp_msg);
+  }
   if (ret == 0) {
     rsp = std::any_cast<ProtocolPtr&&>(std::move(rsp_msg.msg));
     return;
@@ -266,9 +337,12 @@ Future<ProtocolPtr> ServiceProxy::AsyncUnaryTransportInvoke(const ClientContextP
   req_msg->send_data = std::move(req_msg_buf);
   req_msg->context = context;
 
-  return transport_->AsyncSendRecv(req_msg).Then([context, req_msg, this](Future<CTransportRspMsg>&& fut) mutable {
+  auto rsp_fut = retry_budget_ ? AsyncSendRecvWithRetry(context, req_msg, 0,
+                                                        trpc::time::GetMicroSeconds() + context->GetTimeout() * 1000ULL)
+                               : transport_->AsyncSendRecv(req_msg);
+  return rsp_fut.Then([context, req_msg, this](Future<CTransportRspMsg>&& fut) mutable {
     // generate statistics of backup request
-    ProxyStatistics(context);
+    ProxyStatistics(context, fut.IsReady());
 
     RunFilters(FilterPoint::CLIENT_POST_RECV_MSG, context);
     TRPC_LOG_TRACE("AsyncUnaryInvoke end");
@@ -298,6 +372,108 @@ Future<ProtocolPtr> ServiceProxy::AsyncUnaryTransportInvoke(const ClientContextP
   });
 }
 
+Future<CTransportRspMsg> ServiceProxy::AsyncSendRecvWithRetry(const ClientContextPtr& context,
+                                                              CTransportReqMsg* req_msg, uint32_t retry_times,
+                                                              uint64_t deadline_us) {
+  NoncontiguousBuffer resend_data = req_msg->send_data;
+  return transport_->AsyncSendRecv(req_msg).Then(
+      [this, context, req_msg, retry_times, deadline_us,
+       resend_data = std::move(resend_data)](Future<CTransportRspMsg>&& fut) mutable {
+        if (fut.IsReady()) {
+          return std::move(fut);
+        }
+
+        Exception ex = fut.GetException();
+        if (!RetryOnAnotherNode(context, ex.GetExceptionCode(), retry_times, deadline_us)) {
+          return MakeExceptionFuture<CTransportRspMsg>(std::move(ex));
+        }
+
+        req_msg->send_data = std::move(resend_data);
+        return AsyncSendRecvWithRetry(context, req_msg, retry_times + 1, deadline_us);
+      });
+}
+
+bool ServiceProxy::RetryOnAnotherNode(const ClientContextPtr& context, int ret, uint32_t retry_times,
+                                      uint64_t deadline_us) {
+  // The nodes of the backup requests are selected in pairs, and the node set by the user is the only choice.
+  if (!RetryBudget::IsRetryable(ret, IsIdempotent(context)) || context->IsBackupRequest() || context->IsSetAddr()) {
+    return false;
+  }
+
+  uint64_t now_us = trpc::time::GetMicroSeconds();
+  uint32_t timeout = deadline_us > now_us ? (deadline_us - now_us) / 1000 : 0;
+  if (timeout == 0 || !retry_budget_->CanRetry(retry_times)) {
+    return false;
+  }
+
+  ExtendNodeAddr failed_node;
+  failed_node.addr = context->GetNodeAddr();
+  failed_node.metadata = context->GetTargetMetadata();
+
+  // The failed node is excluded, the request is not retried if the selector keeps on selecting it, e.g. by hash. The
+  // selections discarded are given up by the selections following them, or by the report of the request.
+  bool selected = false;
+  for (uint32_t i = 0; i < kRetrySelectTimes && !selected; ++i) {
+    if (!SelectTarget(context)) {
+      context->SetStatus(Status());
+      break;
+    }
+    const NodeAddr& addr = context->GetNodeAddr();
+    selected = addr.ip != failed_node.addr.ip || addr.port != failed_node.addr.port;
+  }
+
+  // The retry is taken out of the budget once it's going to be sent.
+  if (!selected || !retry_budget_->TryAcquire(retry_times)) {
+    context->SetRequestAddrByNaming(std::move(failed_node));
+    return false;
+  }
+
+  ReportRetriedFailure(context, ret, failed_node, now_us);
+
+  TRPC_FMT_DEBUG("service name:{}, retry request {} on {}:{} for ret:{}", GetServiceName(), context->GetRequestId(),
+                 context->GetIp(), context->GetPort(), ret);
+
+  // The retry is sent within the time left.
+  if (context->IsUseFullLinkTimeout()) {
+    context->SetFullLinkTimeout(timeout);
+  } else {
+    context->SetTimeout(timeout, context->IsIgnoreProxyTimeout());
+  }
+  return true;
+}
+
+bool ServiceProxy::IsIdempotent(const ClientContextPtr& context) const {
+  const auto& methods = option_->idempotent_methods;
+  return !methods.empty() && std::find(methods.begin(), methods.end(), context->GetFuncName()) != methods.end();
+}
+
+void ServiceProxy::ReportRetriedFailure(const ClientContextPtr& context, int ret, const ExtendNodeAddr& failed_node,
+                                        uint64_t now_us) {
+  auto selector = SelectorFactory::GetInstance()->Get(option_->selector_name);
+  if (!selector) {
+    return;
+  }
+
+  // The failure of the node is reported here, the selector filter reports the result of the retry only. It's reported
+  // by a context of its own, so the state of the retry kept by the context of the request, e.g. the node selected by
+  // the load balancer, is left as it is.
+  auto failed_context = MakeRefCounted<ClientContext>();
+  failed_context->SetServiceProxyOption(option_.get());
+  failed_context->SetRequestAddrByNaming(ExtendNodeAddr(failed_node));
+  failed_context->SetSendTimestampUs(context->GetSendTimestampUs());
+  failed_context->SetTimeout(context->GetTimeout());
+  failed_context->SetStatus(Status(ret, 0, ""));
+
+  InvokeResult result;
+  result.name = context->GetServiceTarget();
+  result.framework_result = ret;
+  result.interface_result = 0;
+  uint64_t send_timestamp_us = context->GetSendTimestampUs();
+  result.cost_time = send_timestamp_us && now_us > send_timestamp_us ? (now_us - send_timestamp_us) / 1000 : 0;
+  result.context = failed_context;
+  selector->ReportInvokeResult(&result);
+}
+
 void ServiceProxy::SetCodec(const std::string& codec_name) {
   auto codec = ClientCodecFactory::GetInstance()->Get(codec_name);
 
@@ -350,6 +526,14 @@ void ServiceProxy::SetServiceProxyOptionInner(const std::shared_ptr<ServiceProxy
 
   PrepareStatistics(option->name);
 
+  InitBackupRequestHedging();
+
+  single_flight_.reset(option_->single_flight_methods.empty() ? nullptr : new SingleFlight());
+
+  InitResponseCache();
+
+  InitRetryBudget();
+
   InitFilters();
 
   // Init selector filter, the selector_name configuration option will be used.
@@ -359,6 +543,11 @@ void ServiceProxy::SetServiceProxyOptionInner(const std::shared_ptr<ServiceProxy
   // Init the service routing name.
   // It should be executed after 'InitSelectorFilter'.
   InitServiceNameInfo();
+
+  // It should be executed after 'InitServiceNameInfo'.
+  InitLoadBalanceHandle();
+
+  InitEndpointWatch();
 }
 
 void ServiceProxy::PrepareStatistics(const std::string& service_name) {
@@ -369,6 +558,146 @@ void ServiceProxy::PrepareStatistics(const std::string& service_name) {
   }
 }
 
+void ServiceProxy::InitBackupRequestHedging() {
+  backup_request_hedging_.reset();
+  if (option_->backup_request_delay_percentile == 0) {
+    return;
+  }
+
+  BackupRequestHedging::Options options;
+  options.delay_percentile = option_->backup_request_delay_percentile;
+  options.budget_percent = option_->backup_request_budget_percent;
+  backup_request_hedging_ = std::make_unique<BackupRequestHedging>(options);
+}
+
+void ServiceProxy::InitResponseCache() {
+  response_cache_.reset();
+  if (option_->response_cache_ttl == 0 || option_->response_cache_methods.empty()) {
+    return;
+  }
+
+  ResponseCache::Options options;
+  options.ttl = option_->response_cache_ttl;
+  options.max_size = option_->response_cache_max_size;
+  response_cache_ = std::make_unique<ResponseCache>(options);
+}
+
+void ServiceProxy::InitRetryBudget() {
+  retry_budget_.reset();
+  if (option_->retry_budget_percent == 0) {
+    return;
+  }
+
+  RetryBudget::Options options;
+  options.budget_percent = option_->retry_budget_percent;
+  options.max_retry_times = option_->max_retry_times;
+  retry_budget_ = std::make_unique<RetryBudget>(options);
+}
+
+bool ServiceProxy::IsSingleFlight(const ClientContextPtr& context) const {
+  const auto& methods = option_->single_flight_methods;
+  return single_flight_ && std::find(methods.begin(), methods.end(), context->GetFuncName()) != methods.end();
+}
+
+bool ServiceProxy::IsResponseCached(const ClientContextPtr& context) const {
+  const auto& methods = option_->response_cache_methods;
+  return response_cache_ && std::find(methods.begin(), methods.end(), context->GetFuncName()) != methods.end();
+}
+
+bool ServiceProxy::GetRequestKey(const ClientContextPtr& context, std::string* key) {
+  // The invocations routed by the user, e.g. to a target or an address, or by a hash key, are neither coalesced nor
+  // cached, as their routes are not a part of the key.
+  if (context->IsSetAddr() || context->IsUseFixedConnector() || !context->GetHashKey().empty() ||
+      context->GetServiceTarget() != option_->target) {
+    return false;
+  }
+
+  const ProtocolPtr& req_protocol = context->GetRequest();
+
+  // The attachment is not a part of the key, the invocations carrying one are neither coalesced nor cached.
+  NoncontiguousBuffer attachment = req_protocol->GetProtocolAttachment();
+  if (!attachment.Empty()) {
+    req_protocol->SetProtocolAttachment(std::move(attachment));
+    return false;
+  }
+
+  NoncontiguousBuffer body = req_protocol->GetNonContiguousProtocolBody();
+  if (body.Empty()) {
+    // Either the request is empty or the protocol does not expose its body, which can not be told apart.
+    return false;
+  }
+
+  // The transinfo may change the response, it's a part of the key in the order of its keys.
+  const auto& trans_info = context->GetPbReqTransInfo();
+  std::vector<std::pair<std::string_view, std::string_view>> sorted_trans_info(trans_info.begin(), trans_info.end());
+  std::sort(sorted_trans_info.begin(), sorted_trans_info.end());
+
+  const std::string& callee = context->GetCalleeName();
+  const std::string& func = context->GetFuncName();
+  key->clear();
+  key->reserve(callee.size() + func.size() + body.ByteSize() + 2);
+  key->append(callee).push_back('\0');
+  key->append(func).push_back('\0');
+  for (const auto& [name, value] : sorted_trans_info) {
+    key->append(name).push_back('\0');
+    key->append(value).push_back('\0');
+  }
+  for (const auto& block : body) {
+    key->append(block.data(), block.size());
+  }
+
+  req_protocol->SetNonContiguousProtocolBody(std::move(body));
+  return true;
+}
+
+void ServiceProxy::RunServedLocallyFilters(const ClientContextPtr& context) {
+  context->SetServedLocally(true);
+  RunFilters(FilterPoint::CLIENT_PRE_SEND_MSG, context);
+  RunFilters(FilterPoint::CLIENT_POST_RECV_MSG, context);
+}
+
+bool ServiceProxy::GetCachedResponse(const ClientContextPtr& context, const std::string& key, void* rsp) {
+  ResponseCache::Value value;
+  if (!response_cache_->Get(key, &value)) {
+    return false;
+  }
+
+  auto* serialization = serialization::SerializationFactory::GetInstance()->Get(value.encode_type);
+  if (!serialization || !serialization->Deserialize(&value.rsp, context->GetRspEncodeDataType(), rsp)) {
+    return false;
+  }
+
+  context->SetRspEncodeType(value.encode_type);
+  context->SetStatus(Status());
+  return true;
+}
+
+void ServiceProxy::PutCachedResponse(const ClientContextPtr& context, const std::string& key, void* rsp) {
+  if (!context->GetResponseAttachment().Empty()) {
+    return;
+  }
+
+  ResponseCache::Value value;
+  value.encode_type = context->GetRspEncodeType();
+  if (context->GetRspEncodeDataType() == serialization::kNonContiguousBufferNoop) {
+    // The noop serialization moves the buffer out of the response, so it is shared instead.
+    value.rsp = *static_cast<const NoncontiguousBuffer*>(rsp);
+  } else {
+    serialization::PbAliasedMessage aliased;
+    if (context->GetRspEncodeDataType() == serialization::kPbAliasedMessage) {
+      // The aliased payloads are moved out by the serialization, so a copy sharing them is serialized instead.
+      aliased = *static_cast<const serialization::PbAliasedMessage*>(rsp);
+      rsp = &aliased;
+    }
+    auto* serialization = serialization::SerializationFactory::GetInstance()->Get(value.encode_type);
+    if (!serialization || !serialization->Serialize(context->GetRspEncodeDataType(), rsp, &value.rsp)) {
+      return;
+    }
+  }
+
+  response_cache_->Put(key, std::move(value));
+}
+
 ThreadModel* ServiceProxy::GetThreadModel() {
   if (thread_model_ != nullptr) {
     return thread_model_;
@@ -401,6 +730,8 @@ void ServiceProxy::FillClientContext(const ClientContextPtr& context) {
 
   // Set the ServiceProxy option parameters to the context for use by the selector filter during route selection.
   context->SetServiceProxyOption(option_.get());
+  context->SetLoadBalanceHandle(load_balance_handle_.get());
+  context->SetInvokeResultNeeded(invoke_result_needed_);
 
   // Set unique request id
   if (TRPC_LIKELY(!context->IsSetRequestId())) {
@@ -419,6 +750,24 @@ void ServiceProxy::FillClientContext(const ClientContextPtr& context) {
     }
   }
 
+  if (retry_budget_) {
+    retry_budget_->AddRequest();
+  }
+
+  if (backup_request_hedging_) {
+    backup_request_hedging_->AddRequest();
+    if (context->IsBackupRequest()) {
+      // Hedge at the configured percentile of the recent latencies, as a regular request if out of the budget.
+      if (backup_request_hedging_->HasBudget()) {
+        auto* retry_info = context->GetBackupRequestRetryInfo();
+        retry_info->delay = backup_request_hedging_->GetDelay(retry_info->delay);
+        retry_info->budget = backup_request_hedging_->GetBudget();
+      } else {
+        context->CancelBackupRequest();
+      }
+    }
+  }
+
   if (context->IsBackupRequest()) {
     // The timeout value for the backup request must be greater than the delay value, otherwise it will degrade to a
     // normal unary call.
@@ -463,6 +812,7 @@ TransInfo ServiceProxy::ProxyOptionToTransInfo() {
   trans_info.allow_reconnect = option_->allow_reconnect;
   trans_info.connect_timeout = option_->connect_timeout;
   trans_info.max_conn_num = option_->max_conn_num;
+  trans_info.min_conn_num = std::min(option_->min_conn_num, option_->max_conn_num);
   trans_info.max_packet_size = option_->max_packet_size;
   trans_info.recv_buffer_size = option_->recv_buffer_size;
   trans_info.send_queue_capacity = option_->send_queue_capacity;
@@ -572,6 +922,12 @@ TransInfo ServiceProxy::ProxyOptionToTransInfo() {
 }
 
 void ServiceProxy::Stop() {
+  if (watched_selector_ != nullptr) {
+    watched_selector_->UnwatchEndpoints(endpoint_watch_id_);
+    watched_selector_ = nullptr;
+    endpoint_watch_id_ = 0;
+  }
+
   if (transport_ != nullptr) {
     transport_->Stop();
   }
@@ -666,7 +1022,7 @@ int ServiceProxy::RunFilters(const FilterPoint& point, const ClientContextPtr& c
   return 0;
 }
 
-void ServiceProxy::ProxyStatistics(const ClientContextPtr& ctx) {
+void ServiceProxy::ProxyStatistics(const ClientContextPtr& ctx, bool succ) {
   auto* retry_info = ctx->GetBackupRequestRetryInfo();
   if (retry_info) {
     if (retry_info->resend_count > 0 && backup_retries_) {
@@ -676,6 +1032,12 @@ void ServiceProxy::ProxyStatistics(const ClientContextPtr& ctx) {
       backup_retries_succ_->Add(1);
     }
   }
+
+  if (backup_request_hedging_) {
+    uint64_t now_us = trpc::time::GetMicroSeconds();
+    uint64_t begin_us = ctx->GetBeginTimestampUs();
+    backup_request_hedging_->Report(now_us > begin_us ? now_us - begin_us : 0, succ);
+  }
 }
 
 bool ServiceProxy::SelectTarget(const ClientContextPtr& context) {
@@ -826,6 +1188,9 @@ void ServiceProxy::SetEndpointInfo(const std::string& endpoint_info) {
     assert(!option_->selector_name.empty());
   }
 
+  // The selector may be determined only now.
+  InitEndpointWatch();
+
   auto selector = SelectorFactory::GetInstance()->Get(option_->selector_name);
   assert(selector != nullptr);
   selector->SetEndpoints(&info);
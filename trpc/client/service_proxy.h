@@ -19,12 +19,18 @@
 #include <utility>
 #include <vector>
 
+#include "trpc/client/backup_request_hedging.h"
 #include "trpc/client/client_context.h"
+#include "trpc/client/response_cache.h"
+#include "trpc/client/retry_budget.h"
 #include "trpc/client/service_proxy_option.h"
+#include "trpc/client/single_flight.h"
 #include "trpc/codec/client_codec.h"
 #include "trpc/common/future/future.h"
 #include "trpc/common/status.h"
 #include "trpc/filter/client_filter_controller.h"
+#include "trpc/naming/load_balance.h"
+#include "trpc/naming/selector.h"
 #include "trpc/runtime/threadmodel/thread_model.h"
 #include "trpc/stream/stream.h"
 #include "trpc/transport/client/client_transport.h"
@@ -119,7 +125,8 @@ class ServiceProxy {
   const std::string& GetServiceName();
 
   // Collect statistics on the service proxy and report them to the tvar.
-  void ProxyStatistics(const ClientContextPtr& ctx);
+  // `succ` is whether the invocation succeeded.
+  void ProxyStatistics(const ClientContextPtr& ctx, bool succ);
 
   // Used to determine if the request has timed out. Returns true if timed out, false if normal.
   bool CheckTimeout(const ClientContextPtr& context);
@@ -133,6 +140,29 @@ class ServiceProxy {
   /// @brief Run filters by filter point.
   int RunFilters(const FilterPoint& point, const ClientContextPtr& context);
 
+  /// @brief Whether the identical invocations of the func are coalesced, i.e. it's one of `single_flight_methods`.
+  bool IsSingleFlight(const ClientContextPtr& context) const;
+
+  /// @brief Whether the responses of the func are cached, i.e. it's one of `response_cache_methods`.
+  bool IsResponseCached(const ClientContextPtr& context) const;
+
+  /// @brief Get the key of the invocation for coalescing and caching, made of the callee, the func, the transinfo and
+  /// the serialized request.
+  /// @return false if the invocation can not be coalesced or cached, e.g. it carries an attachment, or it's routed by
+  /// the user to a target, to an address or by a hash key.
+  bool GetRequestKey(const ClientContextPtr& context, std::string* key);
+
+  /// @brief Run the filters of sending the request and receiving the response for the invocation whose response is
+  /// served without sending the request, e.g. from the response cache, so that the filters see it as well.
+  void RunServedLocallyFilters(const ClientContextPtr& context);
+
+  /// @brief Get the cached response of the invocation, deserialized into `rsp`.
+  /// @return false if not cached.
+  bool GetCachedResponse(const ClientContextPtr& context, const std::string& key, void* rsp);
+
+  /// @brief Cache the response of the succeeded invocation.
+  void PutCachedResponse(const ClientContextPtr& context, const std::string& key, void* rsp);
+
   /// @brief Get the threadmodel used by service proxy.
   ThreadModel* GetThreadModel();
 
@@ -144,9 +174,40 @@ class ServiceProxy {
   // Init the service routing name by config
   void InitServiceNameInfo();
 
+  // Resolve the handle of the service in its load balancer, which saves the lookups of the selections, and whether
+  // the selector needs the invocation results of the service
+  void InitLoadBalanceHandle();
+
+  // Watch the nodes added to the service in its selector to connect to them in advance, if `min_conn_num` is set
+  void InitEndpointWatch();
+
   // Check if the tvar variable required for statistical has been created, and create it if it has not been created.
   void PrepareStatistics(const std::string& service_name);
 
+  // Create the adaptive policy of backup requests if `backup_request_delay_percentile` is set.
+  void InitBackupRequestHedging();
+
+  // Create the cache of the responses if `response_cache_ttl` and `response_cache_methods` are set.
+  void InitResponseCache();
+
+  // Create the budget of the retries if `retry_budget_percent` is set.
+  void InitRetryBudget();
+
+  // Whether the request failed with `ret` is retried, after selecting another node within the budget of the retries and
+  // the time left until `deadline_us`. The failure of the node is reported once the retry is taken out of the budget.
+  bool RetryOnAnotherNode(const ClientContextPtr& context, int ret, uint32_t retry_times, uint64_t deadline_us);
+
+  // Whether the func of the request is one of `idempotent_methods`, which may be retried after losing its connection
+  bool IsIdempotent(const ClientContextPtr& context) const;
+
+  // Report the failure of the node a request is retried for to the selector
+  void ReportRetriedFailure(const ClientContextPtr& context, int ret, const ExtendNodeAddr& failed_node,
+                            uint64_t now_us);
+
+  // Send the request and receive the response asynchronously, retrying on other nodes if the budget allows.
+  Future<CTransportRspMsg> AsyncSendRecvWithRetry(const ClientContextPtr& context, CTransportReqMsg* req_msg,
+                                                  uint32_t retry_times, uint64_t deadline_us);
+
   // Determine if pipeline is supported.
   bool SupportPipeline(const std::shared_ptr<ServiceProxyOption>& option);
 
@@ -189,6 +250,12 @@ class ServiceProxy {
 
   ClientFilterController filter_controller_;
 
+  // Coalescing of the concurrent identical invocations, null if `single_flight_methods` is not set.
+  std::unique_ptr<SingleFlight> single_flight_;
+
+  // Cache of the responses, null if `response_cache_ttl` or `response_cache_methods` is not set.
+  std::unique_ptr<ResponseCache> response_cache_;
+
  private:
   std::shared_ptr<ServiceProxyOption> option_;
 
@@ -197,6 +264,16 @@ class ServiceProxy {
   // service routing name
   std::string service_name_;
 
+  // handle of the service in its load balancer, null if the selector does not support it
+  std::unique_ptr<LoadBalanceHandle> load_balance_handle_;
+
+  // whether the invocation results are reported to the selector, e.g. for its load balancer depending on them
+  bool invoke_result_needed_{false};
+
+  // selector watched for the nodes added to the service, and the id of the watch
+  SelectorPtr watched_selector_{nullptr};
+  uint64_t endpoint_watch_id_{0};
+
   ThreadModel* thread_model_{nullptr};
 
   // Total count of backup requests retries at the service level.
@@ -205,6 +282,12 @@ class ServiceProxy {
   // Count of successful backup request retries at the service level.
   std::shared_ptr<tvar::Counter<uint64_t>> backup_retries_succ_{nullptr};
 
+  // Adaptive delay and budget of the backup requests, null if the delay set by the user is used as it is.
+  std::unique_ptr<BackupRequestHedging> backup_request_hedging_;
+
+  // Budget of the retries on other nodes, null if the requests are not retried.
+  std::unique_ptr<RetryBudget> retry_budget_;
+
   friend class ServiceProxyManager;
 };
 
@@ -36,6 +36,16 @@ void ServiceProxyManager::SetOptionFromConfig(const ServiceProxyConfig& proxy_co
   option->send_queue_capacity = proxy_conf.send_queue_capacity;
   option->send_queue_timeout = proxy_conf.send_queue_timeout;
   option->max_conn_num = proxy_conf.max_conn_num;
+  option->min_conn_num = proxy_conf.min_conn_num;
+  option->backup_request_delay_percentile = proxy_conf.backup_request_delay_percentile;
+  option->backup_request_budget_percent = proxy_conf.backup_request_budget_percent;
+  option->single_flight_methods = proxy_conf.single_flight_methods;
+  option->response_cache_methods = proxy_conf.response_cache_methods;
+  option->response_cache_ttl = proxy_conf.response_cache_ttl;
+  option->response_cache_max_size = proxy_conf.response_cache_max_size;
+  option->retry_budget_percent = proxy_conf.retry_budget_percent;
+  option->max_retry_times = proxy_conf.max_retry_times;
+  option->idempotent_methods = proxy_conf.idempotent_methods;
   option->idle_time = proxy_conf.idle_time;
   option->request_timeout_check_interval = proxy_conf.request_timeout_check_interval;
   option->is_reconnection = proxy_conf.is_reconnection;
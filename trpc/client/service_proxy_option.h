@@ -147,6 +147,47 @@ struct ServiceProxyOption {
   /// The maximum number of connections that can be established to the backend nodes.
   uint32_t max_conn_num{kDefaultMaxConnNum};
 
+  /// The minimum number of connections kept to each backend node in the connection pool mode, they are established
+  /// in advance when the node is discovered rather than on the first requests, and not closed when idle.
+  uint32_t min_conn_num{kDefaultMinConnNum};
+
+  /// The percentile(e.g. 95 for P95) of the recent latencies of the service used as the delay of the backup requests,
+  /// instead of the delay set by `ClientContext::SetBackupRequestDelay`. If set 0, the delay set is used as it is.
+  uint32_t backup_request_delay_percentile{kDefaultBackupRequestDelayPercentile};
+
+  /// The backup requests allowed in percent of the requests, if `backup_request_delay_percentile` is set.
+  uint32_t backup_request_budget_percent{kDefaultBackupRequestBudgetPercent};
+
+  /// The funcs whose concurrent identical invocations of `RpcServiceProxy`, i.e. with the same callee, func, serialized
+  /// request and transinfo, share one in-flight RPC and its response, e.g. "/trpc.test.helloworld.Greeter/SayHello".
+  /// List only the funcs which are idempotent reads.
+  std::vector<std::string> single_flight_methods;
+
+  /// The funcs whose responses of `RpcServiceProxy` are cached, and served without invoking the transport for the
+  /// same callee, func, serialized request and transinfo, if `response_cache_ttl` is set. List only the funcs which are
+  /// idempotent reads whose responses may be stale within the time to live.
+  std::vector<std::string> response_cache_methods;
+
+  /// The time(ms) to live of the cached responses of `response_cache_methods`. If set 0, the responses are not cached.
+  uint32_t response_cache_ttl{kDefaultResponseCacheTtl};
+
+  /// The maximum bytes of the cached responses, if `response_cache_ttl` is set.
+  uint32_t response_cache_max_size{kDefaultResponseCacheMaxSize};
+
+  /// The retries allowed in percent of the requests, e.g. 10 for at most one retry per ten requests. The unary requests
+  /// failed to connect, or lost their connections if idempotent(see `idempotent_methods`), are retried on another node
+  /// within the time left of their timeouts, unless they are backup requests or their addresses are set by the user.
+  /// If set 0, the requests are not retried.
+  uint32_t retry_budget_percent{kDefaultRetryBudgetPercent};
+
+  /// The maximum times a request is retried on other nodes, if `retry_budget_percent` is set.
+  uint32_t max_retry_times{kDefaultMaxRetryTimes};
+
+  /// The funcs of the service which can be processed more than once, e.g. "/trpc.test.helloworld.Greeter/SayHello".
+  /// The requests failed to connect are never received by the callee, they are retried whatever their funcs, while the
+  /// requests which lost their connections are retried only if their funcs are idempotent.
+  std::vector<std::string> idempotent_methods;
+
   /// The timeout for idle connections.
   uint32_t idle_time{kDefaultIdleTime};
 
@@ -94,6 +94,13 @@ void SetDefaultOption(const std::shared_ptr<ServiceProxyOption>& option) {
   option->send_queue_capacity = kDefaultSendQueueCapacity;
   option->send_queue_timeout = kDefaultSendQueueTimeout;
   option->max_conn_num = kDefaultMaxConnNum;
+  option->min_conn_num = kDefaultMinConnNum;
+  option->backup_request_delay_percentile = kDefaultBackupRequestDelayPercentile;
+  option->backup_request_budget_percent = kDefaultBackupRequestBudgetPercent;
+  option->response_cache_ttl = kDefaultResponseCacheTtl;
+  option->response_cache_max_size = kDefaultResponseCacheMaxSize;
+  option->retry_budget_percent = kDefaultRetryBudgetPercent;
+  option->max_retry_times = kDefaultMaxRetryTimes;
   option->idle_time = kDefaultIdleTime;
   option->request_timeout_check_interval = kDefaultRequestTimeoutCheckInterval;
   option->is_reconnection = kDefaultIsReconnection;
@@ -172,6 +179,30 @@ void SetSpecifiedOption(const ServiceProxyOption* option_ptr, const std::shared_
   auto max_conn_num = GetValidInput<uint32_t>(option_ptr->max_conn_num, kDefaultMaxConnNum);
   SetOutputByValidInput<uint32_t>(max_conn_num, option->max_conn_num);
 
+  auto min_conn_num = GetValidInput<uint32_t>(option_ptr->min_conn_num, kDefaultMinConnNum);
+  SetOutputByValidInput<uint32_t>(min_conn_num, option->min_conn_num);
+
+  auto delay_percentile =
+      GetValidInput<uint32_t>(option_ptr->backup_request_delay_percentile, kDefaultBackupRequestDelayPercentile);
+  SetOutputByValidInput<uint32_t>(delay_percentile, option->backup_request_delay_percentile);
+
+  auto budget_percent =
+      GetValidInput<uint32_t>(option_ptr->backup_request_budget_percent, kDefaultBackupRequestBudgetPercent);
+  SetOutputByValidInput<uint32_t>(budget_percent, option->backup_request_budget_percent);
+
+  auto response_cache_ttl = GetValidInput<uint32_t>(option_ptr->response_cache_ttl, kDefaultResponseCacheTtl);
+  SetOutputByValidInput<uint32_t>(response_cache_ttl, option->response_cache_ttl);
+
+  auto response_cache_max_size =
+      GetValidInput<uint32_t>(option_ptr->response_cache_max_size, kDefaultResponseCacheMaxSize);
+  SetOutputByValidInput<uint32_t>(response_cache_max_size, option->response_cache_max_size);
+
+  auto retry_budget_percent = GetValidInput<uint32_t>(option_ptr->retry_budget_percent, kDefaultRetryBudgetPercent);
+  SetOutputByValidInput<uint32_t>(retry_budget_percent, option->retry_budget_percent);
+
+  auto max_retry_times = GetValidInput<uint32_t>(option_ptr->max_retry_times, kDefaultMaxRetryTimes);
+  SetOutputByValidInput<uint32_t>(max_retry_times, option->max_retry_times);
+
   auto idle_time = GetValidInput<uint32_t>(option_ptr->idle_time, kDefaultIdleTime);
   SetOutputByValidInput<uint32_t>(idle_time, option->idle_time);
 
@@ -198,6 +229,9 @@ void SetSpecifiedOption(const ServiceProxyOption* option_ptr, const std::shared_
   SetOutputByValidInput<std::string>(threadmodel_instance_name, option->threadmodel_instance_name);
 
   SetOutputByValidInput(option_ptr->service_filters, option->service_filters);
+  SetOutputByValidInput(option_ptr->idempotent_methods, option->idempotent_methods);
+  SetOutputByValidInput(option_ptr->single_flight_methods, option->single_flight_methods);
+  SetOutputByValidInput(option_ptr->response_cache_methods, option->response_cache_methods);
   SetOutputByValidInput(option_ptr->proxy_callback, option->proxy_callback);
   SetOutputByValidInput(option_ptr->redis_conf, option->redis_conf);
   SetOutputByValidInput(option_ptr->ssl_config, option->ssl_config);
@@ -321,6 +321,102 @@ TEST_F(ServiceProxyTestFixture, AsyncBackRequest) {
   ASSERT_TRUE(backup_request_stat.retries_success->GetValue() > 0);
 }
 
+// Retry the requests failed to connect on another node
+TEST_F(ServiceProxyTestFixture, RetryOnAnotherNode) {
+  MockClientTransport* transport = nullptr;
+  auto option = std::make_shared<ServiceProxyOption>();
+  *option = *default_option_;
+  option->name = "trpc.test.helloworld.RetryGreeter";
+  option->target = "127.0.0.1:10001,127.0.0.1:10002";
+  option->retry_budget_percent = 10;
+  option->idempotent_methods = {"/trpc.test.helloworld.Greeter/SayHello"};
+  option->proxy_callback.create_transport_function = [&transport]() {
+    auto mock_transport = std::make_unique<MockClientTransport>();
+    transport = mock_transport.get();
+    return mock_transport;
+  };
+  auto proxy = std::make_shared<TestServiceProxy>();
+  proxy->SetServiceProxyOption(option);
+  ASSERT_TRUE(transport != nullptr);
+
+  std::vector<uint16_t> ports;
+  auto send_recv = [&ports](int ret) {
+    return [&ports, ret](CTransportReqMsg* req_msg, CTransportRspMsg* rsp_msg) {
+      EXPECT_FALSE(req_msg->send_data.Empty());
+      ports.push_back(req_msg->context->GetPort());
+      rsp_msg->msg = std::static_pointer_cast<Protocol>(std::make_shared<TrpcResponseProtocol>());
+      return ret;
+    };
+  };
+  auto invoke = [&proxy](const std::string& func_name = "/trpc.test.helloworld.Greeter/SayHi") {
+    auto context = MakeClientContext(proxy);
+    context->SetFuncName(func_name);
+    EXPECT_EQ(proxy->RunFilters(FilterPoint::CLIENT_PRE_RPC_INVOKE, context), 0);
+    TrpcRequestProtocolPtr req = std::make_shared<TrpcRequestProtocol>();
+    testing::FillTrpcRequestProtocolData(*req);
+    ProtocolPtr rsp;
+    return proxy->UnaryInvoke(context, req, rsp);
+  };
+
+  // The request failed to connect is retried on the other node.
+  EXPECT_CALL(*transport, SendRecv(::testing::_, ::testing::_))
+      .WillOnce(::testing::Invoke(send_recv(TrpcRetCode::TRPC_CLIENT_CONNECT_ERR)))
+      .WillOnce(::testing::Invoke(send_recv(0)));
+  ASSERT_TRUE(invoke().OK());
+  ASSERT_EQ(ports.size(), 2);
+  ASSERT_NE(ports[0], ports[1]);
+
+  // The request timed out is not retried.
+  ports.clear();
+  EXPECT_CALL(*transport, SendRecv(::testing::_, ::testing::_))
+      .WillOnce(::testing::Invoke(send_recv(TrpcRetCode::TRPC_CLIENT_INVOKE_TIMEOUT_ERR)));
+  ASSERT_EQ(invoke().GetFrameworkRetCode(), TrpcRetCode::TRPC_CLIENT_INVOKE_TIMEOUT_ERR);
+  ASSERT_EQ(ports.size(), 1);
+
+  // The request lost its connection may have been processed, it's not retried unless it's idempotent.
+  ports.clear();
+  EXPECT_CALL(*transport, SendRecv(::testing::_, ::testing::_))
+      .WillOnce(::testing::Invoke(send_recv(TrpcRetCode::TRPC_CLIENT_NETWORK_ERR)));
+  ASSERT_EQ(invoke().GetFrameworkRetCode(), TrpcRetCode::TRPC_CLIENT_NETWORK_ERR);
+  ASSERT_EQ(ports.size(), 1);
+
+  // The request is retried `max_retry_times` at most.
+  ports.clear();
+  EXPECT_CALL(*transport, SendRecv(::testing::_, ::testing::_))
+      .Times(2)
+      .WillRepeatedly(::testing::Invoke(send_recv(TrpcRetCode::TRPC_CLIENT_NETWORK_ERR)));
+  ASSERT_EQ(invoke("/trpc.test.helloworld.Greeter/SayHello").GetFrameworkRetCode(),
+            TrpcRetCode::TRPC_CLIENT_NETWORK_ERR);
+  ASSERT_EQ(ports.size(), 2);
+
+  // The asynchronous request failed to connect is retried on the other node.
+  ports.clear();
+  EXPECT_CALL(*transport, AsyncSendRecv(::testing::_))
+      .WillOnce(::testing::Invoke([&ports](CTransportReqMsg* req_msg) {
+        ports.push_back(req_msg->context->GetPort());
+        return MakeExceptionFuture<CTransportRspMsg>(
+            CommonException("connect failed", TrpcRetCode::TRPC_CLIENT_CONNECT_ERR));
+      }))
+      .WillOnce(::testing::Invoke([&ports](CTransportReqMsg* req_msg) {
+        EXPECT_FALSE(req_msg->send_data.Empty());
+        ports.push_back(req_msg->context->GetPort());
+        CTransportRspMsg rsp_msg;
+        rsp_msg.msg = std::static_pointer_cast<Protocol>(std::make_shared<TrpcResponseProtocol>());
+        return MakeReadyFuture<CTransportRspMsg>(std::move(rsp_msg));
+      }));
+  auto context = MakeClientContext(proxy);
+  ASSERT_EQ(proxy->RunFilters(FilterPoint::CLIENT_PRE_RPC_INVOKE, context), 0);
+  TrpcRequestProtocolPtr req = std::make_shared<TrpcRequestProtocol>();
+  testing::FillTrpcRequestProtocolData(*req);
+  auto fut = future::BlockingGet(proxy->AsyncUnaryInvoke(context, req));
+  ASSERT_TRUE(fut.IsReady());
+  ASSERT_EQ(ports.size(), 2);
+  ASSERT_NE(ports[0], ports[1]);
+
+  proxy->Stop();
+  proxy->Destroy();
+}
+
 // test service filter without shared data
 struct TestNoSharedDataFilterConfig {
   bool reject = false;
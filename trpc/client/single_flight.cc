@@ -0,0 +1,76 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/client/single_flight.h"
+
+#include <optional>
+#include <utility>
+
+#include "trpc/codec/trpc/trpc.pb.h"
+
+#include "trpc/coroutine/future.h"
+#include "trpc/future/future_utility.h"
+#include "trpc/runtime/threadmodel/fiber/detail/fiber_entity.h"
+
+namespace trpc {
+
+SingleFlight::Role SingleFlight::Join(const std::string& key, uint64_t deadline_ms, Future<ResultPtr>* waiter) {
+  std::scoped_lock lock(mutex_);
+  auto [iter, is_leader] = calls_.try_emplace(key);
+  if (is_leader) {
+    iter->second.deadline_ms = deadline_ms;
+    return Role::kLeader;
+  }
+
+  if (iter->second.deadline_ms > deadline_ms) {
+    return Role::kAlone;
+  }
+
+  iter->second.waiters.emplace_back();
+  *waiter = iter->second.waiters.back().GetFuture();
+  return Role::kWaiter;
+}
+
+void SingleFlight::Done(const std::string& key, ResultPtr result) {
+  std::vector<Promise<ResultPtr>> waiters;
+  {
+    std::scoped_lock lock(mutex_);
+    auto iter = calls_.find(key);
+    if (iter == calls_.end()) {
+      return;
+    }
+    waiters = std::move(iter->second.waiters);
+    calls_.erase(iter);
+  }
+
+  // The waiters are woken up outside the lock, their continuations may join the key again.
+  for (auto& waiter : waiters) {
+    waiter.SetValue(ResultPtr(result));
+  }
+}
+
+SingleFlight::ResultPtr SingleFlight::Wait(Future<ResultPtr>&& waiter, uint32_t timeout_ms) {
+  std::optional<Future<ResultPtr>> result;
+  if (fiber::detail::IsFiberContextPresent()) {
+    result = fiber::BlockingTryGet(std::move(waiter), timeout_ms);
+  } else {
+    result = future::BlockingTryGet(std::move(waiter), timeout_ms);
+  }
+
+  if (!result) {
+    return MakeResult(Status(TrpcRetCode::TRPC_CLIENT_INVOKE_TIMEOUT_ERR, 0, "wait for the coalesced call timeout"));
+  }
+  return result->GetValue0();
+}
+
+}  // namespace trpc
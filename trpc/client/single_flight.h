@@ -0,0 +1,97 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "trpc/common/future/future.h"
+#include "trpc/common/status.h"
+
+namespace trpc {
+
+/// @brief Coalesces the concurrent identical calls: the first caller of a key (the leader) makes the call, the callers
+/// joining the key before the leader is done (the waiters) share its result instead of making their own calls.
+/// @note Thread safe. Only the calls that are idempotent and return the same result for the same key can be coalesced.
+class SingleFlight {
+ public:
+  /// @brief The result of a call, shared by the leader with the waiters.
+  struct Result {
+    Status status;
+
+    /// The response of the call, set if succeeded. The type is known by the callers of the same key.
+    std::shared_ptr<const void> rsp;
+  };
+
+  using ResultPtr = std::shared_ptr<const Result>;
+
+  /// @brief The role of a caller joining the call of a key.
+  enum class Role {
+    /// The caller makes the call, and must finish it by `Done`.
+    kLeader,
+    /// The caller shares the result of the call of the leader.
+    kWaiter,
+    /// The call of the leader may outlive the deadline of the caller, the caller makes a call of its own.
+    kAlone,
+  };
+
+  /// @brief Joins the call of the key.
+  /// @param deadline_ms The deadline(ms) of the caller, the caller waits only for the calls of the leaders whose
+  ///                    deadlines are not later than it.
+  /// @param[out] waiter The future of the result of the call if the caller is a waiter.
+  /// @return The role of the caller.
+  Role Join(const std::string& key, uint64_t deadline_ms, Future<ResultPtr>* waiter);
+
+  /// @brief Finishes the call of the key by the leader, the result is fanned out to the waiters.
+  void Done(const std::string& key, ResultPtr result);
+
+  /// @brief Blocks until the result of a waiter is ready, it won't block the current pthread in fiber runtime.
+  /// @param timeout_ms The timeout(ms) of the waiter, a result of TRPC_CLIENT_INVOKE_TIMEOUT_ERR is returned once the
+  ///                   waiter times out.
+  static ResultPtr Wait(Future<ResultPtr>&& waiter, uint32_t timeout_ms);
+
+  /// @brief Makes the result of a failed call.
+  static ResultPtr MakeResult(const Status& status) {
+    auto result = std::make_shared<Result>();
+    result->status = status;
+    return result;
+  }
+
+  /// @brief Makes the result of a call, the response is kept only if succeeded.
+  template <class ResponseMessage>
+  static ResultPtr MakeResult(const Status& status, const ResponseMessage& rsp) {
+    auto result = std::make_shared<Result>();
+    result->status = status;
+    if (status.OK()) {
+      result->rsp = std::make_shared<const ResponseMessage>(rsp);
+    }
+    return result;
+  }
+
+ private:
+  struct Call {
+    // The deadline(ms) of the leader.
+    uint64_t deadline_ms;
+    std::vector<Promise<ResultPtr>> waiters;
+  };
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<std::string, Call> calls_;
+};
+
+}  // namespace trpc
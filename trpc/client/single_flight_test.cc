@@ -0,0 +1,102 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/client/single_flight.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "trpc/codec/trpc/trpc.pb.h"
+#include "trpc/util/thread/latch.h"
+
+namespace trpc::testing {
+
+TEST(SingleFlightTest, JoinAndDone) {
+  SingleFlight single_flight;
+  Future<SingleFlight::ResultPtr> waiter;
+  ASSERT_EQ(single_flight.Join("key", 1000, &waiter), SingleFlight::Role::kLeader);
+  ASSERT_EQ(single_flight.Join("other_key", 1000, &waiter), SingleFlight::Role::kLeader);
+
+  std::vector<Future<SingleFlight::ResultPtr>> waiters(2);
+  ASSERT_EQ(single_flight.Join("key", 1000, &waiters[0]), SingleFlight::Role::kWaiter);
+  ASSERT_EQ(single_flight.Join("key", 2000, &waiters[1]), SingleFlight::Role::kWaiter);
+  // The call of the leader may outlive the caller.
+  ASSERT_EQ(single_flight.Join("key", 999, &waiter), SingleFlight::Role::kAlone);
+  ASSERT_FALSE(waiters[0].IsReady());
+
+  single_flight.Done("key", SingleFlight::MakeResult(Status(), std::string("rsp")));
+  for (auto& fut : waiters) {
+    ASSERT_TRUE(fut.IsReady());
+    SingleFlight::ResultPtr result = fut.GetValue0();
+    ASSERT_TRUE(result->status.OK());
+    ASSERT_EQ(*static_cast<const std::string*>(result->rsp.get()), "rsp");
+  }
+
+  // The call is over once done, the next caller of the key leads a new call.
+  ASSERT_EQ(single_flight.Join("key", 1000, &waiter), SingleFlight::Role::kLeader);
+
+  ASSERT_EQ(single_flight.Join("other_key", 1000, &waiter), SingleFlight::Role::kWaiter);
+  single_flight.Done("other_key", SingleFlight::MakeResult(Status(-1, "failed"), std::string("rsp")));
+  SingleFlight::ResultPtr result = SingleFlight::Wait(std::move(waiter), 1000);
+  ASSERT_FALSE(result->status.OK());
+  ASSERT_EQ(result->rsp, nullptr);
+}
+
+TEST(SingleFlightTest, WaitTimeout) {
+  SingleFlight single_flight;
+  Future<SingleFlight::ResultPtr> waiter;
+  ASSERT_EQ(single_flight.Join("key", 1000, &waiter), SingleFlight::Role::kLeader);
+  ASSERT_EQ(single_flight.Join("key", 1000, &waiter), SingleFlight::Role::kWaiter);
+
+  // The waiter gives up once it times out, the result of the leader done later is dropped.
+  SingleFlight::ResultPtr result = SingleFlight::Wait(std::move(waiter), 10);
+  ASSERT_EQ(result->status.GetFrameworkRetCode(), TrpcRetCode::TRPC_CLIENT_INVOKE_TIMEOUT_ERR);
+  ASSERT_EQ(result->rsp, nullptr);
+  single_flight.Done("key", SingleFlight::MakeResult(Status(), std::string("rsp")));
+}
+
+TEST(SingleFlightTest, ConcurrentCalls) {
+  SingleFlight single_flight;
+  std::atomic<int> calls{0};
+  std::atomic<int> shared{0};
+  Latch joined(8);
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; ++i) {
+    threads.emplace_back([&]() {
+      Future<SingleFlight::ResultPtr> waiter;
+      if (single_flight.Join("key", 1000, &waiter) == SingleFlight::Role::kLeader) {
+        joined.arrive_and_wait();
+        calls.fetch_add(1);
+        single_flight.Done("key", SingleFlight::MakeResult(Status(), 1));
+        return;
+      }
+
+      joined.count_down();
+      SingleFlight::ResultPtr result = SingleFlight::Wait(std::move(waiter), 10000);
+      shared.fetch_add(*static_cast<const int*>(result->rsp.get()));
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(calls, 1);
+  ASSERT_EQ(shared, 7);
+}
+
+}  // namespace trpc::testing
@@ -55,6 +55,11 @@ int CheckTrpcProtocolMessage(const ConnectionPtr& conn, NoncontiguousBuffer& in,
     // Checks it contains full data frame.
     if (total_buff_size < header.data_frame_size) {
       TRPC_FMT_TRACE("Check less, total_buff_size:{} packet_size:{}", total_buff_size, header.data_frame_size);
+      if (conn.Get() != nullptr) {
+        // The rest of the frame may be read into a block of its own, with the body contiguous and aligned.
+        conn->SetRecvFrameHint(header.data_frame_size,
+                               TrpcFixedHeader::TRPC_PROTO_PREFIX_SPACE + header.pb_header_size);
+      }
       break;
     }
     out.emplace_back(in.Cut(header.data_frame_size));
@@ -303,11 +303,18 @@ TEST_F(TrpcProtoCheckerTest, TrpcProtoCheckerPACKETLESS2) {
   auto buff = builder.DestructiveGet();
   ASSERT_EQ(buff.ByteSize(), total_size - body_str.size());
 
+  conn = MakeRefCounted<trpc::testing::MockConnection>();
   auto result = trpc::CheckTrpcProtocolMessage(conn, buff, out);
 
   ASSERT_EQ(result, PacketChecker::PACKET_LESS);
   ASSERT_EQ(out.size(), 0);
   ASSERT_EQ(buff.ByteSize(), total_size - body_str.size());
+
+  // The size of the frame and the offset of its body are hinted to the connection.
+  uint32_t body_offset = 0;
+  ASSERT_EQ(conn->TakeRecvFrameHint(&body_offset), total_size);
+  ASSERT_EQ(body_offset, TrpcFixedHeader::TRPC_PROTO_PREFIX_SPACE + req_header_size);
+  ASSERT_EQ(conn->TakeRecvFrameHint(&body_offset), 0);
 }
 
 TEST(PickTrpcProtocolMessageMetadataTest, CheckOk) {
@@ -0,0 +1,36 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/common/config/circuit_break_conf.h"
+
+#include "trpc/util/log/logging.h"
+
+namespace trpc::naming {
+
+void CircuitBreakConfig::Display() const {
+  TRPC_FMT_DEBUG("-----CircuitBreakConfig begin-------");
+
+  TRPC_FMT_DEBUG("enable:{}", enable);
+  TRPC_FMT_DEBUG("consecutive_failures:{}", consecutive_failures);
+  TRPC_FMT_DEBUG("stat_window_ms:{}", stat_window_ms);
+  TRPC_FMT_DEBUG("min_requests:{}", min_requests);
+  TRPC_FMT_DEBUG("timeout_rate:{}", timeout_rate);
+  TRPC_FMT_DEBUG("ejection_ms:{}", ejection_ms);
+  TRPC_FMT_DEBUG("max_ejection_ms:{}", max_ejection_ms);
+  TRPC_FMT_DEBUG("half_open_probes:{}", half_open_probes);
+  TRPC_FMT_DEBUG("max_ejection_percent:{}", max_ejection_percent);
+
+  TRPC_FMT_DEBUG("------------------------------------");
+}
+
+}  // namespace trpc::naming
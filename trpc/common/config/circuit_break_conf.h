@@ -0,0 +1,54 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <cstdint>
+
+namespace trpc::naming {
+
+/// @brief Configuration of the circuit breaking of the endpoints, done by the selectors without a naming service
+struct CircuitBreakConfig {
+  /// @brief Whether to eject the failing endpoints
+  bool enable{false};
+
+  /// @brief Number of consecutive failures ejecting an endpoint, 0 means disabled
+  uint32_t consecutive_failures{5};
+
+  /// @brief Time window(ms) of the timeout rate
+  uint32_t stat_window_ms{10000};
+
+  /// @brief Minimum number of requests in a window for the timeout rate to be taken into account
+  uint32_t min_requests{20};
+
+  /// @brief Rate of timeouts in a window ejecting an endpoint, in (0, 1], 0 means disabled
+  double timeout_rate{0.5};
+
+  /// @brief Time(ms) of the first ejection of an endpoint, doubled on each ejection in a row
+  uint32_t ejection_ms{5000};
+
+  /// @brief Maximum time(ms) of an ejection
+  uint32_t max_ejection_ms{300000};
+
+  /// @brief Number of probes sent to an endpoint after its ejection, the endpoint is admitted again if all succeed
+  uint32_t half_open_probes{3};
+
+  /// @brief Maximum percentage of ejected endpoints of a callee, at least one endpoint can be ejected if the callee
+  ///        has two or more
+  uint32_t max_ejection_percent{50};
+
+  /// @brief Print out the configuration.
+  void Display() const;
+};
+
+}  // namespace trpc::naming
@@ -0,0 +1,70 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include "yaml-cpp/yaml.h"
+
+#include "trpc/common/config/circuit_break_conf.h"
+
+namespace YAML {
+
+template <>
+struct convert<trpc::naming::CircuitBreakConfig> {
+  static YAML::Node encode(const trpc::naming::CircuitBreakConfig& config) {
+    YAML::Node node;
+    node["enable"] = config.enable;
+    node["consecutive_failures"] = config.consecutive_failures;
+    node["stat_window_ms"] = config.stat_window_ms;
+    node["min_requests"] = config.min_requests;
+    node["timeout_rate"] = config.timeout_rate;
+    node["ejection_ms"] = config.ejection_ms;
+    node["max_ejection_ms"] = config.max_ejection_ms;
+    node["half_open_probes"] = config.half_open_probes;
+    node["max_ejection_percent"] = config.max_ejection_percent;
+    return node;
+  }
+
+  static bool decode(const YAML::Node& node, trpc::naming::CircuitBreakConfig& config) {
+    if (node["enable"]) {
+      config.enable = node["enable"].as<bool>();
+    }
+    if (node["consecutive_failures"]) {
+      config.consecutive_failures = node["consecutive_failures"].as<uint32_t>();
+    }
+    if (node["stat_window_ms"]) {
+      config.stat_window_ms = node["stat_window_ms"].as<uint32_t>();
+    }
+    if (node["min_requests"]) {
+      config.min_requests = node["min_requests"].as<uint32_t>();
+    }
+    if (node["timeout_rate"]) {
+      config.timeout_rate = node["timeout_rate"].as<double>();
+    }
+    if (node["ejection_ms"]) {
+      config.ejection_ms = node["ejection_ms"].as<uint32_t>();
+    }
+    if (node["max_ejection_ms"]) {
+      config.max_ejection_ms = node["max_ejection_ms"].as<uint32_t>();
+    }
+    if (node["half_open_probes"]) {
+      config.half_open_probes = node["half_open_probes"].as<uint32_t>();
+    }
+    if (node["max_ejection_percent"]) {
+      config.max_ejection_percent = node["max_ejection_percent"].as<uint32_t>();
+    }
+    return true;
+  }
+};
+
+}  // namespace YAML
@@ -47,6 +47,22 @@ void ServiceProxyConfig::Display() const {
   TRPC_LOG_DEBUG("send_queue_capacity:" << send_queue_capacity);
   TRPC_LOG_DEBUG("send_queue_timeout:" << send_queue_timeout);
   TRPC_LOG_DEBUG("max_conn_num:" << max_conn_num);
+  TRPC_LOG_DEBUG("min_conn_num:" << min_conn_num);
+  TRPC_LOG_DEBUG("backup_request_delay_percentile:" << backup_request_delay_percentile);
+  TRPC_LOG_DEBUG("backup_request_budget_percent:" << backup_request_budget_percent);
+  for (const auto& method : single_flight_methods) {
+    TRPC_LOG_DEBUG("single_flight_method:" << method);
+  }
+  for (const auto& method : response_cache_methods) {
+    TRPC_LOG_DEBUG("response_cache_method:" << method);
+  }
+  TRPC_LOG_DEBUG("response_cache_ttl:" << response_cache_ttl);
+  TRPC_LOG_DEBUG("response_cache_max_size:" << response_cache_max_size);
+  TRPC_LOG_DEBUG("retry_budget_percent:" << retry_budget_percent);
+  TRPC_LOG_DEBUG("max_retry_times:" << max_retry_times);
+  for (const auto& method : idempotent_methods) {
+    TRPC_LOG_DEBUG("idempotent_method:" << method);
+  }
   TRPC_LOG_DEBUG("request_timeout_check_interval:" << request_timeout_check_interval);
   TRPC_LOG_DEBUG("is_reconnection:" << is_reconnection);
   TRPC_LOG_DEBUG("connect_timeout:" << connect_timeout);
@@ -92,6 +92,41 @@ struct ServiceProxyConfig {
   /// If exceed, new connection will be released after used
   uint32_t max_conn_num{kDefaultMaxConnNum};
 
+  /// The minimum number of connections the `ServiceProxy` keeps to each backend in the connection pool mode
+  /// They are established once the backend is discovered, and not released when idle
+  uint32_t min_conn_num{kDefaultMinConnNum};
+
+  /// The percentile(e.g. 95 for P95) of the recent latencies used as the delay of backup requests
+  /// If set 0, the delay set by `ClientContext` is used
+  uint32_t backup_request_delay_percentile{kDefaultBackupRequestDelayPercentile};
+
+  /// The backup requests allowed in percent of the requests, when the delay of them follows the latencies
+  uint32_t backup_request_budget_percent{kDefaultBackupRequestBudgetPercent};
+
+  /// The funcs whose concurrent identical invocations share one in-flight RPC and its response
+  /// Only for the funcs which are idempotent reads
+  std::vector<std::string> single_flight_methods;
+
+  /// The funcs whose responses are cached, only for the funcs which are idempotent reads
+  std::vector<std::string> response_cache_methods;
+
+  /// The time(ms) to live of the cached responses of `response_cache_methods`
+  /// If set 0, the responses are not cached
+  uint32_t response_cache_ttl{kDefaultResponseCacheTtl};
+
+  /// The maximum bytes of the cached responses
+  uint32_t response_cache_max_size{kDefaultResponseCacheMaxSize};
+
+  /// The retries on other nodes allowed in percent of the requests, for the requests failed to connect, or lost their
+  /// connections if idempotent. If set 0, the requests are not retried
+  uint32_t retry_budget_percent{kDefaultRetryBudgetPercent};
+
+  /// The maximum times a request is retried on other nodes, if `retry_budget_percent` is set
+  uint32_t max_retry_times{kDefaultMaxRetryTimes};
+
+  /// The idempotent funcs of the service, the requests which lost their connections are retried only if idempotent
+  std::vector<std::string> idempotent_methods;
+
   /// The timeout(ms) for idle connections
   uint32_t idle_time{kDefaultIdleTime};
 
@@ -42,6 +42,16 @@ struct convert<trpc::ServiceProxyConfig> {
     node["allow_reconnect"] = proxy_config.allow_reconnect;
     node["max_packet_size"] = proxy_config.max_packet_size;
     node["max_conn_num"] = proxy_config.max_conn_num;
+    node["min_conn_num"] = proxy_config.min_conn_num;
+    node["backup_request_delay_percentile"] = proxy_config.backup_request_delay_percentile;
+    node["backup_request_budget_percent"] = proxy_config.backup_request_budget_percent;
+    node["single_flight_methods"] = proxy_config.single_flight_methods;
+    node["response_cache_methods"] = proxy_config.response_cache_methods;
+    node["response_cache_ttl"] = proxy_config.response_cache_ttl;
+    node["response_cache_max_size"] = proxy_config.response_cache_max_size;
+    node["retry_budget_percent"] = proxy_config.retry_budget_percent;
+    node["max_retry_times"] = proxy_config.max_retry_times;
+    node["idempotent_methods"] = proxy_config.idempotent_methods;
     node["idle_time"] = proxy_config.idle_time;
     node["recv_buffer_size"] = proxy_config.recv_buffer_size;
     node["send_queue_capacity"] = proxy_config.send_queue_capacity;
@@ -99,6 +109,34 @@ struct convert<trpc::ServiceProxyConfig> {
     if (node["allow_reconnect"]) proxy_config.allow_reconnect = node["allow_reconnect"].as<bool>();
 	  if (node["max_packet_size"]) proxy_config.max_packet_size = node["max_packet_size"].as<uint32_t>();
     if (node["max_conn_num"]) proxy_config.max_conn_num = node["max_conn_num"].as<uint32_t>();
+    if (node["min_conn_num"]) proxy_config.min_conn_num = node["min_conn_num"].as<uint32_t>();
+    if (node["backup_request_delay_percentile"]) {
+      proxy_config.backup_request_delay_percentile = node["backup_request_delay_percentile"].as<uint32_t>();
+    }
+    if (node["backup_request_budget_percent"]) {
+      proxy_config.backup_request_budget_percent = node["backup_request_budget_percent"].as<uint32_t>();
+    }
+    if (node["single_flight_methods"]) {
+      proxy_config.single_flight_methods = node["single_flight_methods"].as<std::vector<std::string>>();
+    }
+    if (node["response_cache_methods"]) {
+      proxy_config.response_cache_methods = node["response_cache_methods"].as<std::vector<std::string>>();
+    }
+    if (node["response_cache_ttl"]) {
+      proxy_config.response_cache_ttl = node["response_cache_ttl"].as<uint32_t>();
+    }
+    if (node["response_cache_max_size"]) {
+      proxy_config.response_cache_max_size = node["response_cache_max_size"].as<uint32_t>();
+    }
+    if (node["retry_budget_percent"]) {
+      proxy_config.retry_budget_percent = node["retry_budget_percent"].as<uint32_t>();
+    }
+    if (node["max_retry_times"]) {
+      proxy_config.max_retry_times = node["max_retry_times"].as<uint32_t>();
+    }
+    if (node["idempotent_methods"]) {
+      proxy_config.idempotent_methods = node["idempotent_methods"].as<std::vector<std::string>>();
+    }
     if (node["idle_time"]) proxy_config.idle_time = node["idle_time"].as<uint32_t>();
     if (node["recv_buffer_size"]) proxy_config.recv_buffer_size = node["recv_buffer_size"].as<uint32_t>();
     if (node["send_queue_capacity"]) proxy_config.send_queue_capacity = node["send_queue_capacity"].as<uint32_t>();
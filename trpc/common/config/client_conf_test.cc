@@ -37,6 +37,16 @@ TEST(ClientConfigTest, All) {
   proxy_config.request_timeout_check_interval = 5;
   proxy_config.max_packet_size = 20000000;
   proxy_config.max_conn_num = 128;
+  proxy_config.min_conn_num = 4;
+  proxy_config.backup_request_delay_percentile = 95;
+  proxy_config.backup_request_budget_percent = 10;
+  proxy_config.single_flight_methods = {"/trpc.test.helloworld.Greeter/SayHello"};
+  proxy_config.response_cache_methods = {"/trpc.test.helloworld.Greeter/SayHi"};
+  proxy_config.response_cache_ttl = 100;
+  proxy_config.response_cache_max_size = 1024;
+  proxy_config.retry_budget_percent = 10;
+  proxy_config.max_retry_times = 2;
+  proxy_config.idempotent_methods = {"/trpc.test.helloworld.Greeter/SayHello"};
   proxy_config.idle_time = 10000;
   proxy_config.is_reconnection = false;
   proxy_config.allow_reconnect = false;
@@ -87,6 +97,16 @@ TEST(ClientConfigTest, All) {
   ASSERT_EQ(proxy_config.request_timeout_check_interval, tmp_proxy_config.request_timeout_check_interval);
   ASSERT_EQ(proxy_config.max_packet_size, tmp_proxy_config.max_packet_size);
   ASSERT_EQ(proxy_config.max_conn_num, tmp_proxy_config.max_conn_num);
+  ASSERT_EQ(proxy_config.min_conn_num, tmp_proxy_config.min_conn_num);
+  ASSERT_EQ(proxy_config.backup_request_delay_percentile, tmp_proxy_config.backup_request_delay_percentile);
+  ASSERT_EQ(proxy_config.backup_request_budget_percent, tmp_proxy_config.backup_request_budget_percent);
+  ASSERT_EQ(proxy_config.single_flight_methods, tmp_proxy_config.single_flight_methods);
+  ASSERT_EQ(proxy_config.response_cache_methods, tmp_proxy_config.response_cache_methods);
+  ASSERT_EQ(proxy_config.response_cache_ttl, tmp_proxy_config.response_cache_ttl);
+  ASSERT_EQ(proxy_config.response_cache_max_size, tmp_proxy_config.response_cache_max_size);
+  ASSERT_EQ(proxy_config.retry_budget_percent, tmp_proxy_config.retry_budget_percent);
+  ASSERT_EQ(proxy_config.max_retry_times, tmp_proxy_config.max_retry_times);
+  ASSERT_EQ(proxy_config.idempotent_methods, tmp_proxy_config.idempotent_methods);
   ASSERT_EQ(proxy_config.idle_time, tmp_proxy_config.idle_time);
   ASSERT_EQ(proxy_config.is_reconnection, tmp_proxy_config.is_reconnection);
   ASSERT_EQ(proxy_config.allow_reconnect, tmp_proxy_config.allow_reconnect);
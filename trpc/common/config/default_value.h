@@ -70,6 +70,28 @@ constexpr uint32_t kEndpointHashBucketSize = 1024;
 /// The default maximum number of connections that can be established to the backend nodes.
 constexpr uint32_t kDefaultMaxConnNum = 64;
 
+/// The default minimum number of connections kept to each backend node, no connection is established in advance.
+constexpr uint32_t kDefaultMinConnNum = 0;
+
+/// The default percentile of the recent latencies used as the delay of backup requests, the delay set by the user is
+/// used as it is.
+constexpr uint32_t kDefaultBackupRequestDelayPercentile = 0;
+
+/// The default percentage of the requests allowed to issue backup requests, if the delay of them is adaptive.
+constexpr uint32_t kDefaultBackupRequestBudgetPercent = 5;
+
+/// The default time(ms) to live of the cached responses, the responses are not cached.
+constexpr uint32_t kDefaultResponseCacheTtl = 0;
+
+/// The default maximum bytes of the cached responses.
+constexpr uint32_t kDefaultResponseCacheMaxSize = 64 * 1024 * 1024;
+
+/// The default percentage of the requests allowed to be retried on another node, the requests are not retried.
+constexpr uint32_t kDefaultRetryBudgetPercent = 0;
+
+/// The default maximum times a request is retried on other nodes.
+constexpr uint32_t kDefaultMaxRetryTimes = 1;
+
 /// The default timeout(ms) for idle connections.
 constexpr uint32_t kDefaultIdleTime = 50000;
 
@@ -0,0 +1,29 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include "trpc/common/config/circuit_break_conf.h"
+
+namespace trpc::naming {
+
+/// @brief direct select plugin configuration
+struct DirectSelectorConfig {
+  /// @brief Circuit breaking of the endpoints
+  CircuitBreakConfig circuit_break;
+
+  /// @brief Print out the configuration.
+  void Display() const;
+};
+
+}  // namespace trpc::naming
@@ -0,0 +1,39 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include "yaml-cpp/yaml.h"
+
+#include "trpc/common/config/circuit_break_conf_parser.h"
+#include "trpc/common/config/direct_naming_conf.h"
+
+namespace YAML {
+
+template <>
+struct convert<trpc::naming::DirectSelectorConfig> {
+  static YAML::Node encode(const trpc::naming::DirectSelectorConfig& config) {
+    YAML::Node node;
+    node["circuit_break"] = config.circuit_break;
+    return node;
+  }
+
+  static bool decode(const YAML::Node& node, trpc::naming::DirectSelectorConfig& config) {
+    if (node["circuit_break"]) {
+      config.circuit_break = node["circuit_break"].as<trpc::naming::CircuitBreakConfig>();
+    }
+    return true;
+  }
+};
+
+}  // namespace YAML
@@ -17,10 +17,24 @@
 
 namespace trpc::naming {
 
+void AsyncDnsConfig::Display() const {
+  TRPC_FMT_DEBUG("async_dns enable:{}", enable);
+  for (const auto& server : servers) {
+    TRPC_FMT_DEBUG("async_dns server:{}", server);
+  }
+  TRPC_FMT_DEBUG("async_dns timeout_ms:{}", timeout_ms);
+  TRPC_FMT_DEBUG("async_dns attempts:{}", attempts);
+  TRPC_FMT_DEBUG("async_dns min_ttl_ms:{}", min_ttl_ms);
+  TRPC_FMT_DEBUG("async_dns max_ttl_ms:{}", max_ttl_ms);
+  TRPC_FMT_DEBUG("async_dns negative_ttl_ms:{}", negative_ttl_ms);
+}
+
 void DomainSelectorConfig::Display() const {
   TRPC_FMT_DEBUG("-----DomainSelectorConfig begin-------");
 
   TRPC_FMT_DEBUG("exclude_ipv6:{}", exclude_ipv6);
+  circuit_break.Display();
+  async_dns.Display();
 
   TRPC_FMT_DEBUG("--------------------------------------");
 }
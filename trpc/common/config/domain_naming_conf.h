@@ -13,13 +13,48 @@
 
 #pragma once
 
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "trpc/common/config/circuit_break_conf.h"
+
 namespace trpc::naming {
 
+/// @brief Configuration of resolving the domain names asynchronously, instead of the blocking getaddrinfo
+struct AsyncDnsConfig {
+  bool enable{false};
+
+  /// @brief Name servers as "ip:port" or "[ipv6]:port", those of /etc/resolv.conf if empty
+  std::vector<std::string> servers;
+
+  /// @brief Timeout of a query to a name server
+  uint32_t timeout_ms{1000};
+
+  /// @brief Number of the queries of a name before it fails
+  uint32_t attempts{2};
+
+  /// @brief Bounds of the time the addresses are cached
+  uint32_t min_ttl_ms{1000};
+  uint32_t max_ttl_ms{300000};
+
+  /// @brief Time a failure is cached
+  uint32_t negative_ttl_ms{5000};
+
+  void Display() const;
+};
+
 /// @brief domain select plugin configuration
 struct DomainSelectorConfig {
   /// @brief Is ipv6 excluded (if the domain is ipv6 only, the exclusion will not apply)
   bool exclude_ipv6{false};
 
+  /// @brief Circuit breaking of the resolved endpoints
+  CircuitBreakConfig circuit_break;
+
+  /// @brief Asynchronous resolving of the domain names
+  AsyncDnsConfig async_dns;
+
   /// @brief Print out the logger configuration.
   void Display() const;
 };
@@ -13,15 +13,58 @@
 
 #include "yaml-cpp/yaml.h"
 
+#include "trpc/common/config/circuit_break_conf_parser.h"
 #include "trpc/common/config/domain_naming_conf.h"
 
 namespace YAML {
 
+template <>
+struct convert<trpc::naming::AsyncDnsConfig> {
+  static YAML::Node encode(const trpc::naming::AsyncDnsConfig& config) {
+    YAML::Node node;
+    node["enable"] = config.enable;
+    node["servers"] = config.servers;
+    node["timeout_ms"] = config.timeout_ms;
+    node["attempts"] = config.attempts;
+    node["min_ttl_ms"] = config.min_ttl_ms;
+    node["max_ttl_ms"] = config.max_ttl_ms;
+    node["negative_ttl_ms"] = config.negative_ttl_ms;
+    return node;
+  }
+
+  static bool decode(const YAML::Node& node, trpc::naming::AsyncDnsConfig& config) {
+    if (node["enable"]) {
+      config.enable = node["enable"].as<bool>();
+    }
+    if (node["servers"]) {
+      config.servers = node["servers"].as<std::vector<std::string>>();
+    }
+    if (node["timeout_ms"]) {
+      config.timeout_ms = node["timeout_ms"].as<uint32_t>();
+    }
+    if (node["attempts"]) {
+      config.attempts = node["attempts"].as<uint32_t>();
+    }
+    if (node["min_ttl_ms"]) {
+      config.min_ttl_ms = node["min_ttl_ms"].as<uint32_t>();
+    }
+    if (node["max_ttl_ms"]) {
+      config.max_ttl_ms = node["max_ttl_ms"].as<uint32_t>();
+    }
+    if (node["negative_ttl_ms"]) {
+      config.negative_ttl_ms = node["negative_ttl_ms"].as<uint32_t>();
+    }
+    return true;
+  }
+};
+
 template <>
 struct convert<trpc::naming::DomainSelectorConfig> {
   static YAML::Node encode(const trpc::naming::DomainSelectorConfig& config) {
     YAML::Node node;
     node["exclude_ipv6"] = config.exclude_ipv6;
+    node["circuit_break"] = config.circuit_break;
+    node["async_dns"] = config.async_dns;
     return node;
   }
 
@@ -29,6 +72,12 @@ struct convert<trpc::naming::DomainSelectorConfig> {
     if (node["exclude_ipv6"]) {
       config.exclude_ipv6 = node["exclude_ipv6"].as<bool>();
     }
+    if (node["circuit_break"]) {
+      config.circuit_break = node["circuit_break"].as<trpc::naming::CircuitBreakConfig>();
+    }
+    if (node["async_dns"]) {
+      config.async_dns = node["async_dns"].as<trpc::naming::AsyncDnsConfig>();
+    }
     return true;
   }
 };
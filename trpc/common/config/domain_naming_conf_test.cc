@@ -20,6 +20,11 @@
 TEST(LoadbalancerConfig, load_test) {
   trpc::naming::DomainSelectorConfig domain_selector_config;
   domain_selector_config.exclude_ipv6 = true;
+  domain_selector_config.circuit_break.enable = true;
+  domain_selector_config.circuit_break.timeout_rate = 0.2;
+  domain_selector_config.async_dns.enable = true;
+  domain_selector_config.async_dns.servers = {"127.0.0.1:53", "[::1]:53"};
+  domain_selector_config.async_dns.timeout_ms = 200;
   domain_selector_config.Display();
 
   YAML::convert<trpc::naming::DomainSelectorConfig> c;
@@ -30,4 +35,11 @@ TEST(LoadbalancerConfig, load_test) {
 
   tmp.Display();
   ASSERT_EQ(domain_selector_config.exclude_ipv6, tmp.exclude_ipv6);
+  ASSERT_TRUE(tmp.circuit_break.enable);
+  ASSERT_EQ(tmp.circuit_break.timeout_rate, 0.2);
+  ASSERT_EQ(tmp.circuit_break.consecutive_failures, domain_selector_config.circuit_break.consecutive_failures);
+  ASSERT_TRUE(tmp.async_dns.enable);
+  ASSERT_EQ(tmp.async_dns.servers, domain_selector_config.async_dns.servers);
+  ASSERT_EQ(tmp.async_dns.timeout_ms, 200);
+  ASSERT_EQ(tmp.async_dns.attempts, domain_selector_config.async_dns.attempts);
 }
@@ -39,6 +39,9 @@ void DefaultThreadModelInstanceConfig::Display() const {
   TRPC_LOG_DEBUG("handle_thread_task_queue_size:" << handle_thread_task_queue_size);
   TRPC_LOG_DEBUG("handle_cpu_affinitys:" << handle_cpu_affinitys);
   TRPC_LOG_DEBUG("disallow_cpu_migration:" << disallow_cpu_migration);
+  TRPC_LOG_DEBUG("queue_codel_target:" << queue_codel_target);
+  TRPC_LOG_DEBUG("queue_codel_interval:" << queue_codel_interval);
+  TRPC_LOG_DEBUG("queue_lifo_when_overloaded:" << queue_lifo_when_overloaded);
   TRPC_LOG_DEBUG("enable_async_io:" << enable_async_io);
   TRPC_LOG_DEBUG("io_uring_entries:" << io_uring_entries);
   TRPC_LOG_DEBUG("io_uring_flags:" << io_uring_flags);
@@ -61,6 +64,14 @@ void FiberThreadModelInstanceConfig::Display() const {
   TRPC_LOG_DEBUG("reactor_num_per_scheduling_group:" << reactor_num_per_scheduling_group);
   TRPC_LOG_DEBUG("cross_numa_work_stealing_ratio:" << cross_numa_work_stealing_ratio);
   TRPC_LOG_DEBUG("fiber_run_queue_size:" << fiber_run_queue_size);
+  std::string lane_weights;
+  for (auto weight : fiber_scheduling_lane_weights) {
+    lane_weights += std::to_string(weight) + ",";
+  }
+  if (!lane_weights.empty()) {
+    lane_weights.pop_back();
+  }
+  TRPC_LOG_DEBUG("fiber_scheduling_lane_weights:" << lane_weights);
   TRPC_LOG_DEBUG("fiber_stack_size:" << fiber_stack_size);
   TRPC_LOG_DEBUG("fiber_pool_num_by_mmap:" << fiber_pool_num_by_mmap);
   TRPC_LOG_DEBUG("fiber_stack_enable_guard_page:" << fiber_stack_enable_guard_page);
@@ -103,6 +114,18 @@ void BufferPoolConfig::Display() const {
   TRPC_LOG_DEBUG("================================");
 }
 
+void AsyncCompressConfig::Display() const {
+  TRPC_LOG_DEBUG("================================");
+
+  TRPC_LOG_DEBUG("enable:" << enable);
+  TRPC_LOG_DEBUG("threshold:" << threshold);
+  TRPC_LOG_DEBUG("thread_num:" << thread_num);
+  TRPC_LOG_DEBUG("task_queue_size:" << task_queue_size);
+  TRPC_LOG_DEBUG("parallel_block_size:" << parallel_block_size);
+
+  TRPC_LOG_DEBUG("================================");
+}
+
 void TvarConfig::Display() const {
   TRPC_LOG_DEBUG("================================");
 
@@ -153,6 +176,8 @@ void GlobalConfig::Display() const {
 
   buffer_pool_config.Display();
 
+  async_compress_config.Display();
+
   TRPC_LOG_DEBUG("=============global==============");
 }
 
@@ -74,6 +74,13 @@ struct FiberThreadModelInstanceConfig {
   /// @brief The size of fiber running queue
   uint32_t fiber_run_queue_size{131072};
 
+  /// @brief Weights of the priority lanes of the fiber running queue, from the highest priority lane to the lowest
+  /// one. Requests are put into the lanes by their `trpc-priority`, and the lanes share the fiber workers in
+  /// proportion to their weights while all of them are busy. The lanes split `fiber_run_queue_size` evenly. A single
+  /// lane if empty.
+  /// only use in scheduling v1
+  std::vector<uint32_t> fiber_scheduling_lane_weights;
+
   /// @brief The size of fiber memory stack
   uint32_t fiber_stack_size{131072};
 
@@ -139,6 +146,20 @@ struct DefaultThreadModelInstanceConfig {
   ///        In merge threadmodel, io_cpu_affinitys need be configured
   bool disallow_cpu_migration{false};
 
+  /// @brief Target sojourn time(ms) of the requests queued to the handle threads, for the controlled-delay(CoDel)
+  ///        queue management: once the sojourn time stays above the target for `queue_codel_interval`, the requests
+  ///        waiting longer than the target are dropped as overloaded, at a rate growing while it stays above the
+  ///        target. 0 means disabled
+  uint32_t queue_codel_target{0};
+
+  /// @brief Interval(ms) of the CoDel queue management, also the initial spacing of the drops
+  uint32_t queue_codel_interval{100};
+
+  /// @brief Whether to handle the newest requests first while the queue is overloaded by CoDel
+  /// @note  Only for the non_steal scheduling of separate threadmodel, and only for the requests without a routing key
+  ///        in its global queue
+  bool queue_lifo_when_overloaded{false};
+
   /// @brief For separate threadmodel
   SeparateThreadModelSchedulingConfig scheduling;
 
@@ -200,6 +221,29 @@ struct BufferPoolConfig {
   void Display() const;
 };
 
+/// @brief Configurations of the asynchronous compression stage, which compresses large payloads in a dedicated thread
+/// pool instead of the handler/io thread.
+struct AsyncCompressConfig {
+  /// @brief Whether to enable the asynchronous compression stage.
+  bool enable{false};
+
+  /// @brief Payloads whose size is greater than or equal to it(in bytes) are compressed asynchronously.
+  uint32_t threshold{1024 * 1024};
+
+  /// @brief The number of compression threads.
+  uint32_t thread_num{2};
+
+  /// @brief Max number of pending compression tasks, payloads are compressed inline once it is exceeded.
+  uint32_t task_queue_size{1024};
+
+  /// @brief Payloads larger than it(in bytes) are split into blocks and compressed in parallel(lz4 frame only).
+  /// 0(default) disables the block-parallel compression. The output is made of concatenated lz4 frames, which the
+  /// decoders of older tRPC versions reject, so enable it only if all the peers decompress them.
+  uint32_t parallel_block_size{0};
+
+  void Display() const;
+};
+
 /// @brief Configurations for tvar.
 /// @note p999 and p9999 will be recorded by default, still open three percentages to users.
 struct TvarConfig {
@@ -301,6 +345,9 @@ struct GlobalConfig {
   /// @brief Rpcz config
   RpczConfig rpcz_config;
 
+  /// @brief Asynchronous compression config
+  AsyncCompressConfig async_compress_config;
+
   void Display() const;
 };
 
@@ -40,6 +40,7 @@ struct convert<trpc::FiberThreadModelInstanceConfig> {
     node["reactor_task_queue_size"] = config.reactor_task_queue_size;
     node["cross_numa_work_stealing_ratio"] = config.cross_numa_work_stealing_ratio;
     node["fiber_run_queue_size"] = config.fiber_run_queue_size;
+    node["fiber_scheduling_lane_weights"] = config.fiber_scheduling_lane_weights;
     node["fiber_stack_size"] = config.fiber_stack_size;
     node["fiber_pool_num_by_mmap"] = config.fiber_pool_num_by_mmap;
     node["fiber_stack_enable_guard_page"] = config.fiber_stack_enable_guard_page;
@@ -94,6 +95,10 @@ struct convert<trpc::FiberThreadModelInstanceConfig> {
       config.fiber_run_queue_size = node["fiber_run_queue_size"].as<uint32_t>();
     }
 
+    if (node["fiber_scheduling_lane_weights"]) {
+      config.fiber_scheduling_lane_weights = node["fiber_scheduling_lane_weights"].as<std::vector<uint32_t>>();
+    }
+
     if (node["fiber_stack_size"]) {
       config.fiber_stack_size = node["fiber_stack_size"].as<uint32_t>();
     }
@@ -171,6 +176,9 @@ struct convert<trpc::DefaultThreadModelInstanceConfig> {
     node["disallow_cpu_migration"] = config.disallow_cpu_migration;
     node["io_thread_task_queue_size"] = config.io_thread_task_queue_size;
     node["handle_thread_task_queue_size"] = config.handle_thread_task_queue_size;
+    node["queue_codel_target"] = config.queue_codel_target;
+    node["queue_codel_interval"] = config.queue_codel_interval;
+    node["queue_lifo_when_overloaded"] = config.queue_lifo_when_overloaded;
     node["scheduling"] = config.scheduling;
     node["enable_async_io"] = config.enable_async_io;
     node["io_uring_entries"] = config.io_uring_entries;
@@ -216,6 +224,18 @@ struct convert<trpc::DefaultThreadModelInstanceConfig> {
       config.handle_thread_task_queue_size = node["handle_thread_task_queue_size"].as<uint32_t>();
     }
 
+    if (node["queue_codel_target"]) {
+      config.queue_codel_target = node["queue_codel_target"].as<uint32_t>();
+    }
+
+    if (node["queue_codel_interval"]) {
+      config.queue_codel_interval = node["queue_codel_interval"].as<uint32_t>();
+    }
+
+    if (node["queue_lifo_when_overloaded"]) {
+      config.queue_lifo_when_overloaded = node["queue_lifo_when_overloaded"].as<bool>();
+    }
+
     if (node["scheduling"]) {
       config.scheduling = node["scheduling"].as<trpc::SeparateThreadModelSchedulingConfig>();
     }
@@ -283,6 +303,38 @@ struct convert<trpc::BufferPoolConfig> {
   }
 };
 
+template <>
+struct convert<trpc::AsyncCompressConfig> {
+  static YAML::Node encode(const trpc::AsyncCompressConfig& config) {
+    YAML::Node node;
+    node["enable"] = config.enable;
+    node["threshold"] = config.threshold;
+    node["thread_num"] = config.thread_num;
+    node["task_queue_size"] = config.task_queue_size;
+    node["parallel_block_size"] = config.parallel_block_size;
+    return node;
+  }
+
+  static bool decode(const YAML::Node& node, trpc::AsyncCompressConfig& config) {
+    if (node["enable"]) {
+      config.enable = node["enable"].as<bool>();
+    }
+    if (node["threshold"]) {
+      config.threshold = node["threshold"].as<uint32_t>();
+    }
+    if (node["thread_num"]) {
+      config.thread_num = node["thread_num"].as<uint32_t>();
+    }
+    if (node["task_queue_size"]) {
+      config.task_queue_size = node["task_queue_size"].as<uint32_t>();
+    }
+    if (node["parallel_block_size"]) {
+      config.parallel_block_size = node["parallel_block_size"].as<uint32_t>();
+    }
+    return true;
+  }
+};
+
 template <>
 struct convert<trpc::TvarConfig> {
   static YAML::Node encode(const trpc::TvarConfig& config) {
@@ -416,6 +468,7 @@ struct convert<trpc::GlobalConfig> {
     node["buffer_pool"] = global_config.buffer_pool_config;
     node["tvar"] = global_config.tvar_config;
     node["rpcz"] = global_config.rpcz_config;
+    node["async_compress"] = global_config.async_compress_config;
 
     return node;
   }
@@ -496,6 +549,10 @@ struct convert<trpc::GlobalConfig> {
       global_config.rpcz_config = node["rpcz"].as<trpc::RpczConfig>();
     }
 
+    if (node["async_compress"]) {
+      global_config.async_compress_config = node["async_compress"].as<trpc::AsyncCompressConfig>();
+    }
+
     return true;
   }
 };
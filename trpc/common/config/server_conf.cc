@@ -38,8 +38,11 @@ void ServiceConfig::Display() const {
   TRPC_LOG_DEBUG("recv_buffer_size:" << recv_buffer_size);
   TRPC_LOG_DEBUG("send_queue_capacity:" << send_queue_capacity);
   TRPC_LOG_DEBUG("send_queue_timeout:" << send_queue_timeout);
+  TRPC_LOG_DEBUG("send_queue_high_watermark:" << send_queue_high_watermark);
+  TRPC_LOG_DEBUG("send_queue_low_watermark:" << send_queue_low_watermark);
   TRPC_LOG_DEBUG("threadmodel_instance_name:" << threadmodel_instance_name);
   TRPC_LOG_DEBUG("accept_thread_num:" << accept_thread_num);
+  TRPC_LOG_DEBUG("reuseport_cpu_steering:" << reuseport_cpu_steering);
   TRPC_LOG_DEBUG("stream_read_timeout:" << stream_read_timeout);
   TRPC_LOG_DEBUG("stream_max_window_size:" << stream_max_window_size);
 
@@ -62,6 +65,7 @@ void ServerConfig::Display() const {
   TRPC_LOG_DEBUG("enable_server_stats:" << enable_server_stats);
   TRPC_LOG_DEBUG("server_stats_interval:" << server_stats_interval);
   TRPC_LOG_DEBUG("stop_max_wait_time:" << stop_max_wait_time);
+  TRPC_LOG_DEBUG("listen_fd_handoff_path:" << listen_fd_handoff_path);
 
   for (const auto& i : services_config) {
     i.Display();
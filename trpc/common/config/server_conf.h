@@ -98,6 +98,16 @@ struct ServiceConfig {
   /// Use in fiber runtime
   uint32_t send_queue_timeout{3000};
 
+  /// @brief When the data(bytes) cached in the io-send queue of a connection reaches it, reading requests from the
+  /// connection is paused, and the senders(such as the stream writers) are suspended until the queue drains to
+  /// `send_queue_low_watermark`. Use in fiber runtime(reading is also paused in the default runtime), if set 0, not
+  /// enabled
+  uint32_t send_queue_high_watermark{0};
+
+  /// @brief The data(bytes) the io-send queue drains to for resuming a connection paused by
+  /// `send_queue_high_watermark`, if set 0, half of `send_queue_high_watermark` is used
+  uint32_t send_queue_low_watermark{0};
+
   /// @brief The thread model type use by service, deprecated.
   std::string threadmodel_type;
 
@@ -109,6 +119,11 @@ struct ServiceConfig {
   /// @brief The number of threads(fibers) listening on the port
   uint32_t accept_thread_num{1};
 
+  /// @brief Whether to steer the new connections to the acceptors running on the cpu receiving them, which keeps the
+  /// softirq, the reactor and the handler of a connection on the same cpus. Used in fiber runtime with reuseport,
+  /// effective only if the fiber scheduling groups are bound to cpus.
+  bool reuseport_cpu_steering{false};
+
   /// @brief Under streaming, the timeout for reading messages from the stream
   int stream_read_timeout{3000};
 
@@ -177,6 +192,11 @@ struct ServerConfig {
   /// @brief set max wait timeout(ms) when stop incase cannot stop
   uint32_t stop_max_wait_time{5000};
 
+  /// @brief Path of the unix domain socket to hand the listening sockets over on hot restart, disabled if empty.
+  /// On start, the server takes over the listening sockets from the process serving them on the path, which then stops
+  /// gracefully, and serves its own listening sockets on the path to the process replacing it.
+  std::string listen_fd_handoff_path;
+
   void Display() const;
 };
 
@@ -49,9 +49,12 @@ struct convert<trpc::ServiceConfig> {
     node["recv_buffer_size"] = service_config.recv_buffer_size;
     node["send_queue_capacity"] = service_config.send_queue_capacity;
     node["send_queue_timeout"] = service_config.send_queue_timeout;
+    node["send_queue_high_watermark"] = service_config.send_queue_high_watermark;
+    node["send_queue_low_watermark"] = service_config.send_queue_low_watermark;
     node["threadmodel_type"] = service_config.threadmodel_type;
     node["threadmodel_instance_name"] = service_config.threadmodel_instance_name;
     node["accept_thread_num"] = service_config.accept_thread_num;
+    node["reuseport_cpu_steering"] = service_config.reuseport_cpu_steering;
     node["stream_read_timeout"] = service_config.stream_read_timeout;
     node["stream_max_window_size"] = service_config.stream_max_window_size;
     node["filter"] = service_config.service_filters;
@@ -123,6 +126,12 @@ struct convert<trpc::ServiceConfig> {
     if (node["send_queue_timeout"]) {
       service_config.send_queue_timeout = node["send_queue_timeout"].as<uint32_t>();
     }
+    if (node["send_queue_high_watermark"]) {
+      service_config.send_queue_high_watermark = node["send_queue_high_watermark"].as<uint32_t>();
+    }
+    if (node["send_queue_low_watermark"]) {
+      service_config.send_queue_low_watermark = node["send_queue_low_watermark"].as<uint32_t>();
+    }
     if (node["threadmodel_type"]) {
       service_config.threadmodel_type = node["threadmodel_type"].as<std::string>();
     }
@@ -150,6 +159,11 @@ struct convert<trpc::ServiceConfig> {
       }
 #endif
     }
+
+    if (node["reuseport_cpu_steering"]) {
+      service_config.reuseport_cpu_steering = node["reuseport_cpu_steering"].as<bool>();
+    }
+
     if (node["filter"]) {
       service_config.service_filters = node["filter"].as<std::vector<std::string>>();
     }
@@ -181,6 +195,7 @@ struct convert<trpc::ServerConfig> {
     node["filter"] = server_config.filters;
     node["service"] = server_config.services_config;
     node["stop_max_wait_time"] = server_config.stop_max_wait_time;
+    node["listen_fd_handoff_path"] = server_config.listen_fd_handoff_path;
 
     return node;
   }
@@ -245,6 +260,10 @@ struct convert<trpc::ServerConfig> {
       server_config.stop_max_wait_time = node["stop_max_wait_time"].as<uint32_t>();
     }
 
+    if (node["listen_fd_handoff_path"]) {
+      server_config.listen_fd_handoff_path = node["listen_fd_handoff_path"].as<std::string>();
+    }
+
     return true;
   }
 };
@@ -35,6 +35,7 @@ TEST(ServerConfigTest, server_config_test) {
   server_config.server_stats_interval = 60000;
   server_config.filters = {"tpstelemetry"};
   server_config.stop_max_wait_time = 1000;
+  server_config.listen_fd_handoff_path = "/tmp/trpc_listen_fd_handoff.sock";
 
   ServiceConfig service_config;
   service_config.service_name = "trpc.test.helloworld.Greeter";
@@ -56,6 +57,7 @@ TEST(ServerConfigTest, server_config_test) {
   service_config.send_queue_timeout = 5000;
   service_config.threadmodel_instance_name = "instance1";
   service_config.accept_thread_num = 2;
+  service_config.reuseport_cpu_steering = true;
   service_config.stream_read_timeout = 3000;
   service_config.stream_max_window_size = 65535;
 
@@ -84,6 +86,7 @@ TEST(ServerConfigTest, server_config_test) {
   ASSERT_EQ(server_config.server_stats_interval, tmp.server_stats_interval);
   ASSERT_EQ(server_config.filters[0], tmp.filters[0]);
   ASSERT_EQ(server_config.stop_max_wait_time, tmp.stop_max_wait_time);
+  ASSERT_EQ(server_config.listen_fd_handoff_path, tmp.listen_fd_handoff_path);
 
   ASSERT_EQ(server_config.services_config.front().service_name, tmp.services_config.front().service_name);
   ASSERT_EQ(server_config.services_config.front().network, tmp.services_config.front().network);
@@ -105,6 +108,7 @@ TEST(ServerConfigTest, server_config_test) {
   ASSERT_EQ(server_config.services_config.front().share_transport, tmp.services_config.front().share_transport);
   ASSERT_EQ(server_config.services_config.front().stream_max_window_size,
             tmp.services_config.front().stream_max_window_size);
+  ASSERT_TRUE(tmp.services_config.front().reuseport_cpu_steering);
 
 #if defined(SO_REUSEPORT) && !defined(TRPC_DISABLE_REUSEPORT)
   ASSERT_EQ(YAML::convert<trpc::ServerConfig>::decode(server_config_node, tmp), true);
@@ -19,6 +19,8 @@
 #include "trpc/codec/client_codec_factory.h"
 #include "trpc/codec/codec_manager.h"
 #include "trpc/codec/server_codec_factory.h"
+#include "trpc/common/config/trpc_config.h"
+#include "trpc/compressor/async_compressor.h"
 #include "trpc/compressor/compressor_factory.h"
 #include "trpc/compressor/trpc_compressor.h"
 #include "trpc/config/config_factory.h"
@@ -60,6 +62,24 @@
 
 namespace trpc {
 
+namespace {
+
+bool InitAsyncCompress() {
+  const auto& config = TrpcConfig::GetInstance()->GetGlobalConfig().async_compress_config;
+  if (!config.enable) {
+    return true;
+  }
+
+  compressor::AsyncCompressOption option;
+  option.threshold = config.threshold;
+  option.thread_num = config.thread_num;
+  option.task_queue_size = config.task_queue_size;
+  option.parallel_block_size = config.parallel_block_size;
+  return compressor::InitAsyncCompress(option);
+}
+
+}  // namespace
+
 // The plugins supported by the framework by default are registered here
 int TrpcPlugin::RegisterPlugins() {
   std::scoped_lock<std::mutex> lock(mutex_);
@@ -71,6 +91,7 @@ int TrpcPlugin::RegisterPlugins() {
   util::IgnorePipe();
 
   TRPC_ASSERT(compressor::Init());
+  TRPC_ASSERT(InitAsyncCompress());
   TRPC_ASSERT(serialization::Init());
   TRPC_ASSERT(codec::Init());
 
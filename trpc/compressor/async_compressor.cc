@@ -0,0 +1,180 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/compressor/async_compressor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
+#include "trpc/compressor/trpc_compressor.h"
+#include "trpc/coroutine/fiber.h"
+#include "trpc/coroutine/future.h"
+#include "trpc/future/future_utility.h"
+#include "trpc/util/likely.h"
+#include "trpc/util/log/logging.h"
+#include "trpc/util/thread/thread_pool.h"
+
+namespace trpc::compressor {
+
+namespace {
+
+std::atomic<bool> async_compress_enabled{false};
+AsyncCompressOption async_compress_option;
+std::unique_ptr<ThreadPool> compress_thread_pool;
+// Fences the submissions against `DestroyAsyncCompress`, the pool is read with it shared and reset with it exclusive.
+std::shared_mutex compress_thread_pool_mutex;
+
+// Shared by the caller and the compression thread, the input bytes and the promise have to survive a failed `AddTask`
+// because the task is consumed by the queue even if it is full.
+struct CompressTask {
+  CompressType type;
+  LevelType level;
+  NoncontiguousBuffer in;
+  Promise<NoncontiguousBuffer> promise;
+
+  void Run() {
+    NoncontiguousBuffer out;
+    if (TRPC_LIKELY(Compress(type, in, out, level))) {
+      promise.SetValue(std::move(out));
+    } else {
+      promise.SetException(CommonException("compress failed"));
+    }
+  }
+};
+
+Future<NoncontiguousBuffer> SubmitCompressTask(CompressType type, NoncontiguousBuffer&& in, LevelType level) {
+  auto task = std::make_shared<CompressTask>();
+  task->type = type;
+  task->level = level;
+  task->in = std::move(in);
+  auto fut = task->promise.GetFuture();
+
+  {
+    std::shared_lock<std::shared_mutex> lock(compress_thread_pool_mutex);
+    // The pool is gone if the stage is destroyed after the caller checked it, the input is compressed inline then.
+    if (TRPC_LIKELY(compress_thread_pool != nullptr)) {
+      if (TRPC_LIKELY(compress_thread_pool->AddTask([task]() { task->Run(); }))) {
+        return fut;
+      }
+      // The compression threads are saturated, falls back to inline compression to bound the queue.
+      TRPC_FMT_WARN_EVERY_SECOND("compression task queue is full, compress inline");
+    }
+  }
+  task->Run();
+  return fut;
+}
+
+// Concatenated frames are valid lz4 frame stream, so the blocks can be compressed independently.
+bool IsBlockParallelSupported(CompressType type) { return type == kLz4Frame; }
+
+Future<NoncontiguousBuffer> BlockParallelCompress(CompressType type, NoncontiguousBuffer&& in, LevelType level,
+                                                  std::size_t block_size) {
+  std::vector<Future<NoncontiguousBuffer>> futs;
+  futs.reserve(in.ByteSize() / block_size + 1);
+  while (!in.Empty()) {
+    futs.emplace_back(SubmitCompressTask(type, in.Cut(std::min(block_size, in.ByteSize())), level));
+  }
+
+  return WhenAll(futs.begin(), futs.end()).Then([](std::vector<Future<NoncontiguousBuffer>>&& results) {
+    NoncontiguousBuffer out;
+    for (auto& result : results) {
+      if (result.IsFailed()) {
+        return MakeExceptionFuture<NoncontiguousBuffer>(result.GetException());
+      }
+      out.Append(result.GetValue0());
+    }
+    return MakeReadyFuture<NoncontiguousBuffer>(std::move(out));
+  });
+}
+
+}  // namespace
+
+bool InitAsyncCompress(const AsyncCompressOption& option) {
+  if (async_compress_enabled.load(std::memory_order_acquire)) {
+    return true;
+  }
+
+  async_compress_option = option;
+
+  ThreadPoolOption thread_pool_option;
+  thread_pool_option.thread_num = std::max<std::size_t>(option.thread_num, 1);
+  thread_pool_option.task_queue_size = std::max<std::size_t>(option.task_queue_size, 1);
+  auto thread_pool = std::make_unique<ThreadPool>(std::move(thread_pool_option));
+  if (!thread_pool->Start()) {
+    TRPC_LOG_ERROR("start compression thread pool failed");
+    return false;
+  }
+
+  std::unique_lock<std::shared_mutex> lock(compress_thread_pool_mutex);
+  compress_thread_pool = std::move(thread_pool);
+  async_compress_enabled.store(true, std::memory_order_release);
+  return true;
+}
+
+void DestroyAsyncCompress() {
+  if (!async_compress_enabled.exchange(false, std::memory_order_acq_rel)) {
+    return;
+  }
+  std::unique_ptr<ThreadPool> thread_pool;
+  {
+    // Waits for the submissions in progress, the later ones compress inline.
+    std::unique_lock<std::shared_mutex> lock(compress_thread_pool_mutex);
+    thread_pool.swap(compress_thread_pool);
+  }
+  thread_pool->Stop();
+  thread_pool->Join();
+}
+
+bool IsAsyncCompressEnabled() { return async_compress_enabled.load(std::memory_order_acquire); }
+
+bool ShouldCompressAsync(CompressType type, std::size_t size) {
+  return type != kNone && IsAsyncCompressEnabled() && size >= async_compress_option.threshold;
+}
+
+Future<NoncontiguousBuffer> AsyncCompress(CompressType type, NoncontiguousBuffer&& in, LevelType level) {
+  if (!IsAsyncCompressEnabled()) {
+    NoncontiguousBuffer out;
+    if (TRPC_UNLIKELY(!Compress(type, in, out, level))) {
+      return MakeExceptionFuture<NoncontiguousBuffer>(CommonException("compress failed"));
+    }
+    return MakeReadyFuture<NoncontiguousBuffer>(std::move(out));
+  }
+
+  std::size_t block_size = async_compress_option.parallel_block_size;
+  if (block_size > 0 && IsBlockParallelSupported(type) && in.ByteSize() > block_size) {
+    return BlockParallelCompress(type, std::move(in), level, block_size);
+  }
+  return SubmitCompressTask(type, std::move(in), level);
+}
+
+bool CompressAndWait(CompressType type, NoncontiguousBuffer& data, LevelType level) {
+  // Copying the buffer only increases the reference count of blocks, |data| is kept untouched on failure.
+  NoncontiguousBuffer in = data;
+  auto fut = AsyncCompress(type, std::move(in), level);
+  if (!fut.IsReady() && !fut.IsFailed()) {
+    fut = trpc::IsRunningInFiberWorker() ? fiber::BlockingGet(std::move(fut)) : future::BlockingGet(std::move(fut));
+  }
+  if (TRPC_UNLIKELY(fut.IsFailed())) {
+    TRPC_FMT_ERROR("async compress failed, type: {}, error: {}", static_cast<int>(type), fut.GetException().what());
+    return false;
+  }
+  data = fut.GetValue0();
+  return true;
+}
+
+}  // namespace trpc::compressor
@@ -0,0 +1,77 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <cstddef>
+
+#include "trpc/compressor/compressor_type.h"
+#include "trpc/future/future.h"
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+
+/// @brief Offloads the compression of large payloads to a dedicated thread pool, so that the handler/io fiber which
+/// compresses a 10 MB response does not stall the other requests sharing the same worker.
+namespace trpc::compressor {
+
+/// @brief Options of the asynchronous compression stage.
+struct AsyncCompressOption {
+  /// @brief Inputs whose size is greater than or equal to it are compressed in the compression thread pool, the smaller
+  /// ones are compressed inline.
+  std::size_t threshold{1024 * 1024};
+
+  /// @brief The number of compression threads.
+  std::size_t thread_num{2};
+
+  /// @brief Max number of pending compression tasks. Once the queue is full, the caller compresses inline.
+  std::size_t task_queue_size{1024};
+
+  /// @brief Inputs larger than it are split into blocks of this size and the blocks are compressed in parallel, the
+  /// output is the concatenation of the independently compressed frames. Only applies to the compression algorithms
+  /// whose format allows concatenated frames (lz4 frame). 0 disables the block-parallel compression.
+  /// @note Off by default: the decoders of older tRPC versions reject concatenated lz4 frames, so it's enabled only
+  /// once all the peers decompress them.
+  std::size_t parallel_block_size{0};
+};
+
+/// @brief Starts the compression thread pool.
+/// @return Returns true on success.
+bool InitAsyncCompress(const AsyncCompressOption& option);
+
+/// @brief Stops the compression thread pool, the pending tasks are finished before it returns. It may be called while
+/// other threads are still compressing, their inputs are compressed inline once the pool is stopped.
+void DestroyAsyncCompress();
+
+/// @brief Returns true if the compression thread pool is running.
+bool IsAsyncCompressEnabled();
+
+/// @brief Returns true if the input of |size| bytes should be compressed in the compression thread pool.
+bool ShouldCompressAsync(CompressType type, std::size_t size);
+
+/// @brief Compresses the input bytes in the compression thread pool.
+/// @param type is the compression algorithm.
+/// @param in is the input bytes.
+/// @param level indicates the compression quality.
+/// @return Returns a future holding the compressed bytes, it is failed if compression fails.
+/// @note If the compression thread pool is not running or its task queue is full, the input is compressed inline and a
+/// ready future is returned.
+Future<NoncontiguousBuffer> AsyncCompress(CompressType type, NoncontiguousBuffer&& in, LevelType level = kDefault);
+
+/// @brief Compresses the input bytes in the compression thread pool and waits for the result. Fiber is suspended
+/// (instead of the worker thread) while waiting if it is called in fiber runtime.
+/// @param type is the compression algorithm.
+/// @param data is the input bytes(it will be overwritten if compressed successfully).
+/// @param level indicates the compression quality.
+/// @return Returns true on success, false otherwise.
+bool CompressAndWait(CompressType type, NoncontiguousBuffer& data, LevelType level = kDefault);
+
+}  // namespace trpc::compressor
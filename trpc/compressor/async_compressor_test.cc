@@ -0,0 +1,172 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/compressor/async_compressor.h"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "trpc/compressor/compressor_factory.h"
+#include "trpc/compressor/testing/compressor_testing.h"
+#include "trpc/compressor/trpc_compressor.h"
+#include "trpc/future/future_utility.h"
+#include "trpc/util/buffer/buffer.h"
+
+namespace trpc::compressor::testing {
+
+class AsyncCompressorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(Init());
+    AsyncCompressOption option;
+    option.threshold = 1024;
+    option.thread_num = 2;
+    option.parallel_block_size = 64 * 1024;
+    ASSERT_TRUE(InitAsyncCompress(option));
+  }
+
+  void TearDown() override { Destroy(); }
+};
+
+TEST_F(AsyncCompressorTest, ShouldCompressAsync) {
+  ASSERT_TRUE(IsAsyncCompressEnabled());
+  ASSERT_FALSE(ShouldCompressAsync(kNone, 1024 * 1024));
+  ASSERT_FALSE(ShouldCompressAsync(kGzip, 1023));
+  ASSERT_TRUE(ShouldCompressAsync(kGzip, 1024));
+}
+
+TEST_F(AsyncCompressorTest, AsyncCompress) {
+  for (auto type : {kGzip, kZlib, kSnappy, kLz4Frame}) {
+    std::string in = GenRandomStr(1024 * 1024 + 1);
+    auto fut = future::BlockingGet(AsyncCompress(type, CreateBufferSlow(in)));
+    ASSERT_TRUE(fut.IsReady());
+
+    NoncontiguousBuffer out;
+    ASSERT_TRUE(Decompress(type, fut.GetValue0(), out));
+    ASSERT_EQ(FlattenSlow(out), in);
+  }
+}
+
+TEST_F(AsyncCompressorTest, CompressIfNeeded) {
+  for (auto size : {100, 1024 * 1024}) {
+    std::string in = GenRandomStr(size);
+    NoncontiguousBuffer data = CreateBufferSlow(in);
+    ASSERT_TRUE(CompressIfNeeded(kLz4Frame, data));
+    ASSERT_TRUE(DecompressIfNeeded(kLz4Frame, data));
+    ASSERT_EQ(FlattenSlow(data), in);
+  }
+}
+
+TEST_F(AsyncCompressorTest, CompressFail) {
+  CompressType type{135};
+  auto p = MakeRefCounted<MockCompressor>();
+  EXPECT_CALL(*p, Type()).WillOnce(::testing::Return(type));
+  EXPECT_CALL(*p, DoCompress(::testing::_, ::testing::_, ::testing::_)).WillRepeatedly(::testing::Return(false));
+  ASSERT_TRUE(CompressorFactory::GetInstance()->Register(p));
+
+  std::string in = GenRandomStr(4096);
+  NoncontiguousBuffer data = CreateBufferSlow(in);
+  ASSERT_FALSE(CompressIfNeeded(type, data));
+  ASSERT_EQ(FlattenSlow(data), in);
+
+  auto fut = future::BlockingGet(AsyncCompress(type, CreateBufferSlow(in)));
+  ASSERT_TRUE(fut.IsFailed());
+}
+
+TEST_F(AsyncCompressorTest, DestroyWhileCompressing) {
+  std::atomic<bool> stopped{false};
+  std::atomic<int> failures{0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&]() {
+      std::string in = GenRandomStr(64 * 1024);
+      while (!stopped.load(std::memory_order_relaxed)) {
+        NoncontiguousBuffer data = CreateBufferSlow(in);
+        if (!CompressIfNeeded(kLz4Frame, data) || !DecompressIfNeeded(kLz4Frame, data) || FlattenSlow(data) != in) {
+          failures.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    });
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  // The compressions submitted meanwhile are finished by the pool or compressed inline.
+  DestroyAsyncCompress();
+  ASSERT_FALSE(IsAsyncCompressEnabled());
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  stopped = true;
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(failures, 0);
+}
+
+TEST(AsyncCompressor, Disabled) {
+  ASSERT_TRUE(Init());
+  ASSERT_FALSE(IsAsyncCompressEnabled());
+  ASSERT_FALSE(ShouldCompressAsync(kGzip, 1024 * 1024 * 1024));
+
+  std::string in = GenRandomStr(4096);
+  auto fut = AsyncCompress(kGzip, CreateBufferSlow(in));
+  ASSERT_TRUE(fut.IsReady());
+  NoncontiguousBuffer out;
+  ASSERT_TRUE(Decompress(kGzip, fut.GetValue0(), out));
+  ASSERT_EQ(FlattenSlow(out), in);
+  Destroy();
+}
+
+namespace {
+
+// The number of lz4 frames in `data`, by their magic numbers.
+std::size_t CountLz4Frames(const NoncontiguousBuffer& data) {
+  constexpr std::string_view kMagic("\x04\x22\x4d\x18", 4);
+  std::string flat = FlattenSlow(data);
+  std::size_t count = 0;
+  for (auto pos = flat.find(kMagic); pos != std::string::npos; pos = flat.find(kMagic, pos + kMagic.size())) {
+    ++count;
+  }
+  return count;
+}
+
+}  // namespace
+
+TEST(AsyncCompressor, SingleLz4FrameByDefault) {
+  ASSERT_TRUE(Init());
+  // The block-parallel compression is opt-in, as the older decoders accept a single frame only.
+  AsyncCompressOption option;
+  ASSERT_EQ(option.parallel_block_size, 0);
+  option.threshold = 1024;
+  ASSERT_TRUE(InitAsyncCompress(option));
+
+  std::string in = GenRandomStr(1024 * 1024);
+  auto fut = future::BlockingGet(AsyncCompress(kLz4Frame, CreateBufferSlow(in)));
+  ASSERT_TRUE(fut.IsReady());
+  NoncontiguousBuffer out = fut.GetValue0();
+  ASSERT_EQ(CountLz4Frames(out), 1);
+  DestroyAsyncCompress();
+
+  option.parallel_block_size = 64 * 1024;
+  ASSERT_TRUE(InitAsyncCompress(option));
+  fut = future::BlockingGet(AsyncCompress(kLz4Frame, CreateBufferSlow(in)));
+  ASSERT_TRUE(fut.IsReady());
+  ASSERT_EQ(CountLz4Frames(fut.GetValue0()), 16);
+  Destroy();
+}
+
+}  // namespace trpc::compressor::testing
@@ -100,4 +100,28 @@ TEST(Lz4FrameCompressor, CompressStr) {
   }
 }
 
+TEST(Lz4FrameCompressor, DecompressConcatenatedFrames) {
+  Lz4FrameCompressor compressor;
+
+  std::string first = GenRandomStr(300 * 1024);
+  std::string second = GenRandomStr(100);
+  trpc::NoncontiguousBuffer first_out;
+  ASSERT_TRUE(compressor.Compress(trpc::CreateBufferSlow(first), first_out));
+  trpc::NoncontiguousBuffer second_out;
+  ASSERT_TRUE(compressor.Compress(trpc::CreateBufferSlow(second), second_out));
+
+  // Frames which resides in the same block and in different blocks are both decompressed.
+  for (bool flatten : {true, false}) {
+    trpc::NoncontiguousBuffer decompress_in;
+    decompress_in.Append(first_out);
+    decompress_in.Append(second_out);
+    if (flatten) {
+      decompress_in = trpc::CreateBufferSlow(trpc::FlattenSlow(decompress_in));
+    }
+    trpc::NoncontiguousBuffer decompress_out;
+    ASSERT_TRUE(compressor.Decompress(decompress_in, decompress_out));
+    EXPECT_EQ(trpc::FlattenSlow(decompress_out), first + second);
+  }
+}
+
 }  // namespace trpc::compressor::testing
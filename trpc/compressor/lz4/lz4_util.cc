@@ -78,17 +78,18 @@ bool CompressedToOutputStream(trpc::NoncontiguousBufferOutputStream* out_stream,
 
 bool DecompressSingleBuffer(LZ4F_dctx* ctx, const char* in_data, size_t in_size, void* out, size_t out_capacity,
                             trpc::NoncontiguousBufferOutputStream* out_stream) {
-  size_t ret = 1;
   // Decompress:
-  // Continue while there is more input to read (in_data != in_data_end)
-  // and the frame isn't over (ret != 0)
+  // Continue while there is more input to read (in_data != in_data_end).
+  // Once a frame is over (ret == 0), the context is ready to decode the next concatenated frame, e.g. the output of
+  // block-parallel compression.
   char* curr_in_data = const_cast<char*>(in_data);
   const char* in_data_end = in_data + in_size;
-  while (curr_in_data < in_data_end && ret != 0) {
+  while (curr_in_data < in_data_end) {
     // Any data within dst has been flushed at this stage
     size_t out_size = out_capacity;
     size_t curr_in_size = in_data_end - curr_in_data;
-    ret = LZ4F_decompress(ctx, out, &out_size, curr_in_data, &curr_in_size, /* LZ4F_decompressOptions_t */ nullptr);
+    size_t ret = LZ4F_decompress(ctx, out, &out_size, curr_in_data, &curr_in_size,
+                                 /* LZ4F_decompressOptions_t */ nullptr);
     if (LZ4F_isError(ret)) {
       TRPC_FMT_ERROR("Decompression error: {}", LZ4F_getErrorName(ret));
       return false;
@@ -103,11 +104,6 @@ bool DecompressSingleBuffer(LZ4F_dctx* ctx, const char* in_data, size_t in_size,
     // Update input
     curr_in_data += curr_in_size;
   }
-
-  if (curr_in_data < in_data_end) {
-    TRPC_FMT_ERROR("Decompress: Trailing data left in file after frame");
-    return false;
-  }
   return true;
 }
 
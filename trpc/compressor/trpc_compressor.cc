@@ -15,6 +15,7 @@
 
 #include <utility>
 
+#include "trpc/compressor/async_compressor.h"
 #include "trpc/compressor/compressor_factory.h"
 #include "trpc/compressor/gzip/gzip_compressor.h"
 #include "trpc/compressor/lz4/lz4_compressor.h"
@@ -44,6 +45,7 @@ bool Init() {
 }
 
 void Destroy() {
+  DestroyAsyncCompress();
   CompressorFactory::GetInstance()->Clear();
 }
 
@@ -51,6 +53,9 @@ bool CompressIfNeeded(CompressType type, NoncontiguousBuffer& data, LevelType le
   if (type == kNone) {
     return true;
   }
+  if (ShouldCompressAsync(type, data.ByteSize())) {
+    return CompressAndWait(type, data, level);
+  }
   NoncontiguousBuffer out;
   if (TRPC_UNLIKELY(!Compress(type, data, out, level))) {
     return false;
@@ -46,6 +46,8 @@ bool Decompress(CompressType type, const NoncontiguousBuffer& in, NoncontiguousB
 /// @param data is the input bytes(it will be overwritten if compressed successfully).
 /// @param level indicates the compression quality.
 /// @return Returns true on success, false otherwise. Keep in mind: it always returns ture when |type| is "kNone".
+/// @note If the asynchronous compression stage is enabled(see `InitAsyncCompress`) and |data| is large enough, the
+/// compression runs in the compression thread pool and the calling fiber is suspended until it finishes.
 bool CompressIfNeeded(CompressType type, NoncontiguousBuffer& data, LevelType level = kDefault);
 
 /// @brief Decompresses the compressed bytes and put the uncompressed bytes into output buffer if the |type| is not
@@ -39,6 +39,13 @@ fiber::detail::SchedulingGroup* GetSchedulingGroup(std::size_t id) {
   }
 }
 
+// Fibers started by a fiber are queued in the lane of their parent, so the work spawned by a request keeps the
+// priority of the request.
+std::uint8_t GetCurrentSchedulingLane() {
+  auto self = fiber::detail::GetCurrentFiberEntity();
+  return self ? self->scheduling_lane : 0;
+}
+
 }  // namespace
 
 Fiber::Fiber() = default;
@@ -65,6 +72,7 @@ Fiber::Fiber(const Attributes& attr, Function<void()>&& start) {
   desc->start_proc = std::move(start);
   desc->scheduling_group_local = attr.scheduling_group_local;
   desc->is_fiber_reactor = attr.is_fiber_reactor;
+  desc->scheduling_lane = GetCurrentSchedulingLane();
 
   // If `join()` is called, we'll sleep on this.
   desc->exit_barrier = object_pool::MakeLwShared<fiber::detail::ExitBarrier>();
@@ -100,6 +108,7 @@ bool StartFiberDetached(Function<void()>&& start_proc) {
   desc->start_proc = std::move(start_proc);
   TRPC_CHECK(!desc->exit_barrier);
   desc->scheduling_group_local = false;
+  desc->scheduling_lane = GetCurrentSchedulingLane();
 
   return fiber::detail::NearestSchedulingGroup()->StartFiber(desc);
 }
@@ -119,6 +128,7 @@ bool StartFiberDetached(Fiber::Attributes&& attrs, Function<void()>&& start_proc
   desc->start_proc = std::move(start_proc);
   TRPC_CHECK(!desc->exit_barrier);
   desc->scheduling_group_local = attrs.scheduling_group_local;
+  desc->scheduling_lane = GetCurrentSchedulingLane();
 
   if (attrs.launch_policy == fiber::Launch::Post) {
     return sg->StartFiber(desc);
@@ -132,11 +142,13 @@ bool StartFiberDetached(Fiber::Attributes&& attrs, Function<void()>&& start_proc
 
 bool BatchStartFiberDetached(std::vector<Function<void()>>&& start_procs) {
   std::vector<fiber::detail::FiberDesc*> descs;
+  auto lane = GetCurrentSchedulingLane();
   for (auto&& e : start_procs) {
     auto desc = fiber::detail::NewFiberDesc();
     desc->start_proc = std::move(e);
     TRPC_CHECK(!desc->exit_barrier);
     desc->scheduling_group_local = false;
+    desc->scheduling_lane = lane;
     descs.push_back(desc);
   }
 
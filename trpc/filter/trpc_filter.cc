@@ -29,6 +29,7 @@
 #include "trpc/rpcz/span.h"
 #endif
 #ifdef TRPC_BUILD_INCLUDE_OVERLOAD_CONTROL
+#include "trpc/overload_control/adaptive_concurrency/adaptive_concurrency_server_filter.h"
 #include "trpc/overload_control/concurrency_limiter/concurrency_limiter_server_filter.h"
 #include "trpc/overload_control/fiber_limiter/fiber_limiter_client_filter.h"
 #include "trpc/overload_control/fiber_limiter/fiber_limiter_server_filter.h"
@@ -55,6 +56,10 @@ bool InitializeServerFilter() {
   concurrency_limiter_server_filter->Init();
   FilterManager::GetInstance()->AddMessageServerFilter(concurrency_limiter_server_filter);
 
+  MessageServerFilterPtr adaptive_concurrency_server_filter(new overload_control::AdaptiveConcurrencyServerFilter());
+  adaptive_concurrency_server_filter->Init();
+  FilterManager::GetInstance()->AddMessageServerFilter(adaptive_concurrency_server_filter);
+
   MessageServerFilterPtr fiber_limiter_server_filter(new overload_control::FiberLimiterServerFilter());
   fiber_limiter_server_filter->Init();
   FilterManager::GetInstance()->AddMessageServerFilter(fiber_limiter_server_filter);
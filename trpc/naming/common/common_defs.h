@@ -23,6 +23,8 @@
 
 namespace trpc {
 
+struct LoadBalanceHandle;
+
 /// @brief Structure of service registration information
 struct RegistryInfo {
   /// Name of the route registered to the naming service
@@ -81,6 +83,9 @@ struct SelectorInfo {
 
   /// Indicates whether the request comes from the SelectorWorkFlow of the framework
   bool is_from_workflow = false;
+
+  /// Load balancer and callee pre-resolved by the service proxy, null if not resolved
+  const LoadBalanceHandle* load_balance_handle = nullptr;
 };
 
 /// @brief Structure of service discovery information for external use
@@ -144,7 +149,25 @@ struct InvokeResult {
   uint64_t cost_time;
   /// Current user request context
   ClientContextPtr context;
-};
+  /// Whether the request has been sent, false if its response is served without calling the node selected, e.g. from
+  /// the response cache
+  bool request_sent = true;
+};
+
+/// @brief Whether the request of an invocation has been sent to the callee, judged by its framework error code.
+/// @note The requests failed with TRPC_CLIENT_ENCODE_ERR, TRPC_CLIENT_ROUTER_ERR, TRPC_CLIENT_LIMITED_ERR or
+///       TRPC_CLIENT_OVERLOAD_ERR have not been sent, so their results tell nothing about the callee.
+inline bool IsInvokeRequestSent(int framework_result) {
+  return framework_result != TrpcRetCode::TRPC_CLIENT_ENCODE_ERR &&
+         framework_result != TrpcRetCode::TRPC_CLIENT_ROUTER_ERR &&
+         framework_result != TrpcRetCode::TRPC_CLIENT_LIMITED_ERR &&
+         framework_result != TrpcRetCode::TRPC_CLIENT_OVERLOAD_ERR;
+}
+
+/// @brief Whether the request of an invocation has been sent to the callee, judged by the invocation result.
+inline bool IsInvokeRequestSent(const InvokeResult& result) {
+  return result.request_sent && IsInvokeRequestSent(result.framework_result);
+}
 
 /// @brief Structure of service discovery invocation result
 struct TrpcInvokeResult {
@@ -0,0 +1,328 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/naming/common/util/circuit_break/circuit_breaker.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "trpc/util/time.h"
+
+namespace trpc::naming {
+
+namespace {
+
+// The errors caused by the caller rather than the endpoint.
+const std::vector<int> kDefaultWhiteList = {
+    TrpcRetCode::TRPC_SERVER_NOSERVICE_ERR,         TrpcRetCode::TRPC_SERVER_NOFUNC_ERR,
+    TrpcRetCode::TRPC_SERVER_FULL_LINK_TIMEOUT_ERR, TrpcRetCode::TRPC_SERVER_AUTH_ERR,
+    TrpcRetCode::TRPC_SERVER_VALIDATE_ERR,          TrpcRetCode::TRPC_CLIENT_FULL_LINK_TIMEOUT_ERR,
+    TrpcRetCode::TRPC_CLIENT_VALIDATE_ERR,          TrpcRetCode::TRPC_CLIENT_CANCELED_ERR,
+};
+
+// Ejection time doubles at most 2^kMaxEjectionShift times.
+constexpr uint32_t kMaxEjectionShift = 16;
+
+}  // namespace
+
+CircuitBreaker::CircuitBreaker(const CircuitBreakConfig& config) : config_(config), white_list_(kDefaultWhiteList) {
+  // At least one probe is needed to admit an endpoint again.
+  config_.half_open_probes = std::max<uint32_t>(config_.half_open_probes, 1);
+}
+
+CircuitBreaker::EndpointState* CircuitBreaker::CalleeState::Find(std::string_view host, int port) {
+  auto range = index.equal_range(host);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (endpoints[it->second]->endpoint.port == port) {
+      return endpoints[it->second].get();
+    }
+  }
+  return nullptr;
+}
+
+void CircuitBreaker::SetWhiteList(const std::vector<int>& framework_retcodes) {
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  white_list_ = framework_retcodes;
+}
+
+void CircuitBreaker::SetEndpoints(const std::string& callee, const std::vector<TrpcEndpointInfo>& endpoints) {
+  auto new_callee = std::make_unique<CalleeState>();
+  new_callee->endpoints.reserve(endpoints.size());
+  new_callee->index.reserve(endpoints.size());
+
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  auto& existing = callees_[callee];
+  uint64_t next_ejection_end_ms = UINT64_MAX;
+  for (const auto& endpoint : endpoints) {
+    auto state = std::make_unique<EndpointState>();
+    state->endpoint = endpoint;
+
+    if (EndpointState* old = existing ? existing->Find(endpoint.host, endpoint.port) : nullptr) {
+      State old_state = old->state.load(std::memory_order_relaxed);
+      state->state.store(old_state, std::memory_order_relaxed);
+      state->consecutive_failures.store(old->consecutive_failures.load(std::memory_order_relaxed),
+                                        std::memory_order_relaxed);
+      state->window_begin_ms.store(old->window_begin_ms.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      state->window_requests.store(old->window_requests.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      state->window_timeouts.store(old->window_timeouts.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      state->ejections = old->ejections;
+      state->ejection_end_ms.store(old->ejection_end_ms.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      state->probes.store(old->probes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      state->probe_successes.store(old->probe_successes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+      if (old_state != State::kClosed) {
+        ++new_callee->ejected;
+      }
+      if (old_state == State::kHalfOpen) {
+        new_callee->half_open.fetch_add(1, std::memory_order_relaxed);
+      } else if (old_state == State::kOpen) {
+        next_ejection_end_ms = std::min(next_ejection_end_ms, state->ejection_end_ms.load(std::memory_order_relaxed));
+      }
+    }
+
+    new_callee->index.emplace(state->endpoint.host, new_callee->endpoints.size());
+    new_callee->endpoints.push_back(std::move(state));
+  }
+  new_callee->next_ejection_end_ms.store(next_ejection_end_ms, std::memory_order_relaxed);
+
+  existing = std::move(new_callee);
+}
+
+bool CircuitBreaker::GetAvailableEndpoints(const std::string& callee, std::vector<TrpcEndpointInfo>* endpoints) {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  auto iter = callees_.find(callee);
+  if (iter == callees_.end()) {
+    return false;
+  }
+
+  endpoints->clear();
+  endpoints->reserve(iter->second->endpoints.size());
+  for (const auto& state : iter->second->endpoints) {
+    if (state->state.load(std::memory_order_acquire) == State::kClosed) {
+      endpoints->push_back(state->endpoint);
+    }
+  }
+
+  if (endpoints->empty()) {
+    for (const auto& state : iter->second->endpoints) {
+      endpoints->push_back(state->endpoint);
+    }
+  }
+  return true;
+}
+
+void CircuitBreaker::FilterEndpoints(const std::string& callee, std::vector<TrpcEndpointInfo>* endpoints) {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  auto iter = callees_.find(callee);
+  if (iter == callees_.end() || iter->second->ejected.load(std::memory_order_relaxed) == 0) {
+    return;
+  }
+
+  auto& callee_state = *iter->second;
+  endpoints->erase(std::remove_if(endpoints->begin(), endpoints->end(),
+                                  [&callee_state](const TrpcEndpointInfo& endpoint) {
+                                    EndpointState* state = callee_state.Find(endpoint.host, endpoint.port);
+                                    return state && state->state.load(std::memory_order_acquire) != State::kClosed;
+                                  }),
+                   endpoints->end());
+}
+
+bool CircuitBreaker::SelectProbe(const std::string& callee, TrpcEndpointInfo* endpoint) {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  auto iter = callees_.find(callee);
+  if (iter == callees_.end()) {
+    return false;
+  }
+
+  auto& callee_state = *iter->second;
+  uint64_t now_ms = trpc::time::GetMilliSeconds();
+  if (now_ms >= callee_state.next_ejection_end_ms.load(std::memory_order_relaxed)) {
+    HalfOpenExpired(callee_state, now_ms);
+  }
+
+  if (callee_state.half_open.load(std::memory_order_relaxed) == 0) {
+    return false;
+  }
+
+  for (const auto& state : callee_state.endpoints) {
+    if (state->state.load(std::memory_order_acquire) != State::kHalfOpen) {
+      continue;
+    }
+    uint32_t probes = state->probes.load(std::memory_order_relaxed);
+    while (probes < config_.half_open_probes) {
+      if (state->probes.compare_exchange_weak(probes, probes + 1, std::memory_order_relaxed)) {
+        *endpoint = state->endpoint;
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+bool CircuitBreaker::ReportInvokeResult(const InvokeResult* result) {
+  if (result == nullptr || !result->context) {
+    return false;
+  }
+
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  auto iter = callees_.find(result->name);
+  if (iter == callees_.end()) {
+    return false;
+  }
+
+  auto& callee_state = *iter->second;
+  EndpointState* state = callee_state.Find(result->context->GetIp(), result->context->GetPort());
+  if (state == nullptr) {
+    return false;
+  }
+
+  State current = state->state.load(std::memory_order_acquire);
+  if (!IsInvokeRequestSent(*result)) {
+    // A probe not sent is given back.
+    uint32_t probes = state->probes.load(std::memory_order_relaxed);
+    while (current == State::kHalfOpen && probes > 0 &&
+           !state->probes.compare_exchange_weak(probes, probes - 1, std::memory_order_relaxed)) {
+    }
+    return false;
+  }
+
+  uint64_t now_ms = trpc::time::GetMilliSeconds();
+  bool failure = IsFailure(result->framework_result);
+  switch (current) {
+    case State::kClosed:
+      if (CountClosedResult(*state, failure, result->framework_result == TrpcRetCode::TRPC_CLIENT_INVOKE_TIMEOUT_ERR,
+                            now_ms)) {
+        return Eject(callee_state, *state, now_ms);
+      }
+      return false;
+    case State::kHalfOpen:
+      if (failure) {
+        Eject(callee_state, *state, now_ms);
+        return false;
+      }
+      if (state->probe_successes.fetch_add(1, std::memory_order_relaxed) + 1 >= config_.half_open_probes) {
+        Close(callee_state, *state);
+        return true;
+      }
+      return false;
+    default:
+      // Responses of the requests sent before the ejection.
+      return false;
+  }
+}
+
+bool CircuitBreaker::IsFailure(int framework_result) {
+  return framework_result != TrpcRetCode::TRPC_INVOKE_SUCCESS &&
+         std::find(white_list_.begin(), white_list_.end(), framework_result) == white_list_.end();
+}
+
+bool CircuitBreaker::CountClosedResult(EndpointState& state, bool failure, bool timeout, uint64_t now_ms) {
+  if (!failure) {
+    state.consecutive_failures.store(0, std::memory_order_relaxed);
+  } else if (state.consecutive_failures.fetch_add(1, std::memory_order_relaxed) + 1 >= config_.consecutive_failures &&
+             config_.consecutive_failures != 0) {
+    return true;
+  }
+
+  if (config_.timeout_rate <= 0 || config_.stat_window_ms == 0) {
+    return false;
+  }
+
+  uint64_t window_begin_ms = state.window_begin_ms.load(std::memory_order_relaxed);
+  if (now_ms >= window_begin_ms + config_.stat_window_ms &&
+      state.window_begin_ms.compare_exchange_strong(window_begin_ms, now_ms, std::memory_order_relaxed)) {
+    state.window_requests.store(0, std::memory_order_relaxed);
+    state.window_timeouts.store(0, std::memory_order_relaxed);
+  }
+
+  uint32_t requests = state.window_requests.fetch_add(1, std::memory_order_relaxed) + 1;
+  uint32_t timeouts = timeout ? state.window_timeouts.fetch_add(1, std::memory_order_relaxed) + 1
+                              : state.window_timeouts.load(std::memory_order_relaxed);
+  return requests >= std::max<uint32_t>(config_.min_requests, 1) && timeouts >= config_.timeout_rate * requests;
+}
+
+bool CircuitBreaker::Eject(CalleeState& callee, EndpointState& state, uint64_t now_ms) {
+  std::scoped_lock lock(callee.mutex);
+  State current = state.state.load(std::memory_order_relaxed);
+  if (current == State::kOpen) {
+    return false;
+  }
+
+  state.consecutive_failures.store(0, std::memory_order_relaxed);
+  state.window_begin_ms.store(0, std::memory_order_relaxed);
+  state.window_requests.store(0, std::memory_order_relaxed);
+  state.window_timeouts.store(0, std::memory_order_relaxed);
+
+  if (current == State::kClosed) {
+    // Always keeps part of the endpoints, the failures may be caused by the caller itself, e.g. its network.
+    std::size_t size = callee.endpoints.size();
+    std::size_t max_ejected = size < 2 ? 0 : std::max<std::size_t>(1, size * config_.max_ejection_percent / 100);
+    if (callee.ejected.load(std::memory_order_relaxed) >= max_ejected) {
+      return false;
+    }
+    ++callee.ejected;
+  } else {
+    callee.half_open.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  uint64_t ejection_ms = std::min<uint64_t>(static_cast<uint64_t>(config_.ejection_ms)
+                                                << std::min(state.ejections, kMaxEjectionShift),
+                                            config_.max_ejection_ms);
+  ++state.ejections;
+  state.ejection_end_ms.store(now_ms + ejection_ms, std::memory_order_relaxed);
+  if (now_ms + ejection_ms < callee.next_ejection_end_ms.load(std::memory_order_relaxed)) {
+    callee.next_ejection_end_ms.store(now_ms + ejection_ms, std::memory_order_relaxed);
+  }
+  state.state.store(State::kOpen, std::memory_order_release);
+  return current == State::kClosed;
+}
+
+void CircuitBreaker::Close(CalleeState& callee, EndpointState& state) {
+  std::scoped_lock lock(callee.mutex);
+  if (state.state.load(std::memory_order_relaxed) != State::kHalfOpen) {
+    return;
+  }
+
+  --callee.ejected;
+  callee.half_open.fetch_sub(1, std::memory_order_relaxed);
+  state.ejections = 0;
+  state.state.store(State::kClosed, std::memory_order_release);
+}
+
+void CircuitBreaker::HalfOpenExpired(CalleeState& callee, uint64_t now_ms) {
+  std::scoped_lock lock(callee.mutex);
+  if (now_ms < callee.next_ejection_end_ms.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  uint64_t next_ejection_end_ms = UINT64_MAX;
+  for (const auto& state : callee.endpoints) {
+    if (state->state.load(std::memory_order_relaxed) != State::kOpen) {
+      continue;
+    }
+
+    uint64_t ejection_end_ms = state->ejection_end_ms.load(std::memory_order_relaxed);
+    if (ejection_end_ms > now_ms) {
+      next_ejection_end_ms = std::min(next_ejection_end_ms, ejection_end_ms);
+      continue;
+    }
+
+    state->probes.store(0, std::memory_order_relaxed);
+    state->probe_successes.store(0, std::memory_order_relaxed);
+    callee.half_open.fetch_add(1, std::memory_order_relaxed);
+    state->state.store(State::kHalfOpen, std::memory_order_release);
+  }
+  callee.next_ejection_end_ms.store(next_ejection_end_ms, std::memory_order_relaxed);
+}
+
+}  // namespace trpc::naming
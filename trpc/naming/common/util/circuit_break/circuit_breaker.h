@@ -0,0 +1,118 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "trpc/common/config/circuit_break_conf.h"
+#include "trpc/naming/common/common_defs.h"
+
+namespace trpc::naming {
+
+/// @brief Circuit breaker of the endpoints of the callees, for the selectors working without a naming service.
+///
+/// An endpoint is ejected (open) after consecutive failures or a high timeout rate in a time window. When its ejection
+/// time expires it becomes half-open: a few probes are sent to it, it is admitted again (closed) if all of them
+/// succeed, and ejected again for twice as long otherwise.
+///
+/// The selector keeps the load balancer updated with `GetAvailableEndpoints`, i.e. the closed endpoints, whenever
+/// `SetEndpoints` is called or `ReportInvokeResult` returns true. The probes are selected by `SelectProbe` before the
+/// load balancer is asked.
+class CircuitBreaker {
+ public:
+  explicit CircuitBreaker(const CircuitBreakConfig& config);
+
+  /// @brief Sets the framework error codes not counted as failures, replacing the default ones.
+  void SetWhiteList(const std::vector<int>& framework_retcodes);
+
+  /// @brief Sets the endpoints of the callee, the states of the endpoints kept are preserved.
+  void SetEndpoints(const std::string& callee, const std::vector<TrpcEndpointInfo>& endpoints);
+
+  /// @brief Gets the endpoints of the callee which are not ejected, or all of them if every endpoint is ejected.
+  /// @return false if the callee is unknown.
+  bool GetAvailableEndpoints(const std::string& callee, std::vector<TrpcEndpointInfo>* endpoints);
+
+  /// @brief Removes the ejected endpoints from `endpoints`, e.g. the result of a batch selection.
+  void FilterEndpoints(const std::string& callee, std::vector<TrpcEndpointInfo>* endpoints);
+
+  /// @brief Selects a half-open endpoint of the callee to be probed, if there is one with probes left.
+  /// @return true if `endpoint` is the one to be probed.
+  bool SelectProbe(const std::string& callee, TrpcEndpointInfo* endpoint);
+
+  /// @brief Counts the result of an invocation.
+  /// @return true if the available endpoints of the callee have changed.
+  bool ReportInvokeResult(const InvokeResult* result);
+
+ private:
+  enum class State : uint8_t { kClosed, kOpen, kHalfOpen };
+
+  struct EndpointState {
+    TrpcEndpointInfo endpoint;
+    std::atomic<State> state{State::kClosed};
+    std::atomic<uint32_t> consecutive_failures{0};
+    // Counters of the current time window, reset by the first report after the window ends.
+    std::atomic<uint64_t> window_begin_ms{0};
+    std::atomic<uint32_t> window_requests{0};
+    std::atomic<uint32_t> window_timeouts{0};
+    // Number of ejections in a row and the time the current one ends.
+    uint32_t ejections{0};
+    std::atomic<uint64_t> ejection_end_ms{0};
+    // Probes sent and succeeded while half-open.
+    std::atomic<uint32_t> probes{0};
+    std::atomic<uint32_t> probe_successes{0};
+  };
+
+  struct CalleeState {
+    std::vector<std::unique_ptr<EndpointState>> endpoints;
+    // Host of the endpoint -> index of the endpoint, the keys refer to the hosts in `endpoints`.
+    std::unordered_multimap<std::string_view, std::size_t> index;
+    // Earliest end of the current ejections, and the number of the ejected and half-open endpoints.
+    std::atomic<uint64_t> next_ejection_end_ms{UINT64_MAX};
+    std::atomic<uint32_t> half_open{0};
+    std::atomic<uint32_t> ejected{0};
+    // Serializes the state changes of the endpoints.
+    std::mutex mutex;
+
+    EndpointState* Find(std::string_view host, int port);
+  };
+
+  bool IsFailure(int framework_result);
+
+  // Counts the result of a closed endpoint, returns true if the endpoint should be ejected.
+  bool CountClosedResult(EndpointState& state, bool failure, bool timeout, uint64_t now_ms);
+
+  // Returns true if the endpoint is ejected, it may be refused as too many endpoints are ejected.
+  bool Eject(CalleeState& callee, EndpointState& state, uint64_t now_ms);
+
+  void Close(CalleeState& callee, EndpointState& state);
+
+  // Moves the endpoints whose ejection time ends to half-open.
+  void HalfOpenExpired(CalleeState& callee, uint64_t now_ms);
+
+ private:
+  CircuitBreakConfig config_;
+  std::vector<int> white_list_;
+  std::unordered_map<std::string, std::unique_ptr<CalleeState>> callees_;
+  std::shared_mutex mutex_;
+};
+
+}  // namespace trpc::naming
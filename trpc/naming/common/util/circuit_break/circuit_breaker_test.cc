@@ -0,0 +1,178 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/naming/common/util/circuit_break/circuit_breaker.h"
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "trpc/client/client_context.h"
+
+namespace trpc::naming::testing {
+
+namespace {
+
+constexpr char kCallee[] = "test_service";
+
+std::vector<TrpcEndpointInfo> MakeEndpoints(const std::vector<int>& ports) {
+  std::vector<TrpcEndpointInfo> endpoints;
+  for (int port : ports) {
+    TrpcEndpointInfo endpoint;
+    endpoint.host = "127.0.0.1";
+    endpoint.port = port;
+    endpoints.push_back(endpoint);
+  }
+  return endpoints;
+}
+
+bool Report(CircuitBreaker& breaker, int port, int framework_result) {
+  auto context = MakeRefCounted<ClientContext>();
+  context->SetAddr("127.0.0.1", port);
+
+  InvokeResult result;
+  result.name = kCallee;
+  result.framework_result = framework_result;
+  result.interface_result = 0;
+  result.cost_time = 0;
+  result.context = context;
+  return breaker.ReportInvokeResult(&result);
+}
+
+std::vector<int> AvailablePorts(CircuitBreaker& breaker) {
+  std::vector<TrpcEndpointInfo> endpoints;
+  EXPECT_TRUE(breaker.GetAvailableEndpoints(kCallee, &endpoints));
+  std::vector<int> ports;
+  for (const auto& endpoint : endpoints) {
+    ports.push_back(endpoint.port);
+  }
+  return ports;
+}
+
+CircuitBreakConfig MakeConfig() {
+  CircuitBreakConfig config;
+  config.enable = true;
+  config.consecutive_failures = 3;
+  config.timeout_rate = 0;
+  config.ejection_ms = 50;
+  config.half_open_probes = 2;
+  return config;
+}
+
+}  // namespace
+
+TEST(CircuitBreakerTest, EjectAndReadmit) {
+  CircuitBreaker breaker(MakeConfig());
+  breaker.SetEndpoints(kCallee, MakeEndpoints({10000, 20000, 30000}));
+
+  ASSERT_FALSE(Report(breaker, 10000, TrpcRetCode::TRPC_CLIENT_CONNECT_ERR));
+  ASSERT_FALSE(Report(breaker, 10000, TrpcRetCode::TRPC_CLIENT_CONNECT_ERR));
+  ASSERT_TRUE(Report(breaker, 10000, TrpcRetCode::TRPC_CLIENT_CONNECT_ERR));
+  ASSERT_EQ(AvailablePorts(breaker), std::vector<int>({20000, 30000}));
+
+  std::vector<TrpcEndpointInfo> batch = MakeEndpoints({10000, 20000});
+  breaker.FilterEndpoints(kCallee, &batch);
+  ASSERT_EQ(batch.size(), 1);
+  ASSERT_EQ(batch[0].port, 20000);
+
+  TrpcEndpointInfo probe;
+  ASSERT_FALSE(breaker.SelectProbe(kCallee, &probe));
+  std::this_thread::sleep_for(std::chrono::milliseconds(60));
+
+  // Half-open: two probes only.
+  ASSERT_TRUE(breaker.SelectProbe(kCallee, &probe));
+  ASSERT_EQ(probe.port, 10000);
+  ASSERT_TRUE(breaker.SelectProbe(kCallee, &probe));
+  ASSERT_FALSE(breaker.SelectProbe(kCallee, &probe));
+
+  // All the probes succeed.
+  ASSERT_FALSE(Report(breaker, 10000, TrpcRetCode::TRPC_INVOKE_SUCCESS));
+  ASSERT_TRUE(Report(breaker, 10000, TrpcRetCode::TRPC_INVOKE_SUCCESS));
+  ASSERT_EQ(AvailablePorts(breaker), std::vector<int>({10000, 20000, 30000}));
+  ASSERT_FALSE(breaker.SelectProbe(kCallee, &probe));
+}
+
+TEST(CircuitBreakerTest, ProbeFailure) {
+  CircuitBreaker breaker(MakeConfig());
+  breaker.SetEndpoints(kCallee, MakeEndpoints({10000, 20000}));
+
+  for (int i = 0; i < 3; ++i) {
+    Report(breaker, 10000, TrpcRetCode::TRPC_CLIENT_INVOKE_TIMEOUT_ERR);
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(60));
+
+  TrpcEndpointInfo probe;
+  ASSERT_TRUE(breaker.SelectProbe(kCallee, &probe));
+  ASSERT_FALSE(Report(breaker, 10000, TrpcRetCode::TRPC_CLIENT_INVOKE_TIMEOUT_ERR));
+  ASSERT_EQ(AvailablePorts(breaker), std::vector<int>({20000}));
+
+  // Ejected twice as long.
+  std::this_thread::sleep_for(std::chrono::milliseconds(60));
+  ASSERT_FALSE(breaker.SelectProbe(kCallee, &probe));
+  std::this_thread::sleep_for(std::chrono::milliseconds(60));
+  ASSERT_TRUE(breaker.SelectProbe(kCallee, &probe));
+}
+
+TEST(CircuitBreakerTest, TimeoutRate) {
+  CircuitBreakConfig config = MakeConfig();
+  config.consecutive_failures = 0;
+  config.timeout_rate = 0.5;
+  config.min_requests = 10;
+  CircuitBreaker breaker(config);
+  breaker.SetEndpoints(kCallee, MakeEndpoints({10000, 20000}));
+
+  for (int i = 0; i < 9; ++i) {
+    ASSERT_FALSE(
+        Report(breaker, 10000, i % 2 ? TrpcRetCode::TRPC_INVOKE_SUCCESS : TrpcRetCode::TRPC_CLIENT_INVOKE_TIMEOUT_ERR));
+  }
+  ASSERT_TRUE(Report(breaker, 10000, TrpcRetCode::TRPC_CLIENT_INVOKE_TIMEOUT_ERR));
+  ASSERT_EQ(AvailablePorts(breaker), std::vector<int>({20000}));
+}
+
+TEST(CircuitBreakerTest, NotCounted) {
+  CircuitBreaker breaker(MakeConfig());
+  breaker.SetEndpoints(kCallee, MakeEndpoints({10000, 20000}));
+
+  // Caller side errors, requests not sent and business errors are not failures of the endpoint.
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_FALSE(Report(breaker, 10000, TrpcRetCode::TRPC_CLIENT_FULL_LINK_TIMEOUT_ERR));
+    ASSERT_FALSE(Report(breaker, 10000, TrpcRetCode::TRPC_CLIENT_LIMITED_ERR));
+  }
+  ASSERT_EQ(AvailablePorts(breaker).size(), 2);
+
+  breaker.SetWhiteList({TrpcRetCode::TRPC_CLIENT_CONNECT_ERR});
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_FALSE(Report(breaker, 10000, TrpcRetCode::TRPC_CLIENT_CONNECT_ERR));
+  }
+  ASSERT_EQ(AvailablePorts(breaker).size(), 2);
+}
+
+TEST(CircuitBreakerTest, MaxEjectionPercent) {
+  CircuitBreaker breaker(MakeConfig());
+  breaker.SetEndpoints(kCallee, MakeEndpoints({10000, 20000}));
+
+  for (int i = 0; i < 3; ++i) {
+    Report(breaker, 10000, TrpcRetCode::TRPC_CLIENT_NETWORK_ERR);
+    Report(breaker, 20000, TrpcRetCode::TRPC_CLIENT_NETWORK_ERR);
+  }
+  ASSERT_EQ(AvailablePorts(breaker), std::vector<int>({20000}));
+
+  // The states of the endpoints kept survive the update.
+  breaker.SetEndpoints(kCallee, MakeEndpoints({10000, 20000, 30000}));
+  ASSERT_EQ(AvailablePorts(breaker), std::vector<int>({20000, 30000}));
+}
+
+}  // namespace trpc::naming::testing
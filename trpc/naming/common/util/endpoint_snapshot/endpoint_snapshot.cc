@@ -0,0 +1,100 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/naming/common/util/endpoint_snapshot/endpoint_snapshot.h"
+
+#include <mutex>
+#include <utility>
+
+namespace trpc::naming {
+
+EndpointSnapshotSlot::~EndpointSnapshotSlot() {
+  // No reader is left once the load balancer owning the slot is destroyed.
+  delete snapshot_.load(std::memory_order_acquire);
+}
+
+void EndpointSnapshotSlot::Publish(std::unique_ptr<EndpointSnapshot> snapshot) {
+  EndpointSnapshot* old = snapshot_.exchange(snapshot.release(), std::memory_order_acq_rel);
+  if (old) {
+    old->Retire();
+  }
+}
+
+const TrpcEndpointInfo* EndpointSnapshotSlot::Next(const EndpointSnapshot& snapshot) {
+  if (snapshot.endpoints.empty()) {
+    return nullptr;
+  }
+
+  uint64_t index = index_.fetch_add(1, std::memory_order_relaxed);
+  if (snapshot.sequence.empty()) {
+    return &snapshot.endpoints[index % snapshot.endpoints.size()];
+  }
+  return &snapshot.endpoints[snapshot.sequence[index % snapshot.sequence.size()]];
+}
+
+EndpointSnapshotTable::~EndpointSnapshotTable() { delete index_.load(std::memory_order_acquire); }
+
+EndpointSnapshotSlot* EndpointSnapshotTable::GetOrCreate(const std::string& callee) {
+  if (EndpointSnapshotSlot* slot = Find(callee)) {
+    return slot;
+  }
+
+  std::scoped_lock lock(mutex_);
+  // Checks again in case the callee was added by another thread meanwhile.
+  Index* index = index_.load(std::memory_order_acquire);
+  if (index) {
+    if (auto iter = index->slots.find(callee); iter != index->slots.end()) {
+      return iter->second;
+    }
+  }
+
+  auto new_index = std::make_unique<Index>();
+  if (index) {
+    new_index->slots = index->slots;
+  }
+  EndpointSnapshotSlot* slot = slots_.emplace_back(std::make_unique<EndpointSnapshotSlot>()).get();
+  new_index->slots.emplace(callee, slot);
+
+  index_.store(new_index.release(), std::memory_order_release);
+  if (index) {
+    index->Retire();
+  }
+  return slot;
+}
+
+EndpointSnapshotSlot* EndpointSnapshotTable::Find(const std::string& callee) const {
+  Hazptr hazptr;
+  const Index* index = hazptr.Keep(&index_);
+  if (index == nullptr) {
+    return nullptr;
+  }
+
+  auto iter = index->slots.find(callee);
+  return iter != index->slots.end() ? iter->second : nullptr;
+}
+
+EndpointSnapshotSlot* EndpointSnapshotTable::Find(const std::string& callee, const LoadBalanceHandle* handle,
+                                                  const LoadBalance* owner) const {
+  if (handle && handle->load_balance.Get() == owner) {
+    return static_cast<EndpointSnapshotSlot*>(handle->callee);
+  }
+  return Find(callee);
+}
+
+void EndpointSnapshotTable::GetHandle(const std::string& callee, LoadBalance* owner, LoadBalanceHandle* handle) {
+  handle->name = callee;
+  handle->load_balance = LoadBalancePtr(ref_ptr, owner);
+  handle->callee = GetOrCreate(callee);
+}
+
+}  // namespace trpc::naming
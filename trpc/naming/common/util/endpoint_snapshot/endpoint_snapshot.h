@@ -0,0 +1,111 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "trpc/naming/common/common_defs.h"
+#include "trpc/naming/load_balance.h"
+#include "trpc/util/align.h"
+#include "trpc/util/hazptr/hazptr.h"
+#include "trpc/util/hazptr/hazptr_object.h"
+
+namespace trpc::naming {
+
+/// @brief Immutable endpoints of a callee, published as a whole by the updates of a load balancer. A load balancer may
+/// derive it to publish its own state of the endpoints along with them, e.g. a hash ring.
+struct EndpointSnapshot : public HazptrObject<EndpointSnapshot> {
+  std::vector<TrpcEndpointInfo> endpoints;
+
+  /// @brief Indexes of `endpoints` in the order of selection, repeated cyclically, e.g. the schedule of a weighted
+  /// round robin. The endpoints are selected in turn if empty.
+  std::vector<uint32_t> sequence;
+};
+
+/// @brief Endpoints of a callee published read-copy-update style: the readers load the current snapshot without any
+/// lock, the writers swap in a new snapshot and the old one is reclaimed once no reader keeps it.
+///
+/// A slot is never removed from its table, so its address is the handle of the callee cached by the callers.
+class alignas(hardware_destructive_interference_size) EndpointSnapshotSlot {
+ public:
+  EndpointSnapshotSlot() = default;
+
+  ~EndpointSnapshotSlot();
+
+  /// @brief Publishes the snapshot, replacing the current one.
+  void Publish(std::unique_ptr<EndpointSnapshot> snapshot);
+
+  /// @brief Gets the current snapshot, kept alive until `hazptr` keeps another one or is destroyed.
+  /// @return null if nothing has been published.
+  const EndpointSnapshot* Read(Hazptr* hazptr) { return hazptr->Keep(&snapshot_); }
+
+  /// @brief Selects the next endpoint in the order of the snapshot, see `EndpointSnapshot::sequence`.
+  /// @return null if the snapshot has no endpoints.
+  const TrpcEndpointInfo* Next(const EndpointSnapshot& snapshot);
+
+ private:
+  std::atomic<EndpointSnapshot*> snapshot_{nullptr};
+  std::atomic<uint64_t> index_{0};
+};
+
+/// @brief The endpoint snapshots of the callees of a load balancer.
+///
+/// The callees are looked up without any lock as well: the index of the slots is an immutable map replaced as a whole
+/// when a callee is added, which is rare.
+class EndpointSnapshotTable {
+ public:
+  EndpointSnapshotTable() = default;
+
+  ~EndpointSnapshotTable();
+
+  /// @brief Gets the slot of the callee, created if not exists.
+  EndpointSnapshotSlot* GetOrCreate(const std::string& callee);
+
+  /// @brief Gets the slot of the callee.
+  /// @return null if not exists.
+  EndpointSnapshotSlot* Find(const std::string& callee) const;
+
+  /// @brief Gets the slot of the callee, through `handle` if it's resolved by `owner`.
+  /// @return null if not exists.
+  EndpointSnapshotSlot* Find(const std::string& callee, const LoadBalanceHandle* handle,
+                             const LoadBalance* owner) const;
+
+  /// @brief Gets the slot of the callee of a selection, through the handle of `owner` if the selection has one.
+  /// @return null if not exists.
+  EndpointSnapshotSlot* Find(const SelectorInfo& info, const LoadBalance* owner) const {
+    return Find(info.name, info.load_balance_handle, owner);
+  }
+
+  /// @brief Resolves the handle of `owner` to the slot of the callee, the slot is created if not exists.
+  void GetHandle(const std::string& callee, LoadBalance* owner, LoadBalanceHandle* handle);
+
+ private:
+  struct Index : public HazptrObject<Index> {
+    std::unordered_map<std::string, EndpointSnapshotSlot*> slots;
+  };
+
+  // Keeping an index alive by hazptr changes nothing of the table.
+  mutable std::atomic<Index*> index_{nullptr};
+  // Owns the slots, and serializes the additions of the callees.
+  std::vector<std::unique_ptr<EndpointSnapshotSlot>> slots_;
+  std::mutex mutex_;
+};
+
+}  // namespace trpc::naming
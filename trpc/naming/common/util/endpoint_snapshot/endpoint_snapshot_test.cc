@@ -0,0 +1,169 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/naming/common/util/endpoint_snapshot/endpoint_snapshot.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace trpc::naming::testing {
+
+namespace {
+
+std::unique_ptr<EndpointSnapshot> MakeSnapshot(const std::vector<int>& ports, std::vector<uint32_t> sequence = {}) {
+  auto snapshot = std::make_unique<EndpointSnapshot>();
+  for (int port : ports) {
+    TrpcEndpointInfo endpoint;
+    endpoint.host = "127.0.0.1";
+    endpoint.port = port;
+    snapshot->endpoints.push_back(endpoint);
+  }
+  snapshot->sequence = std::move(sequence);
+  return snapshot;
+}
+
+class DummyLoadBalance : public LoadBalance {
+ public:
+  std::string Name() const override { return "dummy"; }
+  int Update(const LoadBalanceInfo* info) override { return 0; }
+  int Next(LoadBalanceResult& result) override { return 0; }
+};
+
+}  // namespace
+
+TEST(EndpointSnapshotTest, PublishAndNext) {
+  EndpointSnapshotSlot slot;
+  Hazptr hazptr;
+  ASSERT_EQ(slot.Read(&hazptr), nullptr);
+
+  slot.Publish(MakeSnapshot({}));
+  ASSERT_EQ(slot.Next(*slot.Read(&hazptr)), nullptr);
+
+  slot.Publish(MakeSnapshot({1, 2, 3}));
+  const EndpointSnapshot* snapshot = slot.Read(&hazptr);
+  std::vector<int> ports;
+  for (int i = 0; i < 6; ++i) {
+    ports.push_back(slot.Next(*snapshot)->port);
+  }
+  ASSERT_EQ(ports.size(), 6);
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_EQ(ports[i], ports[i + 3]);
+  }
+
+  slot.Publish(MakeSnapshot({1, 2}, {1, 1, 0}));
+  snapshot = slot.Read(&hazptr);
+  int count = 0;
+  for (int i = 0; i < 300; ++i) {
+    count += slot.Next(*snapshot)->port == 2;
+  }
+  ASSERT_EQ(count, 200);
+}
+
+TEST(EndpointSnapshotTest, Table) {
+  EndpointSnapshotTable table;
+  ASSERT_EQ(table.Find("callee"), nullptr);
+
+  EndpointSnapshotSlot* slot = table.GetOrCreate("callee");
+  ASSERT_EQ(table.GetOrCreate("callee"), slot);
+  ASSERT_EQ(table.Find("callee"), slot);
+
+  DummyLoadBalance load_balance, other;
+  LoadBalanceHandle handle;
+  table.GetHandle("other_callee", &load_balance, &handle);
+  ASSERT_EQ(handle.name, "other_callee");
+  ASSERT_EQ(handle.load_balance.Get(), &load_balance);
+  ASSERT_EQ(handle.callee, table.Find("other_callee"));
+  // The load balancer is referenced by the handle.
+  ASSERT_EQ(load_balance.UnsafeRefCount(), 2);
+
+  // The handle is used by the load balancer which resolved it only.
+  SelectorInfo info;
+  info.name = "callee";
+  info.load_balance_handle = &handle;
+  ASSERT_EQ(table.Find(info, &load_balance), handle.callee);
+  ASSERT_EQ(table.Find(info, &other), slot);
+  info.load_balance_handle = nullptr;
+  ASSERT_EQ(table.Find(info, &load_balance), slot);
+}
+
+TEST(EndpointSnapshotTest, ConcurrentFindAndAdd) {
+  EndpointSnapshotTable table;
+  EndpointSnapshotSlot* first = table.GetOrCreate("callee_0");
+
+  std::atomic<bool> stopped{false};
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([&]() {
+      while (!stopped.load(std::memory_order_relaxed)) {
+        ASSERT_EQ(table.Find("callee_0"), first);
+      }
+    });
+  }
+
+  // The writers add the same callees concurrently.
+  std::vector<EndpointSnapshotSlot*> slots[2];
+  std::vector<std::thread> writers;
+  for (int i = 0; i < 2; ++i) {
+    writers.emplace_back([&, i]() {
+      for (int j = 1; j < 500; ++j) {
+        slots[i].push_back(table.GetOrCreate("callee_" + std::to_string(j)));
+      }
+    });
+  }
+  for (auto& writer : writers) {
+    writer.join();
+  }
+  stopped = true;
+  for (auto& reader : readers) {
+    reader.join();
+  }
+
+  ASSERT_EQ(slots[0], slots[1]);
+  for (int j = 1; j < 500; ++j) {
+    ASSERT_EQ(table.Find("callee_" + std::to_string(j)), slots[0][j - 1]);
+  }
+}
+
+TEST(EndpointSnapshotTest, ConcurrentReadAndPublish) {
+  EndpointSnapshotSlot slot;
+  slot.Publish(MakeSnapshot({1}));
+
+  std::atomic<bool> stopped{false};
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([&]() {
+      while (!stopped.load(std::memory_order_relaxed)) {
+        Hazptr hazptr;
+        const EndpointSnapshot* snapshot = slot.Read(&hazptr);
+        const TrpcEndpointInfo* endpoint = slot.Next(*snapshot);
+        ASSERT_EQ(endpoint->host, "127.0.0.1");
+        ASSERT_EQ(static_cast<std::size_t>(endpoint->port), snapshot->endpoints.size());
+      }
+    });
+  }
+
+  for (int i = 2; i < 2000; ++i) {
+    slot.Publish(MakeSnapshot(std::vector<int>(i % 16 + 1, i % 16 + 1)));
+  }
+  stopped = true;
+  for (auto& reader : readers) {
+    reader.join();
+  }
+}
+
+}  // namespace trpc::naming::testing
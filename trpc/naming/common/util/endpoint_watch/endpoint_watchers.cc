@@ -0,0 +1,77 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/naming/common/util/endpoint_watch/endpoint_watchers.h"
+
+#include <unordered_set>
+#include <utility>
+
+namespace trpc::naming {
+
+namespace {
+
+std::string EndpointKey(const TrpcEndpointInfo& endpoint) {
+  return endpoint.host + ":" + std::to_string(endpoint.port);
+}
+
+}  // namespace
+
+uint64_t EndpointWatchers::Watch(const std::string& name, Selector::EndpointsAddedFunction&& func,
+                                 const std::vector<TrpcEndpointInfo>& endpoints) {
+  std::scoped_lock lock(mutex_);
+  if (!endpoints.empty()) {
+    func(endpoints);
+  }
+
+  uint64_t watch_id = next_watch_id_++;
+  watches_[watch_id] = WatchInfo{name, std::move(func)};
+  return watch_id;
+}
+
+void EndpointWatchers::Unwatch(uint64_t watch_id) {
+  std::scoped_lock lock(mutex_);
+  watches_.erase(watch_id);
+}
+
+void EndpointWatchers::Notify(const std::string& name, const std::vector<TrpcEndpointInfo>* old_endpoints,
+                              const std::vector<TrpcEndpointInfo>& endpoints) {
+  std::scoped_lock lock(mutex_);
+  if (watches_.empty()) {
+    return;
+  }
+
+  std::unordered_set<std::string> old_keys;
+  if (old_endpoints) {
+    for (const auto& endpoint : *old_endpoints) {
+      old_keys.insert(EndpointKey(endpoint));
+    }
+  }
+
+  std::vector<TrpcEndpointInfo> added;
+  for (const auto& endpoint : endpoints) {
+    if (old_keys.count(EndpointKey(endpoint)) == 0) {
+      added.push_back(endpoint);
+    }
+  }
+  if (added.empty()) {
+    return;
+  }
+
+  for (auto& [watch_id, watch] : watches_) {
+    if (watch.name == name) {
+      watch.func(added);
+    }
+  }
+}
+
+}  // namespace trpc::naming
@@ -0,0 +1,55 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "trpc/naming/common/common_defs.h"
+#include "trpc/naming/selector.h"
+
+namespace trpc::naming {
+
+/// @brief The watches of the endpoints added to the services of a selector, see `Selector::WatchEndpoints`.
+class EndpointWatchers {
+ public:
+  /// @brief Adds a watch of the service, `endpoints` are the current ones reported at once.
+  /// @return The id of the watch.
+  uint64_t Watch(const std::string& name, Selector::EndpointsAddedFunction&& func,
+                 const std::vector<TrpcEndpointInfo>& endpoints);
+
+  /// @brief Cancels a watch.
+  void Unwatch(uint64_t watch_id);
+
+  /// @brief Reports the endpoints of the service not in its previous endpoints to the watches.
+  /// @param old_endpoints The previous endpoints, null if the service is new.
+  void Notify(const std::string& name, const std::vector<TrpcEndpointInfo>* old_endpoints,
+              const std::vector<TrpcEndpointInfo>& endpoints);
+
+ private:
+  struct WatchInfo {
+    std::string name;
+    Selector::EndpointsAddedFunction func;
+  };
+
+  // The callbacks are called with the lock held, so none is running once the watch is cancelled.
+  std::mutex mutex_;
+  std::unordered_map<uint64_t, WatchInfo> watches_;
+  uint64_t next_watch_id_{1};
+};
+
+}  // namespace trpc::naming
@@ -0,0 +1,80 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/naming/common/util/endpoint_watch/endpoint_watchers.h"
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace trpc::naming::testing {
+
+namespace {
+
+std::vector<TrpcEndpointInfo> MakeEndpoints(const std::vector<int>& ports) {
+  std::vector<TrpcEndpointInfo> endpoints;
+  for (int port : ports) {
+    TrpcEndpointInfo endpoint;
+    endpoint.host = "127.0.0.1";
+    endpoint.port = port;
+    endpoints.push_back(endpoint);
+  }
+  return endpoints;
+}
+
+std::vector<int> Ports(const std::vector<TrpcEndpointInfo>& endpoints) {
+  std::vector<int> ports;
+  for (const auto& endpoint : endpoints) {
+    ports.push_back(endpoint.port);
+  }
+  return ports;
+}
+
+}  // namespace
+
+TEST(EndpointWatchersTest, NotifyAdded) {
+  EndpointWatchers watchers;
+  std::vector<std::vector<int>> reported;
+  auto old_endpoints = MakeEndpoints({1, 2});
+  uint64_t watch_id = watchers.Watch(
+      "callee", [&](const std::vector<TrpcEndpointInfo>& endpoints) { reported.push_back(Ports(endpoints)); },
+      old_endpoints);
+  ASSERT_NE(watch_id, 0);
+  ASSERT_EQ(reported, std::vector<std::vector<int>>({{1, 2}}));
+
+  // Only the endpoints added to the watched service are reported.
+  auto endpoints = MakeEndpoints({2, 3, 4});
+  watchers.Notify("callee", &old_endpoints, endpoints);
+  watchers.Notify("other_callee", nullptr, endpoints);
+  watchers.Notify("callee", &endpoints, MakeEndpoints({3}));
+  ASSERT_EQ(reported, std::vector<std::vector<int>>({{1, 2}, {3, 4}}));
+
+  watchers.Unwatch(watch_id);
+  watchers.Notify("callee", nullptr, endpoints);
+  ASSERT_EQ(reported.size(), 2);
+}
+
+TEST(EndpointWatchersTest, WatchWithoutEndpoints) {
+  EndpointWatchers watchers;
+  int reported = 0;
+  uint64_t watch_id1 = watchers.Watch("callee", [&](const std::vector<TrpcEndpointInfo>&) { ++reported; }, {});
+  uint64_t watch_id2 = watchers.Watch("callee", [&](const std::vector<TrpcEndpointInfo>&) { ++reported; }, {});
+  ASSERT_NE(watch_id1, watch_id2);
+  ASSERT_EQ(reported, 0);
+
+  watchers.Notify("callee", nullptr, MakeEndpoints({1}));
+  ASSERT_EQ(reported, 2);
+}
+
+}  // namespace trpc::naming::testing
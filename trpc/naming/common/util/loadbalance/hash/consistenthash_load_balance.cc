@@ -44,19 +44,15 @@ int ConsistentHashLoadBalance::Init() noexcept {
   return res ? 0 : -1;
 }
 
-bool ConsistentHashLoadBalance::IsLoadBalanceInfoDiff(const LoadBalanceInfo* info) {
-  if (nullptr == info || nullptr == info->info || nullptr == info->endpoints) {
-    return false;
-  }
-
-  const SelectorInfo* select_info = info->info;
-  std::shared_lock<std::shared_mutex> lock(mutex_);
-  auto iter = callee_router_infos_.find(select_info->name);
-  if (callee_router_infos_.end() == iter) {
+bool ConsistentHashLoadBalance::IsLoadBalanceInfoDiff(const LoadBalanceInfo* info,
+                                                      naming::EndpointSnapshotSlot* slot) {
+  Hazptr hazptr;
+  const naming::EndpointSnapshot* snapshot = slot->Read(&hazptr);
+  if (nullptr == snapshot) {
     return true;
   }
 
-  return CheckLoadbalanceInfoDiff(callee_router_infos_[select_info->name].endpoints, info->endpoints);
+  return CheckLoadbalanceInfoDiff(snapshot->endpoints, info->endpoints);
 }
 
 // Update the routing nodes used for load balancing
@@ -66,53 +62,25 @@ int ConsistentHashLoadBalance::Update(const LoadBalanceInfo* info) {
     return -1;
   }
 
-  const SelectorInfo* select_info = info->info;
-
-  if (IsLoadBalanceInfoDiff(info)) {
-    InnerEndpointInfos old_info;
-    {
-      std::unique_lock<std::shared_mutex> lock(mutex_);
-      if (callee_router_infos_.find(select_info->name) != callee_router_infos_.end()) {
-        old_info = callee_router_infos_[select_info->name];
-      }
-    }
-    InnerEndpointInfos endpoint_info;
-
-    endpoint_info.hashring = std::move(old_info.hashring);
-    endpoint_info.endpoints.assign(info->endpoints->begin(), info->endpoints->end());
-
-    std::unordered_set<std::string> old_set;
-    std::unordered_map<std::string, int> new_set;
-
-    for (uint32_t i = 0; i < info->endpoints->size(); i++) {
-      new_set[info->endpoints->at(i).host + std::to_string(info->endpoints->at(i).port)] = i;
-    }
-
-    for (const auto& endpoint : old_info.endpoints) {
-      old_set.insert(endpoint.host + std::to_string(endpoint.port));
-    }
-
-    for (const auto& elem : old_set) {
-      if (new_set.find(elem) == new_set.end()) {
-        for (uint32_t i = 0; i < loadbalance_config_.hash_nodes; i++) {
-          uint64_t key = Hash(elem + std::to_string(i), loadbalance_config_.hash_func);
-          endpoint_info.hashring.erase(key);
-        }
-      }
-    }
+  naming::EndpointSnapshotSlot* slot = callee_router_infos_.GetOrCreate(info->info->name);
+  std::scoped_lock lock(update_mutex_);
+  if (!IsLoadBalanceInfoDiff(info, slot)) {
+    return 0;
+  }
 
-    for (const auto& elem : new_set) {
-      if (old_set.find(elem.first) == old_set.end()) {
-        for (uint32_t i = 0; i < loadbalance_config_.hash_nodes; i++) {
-          uint64_t key = Hash(elem.first + std::to_string(i), loadbalance_config_.hash_func);
-          endpoint_info.hashring[key] = info->endpoints->at(elem.second);
-        }
-      }
+  // The ring is rebuilt as the indexes of the endpoints kept may change, the virtual nodes of an endpoint are the
+  // same as long as its address is.
+  auto snapshot = std::make_unique<HashRingSnapshot>();
+  snapshot->endpoints.assign(info->endpoints->begin(), info->endpoints->end());
+  for (std::uint32_t i = 0; i < snapshot->endpoints.size(); i++) {
+    const TrpcEndpointInfo& endpoint = snapshot->endpoints[i];
+    std::string address = endpoint.host + std::to_string(endpoint.port);
+    for (uint32_t j = 0; j < loadbalance_config_.hash_nodes; j++) {
+      uint64_t key = Hash(address + std::to_string(j), loadbalance_config_.hash_func);
+      snapshot->hashring[key] = i;
     }
-
-    std::unique_lock<std::shared_mutex> lock(mutex_);
-    callee_router_infos_[select_info->name] = endpoint_info;
   }
+  slot->Publish(std::move(snapshot));
 
   return 0;
 }
@@ -122,14 +90,14 @@ int ConsistentHashLoadBalance::Next(LoadBalanceResult& result) {
     return -1;
   }
 
-  std::shared_lock<std::shared_mutex> lock(mutex_);
-  auto iter = callee_router_infos_.find((result.info)->name);
-  if (iter == callee_router_infos_.end()) {
+  naming::EndpointSnapshotSlot* slot = callee_router_infos_.Find(*result.info, this);
+  auto* snapshot = slot ? static_cast<const HashRingSnapshot*>(slot->Read(&result.hazptr)) : nullptr;
+  if (nullptr == snapshot) {
     TRPC_LOG_ERROR("Router info of name " << (result.info)->name << " no found");
     return -1;
   }
 
-  std::map<std::uint64_t, TrpcEndpointInfo>& hashring = iter->second.hashring;
+  const std::map<std::uint64_t, std::uint32_t>& hashring = snapshot->hashring;
   size_t endpoints_num = hashring.size();
   if (endpoints_num < 1) {
     TRPC_LOG_ERROR("Router info of name is empty");
@@ -147,9 +115,14 @@ int ConsistentHashLoadBalance::Next(LoadBalanceResult& result) {
     info_iter = hashring.begin();
   }
 
-  result.result = info_iter->second;
+  result.endpoint = &snapshot->endpoints[info_iter->second];
 
   return 0;
 }
 
+bool ConsistentHashLoadBalance::GetHandle(const std::string& name, LoadBalanceHandle* handle) {
+  callee_router_infos_.GetHandle(name, this, handle);
+  return true;
+}
+
 }  // namespace trpc
@@ -13,16 +13,15 @@
 
 #pragma once
 
-#include <atomic>
+#include <cstdint>
+#include <map>
 #include <memory>
-#include <set>
-#include <shared_mutex>
+#include <mutex>
 #include <string>
-#include <unordered_map>
-#include <vector>
 
 #include "trpc/common/config/loadbalance_naming_conf.h"
 #include "trpc/common/config/loadbalance_naming_conf_parser.h"
+#include "trpc/naming/common/util/endpoint_snapshot/endpoint_snapshot.h"
 #include "trpc/naming/load_balance.h"
 
 namespace trpc {
@@ -44,24 +43,28 @@ class ConsistentHashLoadBalance : public LoadBalance {
   /// @brief Update the routing node information used by the load balancing
   int Update(const LoadBalanceInfo* info) override;
 
-  /// @brief Return a callee node
+  /// @brief Return a callee node, without any lock
   int Next(LoadBalanceResult& result) override;
 
- private:
-  /// @brief Check if the load balancing information is different
-
-  bool IsLoadBalanceInfoDiff(const LoadBalanceInfo* info);
+  /// @brief Get the handle of the endpoint snapshot of the callee
+  bool GetHandle(const std::string& name, LoadBalanceHandle* handle) override;
 
-  struct InnerEndpointInfos {
-    std::vector<TrpcEndpointInfo> endpoints;
-    std::map<std::uint64_t, TrpcEndpointInfo> hashring;
+ private:
+  // The endpoints published along with their hash ring.
+  struct HashRingSnapshot : public naming::EndpointSnapshot {
+    // Hash of a virtual node -> index of its endpoint in `endpoints`.
+    std::map<std::uint64_t, std::uint32_t> hashring;
   };
 
-  std::unordered_map<std::string, ConsistentHashLoadBalance::InnerEndpointInfos> callee_router_infos_;
+  /// @brief Check if the load balancing information is different from the published snapshot
+  bool IsLoadBalanceInfoDiff(const LoadBalanceInfo* info, naming::EndpointSnapshotSlot* slot);
+
+  naming::EndpointSnapshotTable callee_router_infos_;
 
   naming::LoadBalanceConfig loadbalance_config_;
 
-  std::shared_mutex mutex_;
+  // Serializes the updates of the snapshots.
+  std::mutex update_mutex_;
 };
 
 }  // namespace trpc
@@ -21,6 +21,7 @@
 #include <any>
 #include <iostream>
 #include <regex>
+#include <utility>
 #include <vector>
 
 #include "trpc/common/config/trpc_config.h"
@@ -41,18 +42,14 @@ int ModuloHashLoadBalance::Init() noexcept {
   return res ? 0 : -1;
 }
 
-bool ModuloHashLoadBalance::IsLoadBalanceInfoDiff(const LoadBalanceInfo* info) {
-  if (nullptr == info || nullptr == info->info || nullptr == info->endpoints) {
-    return false;
-  }
-
-  const SelectorInfo* select_info = info->info;
-  std::shared_lock<std::shared_mutex> lock(mutex_);
-  if (callee_router_infos_.end() == callee_router_infos_.find(select_info->name)) {
+bool ModuloHashLoadBalance::IsLoadBalanceInfoDiff(const LoadBalanceInfo* info, naming::EndpointSnapshotSlot* slot) {
+  Hazptr hazptr;
+  const naming::EndpointSnapshot* snapshot = slot->Read(&hazptr);
+  if (nullptr == snapshot) {
     return true;
   }
 
-  return CheckLoadbalanceInfoDiff(callee_router_infos_[select_info->name], info->endpoints);
+  return CheckLoadbalanceInfoDiff(snapshot->endpoints, info->endpoints);
 }
 
 // Update the routing nodes used for load balancing
@@ -62,14 +59,12 @@ int ModuloHashLoadBalance::Update(const LoadBalanceInfo* info) {
     return -1;
   }
 
-  const SelectorInfo* select_info = info->info;
-
-  if (IsLoadBalanceInfoDiff(info)) {
-    std::vector<TrpcEndpointInfo> endpoints;
-    endpoints.assign(info->endpoints->begin(), info->endpoints->end());
-
-    std::unique_lock<std::shared_mutex> lock(mutex_);
-    callee_router_infos_[select_info->name] = endpoints;
+  naming::EndpointSnapshotSlot* slot = callee_router_infos_.GetOrCreate(info->info->name);
+  std::scoped_lock lock(update_mutex_);
+  if (IsLoadBalanceInfoDiff(info, slot)) {
+    auto snapshot = std::make_unique<naming::EndpointSnapshot>();
+    snapshot->endpoints.assign(info->endpoints->begin(), info->endpoints->end());
+    slot->Publish(std::move(snapshot));
   }
 
   return 0;
@@ -80,14 +75,14 @@ int ModuloHashLoadBalance::Next(LoadBalanceResult& result) {
     return -1;
   }
 
-  std::shared_lock<std::shared_mutex> lock(mutex_);
-  auto iter = callee_router_infos_.find((result.info)->name);
-  if (iter == callee_router_infos_.end()) {
+  naming::EndpointSnapshotSlot* slot = callee_router_infos_.Find(*result.info, this);
+  const naming::EndpointSnapshot* snapshot = slot ? slot->Read(&result.hazptr) : nullptr;
+  if (nullptr == snapshot) {
     TRPC_LOG_ERROR("Router info of name " << (result.info)->name << " no found");
     return -1;
   }
 
-  std::vector<TrpcEndpointInfo>& endpoints = iter->second;
+  const std::vector<TrpcEndpointInfo>& endpoints = snapshot->endpoints;
   size_t endpoints_num = endpoints.size();
   if (endpoints_num < 1) {
     TRPC_LOG_ERROR("Router info of name is empty");
@@ -101,9 +96,14 @@ int ModuloHashLoadBalance::Next(LoadBalanceResult& result) {
     hash = Hash(GenerateKeysAsString(result.info, loadbalance_config_.hash_args), loadbalance_config_.hash_func,
                 endpoints_num);
   }
-  result.result = endpoints[hash];
+  result.endpoint = &endpoints[hash];
 
   return 0;
 }
 
+bool ModuloHashLoadBalance::GetHandle(const std::string& name, LoadBalanceHandle* handle) {
+  callee_router_infos_.GetHandle(name, this, handle);
+  return true;
+}
+
 }  // namespace trpc
\ No newline at end of file
@@ -0,0 +1,226 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/naming/common/util/loadbalance/p2c/p2c_peak_ewma_load_balance.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "trpc/util/algorithm/random.h"
+#include "trpc/util/log/logging.h"
+#include "trpc/util/time.h"
+
+namespace trpc {
+
+namespace {
+
+// Load of an endpoint having requests in flight but no latency observed yet, so new endpoints are not flooded before
+// their first responses.
+constexpr double kPenaltyLoad = 1e15;
+
+}  // namespace
+
+P2CPeakEwmaLoadBalance::P2CPeakEwmaLoadBalance(uint64_t decay_time_us)
+    : decay_time_us_(std::max<uint64_t>(decay_time_us, 1)) {}
+
+const P2CPeakEwmaLoadBalance::EndpointStatsPtr* P2CPeakEwmaLoadBalance::CalleeSnapshot::Find(std::string_view host,
+                                                                                               int port) const {
+  auto range = index.equal_range(host);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (endpoints[it->second].port == port) {
+      return &stats[it->second];
+    }
+  }
+  return nullptr;
+}
+
+int P2CPeakEwmaLoadBalance::Update(const LoadBalanceInfo* info) {
+  if (info == nullptr || info->info == nullptr || info->endpoints == nullptr) {
+    TRPC_LOG_ERROR("Endpoint info of name is empty");
+    return -1;
+  }
+
+  naming::EndpointSnapshotSlot* slot = callee_endpoints_.GetOrCreate(info->info->name);
+  std::scoped_lock lock(update_mutex_);
+  Hazptr hazptr;
+  auto* existing = static_cast<const CalleeSnapshot*>(slot->Read(&hazptr));
+  if (!IsEndpointsDiff(existing, *info->endpoints)) {
+    return 0;
+  }
+
+  auto callee = std::make_unique<CalleeSnapshot>();
+  callee->endpoints = *info->endpoints;
+  callee->stats.reserve(callee->endpoints.size());
+  callee->index.reserve(callee->endpoints.size());
+  for (std::size_t i = 0; i != callee->endpoints.size(); ++i) {
+    const auto& endpoint = callee->endpoints[i];
+    callee->index.emplace(endpoint.host, i);
+
+    // The endpoints kept keep their statistics, including the requests in flight which will be released later.
+    const EndpointStatsPtr* stats = existing ? existing->Find(endpoint.host, endpoint.port) : nullptr;
+    callee->stats.push_back(stats ? *stats : std::make_shared<EndpointStats>(endpoint.host, endpoint.port));
+  }
+
+  slot->Publish(std::move(callee));
+  return 0;
+}
+
+int P2CPeakEwmaLoadBalance::Next(LoadBalanceResult& result) {
+  if (result.info == nullptr) {
+    return -1;
+  }
+
+  naming::EndpointSnapshotSlot* slot = callee_endpoints_.Find(*result.info, this);
+  auto* callee = slot ? static_cast<const CalleeSnapshot*>(slot->Read(&result.hazptr)) : nullptr;
+  if (callee == nullptr || callee->endpoints.empty()) {
+    TRPC_LOG_ERROR("Router info of name " << result.info->name << " not found");
+    return -1;
+  }
+
+  std::size_t size = callee->endpoints.size();
+  std::size_t selected = 0;
+  if (size > 1) {
+    // Two distinct endpoints picked at random.
+    std::size_t first = Random<std::size_t>(0, size - 1);
+    std::size_t second = Random<std::size_t>(0, size - 2);
+    second += second >= first ? 1 : 0;
+
+    uint64_t now_us = trpc::time::GetMicroSeconds();
+    selected = Load(*callee->stats[first], now_us) <= Load(*callee->stats[second], now_us) ? first : second;
+  }
+
+  // Only the selections held by a context are counted, as no one else releases them.
+  if (result.info->context) {
+    HoldSelection(result.info->context, callee->stats[selected]);
+  }
+  result.endpoint = &callee->endpoints[selected];
+  return 0;
+}
+
+int P2CPeakEwmaLoadBalance::UpdateInvokeResult(const InvokeResult* result) {
+  if (result == nullptr || !result->context) {
+    return -1;
+  }
+
+  const auto& context = result->context;
+  EndpointStatsPtr stats = ReleaseSelection(context);
+  if (!IsInvokeRequestSent(*result)) {
+    return 0;
+  }
+
+  // The latency is observed by the endpoint actually called, which is usually the one selected. Otherwise, e.g. the
+  // one responding first to a backup request, it's looked up in the current snapshot.
+  std::string host = context->GetIp();
+  int port = context->GetPort();
+  if (!stats || stats->port != port || stats->host != host) {
+    naming::EndpointSnapshotSlot* slot = callee_endpoints_.Find(result->name, context->GetLoadBalanceHandle(), this);
+    Hazptr hazptr;
+    auto* callee = slot ? static_cast<const CalleeSnapshot*>(slot->Read(&hazptr)) : nullptr;
+    if (callee == nullptr) {
+      return -1;
+    }
+
+    const EndpointStatsPtr* found = callee->Find(host, port);
+    if (found == nullptr) {
+      // The endpoint has been removed since.
+      return 0;
+    }
+    stats = *found;
+  }
+
+  uint64_t now_us = trpc::time::GetMicroSeconds();
+  uint64_t send_timestamp_us = context->GetSendTimestampUs();
+  double latency_us = send_timestamp_us && now_us > send_timestamp_us ? static_cast<double>(now_us - send_timestamp_us)
+                                                                       : static_cast<double>(result->cost_time) * 1000;
+  if (result->framework_result != TrpcRetCode::TRPC_INVOKE_SUCCESS) {
+    // A failure, e.g. a refused connection, may return much faster than a response, it counts as slow as a timeout
+    // so the failing endpoint is not preferred.
+    latency_us = std::max(latency_us, static_cast<double>(context->GetTimeout()) * 1000);
+  }
+
+  Observe(*stats, latency_us, now_us);
+  return 0;
+}
+
+bool P2CPeakEwmaLoadBalance::GetHandle(const std::string& name, LoadBalanceHandle* handle) {
+  callee_endpoints_.GetHandle(name, this, handle);
+  return true;
+}
+
+void P2CPeakEwmaLoadBalance::HoldSelection(const ClientContextPtr& context, const EndpointStatsPtr& stats) {
+  stats->inflight.fetch_add(1, std::memory_order_relaxed);
+  // A context selecting again before its report, e.g. to retry on another endpoint, gives up its former selection.
+  if (auto* held = context->GetFilterData<EndpointStatsPtr>(GetPluginID())) {
+    if (*held) {
+      (*held)->inflight.fetch_sub(1, std::memory_order_relaxed);
+    }
+    *held = stats;
+    return;
+  }
+  context->SetFilterData(GetPluginID(), EndpointStatsPtr(stats));
+}
+
+P2CPeakEwmaLoadBalance::EndpointStatsPtr P2CPeakEwmaLoadBalance::ReleaseSelection(const ClientContextPtr& context) {
+  auto* held = context->GetFilterData<EndpointStatsPtr>(GetPluginID());
+  if (held && *held) {
+    (*held)->inflight.fetch_sub(1, std::memory_order_relaxed);
+    return std::move(*held);
+  }
+  return nullptr;
+}
+
+bool P2CPeakEwmaLoadBalance::IsEndpointsDiff(const CalleeSnapshot* existing,
+                                             const std::vector<TrpcEndpointInfo>& endpoints) const {
+  if (existing == nullptr || existing->endpoints.size() != endpoints.size()) {
+    return true;
+  }
+
+  for (std::size_t i = 0; i != endpoints.size(); ++i) {
+    if (existing->endpoints[i].host != endpoints[i].host || existing->endpoints[i].port != endpoints[i].port ||
+        existing->endpoints[i].id != endpoints[i].id) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+double P2CPeakEwmaLoadBalance::Load(EndpointStats& stats, uint64_t now_us) const {
+  double cost_us = stats.cost_us.load(std::memory_order_relaxed);
+  uint64_t timestamp_us = stats.timestamp_us.load(std::memory_order_relaxed);
+  if (now_us > timestamp_us) {
+    // Decayed as if zero latencies were observed since, so an endpoint slow long ago is probed again.
+    cost_us *= std::exp(-static_cast<double>(now_us - timestamp_us) / decay_time_us_);
+  }
+
+  int64_t inflight = stats.inflight.load(std::memory_order_relaxed);
+  if (cost_us == 0 && inflight != 0) {
+    return kPenaltyLoad + inflight;
+  }
+  return cost_us * (inflight + 1);
+}
+
+void P2CPeakEwmaLoadBalance::Observe(EndpointStats& stats, double latency_us, uint64_t now_us) const {
+  uint64_t timestamp_us = stats.timestamp_us.exchange(now_us, std::memory_order_relaxed);
+  double weight =
+      now_us > timestamp_us ? std::exp(-static_cast<double>(now_us - timestamp_us) / decay_time_us_) : 1.0;
+
+  double cost_us = stats.cost_us.load(std::memory_order_relaxed);
+  double next_cost_us;
+  do {
+    next_cost_us = latency_us > cost_us ? latency_us : cost_us * weight + latency_us * (1 - weight);
+  } while (!stats.cost_us.compare_exchange_weak(cost_us, next_cost_us, std::memory_order_relaxed));
+}
+
+}  // namespace trpc
@@ -0,0 +1,117 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "trpc/naming/common/util/endpoint_snapshot/endpoint_snapshot.h"
+#include "trpc/naming/load_balance.h"
+#include "trpc/util/align.h"
+
+namespace trpc {
+
+constexpr char kP2CPeakEwmaLoadBalance[] = "p2c_peak_ewma";
+
+/// @brief Latency aware load balancer: power of two choices over the peak-EWMA latencies of the endpoints.
+///
+/// Each endpoint keeps the exponentially weighted moving average of its latencies, which jumps to any latency higher
+/// than the average at once (the peak), and the number of its requests in flight. `Next` picks two endpoints at random
+/// and selects the one with the lower `average * (in flight + 1)`, so a degraded endpoint quickly gets little traffic,
+/// and gets probed again as its average decays over time.
+///
+/// The statistics are fed by `UpdateInvokeResult`, i.e. the invocation results reported to the selector. A selection
+/// is held by the client context of the request, the report releases exactly the endpoint selected, so the requests
+/// whose endpoints are not selected by `Next`, e.g. the backup requests and the probes of the circuit breaker, never
+/// change the counts of the requests in flight.
+///
+/// The endpoints are published as snapshots along with their statistics, so neither `Next` nor `UpdateInvokeResult`
+/// takes any lock.
+class P2CPeakEwmaLoadBalance : public LoadBalance {
+ public:
+  /// @brief Default time window of the moving average, in microseconds.
+  static constexpr uint64_t kDefaultDecayTimeUs = 10 * 1000 * 1000;
+
+  /// @param decay_time_us The time window of the moving average, the weight of a latency observed `decay_time_us` ago
+  ///                      has decayed to 1/e.
+  explicit P2CPeakEwmaLoadBalance(uint64_t decay_time_us = kDefaultDecayTimeUs);
+  ~P2CPeakEwmaLoadBalance() override = default;
+
+  std::string Name() const override { return kP2CPeakEwmaLoadBalance; }
+
+  int Update(const LoadBalanceInfo* info) override;
+
+  int Next(LoadBalanceResult& result) override;
+
+  int UpdateInvokeResult(const InvokeResult* result) override;
+
+  bool NeedInvokeResult() const override { return true; }
+
+  bool GetHandle(const std::string& name, LoadBalanceHandle* handle) override;
+
+ private:
+  // Statistics of an endpoint, each on its own cache line as they are updated by all the threads calling the endpoint.
+  struct alignas(hardware_destructive_interference_size) EndpointStats {
+    EndpointStats(std::string host, int port) : host(std::move(host)), port(port) {}
+
+    // Address of the endpoint, to tell whether a selection held is the endpoint reported.
+    const std::string host;
+    const int port;
+
+    std::atomic<int64_t> inflight{0};
+    std::atomic<double> cost_us{0};
+    std::atomic<uint64_t> timestamp_us{0};
+  };
+
+  // The statistics are shared by the snapshots keeping the endpoint and by the selections not reported yet.
+  using EndpointStatsPtr = std::shared_ptr<EndpointStats>;
+
+  // The endpoints published along with their statistics.
+  struct CalleeSnapshot : public naming::EndpointSnapshot {
+    std::vector<EndpointStatsPtr> stats;
+    // Host of the endpoint -> index of the endpoint, the keys refer to the hosts in `endpoints`.
+    std::unordered_multimap<std::string_view, std::size_t> index;
+
+    const EndpointStatsPtr* Find(std::string_view host, int port) const;
+  };
+
+  // Holds the selection in the context of the request, releasing the selection held before, if any.
+  void HoldSelection(const ClientContextPtr& context, const EndpointStatsPtr& stats);
+
+  // Releases the selection held by the context of the request, if any.
+  EndpointStatsPtr ReleaseSelection(const ClientContextPtr& context);
+
+  bool IsEndpointsDiff(const CalleeSnapshot* existing, const std::vector<TrpcEndpointInfo>& endpoints) const;
+
+  double Load(EndpointStats& stats, uint64_t now_us) const;
+
+  void Observe(EndpointStats& stats, double latency_us, uint64_t now_us) const;
+
+ private:
+  uint64_t decay_time_us_;
+  naming::EndpointSnapshotTable callee_endpoints_;
+  // Serializes the updates of the snapshots.
+  std::mutex update_mutex_;
+};
+
+using P2CPeakEwmaLoadBalancePtr = RefPtr<P2CPeakEwmaLoadBalance>;
+
+}  // namespace trpc
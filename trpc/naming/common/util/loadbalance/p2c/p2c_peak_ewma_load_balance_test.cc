@@ -0,0 +1,185 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/naming/common/util/loadbalance/p2c/p2c_peak_ewma_load_balance.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "trpc/client/client_context.h"
+#include "trpc/util/time.h"
+
+namespace trpc::testing {
+
+namespace {
+
+constexpr char kCallee[] = "test_service";
+
+void UpdateEndpoints(LoadBalance* lb, const std::vector<int>& ports) {
+  std::vector<TrpcEndpointInfo> endpoints;
+  for (int port : ports) {
+    TrpcEndpointInfo endpoint;
+    endpoint.host = "127.0.0.1";
+    endpoint.port = port;
+    endpoints.push_back(endpoint);
+  }
+
+  SelectorInfo selector_info;
+  selector_info.name = kCallee;
+  LoadBalanceInfo info{&selector_info, &endpoints};
+  ASSERT_EQ(lb->Update(&info), 0);
+}
+
+TrpcEndpointInfo Next(LoadBalance* lb, const ClientContextPtr& context) {
+  SelectorInfo selector_info;
+  selector_info.name = kCallee;
+  selector_info.context = context;
+  selector_info.load_balance_handle = context->GetLoadBalanceHandle();
+  LoadBalanceResult result;
+  result.info = &selector_info;
+  EXPECT_EQ(lb->Next(result), 0);
+  EXPECT_NE(result.endpoint, nullptr);
+  return result.TakeEndpoint();
+}
+
+// Reports the result of the request of `context` sent to `endpoint`.
+void Report(LoadBalance* lb, const ClientContextPtr& context, const TrpcEndpointInfo& endpoint, uint64_t latency_us,
+            int framework_result = 0) {
+  context->SetAddr(endpoint.host, endpoint.port);
+  context->SetSendTimestampUs(trpc::time::GetMicroSeconds() - latency_us);
+
+  InvokeResult result;
+  result.name = kCallee;
+  result.framework_result = framework_result;
+  result.interface_result = 0;
+  result.cost_time = latency_us / 1000;
+  result.context = context;
+  ASSERT_EQ(lb->UpdateInvokeResult(&result), 0);
+}
+
+// Calls the endpoints `times` times, the endpoint of port 30000 is 100 times slower than the others.
+std::unordered_map<int, int> CallWithSlowEndpoint(LoadBalance* lb, int times) {
+  std::unordered_map<int, int> count_map;
+  for (int i = 0; i < times; ++i) {
+    auto context = MakeRefCounted<ClientContext>();
+    TrpcEndpointInfo endpoint = Next(lb, context);
+    count_map[endpoint.port]++;
+    Report(lb, context, endpoint, endpoint.port == 30000 ? 100000 : 1000);
+  }
+  return count_map;
+}
+
+}  // namespace
+
+TEST(P2CPeakEwmaLoadBalanceTest, AvoidSlowEndpoint) {
+  auto lb = MakeRefCounted<P2CPeakEwmaLoadBalance>();
+  ASSERT_EQ(lb->Name(), kP2CPeakEwmaLoadBalance);
+  ASSERT_TRUE(lb->NeedInvokeResult());
+  UpdateEndpoints(lb.get(), {10000, 20000, 30000});
+
+  auto count_map = CallWithSlowEndpoint(lb.get(), 3000);
+  EXPECT_GT(count_map[10000], 1000);
+  EXPECT_GT(count_map[20000], 1000);
+  EXPECT_LT(count_map[30000], 30);
+
+  // The statistics of the endpoints kept survive the update.
+  UpdateEndpoints(lb.get(), {10000, 20000, 30000, 40000});
+  count_map = CallWithSlowEndpoint(lb.get(), 3000);
+  EXPECT_GT(count_map[40000], 0);
+  EXPECT_LT(count_map[30000], 30);
+}
+
+TEST(P2CPeakEwmaLoadBalanceTest, CountRequestsInFlight) {
+  auto lb = MakeRefCounted<P2CPeakEwmaLoadBalance>();
+  UpdateEndpoints(lb.get(), {10000, 20000});
+
+  // No latency observed yet, an endpoint with a request in flight is avoided.
+  auto first_context = MakeRefCounted<ClientContext>();
+  auto second_context = MakeRefCounted<ClientContext>();
+  TrpcEndpointInfo first = Next(lb.get(), first_context);
+  TrpcEndpointInfo second = Next(lb.get(), second_context);
+  ASSERT_NE(first.port, second.port);
+
+  // The request not sent releases the endpoint without a latency observed.
+  Report(lb.get(), first_context, first, 1000000, TrpcRetCode::TRPC_CLIENT_LIMITED_ERR);
+  ASSERT_EQ(Next(lb.get(), MakeRefCounted<ClientContext>()).port, first.port);
+}
+
+TEST(P2CPeakEwmaLoadBalanceTest, ReleaseOnlyEndpointSelected) {
+  auto lb = MakeRefCounted<P2CPeakEwmaLoadBalance>();
+  UpdateEndpoints(lb.get(), {10000, 20000});
+
+  auto context = MakeRefCounted<ClientContext>();
+  TrpcEndpointInfo selected = Next(lb.get(), context);
+
+  // The endpoint not selected by `Next`, e.g. a probe of the circuit breaker, releases nothing.
+  Report(lb.get(), MakeRefCounted<ClientContext>(), selected, 1000000, TrpcRetCode::TRPC_CLIENT_LIMITED_ERR);
+  auto other_context = MakeRefCounted<ClientContext>();
+  TrpcEndpointInfo other = Next(lb.get(), other_context);
+  ASSERT_NE(other.port, selected.port);
+
+  // The request sent to another endpoint, e.g. a backup request, releases the endpoint selected.
+  Report(lb.get(), context, other, 1000000, TrpcRetCode::TRPC_CLIENT_LIMITED_ERR);
+  auto third_context = MakeRefCounted<ClientContext>();
+  ASSERT_EQ(Next(lb.get(), third_context).port, selected.port);
+  Report(lb.get(), third_context, selected, 1000000, TrpcRetCode::TRPC_CLIENT_LIMITED_ERR);
+  Report(lb.get(), other_context, other, 1000000, TrpcRetCode::TRPC_CLIENT_LIMITED_ERR);
+
+  // Selecting again before the report, e.g. to retry on another endpoint, gives up the former selection.
+  auto retry_context = MakeRefCounted<ClientContext>();
+  TrpcEndpointInfo former = Next(lb.get(), retry_context);
+  TrpcEndpointInfo retried = Next(lb.get(), retry_context);
+  ASSERT_NE(former.port, retried.port);
+  ASSERT_EQ(Next(lb.get(), MakeRefCounted<ClientContext>()).port, former.port);
+}
+
+TEST(P2CPeakEwmaLoadBalanceTest, SelectThroughHandle) {
+  auto lb = MakeRefCounted<P2CPeakEwmaLoadBalance>();
+  LoadBalanceHandle handle;
+  ASSERT_TRUE(lb->GetHandle(kCallee, &handle));
+  ASSERT_EQ(handle.load_balance.Get(), lb.get());
+  UpdateEndpoints(lb.get(), {10000, 20000});
+
+  auto context = MakeRefCounted<ClientContext>();
+  context->SetLoadBalanceHandle(&handle);
+  TrpcEndpointInfo selected = Next(lb.get(), context);
+
+  // The latency of another endpoint responding instead, e.g. to a backup request, is observed by that endpoint.
+  TrpcEndpointInfo other = selected;
+  other.port = selected.port == 10000 ? 20000 : 10000;
+  Report(lb.get(), context, other, 1000000);
+  for (int i = 0; i < 10; ++i) {
+    auto next_context = MakeRefCounted<ClientContext>();
+    next_context->SetLoadBalanceHandle(&handle);
+    TrpcEndpointInfo endpoint = Next(lb.get(), next_context);
+    ASSERT_EQ(endpoint.port, selected.port);
+    Report(lb.get(), next_context, endpoint, 1000);
+  }
+}
+
+TEST(P2CPeakEwmaLoadBalanceTest, InvalidParameter) {
+  auto lb = MakeRefCounted<P2CPeakEwmaLoadBalance>();
+  ASSERT_EQ(lb->Update(nullptr), -1);
+  ASSERT_EQ(lb->UpdateInvokeResult(nullptr), -1);
+
+  SelectorInfo selector_info;
+  selector_info.name = "unknown";
+  LoadBalanceResult result;
+  result.info = &selector_info;
+  ASSERT_EQ(lb->Next(result), -1);
+}
+
+}  // namespace trpc::testing
@@ -13,14 +13,7 @@
 
 #include "trpc/naming/common/util/loadbalance/polling/polling_load_balance.h"
 
-#include <arpa/inet.h>
-#include <netdb.h>
-#include <sys/socket.h>
-
-#include <algorithm>
-#include <any>
-#include <iostream>
-#include <regex>
+#include <utility>
 #include <vector>
 
 #include "trpc/naming/load_balance_factory.h"
@@ -28,19 +21,14 @@
 
 namespace trpc {
 
-bool PollingLoadBalance::IsLoadBalanceInfoDiff(const LoadBalanceInfo* info) {
-  if (nullptr == info || nullptr == info->info || nullptr == info->endpoints) {
-    return false;
-  }
-
-  const SelectorInfo* select_info = info->info;
-  std::shared_lock<std::shared_mutex> lock(mutex_);
-  if (callee_router_infos_.end() == callee_router_infos_.find(select_info->name)) {
+bool PollingLoadBalance::IsLoadBalanceInfoDiff(const LoadBalanceInfo* info, naming::EndpointSnapshotSlot* slot) {
+  Hazptr hazptr;
+  const naming::EndpointSnapshot* snapshot = slot->Read(&hazptr);
+  if (nullptr == snapshot) {
     return true;
   }
 
-  std::vector<TrpcEndpointInfo>& orig_endpoints = callee_router_infos_[select_info->name].endpoints;
-
+  const std::vector<TrpcEndpointInfo>& orig_endpoints = snapshot->endpoints;
   const std::vector<TrpcEndpointInfo>* new_endpoints = info->endpoints;
   if (orig_endpoints.size() != new_endpoints->size()) {
     return true;
@@ -48,7 +36,7 @@ bool PollingLoadBalance::IsLoadBalanceInfoDiff(const LoadBalanceInfo* info) {
 
   int i = 0;
   for (auto& var : *new_endpoints) {
-    auto orig_endpoint = orig_endpoints[i++];
+    const auto& orig_endpoint = orig_endpoints[i++];
     if (orig_endpoint.host != var.host || orig_endpoint.port != var.port) {
       return true;
     }
@@ -68,14 +56,12 @@ int PollingLoadBalance::Update(const LoadBalanceInfo* info) {
     return -1;
   }
 
-  const SelectorInfo* select_info = info->info;
-  if (IsLoadBalanceInfoDiff(info)) {
-    InnerEndpointInfos endpoint_info;
-    endpoint_info.index = 0;
-    endpoint_info.endpoints.assign(info->endpoints->begin(), info->endpoints->end());
-
-    std::unique_lock<std::shared_mutex> lock(mutex_);
-    callee_router_infos_[select_info->name] = endpoint_info;
+  naming::EndpointSnapshotSlot* slot = callee_router_infos_.GetOrCreate(info->info->name);
+  std::scoped_lock lock(update_mutex_);
+  if (IsLoadBalanceInfoDiff(info, slot)) {
+    auto snapshot = std::make_unique<naming::EndpointSnapshot>();
+    snapshot->endpoints.assign(info->endpoints->begin(), info->endpoints->end());
+    slot->Publish(std::move(snapshot));
   }
 
   return 0;
@@ -87,26 +73,25 @@ int PollingLoadBalance::Next(LoadBalanceResult& result) {
     return -1;
   }
 
-  std::shared_lock<std::shared_mutex> lock(mutex_);
-  auto iter = callee_router_infos_.find((result.info)->name);
-  if (iter == callee_router_infos_.end()) {
+  naming::EndpointSnapshotSlot* slot = callee_router_infos_.Find(*result.info, this);
+  const naming::EndpointSnapshot* snapshot = slot ? slot->Read(&result.hazptr) : nullptr;
+  if (nullptr == snapshot) {
     TRPC_LOG_ERROR("Router info of name " << (result.info)->name << " no found");
     return -1;
   }
 
-  std::vector<TrpcEndpointInfo>& endpoints = iter->second.endpoints;
-  size_t endpoints_num = endpoints.size();
-  if (endpoints_num < 1) {
+  result.endpoint = slot->Next(*snapshot);
+  if (nullptr == result.endpoint) {
     TRPC_LOG_ERROR("Router info of name is empty");
     return -1;
   }
 
-  uint32_t index = 0;
-  uint32_t id = __sync_fetch_and_add(&iter->second.index, 1);
-  index = id % endpoints_num;
-
-  result.result = endpoints[index];
   return 0;
 }
 
+bool PollingLoadBalance::GetHandle(const std::string& name, LoadBalanceHandle* handle) {
+  callee_router_infos_.GetHandle(name, this, handle);
+  return true;
+}
+
 }  // namespace trpc
@@ -13,14 +13,11 @@
 
 #pragma once
 
-#include <atomic>
 #include <memory>
-#include <set>
-#include <shared_mutex>
+#include <mutex>
 #include <string>
-#include <unordered_map>
-#include <vector>
 
+#include "trpc/naming/common/util/endpoint_snapshot/endpoint_snapshot.h"
 #include "trpc/naming/load_balance.h"
 
 namespace trpc {
@@ -40,20 +37,19 @@ class PollingLoadBalance : public LoadBalance {
   /// @brief Update the routing node information used by the load balancing
   int Update(const LoadBalanceInfo* info) override;
 
-  /// @brief Return a callee node
+  /// @brief Return a callee node, without any lock
   int Next(LoadBalanceResult& result) override;
 
- private:
-  /// @brief Check if the load balancing information is different
-  bool IsLoadBalanceInfoDiff(const LoadBalanceInfo* info);
+  /// @brief Get the handle of the endpoint snapshot of the callee
+  bool GetHandle(const std::string& name, LoadBalanceHandle* handle) override;
 
-  struct InnerEndpointInfos {
-    std::vector<TrpcEndpointInfo> endpoints;
-    std::uint32_t index;
-  };
+ private:
+  /// @brief Check if the load balancing information is different from the published snapshot
+  bool IsLoadBalanceInfoDiff(const LoadBalanceInfo* info, naming::EndpointSnapshotSlot* slot);
 
-  std::unordered_map<std::string, PollingLoadBalance::InnerEndpointInfos> callee_router_infos_;
-  mutable std::shared_mutex mutex_;
+  naming::EndpointSnapshotTable callee_router_infos_;
+  // Serializes the updates of the snapshots.
+  std::mutex update_mutex_;
 };
 
 using PollingLoadBalancePtr = RefPtr<PollingLoadBalance>;
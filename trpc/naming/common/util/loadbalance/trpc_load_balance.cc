@@ -15,6 +15,7 @@
 
 #include "trpc/naming/common/util/loadbalance/hash/consistenthash_load_balance.h"
 #include "trpc/naming/common/util/loadbalance/hash/modulohash_load_balance.h"
+#include "trpc/naming/common/util/loadbalance/p2c/p2c_peak_ewma_load_balance.h"
 #include "trpc/naming/common/util/loadbalance/polling/polling_load_balance.h"
 #include "trpc/naming/common/util/loadbalance/weighted_round_robin/weighted_round_robin_load_balancer.h"
 #include "trpc/naming/load_balance_factory.h"
@@ -67,6 +68,12 @@ bool Init() {
     }
   }
 
+  LoadBalancePtr p2c_peak_ewma_load_balance = trpc::LoadBalanceFactory::GetInstance()->Get(kP2CPeakEwmaLoadBalance);
+  if (p2c_peak_ewma_load_balance == nullptr) {
+    p2c_peak_ewma_load_balance = MakeRefCounted<P2CPeakEwmaLoadBalance>();
+    LoadBalanceFactory::GetInstance()->Register(p2c_peak_ewma_load_balance);
+  }
+
   return res;
 }
 
@@ -12,6 +12,12 @@
 //
 
 #include "trpc/naming/common/util/loadbalance/weighted_round_robin/weighted_round_robin_load_balancer.h"
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <utility>
+
 #include "trpc/common/config/trpc_config.h"
 
 namespace trpc {
@@ -22,24 +28,22 @@ int SWRoundRobinLoadBalance::Update(const LoadBalanceInfo* info) {
     return -1;
   }
 
-  std::unique_lock<std::shared_mutex> lock(mutex_);
-
-  if (!IsLoadBalanceInfoDiff(info)) {
+  naming::EndpointSnapshotSlot* slot = callee_router_infos_.GetOrCreate(info->info->name);
+  if (!IsLoadBalanceInfoDiff(info, slot)) {
     return 0;
   }
 
-  InnerEndpointInfos new_info;
-  new_info.total_weight = 0;
+  // The selection order is computed without the lock, which only serializes the publications of the snapshots.
+  auto snapshot = std::make_unique<naming::EndpointSnapshot>();
+  snapshot->endpoints.assign(info->endpoints->begin(), info->endpoints->end());
+  snapshot->sequence = MakeSequence(snapshot->endpoints);
 
-  for (const auto& endpoint_info : *(info->endpoints)) {
-    new_info.endpoints.push_back(endpoint_info);
-    new_info.weights.push_back(endpoint_info.weight);
-    new_info.current_weights.push_back(0);
-    new_info.total_weight += endpoint_info.weight;
+  std::scoped_lock lock(update_mutex_);
+  // Checks again in case the same endpoints were published by another update meanwhile.
+  if (IsLoadBalanceInfoDiff(info, slot)) {
+    slot->Publish(std::move(snapshot));
   }
 
-  callee_router_infos_[info->info->name] = std::move(new_info);
-
   return 0;
 }
 
@@ -48,53 +52,83 @@ int SWRoundRobinLoadBalance::Next(LoadBalanceResult& result) {
     return -1;
   }
 
-  std::shared_lock<std::shared_mutex> lock(mutex_);
-  auto iter = callee_router_infos_.find(result.info->name);
-  if (iter == callee_router_infos_.end()) {
+  naming::EndpointSnapshotSlot* slot = callee_router_infos_.Find(*result.info, this);
+  const naming::EndpointSnapshot* snapshot = slot ? slot->Read(&result.hazptr) : nullptr;
+  if (snapshot == nullptr) {
     TRPC_LOG_ERROR("Router info of name " << result.info->name << " not found");
     return -1;
   }
 
-  auto& info = iter->second;
-  const auto& endpoints = info.endpoints;
-  size_t endpoints_num = endpoints.size();
-
-  if (endpoints_num < 1) {
+  result.endpoint = slot->Next(*snapshot);
+  if (result.endpoint == nullptr) {
     TRPC_LOG_ERROR("Router info of name is empty");
     return -1;
   }
 
-  int max_current_weight = -1;
-  int selected_index = -1;
+  return 0;
+}
 
-  for (size_t i = 0; i < info.endpoints.size(); ++i) {
-    info.current_weights[i] += info.weights[i];
-    if (info.current_weights[i] > max_current_weight) {
-      max_current_weight = info.current_weights[i];
-      selected_index = i;
-    }
+bool SWRoundRobinLoadBalance::GetHandle(const std::string& name, LoadBalanceHandle* handle) {
+  callee_router_infos_.GetHandle(name, this, handle);
+  return true;
+}
+
+std::vector<uint32_t> SWRoundRobinLoadBalance::MakeSequence(const std::vector<TrpcEndpointInfo>& endpoints) {
+  std::vector<uint64_t> weights;
+  weights.reserve(endpoints.size());
+  uint64_t divisor = 0;
+  for (const auto& endpoint : endpoints) {
+    weights.push_back(endpoint.weight);
+    divisor = std::gcd<uint64_t>(divisor, endpoint.weight);
+  }
+  // All the endpoints are selected in turn if none has weight.
+  if (divisor == 0) {
+    return {};
   }
 
-  if (selected_index != -1) {
-    info.current_weights[selected_index] -= info.total_weight;
-    result.result = info.endpoints[selected_index];
-    return 0;
+  uint64_t total_weight = 0;
+  for (auto& weight : weights) {
+    weight /= divisor;
+    total_weight += weight;
   }
 
-  return -1;
-}
+  if (total_weight > kMaxSequenceSize) {
+    uint64_t scaled_total = 0;
+    for (auto& weight : weights) {
+      if (weight > 0) {
+        weight = std::max<uint64_t>(weight * kMaxSequenceSize / total_weight, 1);
+      }
+      scaled_total += weight;
+    }
+    total_weight = scaled_total;
+  }
 
-bool SWRoundRobinLoadBalance::IsLoadBalanceInfoDiff(const LoadBalanceInfo* info) {
-  if (info == nullptr || info->info == nullptr || info->endpoints == nullptr) {
-    return false;
+  std::vector<uint32_t> sequence;
+  sequence.reserve(total_weight);
+  std::vector<int64_t> current_weights(weights.size(), 0);
+  for (uint64_t n = 0; n < total_weight; ++n) {
+    std::size_t selected_index = 0;
+    for (std::size_t i = 0; i < weights.size(); ++i) {
+      current_weights[i] += weights[i];
+      if (current_weights[i] > current_weights[selected_index]) {
+        selected_index = i;
+      }
+    }
+    current_weights[selected_index] -= total_weight;
+    sequence.push_back(static_cast<uint32_t>(selected_index));
   }
 
-  const auto& existing_info = callee_router_infos_.find(info->info->name);
-  if (existing_info == callee_router_infos_.end()) {
+  return sequence;
+}
+
+bool SWRoundRobinLoadBalance::IsLoadBalanceInfoDiff(const LoadBalanceInfo* info, naming::EndpointSnapshotSlot* slot) {
+  Hazptr hazptr;
+  const naming::EndpointSnapshot* snapshot = slot->Read(&hazptr);
+  if (snapshot == nullptr) {
     return true;
   }
 
-  const auto& existing_endpoints = existing_info->second.endpoints;
+  const auto& existing_endpoints = snapshot->endpoints;
 
   if (existing_endpoints.size() != info->endpoints->size()) {
     return true;
@@ -103,11 +137,13 @@ bool SWRoundRobinLoadBalance::IsLoadBalanceInfoDiff(const LoadBalanceInfo* info)
   for (size_t i = 0; i < existing_endpoints.size(); ++i) {
     if (existing_endpoints[i].weight != (*info->endpoints)[i].weight ||
         existing_endpoints[i].host != (*info->endpoints)[i].host ||
-        existing_endpoints[i].port != (*info->endpoints)[i].port) {
+        existing_endpoints[i].port != (*info->endpoints)[i].port ||
+        existing_endpoints[i].status != (*info->endpoints)[i].status) {
       return true;
     }
   }
 
   return false;
 }
+
 }  // namespace trpc
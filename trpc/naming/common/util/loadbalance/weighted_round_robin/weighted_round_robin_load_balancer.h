@@ -12,18 +12,20 @@
 
 #pragma once
 
-#include <atomic>
-#include <shared_mutex>
+#include <cstdint>
+#include <mutex>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
+#include "trpc/naming/common/util/endpoint_snapshot/endpoint_snapshot.h"
 #include "trpc/naming/load_balance.h"
 
 namespace trpc {
 
 constexpr char kSWRoundRobinLoadBalance[] = "swround_robin";
 
+/// @brief Smooth weighted round-robin load balancing plugin. The selection order is computed when the endpoints are
+/// updated, so selecting an endpoint takes no lock.
 class SWRoundRobinLoadBalance : public LoadBalance {
  public:
   SWRoundRobinLoadBalance() = default;
@@ -32,18 +34,20 @@ class SWRoundRobinLoadBalance : public LoadBalance {
   std::string Name() const override { return kSWRoundRobinLoadBalance; }
   int Update(const LoadBalanceInfo* info) override;
   int Next(LoadBalanceResult& result) override;
+  bool GetHandle(const std::string& name, LoadBalanceHandle* handle) override;
+
+  /// @brief Max length of the selection order of a callee, the weights are scaled down proportionally beyond it.
+  static constexpr uint32_t kMaxSequenceSize = 65536;
+
+  /// @brief Computes the smooth weighted round-robin selection order of the weights, reduced by their gcd.
+  static std::vector<uint32_t> MakeSequence(const std::vector<TrpcEndpointInfo>& endpoints);
 
  private:
-  bool IsLoadBalanceInfoDiff(const LoadBalanceInfo* info);
-
-  struct InnerEndpointInfos {
-    std::vector<int> weights;
-    std::vector<TrpcEndpointInfo> endpoints;
-    std::vector<int> current_weights;
-    std::uint32_t total_weight;
-  };
-  std::unordered_map<std::string, InnerEndpointInfos> callee_router_infos_;
-  std::shared_mutex mutex_;
+  bool IsLoadBalanceInfoDiff(const LoadBalanceInfo* info, naming::EndpointSnapshotSlot* slot);
+
+  naming::EndpointSnapshotTable callee_router_infos_;
+  // Serializes the publications of the snapshots, which are computed without it.
+  std::mutex update_mutex_;
 };
 
 using SWRoundRobinLoadBalancePtr = RefPtr<SWRoundRobinLoadBalance>;
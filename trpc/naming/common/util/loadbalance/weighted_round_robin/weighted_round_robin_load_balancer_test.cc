@@ -11,6 +11,7 @@
 //
 //
 
+#include <algorithm>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -99,4 +100,25 @@ TEST_F(SWRoundRobinLoadBalanceTest, SelectWithWeights) {
   EXPECT_NEAR(count_map[30000] / float(count_map[10000]), weight_ratio2, 0.1);
   EXPECT_NEAR(count_map[30000] / float(count_map[20000]), weight_ratio3, 0.1);
 }
-}  // namespace trpc
\ No newline at end of file
+
+TEST_F(SWRoundRobinLoadBalanceTest, MakeSequence) {
+  std::vector<TrpcEndpointInfo> endpoints(3);
+  endpoints[0].weight = 50;
+  endpoints[1].weight = 100;
+  endpoints[2].weight = 0;
+  // Reduced by the gcd and interleaved smoothly, the endpoint without weight is never selected.
+  EXPECT_EQ(SWRoundRobinLoadBalance::MakeSequence(endpoints), std::vector<uint32_t>({1, 0, 1}));
+
+  // The endpoints are selected in turn if none has weight.
+  endpoints[0].weight = endpoints[1].weight = 0;
+  EXPECT_TRUE(SWRoundRobinLoadBalance::MakeSequence(endpoints).empty());
+
+  // Scaled down proportionally, the light endpoint is still selected.
+  endpoints[0].weight = 1;
+  endpoints[1].weight = 1000000;
+  auto sequence = SWRoundRobinLoadBalance::MakeSequence(endpoints);
+  EXPECT_LE(sequence.size(), SWRoundRobinLoadBalance::kMaxSequenceSize + 1);
+  EXPECT_EQ(std::count(sequence.begin(), sequence.end(), 0), 1);
+}
+
+}  // namespace trpc
@@ -17,6 +17,9 @@
 #include <sstream>
 #include <utility>
 
+#include "trpc/common/config/direct_naming_conf.h"
+#include "trpc/common/config/direct_naming_conf_parser.h"
+#include "trpc/common/config/trpc_config.h"
 #include "trpc/naming/common/util/loadbalance/polling/polling_load_balance.h"
 #include "trpc/naming/load_balance_factory.h"
 #include "trpc/naming/selector_factory.h"
@@ -29,6 +32,18 @@ SelectorDirect::SelectorDirect(const LoadBalancePtr& load_balance) : default_loa
   TRPC_ASSERT(default_load_balance_);
 }
 
+int SelectorDirect::Init() noexcept {
+  naming::DirectSelectorConfig config;
+  if (!TrpcConfig::GetInstance()->GetPluginConfig("selector", "direct", config)) {
+    TRPC_FMT_DEBUG("get selector direct config failed, use default value");
+  }
+
+  if (config.circuit_break.enable) {
+    circuit_breaker_ = std::make_unique<naming::CircuitBreaker>(config.circuit_break);
+  }
+  return 0;
+}
+
 LoadBalance* SelectorDirect::GetLoadBalance(const std::string& name) {
   if (!name.empty()) {
     auto load_balance = LoadBalanceFactory::GetInstance()->Get(name).get();
@@ -40,33 +55,70 @@ LoadBalance* SelectorDirect::GetLoadBalance(const std::string& name) {
   return default_load_balance_.get();
 }
 
+LoadBalance* SelectorDirect::GetLoadBalance(const SelectorInfo* info) {
+  if (info->load_balance_handle) {
+    return info->load_balance_handle->load_balance.Get();
+  }
+  return GetLoadBalance(info->load_balance_name);
+}
+
+bool SelectorDirect::NeedInvokeResult(const SelectorInfo* info) {
+  return circuit_breaker_ || GetLoadBalance(info->load_balance_name)->NeedInvokeResult();
+}
+
+bool SelectorDirect::GetLoadBalanceHandle(const SelectorInfo* info, LoadBalanceHandle* handle) {
+  return GetLoadBalance(info->load_balance_name)->GetHandle(info->name, handle);
+}
+
+uint64_t SelectorDirect::WatchEndpoints(const std::string& name, EndpointsAddedFunction&& func) {
+  // The current endpoints are reported with the lock held, so no endpoint added meanwhile is missed
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  auto iter = targets_map_.find(name);
+  if (iter == targets_map_.end()) {
+    return endpoint_watchers_.Watch(name, std::move(func), {});
+  }
+  return endpoint_watchers_.Watch(name, std::move(func), iter->second.endpoints);
+}
+
+void SelectorDirect::UnwatchEndpoints(uint64_t watch_id) { endpoint_watchers_.Unwatch(watch_id); }
+
 // Get the routing interface of the node being called
 int SelectorDirect::Select(const SelectorInfo* info, TrpcEndpointInfo* endpoint) {
+  // The endpoints recovering from ejection are probed first
+  if (circuit_breaker_ && circuit_breaker_->SelectProbe(info->name, endpoint)) {
+    return 0;
+  }
+
   LoadBalanceResult load_balance_result;
   load_balance_result.info = info;
-  auto lb = GetLoadBalance(info->load_balance_name);
+  auto lb = GetLoadBalance(info);
   if (lb->Next(load_balance_result)) {
     std::string error_str = "Do load balance of " + info->name + " failed";
     TRPC_LOG_ERROR(error_str);
     return -1;
   }
 
-  *endpoint = std::move(std::any_cast<TrpcEndpointInfo>(load_balance_result.result));
+  *endpoint = load_balance_result.TakeEndpoint();
   return 0;
 }
 
 // Get a throttling interface asynchronously
 Future<TrpcEndpointInfo> SelectorDirect::AsyncSelect(const SelectorInfo* info) {
+  TrpcEndpointInfo probe;
+  if (circuit_breaker_ && circuit_breaker_->SelectProbe(info->name, &probe)) {
+    return MakeReadyFuture<TrpcEndpointInfo>(std::move(probe));
+  }
+
   LoadBalanceResult load_balance_result;
   load_balance_result.info = info;
-  auto lb = GetLoadBalance(info->load_balance_name);
+  auto lb = GetLoadBalance(info);
   if (lb->Next(load_balance_result)) {
     std::string error_str = "Do load balance of " + info->name + " failed";
     TRPC_LOG_ERROR(error_str);
     return MakeExceptionFuture<TrpcEndpointInfo>(CommonException(error_str.c_str()));
   }
 
-  TrpcEndpointInfo endpoint = std::move(std::any_cast<TrpcEndpointInfo>(load_balance_result.result));
+  TrpcEndpointInfo endpoint = load_balance_result.TakeEndpoint();
   return MakeReadyFuture<TrpcEndpointInfo>(std::move(endpoint));
 }
 
@@ -86,10 +138,19 @@ int SelectorDirect::SelectBatch(const SelectorInfo* info, std::vector<TrpcEndpoi
     return -1;
   }
 
+  // The endpoints ejected by the circuit breaker are excluded
+  std::vector<TrpcEndpointInfo> available;
+  const std::vector<TrpcEndpointInfo>* candidates = &it->second.endpoints;
+  if (circuit_breaker_) {
+    available = it->second.endpoints;
+    circuit_breaker_->FilterEndpoints(info->name, &available);
+    candidates = &available;
+  }
+
   if (info->policy == SelectorPolicy::MULTIPLE) {
-    SelectMultiple(it->second.endpoints, endpoints, info->select_num);
+    SelectMultiple(*candidates, endpoints, info->select_num);
   } else {
-    *endpoints = it->second.endpoints;
+    *endpoints = *candidates;
   }
   return 0;
 }
@@ -111,10 +172,19 @@ Future<std::vector<TrpcEndpointInfo>> SelectorDirect::AsyncSelectBatch(const Sel
   }
 
   std::vector<TrpcEndpointInfo> endpoints;
+  // The endpoints ejected by the circuit breaker are excluded
+  std::vector<TrpcEndpointInfo> available;
+  const std::vector<TrpcEndpointInfo>* candidates = &it->second.endpoints;
+  if (circuit_breaker_) {
+    available = it->second.endpoints;
+    circuit_breaker_->FilterEndpoints(info->name, &available);
+    candidates = &available;
+  }
+
   if (info->policy == SelectorPolicy::MULTIPLE) {
-    SelectMultiple(it->second.endpoints, &endpoints, info->select_num);
+    SelectMultiple(*candidates, &endpoints, info->select_num);
   } else {
-    endpoints = it->second.endpoints;
+    endpoints = *candidates;
   }
 
   return MakeReadyFuture<std::vector<TrpcEndpointInfo>>(std::move(endpoints));
@@ -127,7 +197,18 @@ int SelectorDirect::ReportInvokeResult(const InvokeResult* result) {
     return -1;
   }
 
-  return 0;
+  // Feed the result back to the load balancer which selected the endpoint
+  const ServiceProxyOption* option = result->context ? result->context->GetServiceProxyOption() : nullptr;
+  auto lb = option ? GetLoadBalance(option->load_balance_name) : default_load_balance_.get();
+  int ret = lb->UpdateInvokeResult(result);
+
+  // Update the load balancer once an endpoint is ejected or admitted again
+  if (circuit_breaker_ && circuit_breaker_->ReportInvokeResult(result)) {
+    if (UpdateLoadBalance(result->name, lb)) {
+      return -1;
+    }
+  }
+  return ret;
 }
 
 int SelectorDirect::SetEndpoints(const RouterInfo* info) {
@@ -141,10 +222,13 @@ int SelectorDirect::SetEndpoints(const RouterInfo* info) {
   endpoints_info.endpoints = info->info;
 
   std::unique_lock<std::shared_mutex> uniq_lock(mutex_);
+  std::vector<TrpcEndpointInfo> old_endpoints;
   auto iter = targets_map_.find(info->name);
-  if (iter != targets_map_.end()) {
+  bool is_new = (iter == targets_map_.end());
+  if (!is_new) {
     // If the service name is in the cache, use the original id generator
     endpoints_info.id_generator = std::move(iter->second.id_generator);
+    old_endpoints.swap(iter->second.endpoints);
   }
 
   for (auto& item : endpoints_info.endpoints) {
@@ -155,6 +239,13 @@ int SelectorDirect::SetEndpoints(const RouterInfo* info) {
   targets_map_[info->name] = endpoints_info;
   uniq_lock.unlock();
 
+  endpoint_watchers_.Notify(info->name, is_new ? nullptr : &old_endpoints, endpoints_info.endpoints);
+
+  if (circuit_breaker_) {
+    circuit_breaker_->SetEndpoints(info->name, endpoints_info.endpoints);
+    return UpdateLoadBalance(info->name, GetLoadBalance(info->load_balance_name));
+  }
+
   // Update service routing information to default loadbalance
   SelectorInfo select_info;
   select_info.name = info->name;
@@ -170,4 +261,34 @@ int SelectorDirect::SetEndpoints(const RouterInfo* info) {
   return 0;
 }
 
+bool SelectorDirect::SetCircuitBreakWhiteList(const std::vector<int>& framework_retcodes) {
+  if (!circuit_breaker_) {
+    return false;
+  }
+
+  circuit_breaker_->SetWhiteList(framework_retcodes);
+  return true;
+}
+
+int SelectorDirect::UpdateLoadBalance(const std::string& name, LoadBalance* load_balance) {
+  // Serializes the updates so a stale list of endpoints never overwrites a newer one
+  std::scoped_lock lock(load_balance_update_mutex_);
+  std::vector<TrpcEndpointInfo> endpoints;
+  if (!circuit_breaker_->GetAvailableEndpoints(name, &endpoints)) {
+    return -1;
+  }
+
+  SelectorInfo select_info;
+  select_info.name = name;
+  select_info.context = nullptr;
+  LoadBalanceInfo load_balance_info;
+  load_balance_info.info = &select_info;
+  load_balance_info.endpoints = &endpoints;
+  if (load_balance->Update(&load_balance_info)) {
+    TRPC_FMT_ERROR("Loadbalance {} update failed.", name);
+    return -1;
+  }
+  return 0;
+}
+
 }  // namespace trpc
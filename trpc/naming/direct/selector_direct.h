@@ -14,12 +14,15 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <shared_mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 #include "trpc/common/plugin.h"
+#include "trpc/naming/common/util/circuit_break/circuit_breaker.h"
+#include "trpc/naming/common/util/endpoint_watch/endpoint_watchers.h"
 #include "trpc/naming/common/util/utils_help.h"
 #include "trpc/naming/load_balance.h"
 #include "trpc/naming/selector.h"
@@ -39,6 +42,10 @@ class SelectorDirect : public Selector {
   /// @return The version of the plugin.
   std::string Version() const override { return "0.0.1"; }
 
+  /// @brief Initializes the plugin, e.g. the circuit breaking of the endpoints if enabled by the config.
+  /// @return 0 on success.
+  int Init() noexcept override;
+
   /// @brief Selects a single endpoint for the target service.
   /// @param info The selector information.
   /// @param endpoint The output parameter to store the selected endpoint.
@@ -66,17 +73,52 @@ class SelectorDirect : public Selector {
   /// @return 0 on success, -1 on failure.
   int ReportInvokeResult(const InvokeResult* result) override;
 
+  /// @brief The load balancers may track the requests in flight, so the results of requests not sent are needed.
+  bool NeedUnsentInvokeResult() const override { return true; }
+
+  /// @brief The invocation results are needed by the circuit breaking, or by the load balancers depending on them.
+  bool NeedInvokeResult(const SelectorInfo* info) override;
+
+  /// @brief Resolves the handle of the target service in its load balancer, cached by the service proxy.
+  bool GetLoadBalanceHandle(const SelectorInfo* info, LoadBalanceHandle* handle) override;
+
+  /// @brief Watches the endpoints added to the target service.
+  /// @param name The name of the target service.
+  /// @param func The callback of the endpoints added.
+  /// @return The id of the watch.
+  uint64_t WatchEndpoints(const std::string& name, EndpointsAddedFunction&& func) override;
+
+  /// @brief Cancels a watch of the endpoints.
+  /// @param watch_id The id of the watch.
+  void UnwatchEndpoints(uint64_t watch_id) override;
+
   /// @brief Sets the endpoints for the target service.
   /// @param info The router information.
   /// @return 0 on success, -1 on failure.
   int SetEndpoints(const RouterInfo* info) override;
 
+  /// @brief Sets the framework error codes not counted as failures by the circuit breaking of the endpoints.
+  /// @param framework_retcodes The framework error codes.
+  /// @return true if the circuit breaking is enabled.
+  bool SetCircuitBreakWhiteList(const std::vector<int>& framework_retcodes) override;
+
  private:
   /// @brief Gets the load balancer plugin with the specified name.
   /// @param name The name of the load balancer plugin.
   /// @return A pointer to the load balancer plugin.
   LoadBalance* GetLoadBalance(const std::string& name);
 
+  /// @brief Gets the load balancer plugin of the selection, the one of its handle if resolved.
+  /// @param info The selector information.
+  /// @return A pointer to the load balancer plugin.
+  LoadBalance* GetLoadBalance(const SelectorInfo* info);
+
+  /// @brief Updates the load balancer with the endpoints of the target service not ejected by the circuit breaker.
+  /// @param name The name of the target service.
+  /// @param load_balance The load balancer plugin.
+  /// @return 0 on success, -1 on failure.
+  int UpdateLoadBalance(const std::string& name, LoadBalance* load_balance);
+
  private:
   // The name of the default load balancer plugin.
   static const char default_load_balance_name_[];
@@ -92,6 +134,11 @@ class SelectorDirect : public Selector {
   // The default load balancer plugin.
   LoadBalancePtr default_load_balance_;
   mutable std::shared_mutex mutex_;
+  // The circuit breaker of the endpoints, null if disabled.
+  std::unique_ptr<naming::CircuitBreaker> circuit_breaker_;
+  std::mutex load_balance_update_mutex_;
+  // The watches of the endpoints added.
+  naming::EndpointWatchers endpoint_watchers_;
 };
 
 using SelectorDirectPtr = RefPtr<SelectorDirect>;
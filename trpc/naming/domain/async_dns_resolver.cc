@@ -0,0 +1,550 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/naming/domain/async_dns_resolver.h"
+
+#include <arpa/inet.h>
+#include <errno.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+#include "trpc/runtime/iomodel/reactor/common/socket.h"
+#include "trpc/util/algorithm/random.h"
+#include "trpc/util/log/logging.h"
+#include "trpc/util/thread/latch.h"
+#include "trpc/util/time.h"
+
+namespace trpc::naming {
+
+namespace {
+
+// Interval of checking the names to be refreshed.
+constexpr uint64_t kRefreshCheckIntervalMs = 500;
+
+// A name is refreshed after this percentage of its ttl, so the addresses rarely expire if it is resolved often.
+constexpr uint64_t kRefreshPercentage = 80;
+
+bool IsIpAddress(const std::string& domain) {
+  char buf[sizeof(struct in6_addr)];
+  return inet_pton(AF_INET, domain.c_str(), buf) == 1 || inet_pton(AF_INET6, domain.c_str(), buf) == 1;
+}
+
+// Domain names are case insensitive, and may end with the root.
+std::string NormalizeDomain(const std::string& domain) {
+  std::string name = domain;
+  if (!name.empty() && name.back() == '.') {
+    name.pop_back();
+  }
+  std::transform(name.begin(), name.end(), name.begin(),
+                 [](char c) { return c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c; });
+  return name;
+}
+
+// The `ndots` option of a resolv.conf file, 1 if absent as with the libc resolver.
+uint32_t GetNdots(const std::string& path) {
+  uint32_t ndots = 1;
+  std::ifstream file(path);
+  std::string line;
+  while (std::getline(file, line)) {
+    std::istringstream stream(line);
+    std::string key, option;
+    if (!(stream >> key) || key != "options") {
+      continue;
+    }
+    while (stream >> option) {
+      if (option.compare(0, 6, "ndots:") == 0) {
+        // Capped as by the libc resolver.
+        ndots = std::min<uint32_t>(std::strtoul(option.c_str() + 6, nullptr, 10), 15);
+      }
+    }
+  }
+  return ndots;
+}
+
+// The names and aliases of a hosts file.
+std::unordered_set<std::string> GetHostsNames(const std::string& path) {
+  std::unordered_set<std::string> names;
+  std::ifstream file(path);
+  std::string line;
+  while (std::getline(file, line)) {
+    std::istringstream stream(line.substr(0, line.find('#')));
+    std::string ip, name;
+    if (!(stream >> ip)) {
+      continue;
+    }
+    while (stream >> name) {
+      names.insert(NormalizeDomain(name));
+    }
+  }
+  return names;
+}
+
+NetworkAddress ToServerAddress(const std::string& server) {
+  bool is_ipv6 = !server.empty() && server[0] == '[';
+  return NetworkAddress(server, is_ipv6 ? NetworkAddress::IpType::kIpV6 : NetworkAddress::IpType::kIpV4);
+}
+
+}  // namespace
+
+/// @brief Socket connected to a name server, the responses are read on the reactor thread.
+class AsyncDnsResolver::ServerHandler : public EventHandler {
+ public:
+  ServerHandler(AsyncDnsResolver* resolver, Socket socket, std::string server)
+      : resolver_(resolver), socket_(socket), server_(std::move(server)) {
+    SetFd(socket_.GetFd());
+    EnableEvent(EventHandler::EventType::kReadEvent);
+  }
+
+  bool Send(const std::string& message) {
+    if (socket_.Send(message.data(), message.size()) != static_cast<int>(message.size())) {
+      TRPC_FMT_WARN_IF(TRPC_WITHIN_N(1000), "Send dns query to {} failed, errno: {}", server_, errno);
+      return false;
+    }
+    return true;
+  }
+
+  void Close() { socket_.Close(); }
+
+ protected:
+  int HandleReadEvent() override {
+    char buf[dns::kMaxUdpMessageSize * 8];
+    while (true) {
+      int n = socket_.Recv(buf, sizeof(buf), 0);
+      if (n >= 0) {
+        resolver_->OnMessage(buf, n);
+        continue;
+      }
+      // An icmp error of a previous query, e.g. the name server is not listening.
+      if (errno == EINTR || errno == ECONNREFUSED) {
+        continue;
+      }
+      break;
+    }
+    return 0;
+  }
+
+ private:
+  AsyncDnsResolver* resolver_;
+  Socket socket_;
+  std::string server_;
+};
+
+AsyncDnsResolver::AsyncDnsResolver(const Options& options) : options_(options) {
+  options_.attempts = std::max<uint32_t>(options_.attempts, 1);
+  options_.max_ttl_ms = std::max(options_.max_ttl_ms, options_.min_ttl_ms);
+  hosts_names_ = GetHostsNames(options_.hosts_path);
+  ndots_ = GetNdots(options_.resolv_conf_path);
+}
+
+AsyncDnsResolver::~AsyncDnsResolver() { Stop(); }
+
+std::vector<std::string> AsyncDnsResolver::GetSystemNameServers(const std::string& path) {
+  std::vector<std::string> servers;
+  std::ifstream file(path);
+  std::string line;
+  while (std::getline(file, line)) {
+    std::istringstream stream(line);
+    std::string key, ip;
+    if (!(stream >> key >> ip) || key != "nameserver") {
+      continue;
+    }
+    // The scope id of a link local address is not supported.
+    if (ip.find('%') != std::string::npos || !IsIpAddress(ip)) {
+      continue;
+    }
+    servers.push_back(ip.find(':') == std::string::npos ? ip + ":53" : "[" + ip + "]:53");
+  }
+  return servers;
+}
+
+bool AsyncDnsResolver::Start() {
+  if (started_) {
+    return true;
+  }
+
+  std::vector<std::string> servers =
+      options_.servers.empty() ? GetSystemNameServers(options_.resolv_conf_path) : options_.servers;
+  if (servers.empty()) {
+    // Same as the default of the libc resolver.
+    servers.push_back("127.0.0.1:53");
+  }
+
+  ReactorImpl::Options reactor_options;
+  reactor_options.id = 0;
+  reactor_ = std::make_unique<ReactorImpl>(reactor_options);
+  if (!reactor_->Initialize()) {
+    TRPC_LOG_ERROR("Initialize reactor of the dns resolver failed");
+    return false;
+  }
+
+  for (const auto& server : servers) {
+    NetworkAddress addr = ToServerAddress(server);
+    if (addr.Type() == NetworkAddress::IpType::kUnknown) {
+      TRPC_LOG_ERROR("Invalid name server " << server);
+      continue;
+    }
+
+    Socket socket = Socket::CreateUdpSocket(addr.Type() == NetworkAddress::IpType::kIpV6);
+    if (!socket.IsValid() || !socket.SetBlock(false) || socket.Connect(addr) != 0) {
+      TRPC_LOG_ERROR("Create socket to name server " << server << " failed");
+      socket.Close();
+      continue;
+    }
+
+    auto handler = MakeRefCounted<ServerHandler>(this, socket, server);
+    reactor_->Update(handler.get());
+    servers_.push_back(std::move(handler));
+  }
+
+  if (servers_.empty()) {
+    reactor_->Destroy();
+    reactor_.reset();
+    return false;
+  }
+
+  refresh_timer_id_ =
+      reactor_->AddTimerAfter(kRefreshCheckIntervalMs, kRefreshCheckIntervalMs, [this]() { RefreshCache(); });
+
+  Latch latch(1);
+  thread_ = std::thread([this, &latch]() {
+    latch.count_down();
+    reactor_->Run();
+  });
+  latch.wait();
+
+  std::scoped_lock lock(mutex_);
+  started_ = true;
+  return true;
+}
+
+void AsyncDnsResolver::Stop() {
+  if (!started_) {
+    return;
+  }
+
+  {
+    std::scoped_lock lock(mutex_);
+    started_ = false;
+  }
+
+  reactor_->Stop();
+  thread_.join();
+
+  // The reactor thread is gone, its state is released here.
+  reactor_->CancelTimer(refresh_timer_id_);
+  for (auto& [id, query] : queries_) {
+    reactor_->CancelTimer(query.timer_id);
+  }
+  queries_.clear();
+
+  for (auto& server : servers_) {
+    server->DisableAllEvent();
+    reactor_->Update(server.get());
+    server->Close();
+  }
+  servers_.clear();
+  reactor_->Destroy();
+  reactor_.reset();
+
+  std::vector<Promise<std::vector<std::string>>> waiters;
+  {
+    std::scoped_lock lock(mutex_);
+    for (auto& [domain, entry] : cache_) {
+      entry.resolving = false;
+      std::move(entry.waiters.begin(), entry.waiters.end(), std::back_inserter(waiters));
+      entry.waiters.clear();
+    }
+  }
+  FailWaiters(waiters);
+}
+
+bool AsyncDnsResolver::IsResolvable(const std::string& domain) const {
+  if (IsIpAddress(domain)) {
+    return true;
+  }
+  if (hosts_names_.count(NormalizeDomain(domain)) != 0) {
+    return false;
+  }
+  // An absolute name is queried as it is.
+  if (!domain.empty() && domain.back() == '.') {
+    return true;
+  }
+  return static_cast<uint32_t>(std::count(domain.begin(), domain.end(), '.')) >= ndots_;
+}
+
+Future<std::vector<std::string>> AsyncDnsResolver::Resolve(const std::string& domain) {
+  if (IsIpAddress(domain)) {
+    return MakeReadyFuture<std::vector<std::string>>(std::vector<std::string>{domain});
+  }
+
+  uint64_t now_ms = trpc::time::GetMilliSeconds();
+  std::scoped_lock lock(mutex_);
+  if (!started_) {
+    return MakeExceptionFuture<std::vector<std::string>>(CommonException("Dns resolver is not started"));
+  }
+
+  std::string name = NormalizeDomain(domain);
+  auto& entry = cache_[name];
+  entry.last_access_ms = now_ms;
+  bool expired = entry.expire_ms <= now_ms;
+  if (expired && !entry.resolving) {
+    StartLookup(name, entry);
+  }
+
+  // Stale addresses are served while being refreshed.
+  if (!entry.addrs.empty()) {
+    return MakeReadyFuture<std::vector<std::string>>(std::vector<std::string>(entry.addrs));
+  }
+
+  if (!entry.resolving) {
+    return MakeExceptionFuture<std::vector<std::string>>(CommonException(("Resolve " + domain + " failed").c_str()));
+  }
+
+  Promise<std::vector<std::string>> promise;
+  auto future = promise.GetFuture();
+  entry.waiters.push_back(std::move(promise));
+  return future;
+}
+
+bool AsyncDnsResolver::GetCached(const std::string& domain, std::vector<std::string>* addrs) {
+  if (IsIpAddress(domain)) {
+    *addrs = {domain};
+    return true;
+  }
+
+  uint64_t now_ms = trpc::time::GetMilliSeconds();
+  std::scoped_lock lock(mutex_);
+  if (!started_) {
+    return false;
+  }
+
+  std::string name = NormalizeDomain(domain);
+  auto& entry = cache_[name];
+  entry.last_access_ms = now_ms;
+  if (entry.expire_ms <= now_ms && !entry.resolving) {
+    StartLookup(name, entry);
+  }
+
+  if (entry.addrs.empty()) {
+    return false;
+  }
+  *addrs = entry.addrs;
+  return true;
+}
+
+void AsyncDnsResolver::StartLookup(const std::string& domain, CacheEntry& entry) {
+  // The task is submitted with the lock held, so no task is submitted once the resolver is stopping.
+  entry.resolving = reactor_->SubmitTask([this, domain]() { IssueLookup(domain); }, Reactor::Priority::kNormal);
+  if (!entry.resolving) {
+    // The queue of the reactor is full, a failure cached as a name server failure.
+    entry.negative = true;
+    entry.expire_ms = trpc::time::GetMilliSeconds() + options_.negative_ttl_ms;
+    entry.refresh_ms = entry.expire_ms;
+  }
+}
+
+void AsyncDnsResolver::IssueLookup(std::string domain) {
+  auto lookup = std::make_shared<Lookup>();
+  lookup->domain = std::move(domain);
+  lookup->pending = options_.enable_ipv6 ? 2 : 1;
+
+  Query query;
+  query.lookup = lookup;
+  query.type = dns::RecordType::kA;
+  SendQuery(query);
+  if (options_.enable_ipv6) {
+    query.type = dns::RecordType::kAaaa;
+    SendQuery(std::move(query));
+  }
+}
+
+void AsyncDnsResolver::SendQuery(Query query) {
+  uint16_t id;
+  do {
+    id = static_cast<uint16_t>(Random<uint32_t>(0, UINT16_MAX));
+  } while (queries_.count(id));
+
+  std::string message;
+  if (!dns::EncodeQuery(id, query.lookup->domain, query.type, &message)) {
+    TRPC_FMT_ERROR("Invalid domain name {}", query.lookup->domain);
+    FinishQuery(query, nullptr);
+    return;
+  }
+
+  // The name servers are tried in turn, starting from a random one so the load is spread.
+  std::size_t server = (id + query.attempt) % servers_.size();
+  servers_[server]->Send(message);
+
+  query.timer_id = reactor_->AddTimerAfter(options_.timeout_ms, 0, [this, id]() { OnTimeout(id); });
+  queries_.emplace(id, std::move(query));
+}
+
+void AsyncDnsResolver::OnMessage(const char* data, std::size_t size) {
+  dns::DnsMessage message;
+  if (!dns::DecodeMessage(data, size, &message) || !message.is_response) {
+    TRPC_FMT_WARN_IF(TRPC_WITHIN_N(1000), "Invalid dns response of {} bytes", size);
+    return;
+  }
+
+  auto iter = queries_.find(message.id);
+  if (iter == queries_.end()) {
+    // The query has timed out.
+    return;
+  }
+
+  // The question must match, as the ids are easily guessed.
+  Query& query = iter->second;
+  if (message.question_type != query.type || message.question_name != query.lookup->domain) {
+    return;
+  }
+
+  Query finished = std::move(query);
+  queries_.erase(iter);
+  reactor_->CancelTimer(finished.timer_id);
+
+  if (message.rcode != dns::ResponseCode::kNoError && message.rcode != dns::ResponseCode::kNameError) {
+    // The name server failed, the next one is tried.
+    if (++finished.attempt < options_.attempts) {
+      SendQuery(std::move(finished));
+      return;
+    }
+    FinishQuery(finished, nullptr);
+    return;
+  }
+
+  FinishQuery(finished, &message);
+}
+
+void AsyncDnsResolver::OnTimeout(uint16_t id) {
+  auto iter = queries_.find(id);
+  if (iter == queries_.end()) {
+    return;
+  }
+
+  Query query = std::move(iter->second);
+  queries_.erase(iter);
+  reactor_->DetachTimer(query.timer_id);
+
+  if (++query.attempt < options_.attempts) {
+    SendQuery(std::move(query));
+    return;
+  }
+
+  TRPC_FMT_WARN_IF(TRPC_WITHIN_N(1000), "Resolve {} timeout", query.lookup->domain);
+  FinishQuery(query, nullptr);
+}
+
+void AsyncDnsResolver::FinishQuery(Query& query, const dns::DnsMessage* message) {
+  Lookup& lookup = *query.lookup;
+  if (message) {
+    lookup.answered = true;
+    if (!message->addrs.empty()) {
+      lookup.addrs.insert(lookup.addrs.end(), message->addrs.begin(), message->addrs.end());
+      lookup.ttl = std::min(lookup.ttl, message->ttl);
+    } else if (message->negative_ttl) {
+      lookup.negative_ttl = std::min(lookup.negative_ttl, message->negative_ttl);
+    }
+  }
+
+  if (--lookup.pending == 0) {
+    FinishLookup(lookup);
+  }
+}
+
+void AsyncDnsResolver::FinishLookup(const Lookup& lookup) {
+  uint64_t now_ms = trpc::time::GetMilliSeconds();
+  std::vector<Promise<std::vector<std::string>>> waiters;
+  std::vector<std::string> addrs;
+
+  std::unique_lock lock(mutex_);
+  auto& entry = cache_[lookup.domain];
+  entry.resolving = false;
+  waiters.swap(entry.waiters);
+
+  if (!lookup.addrs.empty()) {
+    uint64_t ttl_ms = std::clamp<uint64_t>(static_cast<uint64_t>(lookup.ttl) * 1000, options_.min_ttl_ms,
+                                           options_.max_ttl_ms);
+    // Sorted, so the callers may compare the lists.
+    entry.addrs = lookup.addrs;
+    std::sort(entry.addrs.begin(), entry.addrs.end());
+    entry.addrs.erase(std::unique(entry.addrs.begin(), entry.addrs.end()), entry.addrs.end());
+    entry.negative = false;
+    entry.expire_ms = now_ms + ttl_ms;
+    entry.refresh_ms = now_ms + ttl_ms * kRefreshPercentage / 100;
+    addrs = entry.addrs;
+  } else {
+    // A name without addresses is cached by the ttl in the SOA record. A failure keeps the stale addresses if there
+    // are any, they are better than nothing while the name servers are unavailable.
+    uint64_t ttl_ms = options_.negative_ttl_ms;
+    if (lookup.answered) {
+      if (lookup.negative_ttl != UINT32_MAX) {
+        ttl_ms = std::min<uint64_t>(ttl_ms, static_cast<uint64_t>(lookup.negative_ttl) * 1000);
+      }
+      entry.addrs.clear();
+    }
+    entry.negative = true;
+    entry.expire_ms = now_ms + ttl_ms;
+    entry.refresh_ms = entry.expire_ms;
+  }
+  lock.unlock();
+
+  if (addrs.empty()) {
+    FailWaiters(waiters);
+    return;
+  }
+  for (auto& waiter : waiters) {
+    waiter.SetValue(std::vector<std::string>(addrs));
+  }
+}
+
+void AsyncDnsResolver::RefreshCache() {
+  uint64_t now_ms = trpc::time::GetMilliSeconds();
+  std::vector<std::string> domains;
+  {
+    std::scoped_lock lock(mutex_);
+    for (auto iter = cache_.begin(); iter != cache_.end();) {
+      CacheEntry& entry = iter->second;
+      if (entry.resolving) {
+        ++iter;
+        continue;
+      }
+      if (entry.last_access_ms + options_.idle_timeout_ms <= now_ms) {
+        iter = cache_.erase(iter);
+        continue;
+      }
+      // The names having addresses, stale ones included, are kept refreshed.
+      if (!entry.addrs.empty() && entry.refresh_ms <= now_ms) {
+        entry.resolving = true;
+        domains.push_back(iter->first);
+      }
+      ++iter;
+    }
+  }
+
+  // Already on the reactor thread, no need to submit a task.
+  for (auto& domain : domains) {
+    IssueLookup(std::move(domain));
+  }
+}
+
+void AsyncDnsResolver::FailWaiters(std::vector<Promise<std::vector<std::string>>>& waiters) {
+  for (auto& waiter : waiters) {
+    waiter.SetException(CommonException("Resolve domain failed"));
+  }
+}
+
+}  // namespace trpc::naming
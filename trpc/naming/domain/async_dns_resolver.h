@@ -0,0 +1,171 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "trpc/common/future/future.h"
+#include "trpc/naming/domain/dns_message.h"
+#include "trpc/runtime/iomodel/reactor/common/network_address.h"
+#include "trpc/runtime/iomodel/reactor/default/reactor_impl.h"
+#include "trpc/runtime/iomodel/reactor/event_handler.h"
+
+namespace trpc::naming {
+
+/// @brief Asynchronous resolver of the addresses of domain names, speaking the dns protocol over udp to the name
+/// servers through a reactor of its own, so neither the worker threads nor the periphery tasks block on `getaddrinfo`.
+///
+/// The results are cached by their ttl, the failures and the names without addresses are cached for a short time.
+/// The names recently resolved are refreshed in the background before their ttl expires, and an expired address list
+/// is still served while it is being refreshed, so the callers seldom wait for the name servers.
+///
+/// The names of the hosts file and the relative names resolved through the search list of resolv.conf are not resolved
+/// by the resolver, see `IsResolvable`.
+///
+/// @note Truncated responses are used as they are, there is no fallback to tcp.
+class AsyncDnsResolver {
+ public:
+  struct Options {
+    /// @brief Name servers as "ip:port" or "[ipv6]:port", those of /etc/resolv.conf if empty.
+    std::vector<std::string> servers;
+
+    /// @brief Timeout of a query to a name server, the next one is tried after it.
+    uint32_t timeout_ms{1000};
+
+    /// @brief Number of the queries of a name before it fails.
+    uint32_t attempts{2};
+
+    /// @brief Whether the ipv6 addresses (AAAA records) are resolved as well.
+    bool enable_ipv6{true};
+
+    /// @brief Bounds of the time the addresses are cached, whatever the ttl of the records.
+    uint32_t min_ttl_ms{1000};
+    uint32_t max_ttl_ms{300000};
+
+    /// @brief Time a failure is cached, and the max time a name without addresses is cached.
+    uint32_t negative_ttl_ms{5000};
+
+    /// @brief The names not resolved within this time are no longer refreshed but dropped.
+    uint32_t idle_timeout_ms{600000};
+
+    /// @brief The resolv.conf file, giving the default name servers and the `ndots` option.
+    std::string resolv_conf_path{"/etc/resolv.conf"};
+
+    /// @brief The hosts file, whose names are left to getaddrinfo.
+    std::string hosts_path{"/etc/hosts"};
+  };
+
+  explicit AsyncDnsResolver(const Options& options);
+
+  ~AsyncDnsResolver();
+
+  /// @brief Starts the reactor thread.
+  /// @return false if there is no usable name server.
+  bool Start();
+
+  /// @brief Stops the reactor thread, the resolutions in progress fail.
+  void Stop();
+
+  /// @brief Whether `domain` is resolved by the resolver. The names of the hosts file (e.g. localhost) are not, nor are the
+  ///        relative names having fewer dots than the `ndots` option of resolv.conf, which the libc resolver tries with
+  ///        the search domains first (e.g. the short service names of kubernetes). The callers resolve them by
+  ///        getaddrinfo instead. The files are read when the resolver is created.
+  bool IsResolvable(const std::string& domain) const;
+
+  /// @brief Resolves the addresses of `domain`, an ip address resolves to itself.
+  /// @return A ready future if the name is cached, an exceptional future if it fails.
+  Future<std::vector<std::string>> Resolve(const std::string& domain);
+
+  /// @brief Gets the cached addresses of `domain` without waiting, and keeps it refreshed.
+  /// @return false if no addresses are cached, a resolution is started then if there is none in progress.
+  bool GetCached(const std::string& domain, std::vector<std::string>* addrs);
+
+  /// @brief Gets the name servers of a resolv.conf file, with the default port 53.
+  static std::vector<std::string> GetSystemNameServers(const std::string& path = "/etc/resolv.conf");
+
+ private:
+  struct CacheEntry {
+    std::vector<std::string> addrs;
+    // Whether the name failed or has no addresses, `addrs` may still hold the stale addresses served.
+    bool negative{false};
+    // Time the entry expires, and the time it is refreshed in the background.
+    uint64_t expire_ms{0};
+    uint64_t refresh_ms{0};
+    uint64_t last_access_ms{0};
+    bool resolving{false};
+    std::vector<Promise<std::vector<std::string>>> waiters;
+  };
+
+  // Resolution of a name in progress, it issues a query per record type. Owned by the reactor thread.
+  struct Lookup {
+    std::string domain;
+    uint32_t pending{0};
+    std::vector<std::string> addrs;
+    uint32_t ttl{UINT32_MAX};
+    uint32_t negative_ttl{UINT32_MAX};
+    // Whether a name server answered, the name does not exist or has no addresses then.
+    bool answered{false};
+  };
+
+  struct Query {
+    std::shared_ptr<Lookup> lookup;
+    uint16_t type{0};
+    uint32_t attempt{0};
+    uint64_t timer_id{0};
+  };
+
+  class ServerHandler;
+
+  // Starts resolving `domain` on the reactor thread, called with the lock held.
+  void StartLookup(const std::string& domain, CacheEntry& entry);
+
+  // Run on the reactor thread.
+  void IssueLookup(std::string domain);
+  void SendQuery(Query query);
+  void OnMessage(const char* data, std::size_t size);
+  void OnTimeout(uint16_t id);
+  void FinishQuery(Query& query, const dns::DnsMessage* message);
+  void FinishLookup(const Lookup& lookup);
+  void RefreshCache();
+
+  void FailWaiters(std::vector<Promise<std::vector<std::string>>>& waiters);
+
+ private:
+  Options options_;
+
+  std::unique_ptr<ReactorImpl> reactor_;
+  std::thread thread_;
+  std::vector<RefPtr<ServerHandler>> servers_;
+  uint64_t refresh_timer_id_{0};
+  bool started_{false};
+
+  // Queries in flight by id, accessed on the reactor thread only.
+  std::unordered_map<uint16_t, Query> queries_;
+
+  std::unordered_map<std::string, CacheEntry> cache_;
+  std::mutex mutex_;
+
+  // Names of the hosts file, and the `ndots` option of resolv.conf.
+  std::unordered_set<std::string> hosts_names_;
+  uint32_t ndots_{1};
+};
+
+}  // namespace trpc::naming
@@ -0,0 +1,322 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/naming/domain/async_dns_resolver.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "trpc/future/future_utility.h"
+
+namespace trpc::naming::testing {
+
+namespace {
+
+void AppendUint16(uint16_t value, std::string* out) {
+  out->push_back(static_cast<char>(value >> 8));
+  out->push_back(static_cast<char>(value & 0xff));
+}
+
+void AppendUint32(uint32_t value, std::string* out) {
+  AppendUint16(static_cast<uint16_t>(value >> 16), out);
+  AppendUint16(static_cast<uint16_t>(value & 0xffff), out);
+}
+
+// Name server answering the A queries of the configured names, the other names do not exist.
+class StubNameServer {
+ public:
+  struct Record {
+    std::vector<std::string> addrs;
+    uint32_t ttl{60};
+    // The queries are not answered.
+    bool silent{false};
+  };
+
+  StubNameServer() {
+    fd_ = ::socket(AF_INET, SOCK_DGRAM, 0);
+    struct sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    ::bind(fd_, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr));
+    socklen_t len = sizeof(addr);
+    ::getsockname(fd_, reinterpret_cast<struct sockaddr*>(&addr), &len);
+    port_ = ntohs(addr.sin_port);
+
+    struct timeval timeout = {0, 10000};
+    ::setsockopt(fd_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    thread_ = std::thread([this]() { Serve(); });
+  }
+
+  ~StubNameServer() {
+    stopped_ = true;
+    thread_.join();
+    ::close(fd_);
+  }
+
+  std::string Address() const { return "127.0.0.1:" + std::to_string(port_); }
+
+  void SetRecord(const std::string& name, const Record& record) {
+    std::scoped_lock lock(mutex_);
+    records_[name] = record;
+  }
+
+  int Queries(const std::string& name) {
+    std::scoped_lock lock(mutex_);
+    return queries_[name];
+  }
+
+ private:
+  void Serve() {
+    char buf[512];
+    while (!stopped_) {
+      struct sockaddr_in peer;
+      socklen_t len = sizeof(peer);
+      int n = ::recvfrom(fd_, buf, sizeof(buf), 0, reinterpret_cast<struct sockaddr*>(&peer), &len);
+      dns::DnsMessage query;
+      if (n <= 0 || !dns::DecodeMessage(buf, n, &query)) {
+        continue;
+      }
+
+      std::string response(buf, n);
+      std::unique_lock lock(mutex_);
+      queries_[query.question_name]++;
+      auto iter = records_.find(query.question_name);
+      if (iter != records_.end() && iter->second.silent) {
+        continue;
+      }
+
+      uint16_t ancount = 0;
+      if (iter == records_.end()) {
+        // NXDOMAIN with a SOA record of 1s minimum.
+        response[3] = static_cast<char>(0x80 | dns::ResponseCode::kNameError);
+        response[9] = 1;
+        AppendUint16(0xc00c, &response);
+        AppendUint16(dns::RecordType::kSoa, &response);
+        AppendUint16(1, &response);
+        AppendUint32(60, &response);
+        AppendUint16(28, &response);
+        response.append("\x02ns\x00\x02hm\x00", 8);
+        for (uint32_t field : {1, 2, 3, 4, 1}) {
+          AppendUint32(field, &response);
+        }
+      } else if (query.question_type == dns::RecordType::kA) {
+        for (const auto& addr : iter->second.addrs) {
+          AppendUint16(0xc00c, &response);
+          AppendUint16(dns::RecordType::kA, &response);
+          AppendUint16(1, &response);
+          AppendUint32(iter->second.ttl, &response);
+          AppendUint16(4, &response);
+          char data[4];
+          inet_pton(AF_INET, addr.c_str(), data);
+          response.append(data, 4);
+          ++ancount;
+        }
+      }
+      lock.unlock();
+
+      response[2] = static_cast<char>(0x81);
+      response[7] = static_cast<char>(ancount);
+      ::sendto(fd_, response.data(), response.size(), 0, reinterpret_cast<struct sockaddr*>(&peer), len);
+    }
+  }
+
+ private:
+  int fd_;
+  uint16_t port_;
+  std::atomic<bool> stopped_{false};
+  std::thread thread_;
+  std::mutex mutex_;
+  std::map<std::string, Record> records_;
+  std::map<std::string, int> queries_;
+};
+
+AsyncDnsResolver::Options MakeOptions(const StubNameServer& server) {
+  AsyncDnsResolver::Options options;
+  options.servers = {server.Address()};
+  options.timeout_ms = 100;
+  options.negative_ttl_ms = 5000;
+  return options;
+}
+
+std::vector<std::string> Resolve(AsyncDnsResolver& resolver, const std::string& domain) {
+  auto future = future::BlockingGet(resolver.Resolve(domain));
+  return future.IsReady() ? future.GetValue0() : std::vector<std::string>{};
+}
+
+}  // namespace
+
+TEST(AsyncDnsResolverTest, ResolveAndCache) {
+  StubNameServer server;
+  server.SetRecord("www.example.com", {{"10.0.0.2", "10.0.0.1", "10.0.0.2"}});
+  AsyncDnsResolver resolver(MakeOptions(server));
+  ASSERT_TRUE(resolver.Start());
+
+  std::vector<std::string> addrs;
+  ASSERT_FALSE(resolver.GetCached("www.example.com", &addrs));
+
+  // Sorted and deduplicated.
+  std::vector<std::string> expected({"10.0.0.1", "10.0.0.2"});
+  ASSERT_EQ(Resolve(resolver, "www.example.com"), expected);
+  ASSERT_EQ(Resolve(resolver, "WWW.example.com."), expected);
+  ASSERT_TRUE(resolver.GetCached("www.example.com", &addrs));
+  ASSERT_EQ(addrs, expected);
+  // The A and AAAA queries of the first resolution only.
+  ASSERT_EQ(server.Queries("www.example.com"), 2);
+
+  ASSERT_EQ(Resolve(resolver, "127.0.0.1"), std::vector<std::string>({"127.0.0.1"}));
+  ASSERT_EQ(Resolve(resolver, "::1"), std::vector<std::string>({"::1"}));
+}
+
+TEST(AsyncDnsResolverTest, CoalesceResolutions) {
+  StubNameServer server;
+  server.SetRecord("www.example.com", {{"10.0.0.1"}});
+  auto options = MakeOptions(server);
+  options.enable_ipv6 = false;
+  AsyncDnsResolver resolver(options);
+  ASSERT_TRUE(resolver.Start());
+
+  std::vector<Future<std::vector<std::string>>> futures;
+  for (int i = 0; i < 10; ++i) {
+    futures.push_back(resolver.Resolve("www.example.com"));
+  }
+  for (auto& future : futures) {
+    ASSERT_EQ(future::BlockingGet(std::move(future)).GetValue0(), std::vector<std::string>({"10.0.0.1"}));
+  }
+  ASSERT_EQ(server.Queries("www.example.com"), 1);
+}
+
+TEST(AsyncDnsResolverTest, NegativeCache) {
+  StubNameServer server;
+  auto options = MakeOptions(server);
+  options.enable_ipv6 = false;
+  AsyncDnsResolver resolver(options);
+  ASSERT_TRUE(resolver.Start());
+
+  ASSERT_TRUE(future::BlockingGet(resolver.Resolve("none.example.com")).IsFailed());
+  ASSERT_TRUE(future::BlockingGet(resolver.Resolve("none.example.com")).IsFailed());
+  ASSERT_EQ(server.Queries("none.example.com"), 1);
+
+  // Cached by the minimum of the SOA record, rather than the negative ttl of the options.
+  server.SetRecord("none.example.com", {{"10.0.0.1"}});
+  std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+  ASSERT_EQ(Resolve(resolver, "none.example.com"), std::vector<std::string>({"10.0.0.1"}));
+}
+
+TEST(AsyncDnsResolverTest, Timeout) {
+  StubNameServer server;
+  server.SetRecord("www.example.com", {{"10.0.0.1"}, 60, true});
+  auto options = MakeOptions(server);
+  options.enable_ipv6 = false;
+  options.attempts = 3;
+  AsyncDnsResolver resolver(options);
+  ASSERT_TRUE(resolver.Start());
+
+  auto begin = std::chrono::steady_clock::now();
+  ASSERT_TRUE(future::BlockingGet(resolver.Resolve("www.example.com")).IsFailed());
+  ASSERT_GE(std::chrono::steady_clock::now() - begin, std::chrono::milliseconds(300));
+  ASSERT_EQ(server.Queries("www.example.com"), 3);
+
+  // The failure is cached.
+  ASSERT_TRUE(future::BlockingGet(resolver.Resolve("www.example.com")).IsFailed());
+  ASSERT_EQ(server.Queries("www.example.com"), 3);
+}
+
+TEST(AsyncDnsResolverTest, BackgroundRefresh) {
+  StubNameServer server;
+  server.SetRecord("www.example.com", {{"10.0.0.1"}, 1});
+  auto options = MakeOptions(server);
+  options.enable_ipv6 = false;
+  AsyncDnsResolver resolver(options);
+  ASSERT_TRUE(resolver.Start());
+  ASSERT_EQ(Resolve(resolver, "www.example.com"), std::vector<std::string>({"10.0.0.1"}));
+
+  // Refreshed before the ttl expires, the cached addresses change without a resolution waited for.
+  server.SetRecord("www.example.com", {{"10.0.0.2"}, 1});
+  std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+  std::vector<std::string> addrs;
+  ASSERT_TRUE(resolver.GetCached("www.example.com", &addrs));
+  ASSERT_EQ(addrs, std::vector<std::string>({"10.0.0.2"}));
+  ASSERT_GE(server.Queries("www.example.com"), 2);
+
+  // The stale addresses are served while the name servers fail.
+  server.SetRecord("www.example.com", {{"10.0.0.3"}, 1, true});
+  std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+  ASSERT_EQ(Resolve(resolver, "www.example.com"), std::vector<std::string>({"10.0.0.2"}));
+}
+
+TEST(AsyncDnsResolverTest, GetSystemNameServers) {
+  std::string path = "async_dns_resolver_test_resolv.conf";
+  {
+    std::ofstream file(path);
+    file << "# comment\nsearch example.com\nnameserver 10.0.0.1\nnameserver fe80::1%eth0\nnameserver ::1\n";
+  }
+  ASSERT_EQ(AsyncDnsResolver::GetSystemNameServers(path), std::vector<std::string>({"10.0.0.1:53", "[::1]:53"}));
+  ::unlink(path.c_str());
+
+  ASSERT_TRUE(AsyncDnsResolver::GetSystemNameServers("not_exist.conf").empty());
+}
+
+TEST(AsyncDnsResolverTest, IsResolvable) {
+  AsyncDnsResolver::Options options;
+  options.resolv_conf_path = "async_dns_resolver_test_ndots.conf";
+  options.hosts_path = "async_dns_resolver_test_hosts";
+  {
+    std::ofstream file(options.resolv_conf_path);
+    file << "search default.svc.cluster.local svc.cluster.local\nnameserver 10.0.0.1\noptions ndots:2 timeout:1\n";
+  }
+  {
+    std::ofstream file(options.hosts_path);
+    file << "# comment\n127.0.0.1 localhost\n10.0.0.5   db.internal.example.com db  # alias\n";
+  }
+  AsyncDnsResolver resolver(options);
+  ::unlink(options.resolv_conf_path.c_str());
+  ::unlink(options.hosts_path.c_str());
+
+  // The names of the hosts file.
+  ASSERT_FALSE(resolver.IsResolvable("localhost"));
+  ASSERT_FALSE(resolver.IsResolvable("DB.internal.example.com."));
+  ASSERT_FALSE(resolver.IsResolvable("db"));
+  // The names tried with the search domains first.
+  ASSERT_FALSE(resolver.IsResolvable("my-service"));
+  ASSERT_FALSE(resolver.IsResolvable("my-service.other-namespace"));
+  ASSERT_TRUE(resolver.IsResolvable("my-service.other-namespace."));
+  ASSERT_TRUE(resolver.IsResolvable("www.example.com"));
+  ASSERT_TRUE(resolver.IsResolvable("10.0.0.1"));
+
+  // No ndots option, only the single label names are tried with the search domains first.
+  options.resolv_conf_path = "not_exist.conf";
+  AsyncDnsResolver default_resolver(options);
+  ASSERT_FALSE(default_resolver.IsResolvable("my-service"));
+  ASSERT_TRUE(default_resolver.IsResolvable("example.com"));
+}
+
+TEST(AsyncDnsResolverTest, NotStarted) {
+  AsyncDnsResolver::Options options;
+  AsyncDnsResolver resolver(options);
+  ASSERT_TRUE(future::BlockingGet(resolver.Resolve("www.example.com")).IsFailed());
+}
+
+}  // namespace trpc::naming::testing
@@ -0,0 +1,266 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/naming/domain/dns_message.h"
+
+#include <arpa/inet.h>
+
+#include <algorithm>
+
+namespace trpc::naming::dns {
+
+namespace {
+
+constexpr uint16_t kClassIn = 1;
+constexpr uint16_t kFlagResponse = 0x8000;
+constexpr uint16_t kFlagTruncated = 0x0200;
+constexpr uint16_t kFlagRecursionDesired = 0x0100;
+constexpr std::size_t kMaxNameSize = 255;
+constexpr std::size_t kMaxLabelSize = 63;
+// Bounds the compression pointers followed in a name, so a malicious loop is detected.
+constexpr int kMaxPointerJumps = 16;
+
+void AppendUint16(uint16_t value, std::string* out) {
+  out->push_back(static_cast<char>(value >> 8));
+  out->push_back(static_cast<char>(value & 0xff));
+}
+
+class Reader {
+ public:
+  Reader(const char* data, std::size_t size)
+      : data_(reinterpret_cast<const uint8_t*>(data)), size_(size) {}
+
+  bool ReadUint16(uint16_t* value) {
+    if (pos_ + 2 > size_) {
+      return false;
+    }
+    *value = static_cast<uint16_t>(data_[pos_] << 8 | data_[pos_ + 1]);
+    pos_ += 2;
+    return true;
+  }
+
+  bool ReadUint32(uint32_t* value) {
+    uint16_t high, low;
+    if (!ReadUint16(&high) || !ReadUint16(&low)) {
+      return false;
+    }
+    *value = static_cast<uint32_t>(high) << 16 | low;
+    return true;
+  }
+
+  bool Skip(std::size_t size) {
+    if (pos_ + size > size_) {
+      return false;
+    }
+    pos_ += size;
+    return true;
+  }
+
+  // Reads a possibly compressed name, in lower case without the trailing dot.
+  bool ReadName(std::string* name) {
+    name->clear();
+    std::size_t pos = pos_;
+    std::size_t end = 0;
+    int jumps = 0;
+    while (true) {
+      if (pos >= size_) {
+        return false;
+      }
+      uint8_t length = data_[pos];
+      if ((length & 0xc0) == 0xc0) {
+        if (pos + 1 >= size_ || ++jumps > kMaxPointerJumps) {
+          return false;
+        }
+        if (end == 0) {
+          end = pos + 2;
+        }
+        pos = static_cast<std::size_t>(length & 0x3f) << 8 | data_[pos + 1];
+        continue;
+      }
+      if (length > kMaxLabelSize) {
+        return false;
+      }
+      ++pos;
+      if (length == 0) {
+        break;
+      }
+      if (pos + length > size_ || name->size() + length + 1 > kMaxNameSize) {
+        return false;
+      }
+      if (!name->empty()) {
+        name->push_back('.');
+      }
+      for (std::size_t i = 0; i != length; ++i) {
+        char c = static_cast<char>(data_[pos + i]);
+        name->push_back(c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c);
+      }
+      pos += length;
+    }
+    pos_ = end ? end : pos;
+    return true;
+  }
+
+  std::size_t Position() const { return pos_; }
+
+  const uint8_t* Data() const { return data_; }
+
+ private:
+  const uint8_t* data_;
+  std::size_t size_;
+  std::size_t pos_{0};
+};
+
+bool ReadAnswer(Reader& reader, DnsMessage* message) {
+  std::string name;
+  uint16_t type, cls, rdlength;
+  uint32_t ttl;
+  if (!reader.ReadName(&name) || !reader.ReadUint16(&type) || !reader.ReadUint16(&cls) ||
+      !reader.ReadUint32(&ttl) || !reader.ReadUint16(&rdlength)) {
+    return false;
+  }
+
+  const uint8_t* rdata = reader.Data() + reader.Position();
+  if (!reader.Skip(rdlength)) {
+    return false;
+  }
+  if (cls != kClassIn || type != message->question_type) {
+    return true;
+  }
+
+  char buf[INET6_ADDRSTRLEN];
+  if (type == RecordType::kA && rdlength == 4) {
+    inet_ntop(AF_INET, rdata, buf, sizeof(buf));
+  } else if (type == RecordType::kAaaa && rdlength == 16) {
+    inet_ntop(AF_INET6, rdata, buf, sizeof(buf));
+  } else {
+    return true;
+  }
+
+  message->ttl = message->addrs.empty() ? ttl : std::min(message->ttl, ttl);
+  message->addrs.emplace_back(buf);
+  return true;
+}
+
+bool ReadAuthority(Reader& reader, DnsMessage* message) {
+  std::string name;
+  uint16_t type, cls, rdlength;
+  uint32_t ttl;
+  if (!reader.ReadName(&name) || !reader.ReadUint16(&type) || !reader.ReadUint16(&cls) ||
+      !reader.ReadUint32(&ttl) || !reader.ReadUint16(&rdlength)) {
+    return false;
+  }
+
+  std::size_t end = reader.Position() + rdlength;
+  if (type != RecordType::kSoa) {
+    return reader.Skip(rdlength);
+  }
+
+  // MNAME, RNAME, SERIAL, REFRESH, RETRY, EXPIRE and MINIMUM.
+  std::string mname, rname;
+  uint32_t fields[5];
+  if (!reader.ReadName(&mname) || !reader.ReadName(&rname)) {
+    return false;
+  }
+  for (auto& field : fields) {
+    if (!reader.ReadUint32(&field)) {
+      return false;
+    }
+  }
+  if (reader.Position() != end) {
+    return false;
+  }
+
+  message->negative_ttl = std::min(ttl, fields[4]);
+  return true;
+}
+
+}  // namespace
+
+bool EncodeQuery(uint16_t id, std::string_view name, uint16_t type, std::string* out) {
+  if (!name.empty() && name.back() == '.') {
+    name.remove_suffix(1);
+  }
+  if (name.empty() || name.size() > kMaxNameSize - 2) {
+    return false;
+  }
+
+  out->clear();
+  out->reserve(kHeaderSize + name.size() + 6);
+  AppendUint16(id, out);
+  AppendUint16(kFlagRecursionDesired, out);
+  // QDCOUNT, ANCOUNT, NSCOUNT and ARCOUNT.
+  AppendUint16(1, out);
+  AppendUint16(0, out);
+  AppendUint16(0, out);
+  AppendUint16(0, out);
+
+  std::size_t begin = 0;
+  while (begin <= name.size()) {
+    std::size_t end = name.find('.', begin);
+    if (end == std::string_view::npos) {
+      end = name.size();
+    }
+    std::size_t length = end - begin;
+    if (length == 0 || length > kMaxLabelSize) {
+      return false;
+    }
+    out->push_back(static_cast<char>(length));
+    out->append(name.data() + begin, length);
+    begin = end + 1;
+  }
+  out->push_back('\0');
+
+  AppendUint16(type, out);
+  AppendUint16(kClassIn, out);
+  return true;
+}
+
+bool DecodeMessage(const char* data, std::size_t size, DnsMessage* message) {
+  Reader reader(data, size);
+  uint16_t flags, qdcount, ancount, nscount, arcount;
+  if (!reader.ReadUint16(&message->id) || !reader.ReadUint16(&flags) || !reader.ReadUint16(&qdcount) ||
+      !reader.ReadUint16(&ancount) || !reader.ReadUint16(&nscount) || !reader.ReadUint16(&arcount)) {
+    return false;
+  }
+
+  message->is_response = flags & kFlagResponse;
+  message->truncated = flags & kFlagTruncated;
+  message->rcode = static_cast<uint8_t>(flags & 0x0f);
+  message->addrs.clear();
+  message->ttl = 0;
+  message->negative_ttl = 0;
+
+  if (qdcount != 1) {
+    return false;
+  }
+  uint16_t cls;
+  if (!reader.ReadName(&message->question_name) || !reader.ReadUint16(&message->question_type) ||
+      !reader.ReadUint16(&cls)) {
+    return false;
+  }
+
+  // A truncated message may end in the middle of a record, the complete records are kept.
+  for (uint16_t i = 0; i != ancount; ++i) {
+    if (!ReadAnswer(reader, message)) {
+      return message->truncated;
+    }
+  }
+  for (uint16_t i = 0; i != nscount; ++i) {
+    if (!ReadAuthority(reader, message)) {
+      return message->truncated;
+    }
+  }
+  return true;
+}
+
+}  // namespace trpc::naming::dns
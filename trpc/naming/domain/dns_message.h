@@ -0,0 +1,76 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace trpc::naming::dns {
+
+/// @brief Types of the resource records handled.
+enum RecordType : uint16_t {
+  kA = 1,
+  kCname = 5,
+  kSoa = 6,
+  kAaaa = 28,
+};
+
+/// @brief Response codes of the header.
+enum ResponseCode : uint8_t {
+  kNoError = 0,
+  kFormatError = 1,
+  kServerFailure = 2,
+  kNameError = 3,
+};
+
+/// @brief Size of the header of a dns message.
+constexpr std::size_t kHeaderSize = 12;
+
+/// @brief Max size of a dns message over udp without EDNS.
+constexpr std::size_t kMaxUdpMessageSize = 512;
+
+/// @brief The fields of a dns message needed by the resolver.
+struct DnsMessage {
+  uint16_t id{0};
+  bool is_response{false};
+  bool truncated{false};
+  uint8_t rcode{ResponseCode::kNoError};
+
+  /// @brief Name and type of the (first) question.
+  std::string question_name;
+  uint16_t question_type{0};
+
+  /// @brief Addresses of the answers of the question type, following the CNAME chain given by the server.
+  std::vector<std::string> addrs;
+
+  /// @brief Min ttl of the addresses in seconds.
+  uint32_t ttl{0};
+
+  /// @brief Ttl of a negative answer in seconds, the min of the SOA record ttl and its MINIMUM field (RFC 2308),
+  /// 0 if there is no SOA record in the authority section.
+  uint32_t negative_ttl{0};
+};
+
+/// @brief Encodes a recursive query of the type of `name` into `out`.
+/// @return false if `name` is not a valid domain name.
+bool EncodeQuery(uint16_t id, std::string_view name, uint16_t type, std::string* out);
+
+/// @brief Decodes a dns message, the records other than addresses and SOA are skipped.
+/// @return false if the message is malformed.
+bool DecodeMessage(const char* data, std::size_t size, DnsMessage* message);
+
+}  // namespace trpc::naming::dns
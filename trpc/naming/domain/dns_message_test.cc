@@ -0,0 +1,136 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/naming/domain/dns_message.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace trpc::naming::dns::testing {
+
+namespace {
+
+void AppendUint16(uint16_t value, std::string* out) {
+  out->push_back(static_cast<char>(value >> 8));
+  out->push_back(static_cast<char>(value & 0xff));
+}
+
+void AppendUint32(uint32_t value, std::string* out) {
+  AppendUint16(static_cast<uint16_t>(value >> 16), out);
+  AppendUint16(static_cast<uint16_t>(value & 0xffff), out);
+}
+
+// Turns a query into a response header with the given counts.
+std::string MakeResponse(const std::string& query, uint8_t rcode, uint16_t ancount, uint16_t nscount) {
+  std::string response = query;
+  response[2] = static_cast<char>(0x81);
+  response[3] = static_cast<char>(0x80 | rcode);
+  response[6] = static_cast<char>(ancount >> 8);
+  response[7] = static_cast<char>(ancount & 0xff);
+  response[8] = static_cast<char>(nscount >> 8);
+  response[9] = static_cast<char>(nscount & 0xff);
+  return response;
+}
+
+}  // namespace
+
+TEST(DnsMessageTest, EncodeQuery) {
+  std::string query;
+  ASSERT_TRUE(EncodeQuery(0x1234, "www.Example.com.", RecordType::kA, &query));
+  ASSERT_EQ(query, std::string("\x12\x34\x01\x00\x00\x01\x00\x00\x00\x00\x00\x00"
+                               "\x03www\x07" "Example\x03" "com\x00\x00\x01\x00\x01",
+                               33));
+
+  DnsMessage message;
+  ASSERT_TRUE(DecodeMessage(query.data(), query.size(), &message));
+  ASSERT_EQ(message.id, 0x1234);
+  ASSERT_FALSE(message.is_response);
+  ASSERT_EQ(message.question_name, "www.example.com");
+  ASSERT_EQ(message.question_type, RecordType::kA);
+
+  ASSERT_FALSE(EncodeQuery(1, "", RecordType::kA, &query));
+  ASSERT_FALSE(EncodeQuery(1, "www..com", RecordType::kA, &query));
+  ASSERT_FALSE(EncodeQuery(1, std::string(64, 'a') + ".com", RecordType::kA, &query));
+}
+
+TEST(DnsMessageTest, DecodeAnswers) {
+  std::string query;
+  ASSERT_TRUE(EncodeQuery(1, "www.example.com", RecordType::kA, &query));
+  std::string response = MakeResponse(query, ResponseCode::kNoError, 3, 0);
+
+  // www.example.com CNAME cdn.example.com, the name is compressed.
+  AppendUint16(0xc00c, &response);
+  AppendUint16(RecordType::kCname, &response);
+  AppendUint16(1, &response);
+  AppendUint32(300, &response);
+  AppendUint16(6, &response);
+  response.append("\x03" "cdn\xc0\x10", 6);
+  std::size_t cdn_offset = response.size() - 6;
+
+  for (uint32_t ttl : {60, 30}) {
+    AppendUint16(static_cast<uint16_t>(0xc000 | cdn_offset), &response);
+    AppendUint16(RecordType::kA, &response);
+    AppendUint16(1, &response);
+    AppendUint32(ttl, &response);
+    AppendUint16(4, &response);
+    response.append(std::string("\x0a\x00\x00", 3) + static_cast<char>(ttl));
+  }
+
+  DnsMessage message;
+  ASSERT_TRUE(DecodeMessage(response.data(), response.size(), &message));
+  ASSERT_TRUE(message.is_response);
+  ASSERT_EQ(message.rcode, ResponseCode::kNoError);
+  ASSERT_EQ(message.addrs, std::vector<std::string>({"10.0.0.60", "10.0.0.30"}));
+  ASSERT_EQ(message.ttl, 30);
+
+  // Cut in the middle of a record.
+  ASSERT_FALSE(DecodeMessage(response.data(), response.size() - 2, &message));
+  response[2] |= 0x02;
+  ASSERT_TRUE(DecodeMessage(response.data(), response.size() - 2, &message));
+  ASSERT_TRUE(message.truncated);
+  ASSERT_EQ(message.addrs, std::vector<std::string>({"10.0.0.60"}));
+}
+
+TEST(DnsMessageTest, DecodeNegativeAnswer) {
+  std::string query;
+  ASSERT_TRUE(EncodeQuery(1, "none.example.com", RecordType::kAaaa, &query));
+  std::string response = MakeResponse(query, ResponseCode::kNameError, 0, 1);
+
+  AppendUint16(0xc011, &response);
+  AppendUint16(RecordType::kSoa, &response);
+  AppendUint16(1, &response);
+  AppendUint32(900, &response);
+  AppendUint16(28, &response);
+  response.append("\x02ns\x00\x02hm\x00", 8);
+  for (uint32_t field : {1, 2, 3, 4, 120}) {
+    AppendUint32(field, &response);
+  }
+
+  DnsMessage message;
+  ASSERT_TRUE(DecodeMessage(response.data(), response.size(), &message));
+  ASSERT_EQ(message.rcode, ResponseCode::kNameError);
+  ASSERT_TRUE(message.addrs.empty());
+  ASSERT_EQ(message.negative_ttl, 120);
+}
+
+TEST(DnsMessageTest, DecodeMalformed) {
+  DnsMessage message;
+  ASSERT_FALSE(DecodeMessage("\x00\x01", 2, &message));
+
+  // The compression pointer of the question points to itself.
+  std::string looped("\x00\x01\x81\x80\x00\x01\x00\x00\x00\x00\x00\x00\xc0\x0c\x00\x01\x00\x01", 18);
+  ASSERT_FALSE(DecodeMessage(looped.data(), looped.size(), &message));
+}
+
+}  // namespace trpc::naming::dns::testing
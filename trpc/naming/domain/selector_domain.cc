@@ -13,12 +13,16 @@
 
 #include "trpc/naming/domain/selector_domain.h"
 
+#include <algorithm>
 #include <memory>
 #include <set>
 #include <sstream>
 #include <utility>
 
 #include "trpc/common/config/trpc_config.h"
+#include "trpc/coroutine/fiber.h"
+#include "trpc/coroutine/future.h"
+#include "trpc/future/future_utility.h"
 #include "trpc/naming/common/util/loadbalance/polling/polling_load_balance.h"
 #include "trpc/naming/load_balance_factory.h"
 #include "trpc/naming/selector_factory.h"
@@ -30,6 +34,13 @@
 
 namespace trpc {
 
+namespace {
+
+// Interval of updating the names resolved by getaddrinfo, including those left to it by the asynchronous resolver
+constexpr uint64_t kGetAddrInfoUpdateIntervalMs = 30 * 1000;
+
+}  // namespace
+
 SelectorDomain::SelectorDomain(const LoadBalancePtr& load_balance) : default_load_balance_(load_balance) {
   TRPC_ASSERT(default_load_balance_);
   dn_update_interval_ = 3600;
@@ -40,19 +51,59 @@ int SelectorDomain::Init() noexcept {
     TRPC_FMT_DEBUG("get selector domain config failed, use default value");
   }
 
-  // domain update duration is 30s
-  dn_update_interval_ = 30 * 1000;
+  if (select_config_.circuit_break.enable) {
+    circuit_breaker_ = std::make_unique<naming::CircuitBreaker>(select_config_.circuit_break);
+  }
+
+  // domain update duration is 30s. The asynchronous resolver refreshes its cache in the background, reading the cache
+  // is cheap, so the changes are applied within 1s
+  dn_update_interval_ = kGetAddrInfoUpdateIntervalMs;
+  if (select_config_.async_dns.enable) {
+    naming::AsyncDnsResolver::Options options;
+    options.servers = select_config_.async_dns.servers;
+    options.timeout_ms = select_config_.async_dns.timeout_ms;
+    options.attempts = select_config_.async_dns.attempts;
+    options.min_ttl_ms = select_config_.async_dns.min_ttl_ms;
+    options.max_ttl_ms = select_config_.async_dns.max_ttl_ms;
+    options.negative_ttl_ms = select_config_.async_dns.negative_ttl_ms;
+    dns_resolver_ = std::make_unique<naming::AsyncDnsResolver>(options);
+    if (!dns_resolver_->Start()) {
+      TRPC_FMT_ERROR("start async dns resolver failed, use getaddrinfo instead");
+      dns_resolver_.reset();
+    } else {
+      dn_update_interval_ = 1000;
+    }
+  }
   last_update_time_ = trpc::time::GetMilliSeconds();
 
   return 0;
 }
 
+void SelectorDomain::ResolveDomain(const std::string& dn_name, bool wait, std::vector<std::string>& ip_list) {
+  // The names of the hosts file and the ones resolved through the search domains are left to getaddrinfo
+  if (!dns_resolver_ || !dns_resolver_->IsResolvable(dn_name)) {
+    trpc::util::GetAddrFromDomain(dn_name, ip_list);
+    return;
+  }
+
+  if (!wait) {
+    dns_resolver_->GetCached(dn_name, &ip_list);
+    return;
+  }
+
+  // Waits no longer than the timeout of the resolver, without blocking the fiber worker
+  auto fut = dns_resolver_->Resolve(dn_name);
+  fut = trpc::IsRunningInFiberWorker() ? fiber::BlockingGet(std::move(fut)) : future::BlockingGet(std::move(fut));
+  if (fut.IsReady()) {
+    ip_list = fut.GetValue0();
+  }
+}
+
 int SelectorDomain::RefreshEndpointInfoByName(std::string dn_name, int dn_port,
-                                              SelectorDomain::DomainEndpointInfo& endpointInfo) {
+                                              SelectorDomain::DomainEndpointInfo& endpointInfo, bool wait) {
   std::vector<std::string> ip_list;
-  trpc::util::GetAddrFromDomain(dn_name, ip_list);
+  ResolveDomain(dn_name, wait, ip_list);
   if (ip_list.empty()) {
-    TRPC_LOG_ERROR("Get address info of " << dn_name << " failed");
     return -1;
   }
 
@@ -93,10 +144,13 @@ int SelectorDomain::RefreshDomainInfo(const SelectorInfo* info, SelectorDomain::
 
   std::unique_lock<std::shared_mutex> uniq_lock(mutex_);
   // Generate a unique id for the node
+  std::vector<TrpcEndpointInfo> old_endpoints;
   auto iter = targets_map_.find(info->name);
-  if (iter != targets_map_.end()) {
+  bool is_new = (iter == targets_map_.end());
+  if (!is_new) {
     // If the service name is in the cache, use the original id generator
     dn_endpointInfo.id_generator = std::move(iter->second.id_generator);
+    old_endpoints.swap(iter->second.endpoints);
   }
 
   for (auto& item : dn_endpointInfo.endpoints) {
@@ -104,18 +158,46 @@ int SelectorDomain::RefreshDomainInfo(const SelectorInfo* info, SelectorDomain::
     item.id = dn_endpointInfo.id_generator.GetEndpointId(endpoint);
   }
 
+  dn_endpointInfo.load_balance_name = info->load_balance_name;
   targets_map_[info->name] = dn_endpointInfo;
 
+  auto snapshot = std::make_unique<naming::EndpointSnapshot>();
+  snapshot->endpoints = dn_endpointInfo.endpoints;
+  endpoint_snapshots_.GetOrCreate(info->name)->Publish(std::move(snapshot));
+
   uniq_lock.unlock();
 
+  endpoint_watchers_.Notify(info->name, is_new ? nullptr : &old_endpoints, dn_endpointInfo.endpoints);
+
+  if (circuit_breaker_) {
+    circuit_breaker_->SetEndpoints(info->name, dn_endpointInfo.endpoints);
+    return UpdateLoadBalance(info->name, GetLoadBalance(info->load_balance_name));
+  }
+
   // update loadbalance cache
   LoadBalanceInfo lb_info;
   lb_info.info = info;
   lb_info.endpoints = &dn_endpointInfo.endpoints;
-  default_load_balance_->Update(&lb_info);
+  GetLoadBalance(info->load_balance_name)->Update(&lb_info);
   return 0;
 }
 
+int SelectorDomain::UpdateLoadBalance(const std::string& name, LoadBalance* load_balance) {
+  // Serializes the updates so a stale list of endpoints never overwrites a newer one
+  std::scoped_lock lock(load_balance_update_mutex_);
+  std::vector<TrpcEndpointInfo> endpoints;
+  if (!circuit_breaker_->GetAvailableEndpoints(name, &endpoints)) {
+    return -1;
+  }
+
+  SelectorInfo selector_info;
+  selector_info.name = name;
+  LoadBalanceInfo lb_info;
+  lb_info.info = &selector_info;
+  lb_info.endpoints = &endpoints;
+  return load_balance->Update(&lb_info);
+}
+
 LoadBalance* SelectorDomain::GetLoadBalance(const std::string& name) {
   if (!name.empty()) {
     auto load_balance = LoadBalanceFactory::GetInstance()->Get(name).get();
@@ -127,6 +209,33 @@ LoadBalance* SelectorDomain::GetLoadBalance(const std::string& name) {
   return default_load_balance_.get();
 }
 
+LoadBalance* SelectorDomain::GetLoadBalance(const SelectorInfo* info) {
+  if (info->load_balance_handle) {
+    return info->load_balance_handle->load_balance.Get();
+  }
+  return GetLoadBalance(info->load_balance_name);
+}
+
+bool SelectorDomain::NeedInvokeResult(const SelectorInfo* info) {
+  return circuit_breaker_ || GetLoadBalance(info->load_balance_name)->NeedInvokeResult();
+}
+
+bool SelectorDomain::GetLoadBalanceHandle(const SelectorInfo* info, LoadBalanceHandle* handle) {
+  return GetLoadBalance(info->load_balance_name)->GetHandle(info->name, handle);
+}
+
+uint64_t SelectorDomain::WatchEndpoints(const std::string& name, EndpointsAddedFunction&& func) {
+  // The current endpoints are reported with the lock held, so no endpoint added meanwhile is missed
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  auto iter = targets_map_.find(name);
+  if (iter == targets_map_.end()) {
+    return endpoint_watchers_.Watch(name, std::move(func), {});
+  }
+  return endpoint_watchers_.Watch(name, std::move(func), iter->second.endpoints);
+}
+
+void SelectorDomain::UnwatchEndpoints(uint64_t watch_id) { endpoint_watchers_.Unwatch(watch_id); }
+
 // Get the routing interface of the node being called
 int SelectorDomain::Select(const SelectorInfo* info, TrpcEndpointInfo* endpoint) {
   if (nullptr == info || nullptr == endpoint) {
@@ -134,15 +243,20 @@ int SelectorDomain::Select(const SelectorInfo* info, TrpcEndpointInfo* endpoint)
     return -1;
   }
 
+  // The endpoints recovering from ejection are probed first
+  if (circuit_breaker_ && circuit_breaker_->SelectProbe(info->name, endpoint)) {
+    return 0;
+  }
+
   LoadBalanceResult load_balance_result;
   load_balance_result.info = info;
-  auto lb = GetLoadBalance(info->load_balance_name);
+  auto lb = GetLoadBalance(info);
   if (lb->Next(load_balance_result)) {
     TRPC_LOG_ERROR("Do load balance of " << info->name << " failed");
     return -1;
   }
 
-  *endpoint = std::any_cast<TrpcEndpointInfo>(load_balance_result.result);
+  *endpoint = load_balance_result.TakeEndpoint();
   return 0;
 }
 
@@ -153,16 +267,21 @@ Future<TrpcEndpointInfo> SelectorDomain::AsyncSelect(const SelectorInfo* info) {
     return MakeExceptionFuture<TrpcEndpointInfo>(CommonException("Selector info is null"));
   }
 
+  TrpcEndpointInfo probe;
+  if (circuit_breaker_ && circuit_breaker_->SelectProbe(info->name, &probe)) {
+    return MakeReadyFuture<TrpcEndpointInfo>(std::move(probe));
+  }
+
   LoadBalanceResult load_balance_result;
   load_balance_result.info = info;
-  auto lb = GetLoadBalance(info->load_balance_name);
+  auto lb = GetLoadBalance(info);
   if (lb->Next(load_balance_result)) {
     std::string error_str = "Do load balance of " + info->name + " failed";
     TRPC_LOG_ERROR(error_str);
     return MakeExceptionFuture<TrpcEndpointInfo>(CommonException(error_str.c_str()));
   }
 
-  TrpcEndpointInfo endpoint = std::any_cast<TrpcEndpointInfo>(load_balance_result.result);
+  TrpcEndpointInfo endpoint = load_balance_result.TakeEndpoint();
   return MakeReadyFuture<TrpcEndpointInfo>(std::move(endpoint));
 }
 
@@ -173,18 +292,28 @@ int SelectorDomain::SelectBatch(const SelectorInfo* info, std::vector<TrpcEndpoi
     return -1;
   }
 
-  std::string callee = info->name;
-  std::shared_lock<std::shared_mutex> lock(mutex_);
-  auto iter = targets_map_.find(callee);
-  if (iter == targets_map_.end()) {
+  const std::string& callee = info->name;
+  naming::EndpointSnapshotSlot* slot = endpoint_snapshots_.Find(callee);
+  Hazptr hazptr;
+  const naming::EndpointSnapshot* snapshot = slot ? slot->Read(&hazptr) : nullptr;
+  if (nullptr == snapshot) {
     TRPC_LOG_ERROR("router info of " << callee << " no found");
     return -1;
   }
 
+  // The endpoints ejected by the circuit breaker are excluded
+  std::vector<TrpcEndpointInfo> available;
+  const std::vector<TrpcEndpointInfo>* candidates = &snapshot->endpoints;
+  if (circuit_breaker_) {
+    available = snapshot->endpoints;
+    circuit_breaker_->FilterEndpoints(callee, &available);
+    candidates = &available;
+  }
+
   if (info->policy == SelectorPolicy::MULTIPLE) {
-    SelectMultiple(iter->second.endpoints, endpoints, info->select_num);
+    SelectMultiple(*candidates, endpoints, info->select_num);
   } else {
-    *endpoints = iter->second.endpoints;
+    *endpoints = *candidates;
   }
 
   return 0;
@@ -197,20 +326,30 @@ Future<std::vector<TrpcEndpointInfo>> SelectorDomain::AsyncSelectBatch(const Sel
     return MakeExceptionFuture<std::vector<TrpcEndpointInfo>>(CommonException("Selector info is empty"));
   }
 
-  std::string callee = info->name;
-  std::shared_lock<std::shared_mutex> lock(mutex_);
-  auto iter = targets_map_.find(callee);
-  if (iter == targets_map_.end()) {
+  const std::string& callee = info->name;
+  naming::EndpointSnapshotSlot* slot = endpoint_snapshots_.Find(callee);
+  Hazptr hazptr;
+  const naming::EndpointSnapshot* snapshot = slot ? slot->Read(&hazptr) : nullptr;
+  if (nullptr == snapshot) {
     std::string error_str = "router info of " + callee + " no found";
     TRPC_LOG_ERROR(error_str);
     return MakeExceptionFuture<std::vector<TrpcEndpointInfo>>(CommonException(error_str.c_str()));
   }
 
   std::vector<TrpcEndpointInfo> endpoints;
+  // The endpoints ejected by the circuit breaker are excluded
+  std::vector<TrpcEndpointInfo> available;
+  const std::vector<TrpcEndpointInfo>* candidates = &snapshot->endpoints;
+  if (circuit_breaker_) {
+    available = snapshot->endpoints;
+    circuit_breaker_->FilterEndpoints(callee, &available);
+    candidates = &available;
+  }
+
   if (info->policy == SelectorPolicy::MULTIPLE) {
-    SelectMultiple(iter->second.endpoints, &endpoints, info->select_num);
+    SelectMultiple(*candidates, &endpoints, info->select_num);
   } else {
-    endpoints = iter->second.endpoints;
+    endpoints = *candidates;
   }
 
   return MakeReadyFuture<std::vector<TrpcEndpointInfo>>(std::move(endpoints));
@@ -223,7 +362,27 @@ int SelectorDomain::ReportInvokeResult(const InvokeResult* result) {
     return -1;
   }
 
-  return 0;
+  // Feed the result back to the load balancer which selected the endpoint
+  const ServiceProxyOption* option = result->context ? result->context->GetServiceProxyOption() : nullptr;
+  auto lb = option ? GetLoadBalance(option->load_balance_name) : default_load_balance_.get();
+  int ret = lb->UpdateInvokeResult(result);
+
+  // Update the load balancer once an endpoint is ejected or admitted again
+  if (circuit_breaker_ && circuit_breaker_->ReportInvokeResult(result)) {
+    if (UpdateLoadBalance(result->name, lb)) {
+      return -1;
+    }
+  }
+  return ret;
+}
+
+bool SelectorDomain::SetCircuitBreakWhiteList(const std::vector<int>& framework_retcodes) {
+  if (!circuit_breaker_) {
+    return false;
+  }
+
+  circuit_breaker_->SetWhiteList(framework_retcodes);
+  return true;
 }
 
 int SelectorDomain::SetEndpoints(const RouterInfo* info) {
@@ -250,6 +409,7 @@ int SelectorDomain::SetEndpoints(const RouterInfo* info) {
 
   SelectorInfo selector_info;
   selector_info.name = info->name;
+  selector_info.load_balance_name = info->load_balance_name;
   RefreshDomainInfo(&selector_info, endpointInfo);
   return 0;
 }
@@ -265,6 +425,15 @@ bool SelectorDomain::NeedUpdate() {
   return false;
 }
 
+namespace {
+
+bool IsSameHosts(const std::vector<TrpcEndpointInfo>& lhs, const std::vector<TrpcEndpointInfo>& rhs) {
+  return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                    [](const TrpcEndpointInfo& l, const TrpcEndpointInfo& r) { return l.host == r.host; });
+}
+
+}  // namespace
+
 // Return 0 on success, -1 on failure
 int SelectorDomain::UpdateEndpointInfo() {
   // copy first
@@ -274,17 +443,48 @@ int SelectorDomain::UpdateEndpointInfo() {
   int targets_count = targets_map_.size();
   int success_count = 0;
 
-  for (auto item : targets_map) {
+  // The names left to getaddrinfo by the asynchronous resolver are updated at the interval of getaddrinfo, as it blocks
+  uint64_t now_ms = trpc::time::GetMilliSeconds();
+  bool getaddrinfo_due = now_ms >= last_getaddrinfo_update_time_ + kGetAddrInfoUpdateIntervalMs;
+  if (getaddrinfo_due) {
+    last_getaddrinfo_update_time_ = now_ms;
+  }
+
+  for (auto& item : targets_map) {
+    if (dns_resolver_ && !getaddrinfo_due && !dns_resolver_->IsResolvable(item.second.domain_name)) {
+      success_count++;
+      continue;
+    }
+
     // Update node information
     SelectorDomain::DomainEndpointInfo endpointInfo;
-    if (!RefreshEndpointInfoByName(item.second.domain_name, item.second.port, endpointInfo)) {
-      TRPC_LOG_DEBUG("Update endpointInfo of " << item.first << ":" << item.second.domain_name << " success");
-      // Update node info to cache
-      SelectorInfo selector_info;
-      selector_info.name = item.first;
-      RefreshDomainInfo(&selector_info, endpointInfo);
+    if (RefreshEndpointInfoByName(item.second.domain_name, item.second.port, endpointInfo, false)) {
+      // Logs when the resolution starts failing only, the update runs every second with the asynchronous resolver
+      if (failed_domains_.insert(item.first).second) {
+        TRPC_LOG_ERROR("Get address info of " << item.second.domain_name << " failed, keep the endpoints of "
+                                              << item.first << " until it recovers");
+      }
+      continue;
+    }
+
+    if (failed_domains_.erase(item.first)) {
+      TRPC_LOG_INFO("Get address info of " << item.second.domain_name << " recovered");
+    }
+
+    // The cached addresses of the asynchronous resolver are read every second, the load balancer is updated only if
+    // they change. The periodic resolutions by getaddrinfo update it as before.
+    if (dns_resolver_ && IsSameHosts(item.second.endpoints, endpointInfo.endpoints)) {
       success_count++;
+      continue;
     }
+
+    TRPC_LOG_DEBUG("Update endpointInfo of " << item.first << ":" << item.second.domain_name << " success");
+    // Update node info to cache
+    SelectorInfo selector_info;
+    selector_info.name = item.first;
+    selector_info.load_balance_name = item.second.load_balance_name;
+    RefreshDomainInfo(&selector_info, endpointInfo);
+    success_count++;
   }
 
   return (targets_count == 0 || success_count > 0) ? 0 : -1;
@@ -309,6 +509,10 @@ void SelectorDomain::Stop() noexcept {
     PeripheryTaskScheduler::GetInstance()->RemoveInnerTask(task_id_);
     task_id_ = 0;
   }
+
+  if (dns_resolver_) {
+    dns_resolver_->Stop();
+  }
 }
 
 }  // namespace trpc
@@ -13,15 +13,22 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>
 #include <shared_mutex>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "trpc/common/config/domain_naming_conf.h"
 #include "trpc/common/config/domain_naming_conf_parser.h"
 #include "trpc/common/plugin.h"
+#include "trpc/naming/common/util/circuit_break/circuit_breaker.h"
+#include "trpc/naming/common/util/endpoint_snapshot/endpoint_snapshot.h"
+#include "trpc/naming/common/util/endpoint_watch/endpoint_watchers.h"
 #include "trpc/naming/common/util/utils_help.h"
+#include "trpc/naming/domain/async_dns_resolver.h"
 #include "trpc/naming/load_balance.h"
 #include "trpc/naming/selector.h"
 
@@ -63,9 +70,27 @@ class SelectorDomain : public Selector {
   /// @brief Interface for reporting call results
   int ReportInvokeResult(const InvokeResult* result) override;
 
+  /// @brief The load balancers may track the requests in flight, so the results of requests not sent are needed.
+  bool NeedUnsentInvokeResult() const override { return true; }
+
+  /// @brief The invocation results are needed by the circuit breaking, or by the load balancers depending on them.
+  bool NeedInvokeResult(const SelectorInfo* info) override;
+
+  /// @brief Resolves the handle of the target service in its load balancer, cached by the service proxy.
+  bool GetLoadBalanceHandle(const SelectorInfo* info, LoadBalanceHandle* handle) override;
+
+  /// @brief Interface for watching the endpoints added to the called service
+  uint64_t WatchEndpoints(const std::string& name, EndpointsAddedFunction&& func) override;
+
+  /// @brief Interface for cancelling a watch of the endpoints
+  void UnwatchEndpoints(uint64_t watch_id) override;
+
   /// @brief Interface for setting the routing information of the called service
   int SetEndpoints(const RouterInfo* info) override;
 
+  /// @brief Interface for setting the framework error codes not counted as failures by the circuit breaking
+  bool SetCircuitBreakWhiteList(const std::vector<int>& framework_retcodes) override;
+
  private:
   struct DomainEndpointInfo {
     // Domain name of the called service
@@ -76,10 +101,17 @@ class SelectorDomain : public Selector {
     std::vector<TrpcEndpointInfo> endpoints;
     // Node ID generator
     EndpointIdGenerator id_generator;
+    // Name of the load balancer plugin, empty for the default one
+    std::string load_balance_name;
   };
 
-  // Update the IP information corresponding to the domain name
-  int RefreshEndpointInfoByName(std::string dn_name, int dn_port, SelectorDomain::DomainEndpointInfo& endpointInfo);
+  // Update the IP information corresponding to the domain name. With the asynchronous resolver, `wait` is false when
+  // the cached addresses are enough
+  int RefreshEndpointInfoByName(std::string dn_name, int dn_port, SelectorDomain::DomainEndpointInfo& endpointInfo,
+                                bool wait = true);
+
+  // Resolve the addresses of the domain name
+  void ResolveDomain(const std::string& dn_name, bool wait, std::vector<std::string>& ip_list);
 
   // Update EndpointInfo to targets_map and load_balance cache
   int RefreshDomainInfo(const SelectorInfo* info, DomainEndpointInfo& dn_endpointInfo);
@@ -93,11 +125,19 @@ class SelectorDomain : public Selector {
   // Get the loadbalance plugin by name
   LoadBalance* GetLoadBalance(const std::string& name);
 
+  // Get the loadbalance plugin of the selection, the one of its handle if resolved
+  LoadBalance* GetLoadBalance(const SelectorInfo* info);
+
+  // Update the load balancer with the endpoints not ejected by the circuit breaker
+  int UpdateLoadBalance(const std::string& name, LoadBalance* load_balance);
+
  private:
   // Default load balancer name
   static const char default_load_balance_name_[];
 
   std::unordered_map<std::string, DomainEndpointInfo> targets_map_;
+  // The endpoints of `targets_map_` published for the batch selections, which read them without any lock
+  naming::EndpointSnapshotTable endpoint_snapshots_;
   // Default load balancer
   LoadBalancePtr default_load_balance_;
   mutable std::shared_mutex mutex_;
@@ -111,6 +151,22 @@ class SelectorDomain : public Selector {
   // Business configuration items specified in the yaml file
   naming::DomainSelectorConfig select_config_;
 
+  // Circuit breaker of the endpoints, null if disabled
+  std::unique_ptr<naming::CircuitBreaker> circuit_breaker_;
+  std::mutex load_balance_update_mutex_;
+
+  // Watches of the endpoints added
+  naming::EndpointWatchers endpoint_watchers_;
+
+  // Asynchronous resolver of the domain names, null if disabled
+  std::unique_ptr<naming::AsyncDnsResolver> dns_resolver_;
+
+  // Names of the callees whose domain names failed to resolve in the last update, accessed by the update task only
+  std::unordered_set<std::string> failed_domains_;
+
+  // Last time the names resolved by getaddrinfo were updated, accessed by the update task only
+  uint64_t last_getaddrinfo_update_time_{0};
+
   /// Task id of periodically updating node tasks
   uint64_t task_id_{0};
 };
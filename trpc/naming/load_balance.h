@@ -13,12 +13,15 @@
 
 #pragma once
 
+#include <any>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "trpc/common/plugin.h"
 #include "trpc/naming/common/common_defs.h"
+#include "trpc/util/hazptr/hazptr.h"
 
 namespace trpc {
 
@@ -30,9 +33,21 @@ struct LoadBalanceInfo {
   const std::vector<TrpcEndpointInfo>* endpoints;
 };
 
+struct LoadBalanceHandle;
+
 struct LoadBalanceResult {
   const SelectorInfo* info;
-  std::any result;  // Used to output the routing selection result
+  std::any result;  // Used to output the routing selection result, if `endpoint` is not set
+
+  // The endpoint selected by the load balancers selecting from immutable snapshots of the endpoints, set instead of
+  // `result` so that it's not copied before taken. The snapshot is kept alive by `hazptr` as long as the result
+  const TrpcEndpointInfo* endpoint = nullptr;
+  Hazptr hazptr;
+
+  /// @brief Take the endpoint selected, whichever way it's output
+  TrpcEndpointInfo TakeEndpoint() {
+    return endpoint ? *endpoint : std::any_cast<TrpcEndpointInfo>(std::move(result));
+  }
 };
 
 /// @brief Load balancing base class
@@ -52,8 +67,41 @@ class LoadBalance : public Plugin {
   /// @return int 0: selection succeeded
   ///             -1: selection failed
   virtual int Next(LoadBalanceResult& result) = 0;
+
+  /// @brief Feed the result of an invocation to the endpoint selected by `Next`, for the load balancing algorithms
+  ///        depending on the state of the endpoints
+  /// @param result The invocation result, including the results of the requests not sent(see `IsInvokeRequestSent`)
+  /// @return int 0: update succeeded
+  ///             -1: update failed
+  virtual int UpdateInvokeResult(const InvokeResult* result) { return 0; }
+
+  /// @brief Whether the load balancing algorithm depends on `UpdateInvokeResult`, the selectors report the invocation
+  ///        results only to the load balancers needing them
+  /// @return bool Returns false by default
+  virtual bool NeedInvokeResult() const { return false; }
+
+  /// @brief Resolve the callee ahead of the selections, the handle is used by `Next` if it's set to
+  ///        `SelectorInfo::load_balance_handle`
+  /// @param name The name of the callee
+  /// @param handle The handle resolved
+  /// @return bool true: resolve succeeded
+  ///              false: the load balancer looks the callees up by name only
+  virtual bool GetHandle(const std::string& name, LoadBalanceHandle* handle) { return false; }
 };
 
 using LoadBalancePtr = RefPtr<LoadBalance>;
 
+/// @brief Callee pre-resolved by a load balancer, so that its selections skip looking the callee up by name. It's
+/// resolved once and cached by the service proxy, see `Selector::GetLoadBalanceHandle`
+struct LoadBalanceHandle {
+  // Name of the callee
+  std::string name;
+
+  // The load balancer resolving the handle, referenced by the handle so that it outlives the cached handle
+  LoadBalancePtr load_balance;
+
+  // State of the callee in the load balancer, valid as long as `load_balance` holds the load balancer
+  void* callee = nullptr;
+};
+
 }  // namespace trpc
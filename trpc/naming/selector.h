@@ -21,6 +21,7 @@
 #include "trpc/common/future/future.h"
 #include "trpc/common/plugin.h"
 #include "trpc/naming/common/common_defs.h"
+#include "trpc/util/function.h"
 
 namespace trpc {
 
@@ -65,6 +66,18 @@ class Selector : public Plugin {
   /// @return int Returns 0 on success, -1 on failure
   virtual int ReportInvokeResult(const InvokeResult* result) = 0;
 
+  /// @brief Whether the results of the requests not sent to the callee(see `IsInvokeRequestSent`) are reported as well
+  /// @return bool Returns false by default, selectors whose load balancers track the requests in flight need them to
+  ///         release the selected endpoints
+  virtual bool NeedUnsentInvokeResult() const { return false; }
+
+  /// @brief Whether the invocation results of a callee are needed by the selector, e.g. by its circuit breaking or by
+  ///        its load balancer. It's queried once by the service proxy, the selector filters report the invocation
+  ///        results of its requests if they are needed
+  /// @param info Service routing selection information
+  /// @return bool Returns false by default
+  virtual bool NeedInvokeResult(const SelectorInfo* info) { return false; }
+
   /// @brief Interface for setting routing information for the called service
   /// @param info Service routing information
   /// @return int Returns 0 on success, -1 on failure
@@ -74,6 +87,27 @@ class Selector : public Plugin {
   /// @param framework_retcodes Framework error code information
   /// @return bool Returns true on success, false on failure
   virtual bool SetCircuitBreakWhiteList(const std::vector<int>& framework_retcodes) { return false; }
+
+  /// @brief Interface for resolving the load balancer and the callee used by the selections ahead of them, the caller
+  ///        caches the handle and sets it to `SelectorInfo::load_balance_handle` of the later selections
+  /// @param info Service routing selection information
+  /// @param handle The handle resolved
+  /// @return bool Returns true on success, false if the selector or its load balancer does not support it
+  virtual bool GetLoadBalanceHandle(const SelectorInfo* info, LoadBalanceHandle* handle) { return false; }
+
+  /// @brief Callback of the endpoints added to a service, it must not block as the updates of the endpoints wait for it
+  using EndpointsAddedFunction = Function<void(const std::vector<TrpcEndpointInfo>& endpoints)>;
+
+  /// @brief Interface for watching the endpoints added to the called service, e.g. to establish the connections ahead
+  ///        of the requests. The current endpoints of the service are reported at once
+  /// @param name The name of the called service
+  /// @param func The callback of the endpoints added
+  /// @return uint64_t Returns the id of the watch, 0 if the selector does not support it
+  virtual uint64_t WatchEndpoints(const std::string& name, EndpointsAddedFunction&& func) { return 0; }
+
+  /// @brief Interface for cancelling a watch, the callback is not called any more once it returns
+  /// @param watch_id The id of the watch
+  virtual void UnwatchEndpoints(uint64_t watch_id) {}
 };
 
 using SelectorPtr = RefPtr<Selector>;
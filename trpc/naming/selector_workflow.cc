@@ -17,6 +17,7 @@
 
 #include "trpc/codec/trpc/trpc.pb.h"
 #include "trpc/naming/common/constants.h"
+#include "trpc/naming/load_balance.h"
 #include "trpc/util/log/logging.h"
 #include "trpc/util/string/string_util.h"
 #include "trpc/util/time.h"
@@ -118,6 +119,11 @@ void SelectorWorkFlow::FillSelectorInfo(const ClientContextPtr& context, Selecto
   selector_info.load_balance_name = service_proxy_option->load_balance_name;
   selector_info.load_balance_type = service_proxy_option->load_balance_type;
   selector_info.context = context;
+  // The handle cached by the service proxy is valid only for the callee it was resolved for.
+  const LoadBalanceHandle* handle = context->GetLoadBalanceHandle();
+  if (handle && handle->name == selector_info.name) {
+    selector_info.load_balance_handle = handle;
+  }
   // Set extend select info at the service level.
   auto iter = service_proxy_option->service_filter_configs.find(plugin_name_);
   if (iter != service_proxy_option->service_filter_configs.end()) {
@@ -182,6 +188,7 @@ void SelectorWorkFlow::FillInvokeResult(const ClientContextPtr& context, InvokeR
   result.framework_result = context->GetStatus().GetFrameworkRetCode();
   result.interface_result = context->GetStatus().GetFuncRetCode();
   result.context = context;
+  result.request_sent = !context->IsServedLocally();
 }
 
 int SelectorWorkFlow::ReportInvokeResult(const ClientContextPtr& context) {
@@ -193,9 +200,11 @@ int SelectorWorkFlow::ReportInvokeResult(const ClientContextPtr& context) {
     return 0;
   }
 
-  if (need_report_) {
-    // Determine if a circuit breaker needs to be reported based on the framework return code
-    if (ShouldReport(context->GetStatus().GetFrameworkRetCode())) {
+  if (need_report_ || context->IsInvokeResultNeeded()) {
+    // Determine if a circuit breaker needs to be reported based on the framework return code, the results of requests
+    // not sent, including the responses served locally, are only reported to the selectors asking for them
+    bool sent = !context->IsServedLocally() && ShouldReport(context->GetStatus().GetFrameworkRetCode());
+    if (sent || selector_->NeedUnsentInvokeResult()) {
       InvokeResult invoke_result;
       FillInvokeResult(context, invoke_result);
       return selector_->ReportInvokeResult(&invoke_result);
@@ -206,17 +215,8 @@ int SelectorWorkFlow::ReportInvokeResult(const ClientContextPtr& context) {
 }
 
 bool SelectorWorkFlow::ShouldReport(int framework_retcode) {
-  // These framework error code scenarios do not need to be reported because
-  // the actual call to the server has not been made yet, including:
-  // TRPC_CLIENT_ENCODE_ERR, TRPC_CLIENT_ROUTER_ERR, TRPC_CLIENT_LIMITED_ERR, TRPC_CLIENT_OVERLOAD_ERR
-  if (framework_retcode == TrpcRetCode::TRPC_CLIENT_ENCODE_ERR ||
-      framework_retcode == TrpcRetCode::TRPC_CLIENT_ROUTER_ERR ||
-      framework_retcode == TrpcRetCode::TRPC_CLIENT_LIMITED_ERR ||
-      framework_retcode == TrpcRetCode::TRPC_CLIENT_OVERLOAD_ERR) {
-    return false;
-  }
-
-  return true;
+  // The scenarios where the actual call to the server has not been made yet do not need to be reported.
+  return IsInvokeRequestSent(framework_retcode);
 }
 
 }  // namespace trpc
@@ -0,0 +1,92 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#ifdef TRPC_BUILD_INCLUDE_OVERLOAD_CONTROL
+
+#include "trpc/overload_control/adaptive_concurrency/adaptive_concurrency_conf.h"
+
+#include "trpc/log/trpc_log.h"
+
+namespace trpc::overload_control {
+
+void AdaptiveConcurrencyConf::Display() const {
+  TRPC_FMT_DEBUG("----------AdaptiveConcurrencyConf---------------");
+
+  TRPC_FMT_DEBUG("initial_limit: {}", initial_limit);
+  TRPC_FMT_DEBUG("min_limit: {}", min_limit);
+  TRPC_FMT_DEBUG("max_limit: {}", max_limit);
+  TRPC_FMT_DEBUG("sample_window: {}", sample_window);
+  TRPC_FMT_DEBUG("min_sample_count: {}", min_sample_count);
+  TRPC_FMT_DEBUG("long_window: {}", long_window);
+  TRPC_FMT_DEBUG("tolerance: {}", tolerance);
+  TRPC_FMT_DEBUG("smoothing: {}", smoothing);
+  TRPC_FMT_DEBUG("is_report: {}", is_report);
+}
+
+}  // namespace trpc::overload_control
+
+namespace YAML {
+
+YAML::Node convert<trpc::overload_control::AdaptiveConcurrencyConf>::encode(
+    const trpc::overload_control::AdaptiveConcurrencyConf& config) {
+  YAML::Node node;
+
+  node["initial_limit"] = config.initial_limit;
+  node["min_limit"] = config.min_limit;
+  node["max_limit"] = config.max_limit;
+  node["sample_window"] = config.sample_window;
+  node["min_sample_count"] = config.min_sample_count;
+  node["long_window"] = config.long_window;
+  node["tolerance"] = config.tolerance;
+  node["smoothing"] = config.smoothing;
+  node["is_report"] = config.is_report;
+
+  return node;
+}
+
+bool convert<trpc::overload_control::AdaptiveConcurrencyConf>::decode(
+    const YAML::Node& node, trpc::overload_control::AdaptiveConcurrencyConf& config) {
+  if (node["initial_limit"]) {
+    config.initial_limit = node["initial_limit"].as<uint32_t>();
+  }
+  if (node["min_limit"]) {
+    config.min_limit = node["min_limit"].as<uint32_t>();
+  }
+  if (node["max_limit"]) {
+    config.max_limit = node["max_limit"].as<uint32_t>();
+  }
+  if (node["sample_window"]) {
+    config.sample_window = node["sample_window"].as<uint32_t>();
+  }
+  if (node["min_sample_count"]) {
+    config.min_sample_count = node["min_sample_count"].as<uint32_t>();
+  }
+  if (node["long_window"]) {
+    config.long_window = node["long_window"].as<uint32_t>();
+  }
+  if (node["tolerance"]) {
+    config.tolerance = node["tolerance"].as<double>();
+  }
+  if (node["smoothing"]) {
+    config.smoothing = node["smoothing"].as<double>();
+  }
+  if (node["is_report"]) {
+    config.is_report = node["is_report"].as<bool>();
+  }
+
+  return true;
+}
+
+}  // namespace YAML
+
+#endif
@@ -0,0 +1,62 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#ifdef TRPC_BUILD_INCLUDE_OVERLOAD_CONTROL
+
+#pragma once
+
+#include <cstdint>
+
+#include "yaml-cpp/yaml.h"
+
+#include "trpc/overload_control/overload_control_defs.h"
+
+namespace trpc::overload_control {
+
+struct AdaptiveConcurrencyConf {
+  uint32_t initial_limit{100};  ///< Concurrency limit before any latency is sampled.
+
+  uint32_t min_limit{20};  ///< Lower bound of the concurrency limit.
+
+  uint32_t max_limit{10000};  ///< Upper bound of the concurrency limit.
+
+  uint32_t sample_window{100};  ///< Interval(ms) of the limit updates, the latencies within it are averaged.
+
+  uint32_t min_sample_count{10};  ///< Latencies sampled in an interval at least to update the limit.
+
+  uint32_t long_window{600};  ///< Intervals averaged by the estimate of the no-load latency.
+
+  double tolerance{1.5};  ///< Ratio of the latency to the no-load one tolerated before the limit is lowered.
+
+  double smoothing{0.2};  ///< Weight of a new limit against the current one, in (0, 1].
+
+  bool is_report{false};  ///< Whether to report the judgment result to the monitoring plugin.
+
+  /// @brief Display the value of the configuration field.
+  void Display() const;
+};
+
+}  // namespace trpc::overload_control
+
+namespace YAML {
+
+template <>
+struct convert<trpc::overload_control::AdaptiveConcurrencyConf> {
+  static YAML::Node encode(const trpc::overload_control::AdaptiveConcurrencyConf& config);
+
+  static bool decode(const YAML::Node& node, trpc::overload_control::AdaptiveConcurrencyConf& config);
+};
+
+}  // namespace YAML
+
+#endif
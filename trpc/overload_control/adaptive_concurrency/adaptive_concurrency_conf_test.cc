@@ -0,0 +1,49 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#ifdef TRPC_BUILD_INCLUDE_OVERLOAD_CONTROL
+
+#include "trpc/overload_control/adaptive_concurrency/adaptive_concurrency_conf.h"
+
+#include "gtest/gtest.h"
+
+namespace trpc::overload_control {
+namespace testing {
+
+TEST(AdaptiveConcurrencyConf, All) {
+  AdaptiveConcurrencyConf conf;
+  ASSERT_EQ(conf.initial_limit, 100);
+  ASSERT_EQ(conf.min_limit, 20);
+  ASSERT_EQ(conf.max_limit, 10000);
+  ASSERT_EQ(conf.is_report, false);
+
+  conf.tolerance = 2.0;
+  conf.sample_window = 50;
+
+  YAML::convert<AdaptiveConcurrencyConf> adaptive_yaml;
+
+  YAML::Node adaptive_node = adaptive_yaml.encode(conf);
+
+  AdaptiveConcurrencyConf decode_conf;
+
+  ASSERT_EQ(adaptive_yaml.decode(adaptive_node, decode_conf), true);
+  ASSERT_EQ(decode_conf.tolerance, 2.0);
+  ASSERT_EQ(decode_conf.sample_window, 50);
+
+  decode_conf.Display();
+}
+
+}  // namespace testing
+}  // namespace trpc::overload_control
+
+#endif
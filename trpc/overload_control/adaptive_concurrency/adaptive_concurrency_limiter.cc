@@ -0,0 +1,117 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#ifdef TRPC_BUILD_INCLUDE_OVERLOAD_CONTROL
+
+#include "trpc/overload_control/adaptive_concurrency/adaptive_concurrency_limiter.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace trpc::overload_control {
+
+AdaptiveConcurrencyLimiter::AdaptiveConcurrencyLimiter(const AdaptiveConcurrencyConf& conf,
+                                                       const std::string& tvar_path)
+    : conf_(conf) {
+  conf_.min_limit = std::max(conf_.min_limit, 1u);
+  conf_.max_limit = std::max(conf_.max_limit, conf_.min_limit);
+  conf_.long_window = std::max(conf_.long_window, 1u);
+  conf_.smoothing = std::clamp(conf_.smoothing, 0.01, 1.0);
+  conf_.tolerance = std::max(conf_.tolerance, 1.0);
+
+  uint32_t initial_limit = std::clamp(conf_.initial_limit, conf_.min_limit, conf_.max_limit);
+  limit_ = initial_limit;
+  estimated_limit_ = initial_limit;
+
+  if (!tvar_path.empty()) {
+    limit_tvar_ =
+        std::make_unique<tvar::PassiveStatus<uint32_t>>(tvar_path + "/limit", [this]() { return GetLimit(); });
+    concurrency_tvar_ = std::make_unique<tvar::PassiveStatus<uint32_t>>(tvar_path + "/concurrency",
+                                                                        [this]() { return GetConcurrency(); });
+  }
+}
+
+bool AdaptiveConcurrencyLimiter::OnRequest() {
+  uint32_t concurrency = concurrency_.fetch_add(1, std::memory_order_relaxed) + 1;
+  if (concurrency > limit_.load(std::memory_order_relaxed)) {
+    concurrency_.fetch_sub(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  uint32_t peak = window_peak_concurrency_.load(std::memory_order_relaxed);
+  while (concurrency > peak &&
+         !window_peak_concurrency_.compare_exchange_weak(peak, concurrency, std::memory_order_relaxed)) {
+  }
+  return true;
+}
+
+void AdaptiveConcurrencyLimiter::OnResponse(uint64_t latency_us, uint64_t now_us) {
+  concurrency_.fetch_sub(1, std::memory_order_relaxed);
+  window_latency_us_.fetch_add(latency_us, std::memory_order_relaxed);
+  window_count_.fetch_add(1, std::memory_order_relaxed);
+
+  uint64_t begin_us = window_begin_us_.load(std::memory_order_relaxed);
+  if (begin_us == 0) {
+    window_begin_us_.compare_exchange_strong(begin_us, now_us, std::memory_order_relaxed);
+    return;
+  }
+  if (now_us < begin_us + conf_.sample_window * 1000ULL ||
+      window_count_.load(std::memory_order_relaxed) < conf_.min_sample_count) {
+    return;
+  }
+
+  // The thread ending the window takes its samples, the samples racing with it are counted into the next window.
+  if (!window_begin_us_.compare_exchange_strong(begin_us, now_us, std::memory_order_relaxed)) {
+    return;
+  }
+  uint32_t count = window_count_.exchange(0, std::memory_order_relaxed);
+  uint64_t total_latency_us = window_latency_us_.exchange(0, std::memory_order_relaxed);
+  uint32_t peak_concurrency = window_peak_concurrency_.exchange(0, std::memory_order_relaxed);
+  if (count > 0) {
+    Update(static_cast<double>(total_latency_us) / count, peak_concurrency);
+  }
+}
+
+void AdaptiveConcurrencyLimiter::Update(double latency_us, uint32_t peak_concurrency) {
+  latency_us = std::max(latency_us, 1.0);
+
+  double no_load_latency_us = no_load_latency_us_.load(std::memory_order_relaxed);
+  if (no_load_latency_us == 0) {
+    no_load_latency_us = latency_us;
+  } else {
+    no_load_latency_us += (latency_us - no_load_latency_us) / conf_.long_window;
+    // The load dropped a lot, the estimate follows faster so the limit is not held down by the past queueing.
+    if (no_load_latency_us > 2 * latency_us) {
+      no_load_latency_us *= 0.95;
+    }
+  }
+  no_load_latency_us_.store(no_load_latency_us, std::memory_order_relaxed);
+
+  double limit = estimated_limit_.load(std::memory_order_relaxed);
+  // The limit is not probed further while far from reached, otherwise it grows without bound at a low load.
+  if (peak_concurrency < limit / 2) {
+    return;
+  }
+
+  double gradient = std::clamp(conf_.tolerance * no_load_latency_us / latency_us, 0.5, 1.0);
+  double new_limit = limit * gradient + std::sqrt(limit);
+  new_limit = limit * (1 - conf_.smoothing) + new_limit * conf_.smoothing;
+  new_limit = std::clamp(new_limit, static_cast<double>(conf_.min_limit), static_cast<double>(conf_.max_limit));
+
+  estimated_limit_.store(new_limit, std::memory_order_relaxed);
+  limit_.store(static_cast<uint32_t>(new_limit), std::memory_order_relaxed);
+}
+
+}  // namespace trpc::overload_control
+
+#endif
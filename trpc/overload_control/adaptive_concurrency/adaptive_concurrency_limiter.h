@@ -0,0 +1,85 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#ifdef TRPC_BUILD_INCLUDE_OVERLOAD_CONTROL
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "trpc/overload_control/adaptive_concurrency/adaptive_concurrency_conf.h"
+#include "trpc/tvar/basic_ops/passive_status.h"
+
+namespace trpc::overload_control {
+
+/// @brief Concurrency limiter tuning its limit by the latencies of the requests, in the way of the gradient algorithm:
+/// the no-load latency is estimated by a long-term average of the latencies, and at every sample window the limit is
+/// scaled by the gradient of the no-load latency to the latency of the window, plus a queue of `sqrt(limit)` to probe
+/// for more concurrency. So the limit grows while the latency stays flat, and shrinks once requests start queueing.
+/// @note Thread safe, the request path is lock free.
+class AdaptiveConcurrencyLimiter {
+ public:
+  /// @param conf Parameters of the algorithm.
+  /// @param tvar_path Path of the tvars exposing the live limit and concurrency, which are not exposed if empty.
+  explicit AdaptiveConcurrencyLimiter(const AdaptiveConcurrencyConf& conf, const std::string& tvar_path = "");
+
+  /// @brief Admits a request if the concurrency is under the limit.
+  /// @return false if the request should be rejected, `OnResponse` must be called once the admitted ones finish.
+  bool OnRequest();
+
+  /// @brief Counts the finish of an admitted request, whose latency is sampled.
+  /// @param latency_us The latency(us) of the request.
+  /// @param now_us Current time(us), at which the limit is updated if a sample window ends.
+  void OnResponse(uint64_t latency_us, uint64_t now_us);
+
+  /// @brief Gets the current concurrency limit.
+  uint32_t GetLimit() const { return limit_.load(std::memory_order_relaxed); }
+
+  /// @brief Gets the number of the requests admitted and not finished.
+  uint32_t GetConcurrency() const { return concurrency_.load(std::memory_order_relaxed); }
+
+  /// @brief Gets the estimate(us) of the no-load latency.
+  double GetNoLoadLatency() const { return no_load_latency_us_.load(std::memory_order_relaxed); }
+
+ private:
+  // Updates the limit by the average latency and the peak concurrency of the sample window ended.
+  void Update(double latency_us, uint32_t peak_concurrency);
+
+ private:
+  AdaptiveConcurrencyConf conf_;
+
+  std::atomic<uint32_t> limit_;
+
+  std::atomic<uint32_t> concurrency_{0};
+
+  // The limit before rounding, which is updated by the thread ending a sample window only.
+  std::atomic<double> estimated_limit_;
+
+  std::atomic<double> no_load_latency_us_{0};
+
+  // Samples of the current window.
+  std::atomic<uint64_t> window_begin_us_{0};
+  std::atomic<uint64_t> window_latency_us_{0};
+  std::atomic<uint32_t> window_count_{0};
+  std::atomic<uint32_t> window_peak_concurrency_{0};
+
+  std::unique_ptr<tvar::PassiveStatus<uint32_t>> limit_tvar_;
+  std::unique_ptr<tvar::PassiveStatus<uint32_t>> concurrency_tvar_;
+};
+
+}  // namespace trpc::overload_control
+
+#endif
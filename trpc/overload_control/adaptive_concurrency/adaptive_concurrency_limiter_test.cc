@@ -0,0 +1,101 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#ifdef TRPC_BUILD_INCLUDE_OVERLOAD_CONTROL
+
+#include "trpc/overload_control/adaptive_concurrency/adaptive_concurrency_limiter.h"
+
+#include "gtest/gtest.h"
+
+namespace trpc::overload_control {
+namespace testing {
+
+namespace {
+
+// Runs rounds of requests as many as the limit, finished with the latency, and returns the current time.
+uint64_t RunRounds(AdaptiveConcurrencyLimiter& limiter, int rounds, uint64_t latency_us, uint64_t now_us) {
+  for (int round = 0; round < rounds; ++round) {
+    uint32_t limit = limiter.GetLimit();
+    for (uint32_t i = 0; i < limit; ++i) {
+      EXPECT_TRUE(limiter.OnRequest());
+    }
+    for (uint32_t i = 0; i < limit; ++i) {
+      limiter.OnResponse(latency_us, now_us);
+    }
+    now_us += 2000;
+  }
+  return now_us;
+}
+
+}  // namespace
+
+TEST(AdaptiveConcurrencyLimiter, Reject) {
+  AdaptiveConcurrencyConf conf;
+  conf.initial_limit = 20;
+  AdaptiveConcurrencyLimiter limiter(conf);
+
+  for (int i = 0; i < 20; ++i) {
+    ASSERT_TRUE(limiter.OnRequest());
+  }
+  ASSERT_FALSE(limiter.OnRequest());
+  ASSERT_EQ(limiter.GetConcurrency(), 20);
+
+  limiter.OnResponse(1000, 1000);
+  ASSERT_EQ(limiter.GetConcurrency(), 19);
+  ASSERT_TRUE(limiter.OnRequest());
+}
+
+TEST(AdaptiveConcurrencyLimiter, Adapt) {
+  AdaptiveConcurrencyConf conf;
+  conf.initial_limit = 20;
+  conf.min_limit = 10;
+  conf.max_limit = 1000;
+  conf.sample_window = 1;
+  conf.min_sample_count = 1;
+  AdaptiveConcurrencyLimiter limiter(conf);
+
+  // The limit grows while the latency stays flat.
+  uint64_t now_us = RunRounds(limiter, 100, 1000, 1000);
+  ASSERT_GT(limiter.GetLimit(), 100);
+  ASSERT_NEAR(limiter.GetNoLoadLatency(), 1000, 1);
+
+  // The limit shrinks once the latency rises.
+  uint32_t limit = limiter.GetLimit();
+  now_us = RunRounds(limiter, 20, 5000, now_us);
+  ASSERT_LT(limiter.GetLimit(), limit / 2);
+
+  // The limit is kept within the bounds.
+  RunRounds(limiter, 100, 50000, now_us);
+  ASSERT_EQ(limiter.GetLimit(), 10);
+}
+
+TEST(AdaptiveConcurrencyLimiter, NotProbedAtLowLoad) {
+  AdaptiveConcurrencyConf conf;
+  conf.initial_limit = 20;
+  conf.sample_window = 1;
+  conf.min_sample_count = 1;
+  AdaptiveConcurrencyLimiter limiter(conf);
+
+  uint64_t now_us = 1000;
+  for (int round = 0; round < 100; ++round) {
+    ASSERT_TRUE(limiter.OnRequest());
+    limiter.OnResponse(1000, now_us);
+    now_us += 2000;
+  }
+  ASSERT_EQ(limiter.GetLimit(), 20);
+}
+
+}  // namespace testing
+}  // namespace trpc::overload_control
+
+#endif
@@ -0,0 +1,128 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#ifdef TRPC_BUILD_INCLUDE_OVERLOAD_CONTROL
+
+#include "trpc/overload_control/adaptive_concurrency/adaptive_concurrency_server_filter.h"
+
+#include "trpc/common/config/trpc_config.h"
+#include "trpc/log/trpc_log.h"
+#include "trpc/overload_control/common/report.h"
+#include "trpc/util/time.h"
+
+namespace trpc::overload_control {
+
+int AdaptiveConcurrencyServerFilter::Init() {
+  // Init is called again when the filters registered are initialized.
+  if (limiter_) {
+    return 0;
+  }
+
+  bool ok = TrpcConfig::GetInstance()->GetPluginConfig<AdaptiveConcurrencyConf>(kOverloadCtrConfField,
+                                                                                kAdaptiveConcurrencyName, conf_);
+  if (!ok) {
+    TRPC_FMT_DEBUG("AdaptiveConcurrencyServerFilter read config failed, will use a default config");
+  }
+  conf_.Display();
+
+  limiter_ = std::make_unique<AdaptiveConcurrencyLimiter>(conf_, kAdaptiveConcurrencyTvarPath);
+
+  return 0;
+}
+
+std::vector<FilterPoint> AdaptiveConcurrencyServerFilter::GetFilterPoint() {
+  return {
+      // Requests are limited as early as possible.
+      FilterPoint::SERVER_PRE_SCHED_RECV_MSG,
+      FilterPoint::SERVER_POST_SCHED_RECV_MSG,
+
+      // The latency is sampled once the request is handled.
+      FilterPoint::SERVER_PRE_RPC_INVOKE,
+      FilterPoint::SERVER_POST_RPC_INVOKE,
+
+      // The following tracking points are only used as a fallback, for the requests failed before handled.
+      FilterPoint::SERVER_POST_RECV_MSG,
+      FilterPoint::SERVER_PRE_SEND_MSG,
+  };
+}
+
+void AdaptiveConcurrencyServerFilter::operator()(FilterStatus& status, FilterPoint point,
+                                                 const ServerContextPtr& context) {
+  if (context->GetCallType() == kOnewayCall) {
+    // The SERVER_POST_RPC_INVOKE tracking point will not be executed in one-way scenarios.
+    return;
+  }
+  switch (point) {
+    case FilterPoint::SERVER_PRE_SCHED_RECV_MSG: {
+      OnRequest(status, context);
+      break;
+    }
+    case FilterPoint::SERVER_POST_RPC_INVOKE: {
+      OnResponse(context);
+      break;
+    }
+    default: {
+      if (TRPC_UNLIKELY(!context->GetStatus().OK())) {
+        OnResponse(context);
+      }
+      break;
+    }
+  }
+}
+
+void AdaptiveConcurrencyServerFilter::OnRequest(FilterStatus& status, const ServerContextPtr& context) {
+  if (TRPC_UNLIKELY(!context->GetStatus().OK())) {
+    // If it is already a dirty request, it will not be processed further to ensure that the first error code is
+    // not overwritten.
+    return;
+  }
+
+  bool passed = limiter_->OnRequest();
+  if (passed) {
+    // The admission time marks the request to be counted once finished.
+    context->SetFilterData<uint64_t>(GetFilterID(), trpc::time::GetMicroSeconds());
+  } else {
+    TRPC_FMT_ERROR_EVERY_SECOND("rejected by adaptive concurrency overload control, concurrency limit: {}",
+                                limiter_->GetLimit());
+    context->SetStatus(
+        Status(TrpcRetCode::TRPC_SERVER_OVERLOAD_ERR, 0, "rejected by adaptive concurrency overload control"));
+    status = FilterStatus::REJECT;
+  }
+
+  if (conf_.is_report) {
+    OverloadInfo infos;
+    infos.attr_name = kOverloadctrlAdaptiveConcurrency;
+    infos.report_name = fmt::format("/{}/{}", context->GetCalleeName(), context->GetFuncName());
+    infos.tags[kOverloadctrlPass] = (passed == true ? 1 : 0);
+    infos.tags[kOverloadctrlLimited] = (passed == false ? 1 : 0);
+    infos.tags["limit"] = limiter_->GetLimit();
+    infos.tags["concurrency"] = limiter_->GetConcurrency();
+    Report::GetInstance()->ReportOverloadInfo(infos);
+  }
+}
+
+void AdaptiveConcurrencyServerFilter::OnResponse(const ServerContextPtr& context) {
+  uint64_t* begin_us = context->GetFilterData<uint64_t>(GetFilterID());
+  if (!begin_us || *begin_us == 0) {
+    // The request was not admitted, or has been counted.
+    return;
+  }
+
+  uint64_t now_us = trpc::time::GetMicroSeconds();
+  limiter_->OnResponse(now_us > *begin_us ? now_us - *begin_us : 0, now_us);
+  *begin_us = 0;
+}
+
+}  // namespace trpc::overload_control
+
+#endif
@@ -0,0 +1,64 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#ifdef TRPC_BUILD_INCLUDE_OVERLOAD_CONTROL
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "trpc/filter/filter.h"
+#include "trpc/overload_control/adaptive_concurrency/adaptive_concurrency_conf.h"
+#include "trpc/overload_control/adaptive_concurrency/adaptive_concurrency_limiter.h"
+#include "trpc/overload_control/overload_control_defs.h"
+#include "trpc/server/server_context.h"
+
+namespace trpc::overload_control {
+
+/// @brief Server filter limiting the concurrent requests by a limit tuned to the latencies of the server, instead of
+/// the static `max_concurrency` of `ConcurrencyLimiterServerFilter`.
+class AdaptiveConcurrencyServerFilter : public MessageServerFilter {
+ public:
+  /// @brief Name of filter
+  std::string Name() override { return kAdaptiveConcurrencyName; }
+
+  /// @brief Initialization function.
+  int Init() override;
+
+  /// @brief Get the collection of tracking points
+  std::vector<FilterPoint> GetFilterPoint() override;
+
+  /// @brief Execute the logic corresponding to the tracking point.
+  void operator()(FilterStatus& status, FilterPoint point, const ServerContextPtr& context) override;
+
+  /// @brief Get the limiter, null before initialized.
+  AdaptiveConcurrencyLimiter* GetLimiter() { return limiter_.get(); }
+
+ private:
+  // Process requests by algorithm the result of which determine whether this request is allowed.
+  void OnRequest(FilterStatus& status, const ServerContextPtr& context);
+
+  // Process the response of current request to sample its latency.
+  void OnResponse(const ServerContextPtr& context);
+
+ private:
+  AdaptiveConcurrencyConf conf_;
+
+  std::unique_ptr<AdaptiveConcurrencyLimiter> limiter_;
+};
+
+}  // namespace trpc::overload_control
+
+#endif
@@ -0,0 +1,93 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#ifdef TRPC_BUILD_INCLUDE_OVERLOAD_CONTROL
+
+#include "trpc/overload_control/adaptive_concurrency/adaptive_concurrency_server_filter.h"
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "trpc/codec/testing/protocol_testing.h"
+#include "trpc/common/config/trpc_config.h"
+#include "trpc/filter/filter_manager.h"
+
+namespace trpc::overload_control {
+namespace testing {
+
+class AdaptiveConcurrencyServerTestFixture : public ::testing::Test {
+ public:
+  static void SetUpTestCase() {
+    trpc::TrpcConfig::GetInstance()->Init("./trpc/overload_control/adaptive_concurrency/adaptive_concurrency.yaml");
+    MessageServerFilterPtr filter(new overload_control::AdaptiveConcurrencyServerFilter());
+    filter->Init();
+    ASSERT_TRUE(FilterManager::GetInstance()->AddMessageServerFilter(filter));
+  }
+
+  static ServerContextPtr MakeServerContext() {
+    auto context = MakeRefCounted<ServerContext>();
+    context->SetRequestMsg(std::make_shared<trpc::testing::TestProtocol>());
+    return context;
+  }
+
+  static AdaptiveConcurrencyServerFilter* GetFilter() {
+    MessageServerFilterPtr filter = FilterManager::GetInstance()->GetMessageServerFilter(kAdaptiveConcurrencyName);
+    return static_cast<AdaptiveConcurrencyServerFilter*>(filter.get());
+  }
+};
+
+TEST_F(AdaptiveConcurrencyServerTestFixture, Init) {
+  AdaptiveConcurrencyServerFilter* filter = GetFilter();
+  ASSERT_NE(filter, nullptr);
+  ASSERT_EQ(filter->GetFilterPoint().size(), 6);
+  ASSERT_EQ(filter->GetLimiter()->GetLimit(), 10);
+}
+
+TEST_F(AdaptiveConcurrencyServerTestFixture, Overload) {
+  AdaptiveConcurrencyServerFilter* filter = GetFilter();
+
+  std::vector<ServerContextPtr> contexts;
+  for (int i = 0; i < 10; ++i) {
+    ServerContextPtr context = MakeServerContext();
+    FilterStatus status = FilterStatus::CONTINUE;
+    (*filter)(status, FilterPoint::SERVER_PRE_SCHED_RECV_MSG, context);
+    ASSERT_EQ(status, FilterStatus::CONTINUE);
+    ASSERT_TRUE(context->GetStatus().OK());
+    contexts.push_back(context);
+  }
+
+  ServerContextPtr context = MakeServerContext();
+  FilterStatus status = FilterStatus::CONTINUE;
+  (*filter)(status, FilterPoint::SERVER_PRE_SCHED_RECV_MSG, context);
+  ASSERT_EQ(status, FilterStatus::REJECT);
+  ASSERT_EQ(context->GetStatus().GetFrameworkRetCode(), TrpcRetCode::TRPC_SERVER_OVERLOAD_ERR);
+
+  // The rejected request is not counted as finished.
+  (*filter)(status, FilterPoint::SERVER_PRE_SEND_MSG, context);
+  ASSERT_EQ(filter->GetLimiter()->GetConcurrency(), 10);
+
+  // The requests are counted once, by the first tracking point reached after handled.
+  for (auto& ctx : contexts) {
+    (*filter)(status, FilterPoint::SERVER_POST_RPC_INVOKE, ctx);
+    ctx->SetStatus(Status(TrpcRetCode::TRPC_SERVER_SYSTEM_ERR, 0, "failed"));
+    (*filter)(status, FilterPoint::SERVER_PRE_SEND_MSG, ctx);
+  }
+  ASSERT_EQ(filter->GetLimiter()->GetConcurrency(), 0);
+}
+
+}  // namespace testing
+}  // namespace trpc::overload_control
+
+#endif
@@ -40,6 +40,12 @@ constexpr char kConcurrencyLimiterName[] = "concurrency_limiter";
 /// @brief Name of monitoring dimensions for request-based concurrent overload protection rate limiter.
 constexpr char kOverloadctrlConcurrencyLimiter[] = "overloadctrl_concurrency_limiter";
 
+constexpr char kAdaptiveConcurrencyName[] = "adaptive_concurrency";
+
+constexpr char kOverloadctrlAdaptiveConcurrency[] = "overloadctrl_adaptive_concurrency";
+
+constexpr char kAdaptiveConcurrencyTvarPath[] = "trpc/overload_control/adaptive_concurrency";
+
 /// @brief Name of overload protection limiter based on fiber count.
 constexpr char kFiberLimiterName[] = "fiber_limiter";
 
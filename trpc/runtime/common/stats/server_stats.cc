@@ -29,6 +29,8 @@ void ServerStats::AddFailedReqCount(uint64_t count) {
   failed_req_count_.Add(count);
 }
 
+void ServerStats::AddExpiredReqCount(uint64_t count) { total_expired_req_count_.Add(count); }
+
 void ServerStats::AddReqDelay(uint64_t delay_in_ms) {
   total_req_delay_.Add(delay_in_ms);
   req_delay_.Add(delay_in_ms);
@@ -60,7 +62,8 @@ void ServerStats::Stats() {
                                  << "\ntotal_req_count: " << GetTotalReqCount() << " last_req_count: " << last_req_count
                                  << " req_count: " << req_count << " total_failed_req_count: "
                                  << GetTotalFailedReqCount() << " last_failed_req_count: " << last_failed_req_count
-                                 << " failed_req_count: " << failed_req_count);
+                                 << " failed_req_count: " << failed_req_count
+                                 << " total_expired_req_count: " << GetTotalExpiredReqCount());
 }
 
 }  // namespace trpc
@@ -49,6 +49,12 @@ class ServerStats {
   /// @brief Get the number of failed requests in the current statistical period
   uint64_t GetFailedReqCount() const { return failed_req_count_.GetValue(); }
 
+  /// @brief Increase the number of requests discarded as their callers' full-link timeout passed before processing
+  void AddExpiredReqCount(uint64_t count = 1);
+
+  /// @brief Get the total number of requests discarded as expired
+  uint64_t GetTotalExpiredReqCount() const { return total_expired_req_count_.GetValue(); }
+
   /// @brief Increase request latency time
   void AddReqDelay(uint64_t delay_in_ms);
 
@@ -125,6 +131,9 @@ class ServerStats {
   // number of failed requests in the last statistical period
   std::atomic<uint64_t> last_failed_req_count_{0};
 
+  // total number of requests discarded as expired
+  tvar::Counter<uint64_t> total_expired_req_count_{0};
+
   // total request latency time
   tvar::Counter<uint64_t> total_req_delay_{0};
 
@@ -28,6 +28,7 @@ TEST_F(FrameStatTest, ServerStatsTest) {
   ASSERT_EQ(stats.GetAvgDelay(), 0.0);
   ASSERT_EQ(stats.GetAvgLastDelay(), 0.0);
   ASSERT_EQ(stats.GetAvgTotalDelay(), 0.0);
+  ASSERT_EQ(stats.GetTotalExpiredReqCount(), 0);
 
   stats.AddConnCount(1);
   ASSERT_EQ(stats.GetConnCount(), 1);
@@ -43,6 +44,7 @@ TEST_F(FrameStatTest, ServerStatsTest) {
   stats.AddReqDelay(1);
   stats.AddReqDelay(2);
   stats.AddReqDelay(3);
+  stats.AddExpiredReqCount();
   ASSERT_EQ(stats.GetTotalReqCount(), 3);
   ASSERT_EQ(stats.GetReqCount(), 3);
   ASSERT_EQ(stats.GetLastReqCount(), 0);
@@ -54,8 +56,10 @@ TEST_F(FrameStatTest, ServerStatsTest) {
   ASSERT_EQ(stats.GetAvgLastDelay(), 0.0);
   ASSERT_EQ(stats.GetLastMaxDelay(), 0.0);
   ASSERT_EQ(stats.GetMaxDelay(), 3.0);
+  ASSERT_EQ(stats.GetTotalExpiredReqCount(), 1);
 
   stats.Stats();
+  ASSERT_EQ(stats.GetTotalExpiredReqCount(), 1);
   ASSERT_EQ(stats.GetTotalReqCount(), 3);
   ASSERT_EQ(stats.GetReqCount(), 0);
   ASSERT_EQ(stats.GetLastReqCount(), 3);
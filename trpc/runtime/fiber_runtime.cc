@@ -107,6 +107,7 @@ void StartRuntime() {
       options.work_stealing_ratio = conf.work_stealing_ratio;
       options.cross_numa_work_stealing_ratio = conf.cross_numa_work_stealing_ratio;
       options.run_queue_size = conf.fiber_run_queue_size;
+      options.scheduling_lane_weights = conf.fiber_scheduling_lane_weights;
       options.stack_size = conf.fiber_stack_size;
       options.pool_num_by_mmap = conf.fiber_pool_num_by_mmap;
       options.stack_enable_guard_page = conf.fiber_stack_enable_guard_page;
@@ -172,6 +173,10 @@ std::size_t GetSchedulingGroupAssignedNode(std::size_t sg_index) {
   return flatten_scheduling_groups[sg_index]->node_id;
 }
 
+const std::vector<unsigned>& GetSchedulingGroupAffinity(std::size_t sg_index) {
+  return detail::GetSchedulingGroup(sg_index)->Affinity();
+}
+
 std::size_t GetFiberQueueSize() {
   TRPC_ASSERT(fiber_threadmodel != nullptr);
   return fiber_threadmodel->GetFiberQueueSize();
@@ -16,6 +16,7 @@
 #include <cstdint>
 #include <cstdlib>
 #include <string>
+#include <vector>
 
 #include "trpc/runtime/threadmodel/thread_model.h"
 
@@ -82,6 +83,10 @@ std::size_t GetSchedulingGroupSize();
 ///       otherwise 0 is returned
 std::size_t GetSchedulingGroupAssignedNode(std::size_t sg_index);
 
+/// @brief get the cpus which the `SchedulingGroup` of a given index is bound to
+/// @return cpus, or an empty vector if not bound
+const std::vector<unsigned>& GetSchedulingGroupAffinity(std::size_t sg_index);
+
 /// @brief traverse all `SchedulingGroup` to get the size of the fibers to be run in the run queue
 std::size_t GetFiberQueueSize();
 
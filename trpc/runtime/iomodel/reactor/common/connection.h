@@ -137,6 +137,33 @@ class alignas(8) Connection : public EventHandler {
   uint32_t GetSendQueueTimeout() const { return send_queue_timeout_; }
   void SetSendQueueTimeout(uint32_t send_queue_timeout) { send_queue_timeout_ = send_queue_timeout; }
 
+  /// @brief Get/Set the watermarks of the send queue, reading from the connection is paused once the data queued
+  ///        reaches the high watermark, and resumed after it drains to the low watermark
+  /// @param high_watermark 0 means not enabled
+  /// @param low_watermark 0 means half of the high watermark
+  uint32_t GetSendQueueHighWatermark() const { return send_queue_high_watermark_; }
+  uint32_t GetSendQueueLowWatermark() const { return send_queue_low_watermark_; }
+  void SetSendQueueWatermark(uint32_t high_watermark, uint32_t low_watermark) {
+    send_queue_high_watermark_ = high_watermark;
+    send_queue_low_watermark_ = (low_watermark == 0 || low_watermark > high_watermark) ? high_watermark / 2
+                                                                                        : low_watermark;
+  }
+
+  /// @brief Hints the size of the frame being received and the offset of its body in it, set by the protocol checker
+  ///        when the buffer holds the head of the frame only. The rest of a large frame is read into a single block
+  ///        sized from the hint, see `RecvFrameBlock`
+  void SetRecvFrameHint(uint32_t frame_size, uint32_t body_offset) {
+    recv_frame_size_ = frame_size;
+    recv_frame_body_offset_ = body_offset;
+  }
+
+  /// @brief Takes the hint set by `SetRecvFrameHint`
+  /// @return The size of the frame, 0 if not hinted
+  uint32_t TakeRecvFrameHint(uint32_t* body_offset) {
+    *body_offset = recv_frame_body_offset_;
+    return std::exchange(recv_frame_size_, 0);
+  }
+
   /// @brief Get/Set self-define field
   std::any& GetUserAny() { return user_any_; }
   void SetUserAny(std::any&& user_data) { user_any_ = std::move(user_data); }
@@ -185,6 +212,11 @@ class alignas(8) Connection : public EventHandler {
   // 0: not limited
   uint32_t recv_buffer_size_{1000000};
 
+  // The size of the frame being received and the offset of its body, hinted by the protocol checker
+  // 0: not hinted
+  uint32_t recv_frame_size_{0};
+  uint32_t recv_frame_body_offset_{0};
+
   // The size limit of the send queue(current fiber use)
   // when exceeded, the send operation will be blocked
   // 0: not limited
@@ -194,6 +226,11 @@ class alignas(8) Connection : public EventHandler {
   // when send queue exceeded the limit
   uint32_t send_queue_timeout_{10000000};
 
+  // The watermarks of the send queue for backpressure
+  // 0: not enabled
+  uint32_t send_queue_high_watermark_{0};
+  uint32_t send_queue_low_watermark_{0};
+
   // The timeout that check if the client connection has timed out(ms)
   // default 0, not check
   uint32_t check_connect_timeout_{0};
@@ -0,0 +1,371 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#include "trpc/runtime/iomodel/reactor/common/listen_fd_handoff.h"
+
+#include <errno.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <utility>
+
+#include "trpc/util/log/logging.h"
+
+namespace trpc {
+
+namespace {
+
+// Max length of the key of a listening socket.
+constexpr std::size_t kMaxKeySize = 256;
+
+// Timeout(ms) of receiving the listening sockets, in case the old process hangs.
+constexpr int kReceiveTimeoutMs = 3000;
+
+// Timeout(ms) of waiting for the new process to listen on the sockets handed over.
+constexpr int kAcknowledgeTimeoutMs = 10000;
+
+// Sent by the new process once it listens on the sockets handed over.
+constexpr char kAcknowledge = 'A';
+
+bool MakeUnixAddress(const std::string& path, sockaddr_un* addr) {
+  if (path.empty() || path.size() >= sizeof(addr->sun_path)) {
+    TRPC_FMT_ERROR("invalid listen fd handoff path: {}", path);
+    return false;
+  }
+  memset(addr, 0, sizeof(*addr));
+  addr->sun_family = AF_UNIX;
+  memcpy(addr->sun_path, path.data(), path.size());
+  return true;
+}
+
+// Each socket is sent in a packet, of which the data is the key and the ancillary data is the fd.
+bool SendFd(int conn_fd, const std::string& key, int fd) {
+  iovec iov{const_cast<char*>(key.data()), key.size()};
+  alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+
+  msghdr msg{};
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_SOCKET;
+  cmsg->cmsg_type = SCM_RIGHTS;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+  memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+
+  return ::sendmsg(conn_fd, &msg, MSG_NOSIGNAL) == static_cast<ssize_t>(key.size());
+}
+
+bool ReceiveFd(int conn_fd, std::string* key, int* fd) {
+  char data[kMaxKeySize];
+  iovec iov{data, sizeof(data)};
+  alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+
+  msghdr msg{};
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+
+  ssize_t n = ::recvmsg(conn_fd, &msg, MSG_CMSG_CLOEXEC);
+  if (n <= 0) {
+    return false;
+  }
+
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  if (cmsg == nullptr || cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS ||
+      cmsg->cmsg_len != CMSG_LEN(sizeof(int))) {
+    return false;
+  }
+  memcpy(fd, CMSG_DATA(cmsg), sizeof(int));
+
+  if (msg.msg_flags & (MSG_TRUNC | MSG_CTRUNC)) {
+    ::close(*fd);
+    return false;
+  }
+
+  key->assign(data, n);
+  return true;
+}
+
+}  // namespace
+
+ListenFdHandoff::~ListenFdHandoff() {
+  StopServe();
+  if (ack_fd_ >= 0) {
+    ::close(ack_fd_);
+  }
+}
+
+int ListenFdHandoff::Receive(const std::string& path) {
+  sockaddr_un addr;
+  if (!MakeUnixAddress(path, &addr)) {
+    return -1;
+  }
+
+  int conn_fd = ::socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+  if (conn_fd < 0) {
+    TRPC_FMT_ERROR("create listen fd handoff socket failed: {}", strerror(errno));
+    return -1;
+  }
+
+  if (::connect(conn_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+    TRPC_FMT_INFO("no process hands the listening sockets over on {}: {}", path, strerror(errno));
+    ::close(conn_fd);
+    return -1;
+  }
+
+  timeval timeout{kReceiveTimeoutMs / 1000, (kReceiveTimeoutMs % 1000) * 1000};
+  ::setsockopt(conn_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+  // The first packet is the number of the sockets.
+  uint32_t count = 0;
+  if (::recv(conn_fd, &count, sizeof(count), 0) != sizeof(count)) {
+    TRPC_FMT_ERROR("receive the listening sockets on {} failed: {}", path, strerror(errno));
+    ::close(conn_fd);
+    return -1;
+  }
+
+  std::vector<std::pair<std::string, int>> received;
+  for (uint32_t i = 0; i < count; ++i) {
+    std::string key;
+    int fd = -1;
+    if (!ReceiveFd(conn_fd, &key, &fd)) {
+      TRPC_FMT_ERROR("receive the listening sockets on {} failed: {}", path, strerror(errno));
+      for (auto& [_, received_fd] : received) {
+        ::close(received_fd);
+      }
+      ::close(conn_fd);
+      return -1;
+    }
+    received.emplace_back(std::move(key), fd);
+  }
+
+  std::scoped_lock _(mutex_);
+  for (auto& [key, fd] : received) {
+    inherited_[key].push_back(fd);
+  }
+  // The old process keeps serving the sockets until acknowledged, or until the connection is closed.
+  if (ack_fd_ >= 0) {
+    ::close(ack_fd_);
+  }
+  ack_fd_ = conn_fd;
+  TRPC_FMT_INFO("{} listening sockets inherited on {}", count, path);
+  return static_cast<int>(count);
+}
+
+bool ListenFdHandoff::Acknowledge() {
+  int ack_fd = -1;
+  {
+    std::scoped_lock _(mutex_);
+    std::swap(ack_fd, ack_fd_);
+  }
+  if (ack_fd < 0) {
+    return false;
+  }
+
+  bool succ = ::send(ack_fd, &kAcknowledge, sizeof(kAcknowledge), MSG_NOSIGNAL) == sizeof(kAcknowledge);
+  if (succ) {
+    // The old process replies once it gives the sockets up, so that it can't time out after the acknowledgement.
+    char reply = 0;
+    succ = ::recv(ack_fd, &reply, sizeof(reply), 0) == sizeof(reply) && reply == kAcknowledge;
+  }
+  if (!succ) {
+    TRPC_FMT_ERROR("acknowledge the listening sockets handed over failed: {}", strerror(errno));
+  }
+  ::close(ack_fd);
+  return succ;
+}
+
+void ListenFdHandoff::Abandon() {
+  std::scoped_lock _(mutex_);
+  if (ack_fd_ >= 0) {
+    ::close(ack_fd_);
+    ack_fd_ = -1;
+  }
+}
+
+bool ListenFdHandoff::Serve(const std::string& path, std::function<void()> on_handoff) {
+  sockaddr_un addr;
+  if (!MakeUnixAddress(path, &addr)) {
+    return false;
+  }
+
+  if (serving_.exchange(true)) {
+    TRPC_FMT_ERROR("the listening sockets are being served already");
+    return false;
+  }
+
+  int server_fd = ::socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+  if (server_fd < 0) {
+    TRPC_FMT_ERROR("create listen fd handoff socket failed: {}", strerror(errno));
+    serving_ = false;
+    return false;
+  }
+
+  // The path may be left by the process replaced, which serves no more.
+  ::unlink(path.c_str());
+  if (::bind(server_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || ::chmod(path.c_str(), 0600) != 0 ||
+      ::listen(server_fd, 1) != 0) {
+    TRPC_FMT_ERROR("serve the listening sockets on {} failed: {}", path, strerror(errno));
+    ::close(server_fd);
+    serving_ = false;
+    return false;
+  }
+
+  serve_thread_ = std::thread([this, server_fd, on_handoff = std::move(on_handoff)] {
+    ServeLoop(server_fd, on_handoff);
+  });
+  return true;
+}
+
+void ListenFdHandoff::StopServe() {
+  serving_ = false;
+  if (serve_thread_.joinable()) {
+    serve_thread_.join();
+  }
+}
+
+void ListenFdHandoff::ServeLoop(int server_fd, const std::function<void()>& on_handoff) {
+  while (serving_.load(std::memory_order_relaxed)) {
+    pollfd pfd{server_fd, POLLIN, 0};
+    if (::poll(&pfd, 1, 100) <= 0) {
+      continue;
+    }
+
+    int conn_fd = ::accept4(server_fd, nullptr, nullptr, SOCK_CLOEXEC);
+    if (conn_fd < 0) {
+      continue;
+    }
+
+    ucred cred{};
+    socklen_t cred_len = sizeof(cred);
+    if (::getsockopt(conn_fd, SOL_SOCKET, SO_PEERCRED, &cred, &cred_len) != 0 || cred.uid != ::getuid()) {
+      TRPC_FMT_WARN("the listening sockets are refused to pid {} of uid {}", cred.pid, cred.uid);
+      ::close(conn_fd);
+      continue;
+    }
+
+    if (!Send(conn_fd)) {
+      TRPC_FMT_ERROR("hand the listening sockets over to pid {} failed: {}", cred.pid, strerror(errno));
+      ::close(conn_fd);
+      continue;
+    }
+
+    // Keeps the sockets unless the new process listens on them.
+    bool acknowledged = WaitAcknowledge(conn_fd);
+    ::close(conn_fd);
+    if (acknowledged) {
+      TRPC_FMT_INFO("the listening sockets are handed over to pid {}", cred.pid);
+      if (on_handoff) {
+        on_handoff();
+      }
+      break;
+    }
+    TRPC_FMT_ERROR("pid {} did not listen on the listening sockets handed over, keep serving them", cred.pid);
+  }
+
+  // The path is left to the process taken over, which binds it again.
+  ::close(server_fd);
+}
+
+bool ListenFdHandoff::Send(int conn_fd) {
+  // The sockets are not closed while sent, see `RemoveListening`.
+  std::scoped_lock _(mutex_);
+  uint32_t count = listening_.size();
+  if (::send(conn_fd, &count, sizeof(count), MSG_NOSIGNAL) != sizeof(count)) {
+    return false;
+  }
+  for (auto& [fd, key] : listening_) {
+    if (!SendFd(conn_fd, key, fd)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ListenFdHandoff::WaitAcknowledge(int conn_fd) {
+  for (int waited_ms = 0; waited_ms < kAcknowledgeTimeoutMs && serving_.load(std::memory_order_relaxed);
+       waited_ms += 100) {
+    pollfd pfd{conn_fd, POLLIN, 0};
+    int ret = ::poll(&pfd, 1, 100);
+    if (ret == 0 || (ret < 0 && errno == EINTR)) {
+      continue;
+    }
+
+    // Closed by the new process if it exits before listening.
+    char ack = 0;
+    if (ret < 0 || ::recv(conn_fd, &ack, sizeof(ack), MSG_DONTWAIT) != sizeof(ack) || ack != kAcknowledge) {
+      return false;
+    }
+    return ::send(conn_fd, &kAcknowledge, sizeof(kAcknowledge), MSG_NOSIGNAL) == sizeof(kAcknowledge);
+  }
+  return false;
+}
+
+int ListenFdHandoff::TakeInherited(const std::string& key) {
+  std::scoped_lock _(mutex_);
+  auto iter = inherited_.find(key);
+  if (iter == inherited_.end()) {
+    return -1;
+  }
+
+  int fd = iter->second.front();
+  iter->second.erase(iter->second.begin());
+  if (iter->second.empty()) {
+    inherited_.erase(iter);
+  }
+  return fd;
+}
+
+std::size_t ListenFdHandoff::CloseInherited() {
+  std::scoped_lock _(mutex_);
+  std::size_t count = 0;
+  for (auto& [key, fds] : inherited_) {
+    for (int fd : fds) {
+      TRPC_FMT_WARN("inherited listening socket of {} is not taken, closed", key);
+      ::close(fd);
+      ++count;
+    }
+  }
+  inherited_.clear();
+  return count;
+}
+
+void ListenFdHandoff::AddListening(const std::string& key, int fd) {
+  if (key.size() > kMaxKeySize) {
+    return;
+  }
+  std::scoped_lock _(mutex_);
+  listening_.emplace_back(fd, key);
+}
+
+void ListenFdHandoff::RemoveListening(int fd) {
+  std::scoped_lock _(mutex_);
+  for (auto iter = listening_.begin(); iter != listening_.end(); ++iter) {
+    if (iter->first == fd) {
+      listening_.erase(iter);
+      return;
+    }
+  }
+}
+
+}  // namespace trpc
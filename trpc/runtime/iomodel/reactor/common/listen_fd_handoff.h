@@ -0,0 +1,112 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace trpc {
+
+/// @brief Hands the listening sockets over from a process to the one replacing it on hot restart, through a unix
+/// domain socket(SCM_RIGHTS). The new process accepts on the same sockets while the old one stops gracefully, so no
+/// connection is refused during the restart.
+///
+/// The acceptors add their listening sockets keyed by the address listened on, and listen on an inherited socket of
+/// the same address instead of binding a new one if any.
+///
+/// The handoff is acknowledged in two phases: the old process sends the sockets, and keeps serving them until the new
+/// process acknowledges that it listens on them(see `Acknowledge`). If the new process fails to start or exits before
+/// that, the old process keeps its sockets and keeps serving them.
+/// @note Thread safe.
+class ListenFdHandoff {
+ public:
+  static ListenFdHandoff* GetInstance() {
+    static ListenFdHandoff instance;
+    return &instance;
+  }
+
+  ListenFdHandoff(const ListenFdHandoff&) = delete;
+  ListenFdHandoff& operator=(const ListenFdHandoff&) = delete;
+
+  ~ListenFdHandoff();
+
+  /// @brief Receives the listening sockets from the process serving them on `path`, they're inherited until taken.
+  ///        The process handing them over waits for `Acknowledge`.
+  /// @return The number of sockets received, or -1 if no process serves them or the handoff failed.
+  int Receive(const std::string& path);
+
+  /// @brief Acknowledges the received sockets once they're listened on, so that the process handing them over stops.
+  /// @return true if the acknowledgement is sent, false if no socket was received or the process handing them over
+  ///         gave up waiting.
+  bool Acknowledge();
+
+  /// @brief Gives the received sockets up without acknowledging, e.g. if the process fails to start, so that the process
+  ///        handing them over keeps serving them.
+  void Abandon();
+
+  /// @brief Serves the listening sockets on `path` in a background thread, to the processes of the same user only.
+  ///        Once a process has received them and acknowledged, `on_handoff` is called and the serving stops.
+  bool Serve(const std::string& path, std::function<void()> on_handoff);
+
+  /// @brief Stops serving the listening sockets.
+  void StopServe();
+
+  /// @brief Takes an inherited socket listening on `key`, in the order they were added by the old process.
+  /// @return The fd of the socket, or -1 if none.
+  int TakeInherited(const std::string& key);
+
+  /// @brief Closes the inherited sockets which are not taken.
+  /// @return The number of sockets closed.
+  std::size_t CloseInherited();
+
+  /// @brief Adds a socket listening on `key`, to be handed over.
+  void AddListening(const std::string& key, int fd);
+
+  /// @brief Removes a listening socket, must be called before the socket is closed.
+  void RemoveListening(int fd);
+
+ private:
+  ListenFdHandoff() = default;
+
+  void ServeLoop(int server_fd, const std::function<void()>& on_handoff);
+
+  bool Send(int conn_fd);
+
+  bool WaitAcknowledge(int conn_fd);
+
+ private:
+  std::mutex mutex_;
+
+  // Inherited sockets of each key.
+  std::unordered_map<std::string, std::vector<int>> inherited_;
+
+  // Listening sockets and their keys, in the order of listening.
+  std::vector<std::pair<int, std::string>> listening_;
+
+  // Connection to the process which handed the sockets over, kept until `Acknowledge`.
+  int ack_fd_{-1};
+
+  std::atomic<bool> serving_{false};
+
+  std::thread serve_thread_;
+};
+
+}  // namespace trpc
@@ -0,0 +1,113 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#include "trpc/runtime/iomodel/reactor/common/listen_fd_handoff.h"
+
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "trpc/runtime/iomodel/reactor/common/socket.h"
+#include "trpc/util/net_util.h"
+
+namespace trpc::testing {
+
+TEST(ListenFdHandoffTest, HandOver) {
+  std::string path = "listen_fd_handoff_test_" + std::to_string(::getpid()) + ".sock";
+  ListenFdHandoff* handoff = ListenFdHandoff::GetInstance();
+
+  // Nobody serves the path.
+  ASSERT_EQ(handoff->Receive(path), -1);
+
+  NetworkAddress addr(trpc::util::GenRandomAvailablePort(), false, NetworkAddress::IpType::kIpV4);
+  Socket listen_socket = Socket::CreateTcpSocket(false);
+  ASSERT_TRUE(listen_socket.Bind(addr));
+  ASSERT_TRUE(listen_socket.Listen());
+  handoff->AddListening(addr.ToString(), listen_socket.GetFd());
+
+  std::atomic<bool> handed_off{false};
+  ASSERT_TRUE(handoff->Serve(path, [&handed_off] { handed_off = true; }));
+  ASSERT_FALSE(handoff->Acknowledge());
+  ASSERT_EQ(handoff->Receive(path), 1);
+  // The sockets are kept by the process handing them over until acknowledged.
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  ASSERT_FALSE(handed_off);
+  ASSERT_TRUE(handoff->Acknowledge());
+  while (!handed_off) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  handoff->StopServe();
+
+  ASSERT_EQ(handoff->TakeInherited("127.0.0.1:0"), -1);
+  int inherited_fd = handoff->TakeInherited(addr.ToString());
+  ASSERT_GE(inherited_fd, 0);
+  ASSERT_NE(inherited_fd, listen_socket.GetFd());
+  ASSERT_EQ(handoff->TakeInherited(addr.ToString()), -1);
+
+  // The inherited socket accepts the connections of the address, after the one handed over is closed.
+  handoff->RemoveListening(listen_socket.GetFd());
+  listen_socket.Close();
+
+  Socket inherited_socket(inherited_fd, AF_INET);
+  Socket client = Socket::CreateTcpSocket(false);
+  ASSERT_EQ(client.Connect(addr), 0);
+  NetworkAddress peer_addr;
+  Socket conn(inherited_socket.Accept(&peer_addr), AF_INET);
+  ASSERT_TRUE(conn.IsValid());
+
+  conn.Close();
+  client.Close();
+  inherited_socket.Close();
+  ASSERT_EQ(handoff->CloseInherited(), 0);
+  ::unlink(path.c_str());
+}
+
+TEST(ListenFdHandoffTest, Abandon) {
+  std::string path = "listen_fd_handoff_test_abandon_" + std::to_string(::getpid()) + ".sock";
+  ListenFdHandoff* handoff = ListenFdHandoff::GetInstance();
+
+  NetworkAddress addr(trpc::util::GenRandomAvailablePort(), false, NetworkAddress::IpType::kIpV4);
+  Socket listen_socket = Socket::CreateTcpSocket(false);
+  ASSERT_TRUE(listen_socket.Bind(addr));
+  ASSERT_TRUE(listen_socket.Listen());
+  handoff->AddListening(addr.ToString(), listen_socket.GetFd());
+
+  std::atomic<bool> handed_off{false};
+  ASSERT_TRUE(handoff->Serve(path, [&handed_off] { handed_off = true; }));
+
+  // The process taking the sockets over fails to start, the sockets are kept and served again.
+  ASSERT_EQ(handoff->Receive(path), 1);
+  handoff->Abandon();
+  ASSERT_FALSE(handoff->Acknowledge());
+  ASSERT_EQ(handoff->CloseInherited(), 1);
+
+  ASSERT_EQ(handoff->Receive(path), 1);
+  ASSERT_TRUE(handoff->Acknowledge());
+  while (!handed_off) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  handoff->StopServe();
+
+  ASSERT_EQ(handoff->CloseInherited(), 1);
+  handoff->RemoveListening(listen_socket.GetFd());
+  listen_socket.Close();
+  ::unlink(path.c_str());
+}
+
+}  // namespace trpc::testing
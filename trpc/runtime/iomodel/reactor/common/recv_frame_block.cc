@@ -0,0 +1,57 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#include "trpc/runtime/iomodel/reactor/common/recv_frame_block.h"
+
+#include <utility>
+
+namespace trpc {
+
+bool RecvFrameBlock::Start(NoncontiguousBuffer& buffered, std::size_t frame_size, std::size_t body_offset,
+                           std::size_t min_frame_size) {
+  std::size_t head_size = buffered.ByteSize();
+  if (frame_size <= min_frame_size || head_size == 0 || head_size >= frame_size || body_offset > frame_size) {
+    return false;
+  }
+
+  block_ = MakeRefCounted<ContiguousBuffer>(frame_size + kBodyAlignment);
+  frame_size_ = frame_size;
+
+  // Skips the padding before the frame which aligns its body.
+  auto body = reinterpret_cast<std::uintptr_t>(block_->GetWritePtr()) + body_offset;
+  std::size_t padding = (kBodyAlignment - body % kBodyAlignment) % kBodyAlignment;
+  block_->AddWriteLen(padding);
+  block_->AddReadLen(padding);
+
+  // The head is usually a small part of the frame, received before the checker knew its size.
+  FlattenToSlow(buffered, block_->GetWritePtr(), head_size);
+  block_->AddWriteLen(head_size);
+  buffered.Clear();
+  return true;
+}
+
+bool RecvFrameBlock::Seal(std::size_t bytes, NoncontiguousBuffer& buffered) {
+  block_->AddWriteLen(bytes);
+  if (block_->ReadableSize() < frame_size_) {
+    return false;
+  }
+
+  auto block = object_pool::MakeLwUnique<BufferBlock>();
+  block->WrapUp(std::move(block_));
+  block_ = nullptr;
+  buffered.Append(std::move(block));
+  return true;
+}
+
+}  // namespace trpc
@@ -0,0 +1,63 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "trpc/util/buffer/contiguous_buffer.h"
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+
+namespace trpc {
+
+/// @brief Receives the rest of a frame into a single block sized from the frame length known by the protocol checker
+/// (see `Connection::SetRecvFrameHint`), instead of the fixed-size blocks of the memory pool. The body of the frame is
+/// aligned to `kBodyAlignment` in the block, so that a body accessed in place (e.g. flatbuffers) is neither flattened
+/// nor copied when it's deserialized.
+class RecvFrameBlock {
+ public:
+  static constexpr std::size_t kBodyAlignment = alignof(std::max_align_t);
+
+  /// @brief Starts receiving the frame if `buffered` holds the head of it only and it's larger than `min_frame_size`,
+  ///        the head is moved into the block.
+  /// @param buffered The bytes received and not consumed by the checker, the head of the frame
+  /// @param frame_size The size of the frame hinted by the checker
+  /// @param body_offset The offset of the body in the frame
+  /// @param min_frame_size Smaller frames are received into the blocks of the memory pool
+  /// @return true if started
+  bool Start(NoncontiguousBuffer& buffered, std::size_t frame_size, std::size_t body_offset,
+             std::size_t min_frame_size);
+
+  /// @brief Whether a frame is being received.
+  bool Active() const { return block_ != nullptr; }
+
+  /// @brief The memory to receive the rest of the frame into, no more than the frame.
+  char* data() { return block_->GetWritePtr(); }
+  std::size_t SizeAvailable() const { return frame_size_ - block_->ReadableSize(); }
+
+  /// @brief Marks `bytes` received. Once the frame is complete, it's appended to `buffered` as a single block and the
+  ///        next frame is received into the blocks of the memory pool.
+  /// @return true if the frame is complete.
+  bool Seal(std::size_t bytes, NoncontiguousBuffer& buffered);
+
+  /// @brief Drops the frame being received.
+  void Clear() { block_ = nullptr; }
+
+ private:
+  BufferPtr block_;
+  std::size_t frame_size_{0};
+};
+
+}  // namespace trpc
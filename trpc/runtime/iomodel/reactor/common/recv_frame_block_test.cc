@@ -0,0 +1,80 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#include "trpc/runtime/iomodel/reactor/common/recv_frame_block.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "trpc/util/buffer/buffer.h"
+
+namespace trpc::testing {
+
+TEST(RecvFrameBlockTest, ReceiveFrame) {
+  std::string frame(100000, 0);
+  for (std::size_t i = 0; i < frame.size(); ++i) {
+    frame[i] = static_cast<char>(i * 7);
+  }
+  // The head straddles two blocks, and the body starts at an odd offset.
+  constexpr std::size_t kBodyOffset = 21;
+  NoncontiguousBuffer buffered = CreateBufferSlow(frame.substr(0, 10));
+  buffered.Append(CreateBufferSlow(frame.substr(10, 90)));
+
+  RecvFrameBlock frame_block;
+  ASSERT_FALSE(frame_block.Active());
+  ASSERT_TRUE(frame_block.Start(buffered, frame.size(), kBodyOffset, 4096));
+  ASSERT_TRUE(frame_block.Active());
+  ASSERT_TRUE(buffered.Empty());
+  ASSERT_EQ(frame_block.SizeAvailable(), frame.size() - 100);
+
+  std::size_t received = 100;
+  while (true) {
+    std::size_t n = std::min<std::size_t>(frame_block.SizeAvailable(), 30000);
+    memcpy(frame_block.data(), frame.data() + received, n);
+    received += n;
+    if (frame_block.Seal(n, buffered)) {
+      break;
+    }
+    ASSERT_TRUE(buffered.Empty());
+  }
+
+  ASSERT_FALSE(frame_block.Active());
+  ASSERT_EQ(buffered.size(), 1);
+  ASSERT_EQ(FlattenSlow(buffered), frame);
+
+  // The body cut from the frame is a single aligned block.
+  buffered.Skip(kBodyOffset);
+  ASSERT_EQ(buffered.size(), 1);
+  ASSERT_EQ(reinterpret_cast<std::uintptr_t>(buffered.FirstContiguous().data()) % RecvFrameBlock::kBodyAlignment, 0);
+}
+
+TEST(RecvFrameBlockTest, NotStarted) {
+  NoncontiguousBuffer buffered = CreateBufferSlow(std::string(100, 'a'));
+  RecvFrameBlock frame_block;
+  // Small frame.
+  ASSERT_FALSE(frame_block.Start(buffered, 4096, 16, 4096));
+  // Complete frame.
+  ASSERT_FALSE(frame_block.Start(buffered, 100, 16, 0));
+  // Invalid body offset.
+  ASSERT_FALSE(frame_block.Start(buffered, 10000, 10001, 0));
+  NoncontiguousBuffer empty;
+  ASSERT_FALSE(frame_block.Start(empty, 10000, 16, 0));
+  ASSERT_FALSE(frame_block.Active());
+  ASSERT_EQ(buffered.ByteSize(), 100);
+}
+
+}  // namespace trpc::testing
@@ -17,6 +17,7 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <ifaddrs.h>
+#include <linux/filter.h>
 #include <net/if.h>
 #include <net/if_arp.h>
 #include <netdb.h>
@@ -123,6 +124,41 @@ bool Socket::SetReusePort() {
   return true;
 }
 
+bool Socket::SetReusePortCpuSteering(const std::vector<int>& socket_index_of_cpu) {
+#if defined(SO_REUSEPORT) && !defined(TRPC_DISABLE_REUSEPORT) && defined(SO_ATTACH_REUSEPORT_CBPF)
+  // A = the cpu receiving the connection; if (A == cpu) return index; ... return -1(hashed by the kernel).
+  std::vector<sock_filter> code;
+  code.push_back(BPF_STMT(BPF_LD | BPF_W | BPF_ABS, static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU)));
+  for (std::size_t cpu = 0; cpu < socket_index_of_cpu.size(); ++cpu) {
+    if (socket_index_of_cpu[cpu] < 0) {
+      continue;
+    }
+    code.push_back(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, static_cast<uint32_t>(cpu), 0, 1));
+    code.push_back(BPF_STMT(BPF_RET | BPF_K, static_cast<uint32_t>(socket_index_of_cpu[cpu])));
+  }
+  code.push_back(BPF_STMT(BPF_RET | BPF_K, 0xFFFFFFFF));
+
+  if (code.size() > BPF_MAXINSNS) {
+    TRPC_LOG_ERROR("SetReusePortCpuSteering failed, too many cpus: " << socket_index_of_cpu.size());
+    return false;
+  }
+
+  sock_fprog prog;
+  prog.len = static_cast<uint16_t>(code.size());
+  prog.filter = code.data();
+  if (SetSockOpt(SO_ATTACH_REUSEPORT_CBPF, static_cast<const void*>(&prog),
+                 static_cast<socklen_t>(sizeof(prog)), SOL_SOCKET) == -1) {
+    TRPC_LOG_ERROR("SetReusePortCpuSteering failed" << ", errno: " << errno <<
+                   ", error msg: " << strerror(errno));
+    return false;
+  }
+  return true;
+#else
+  TRPC_LOG_ERROR("SetReusePortCpuSteering failed, SO_ATTACH_REUSEPORT_CBPF is not supported");
+  return false;
+#endif
+}
+
 bool Socket::Bind(const NetworkAddress& bind_addr) {
   int ret = ::bind(fd_, bind_addr.SockAddr(), bind_addr.Socklen());
   if (ret != 0) {
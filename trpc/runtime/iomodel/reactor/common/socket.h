@@ -20,6 +20,7 @@
 #include <sys/un.h>
 
 #include <functional>
+#include <vector>
 
 #include "trpc/runtime/iomodel/reactor/common/network_address.h"
 #include "trpc/runtime/iomodel/reactor/common/unix_address.h"
@@ -108,6 +109,13 @@ class Socket {
   /// @brief Set SO_REUSEPORT
   bool SetReusePort();
 
+  /// @brief Attach a classic bpf program to the SO_REUSEPORT group of the listening socket, which selects the socket
+  ///        of a new connection by the cpu receiving it, instead of the hash of the connection.
+  /// @param socket_index_of_cpu The index(in the order of joining the group) of the socket selected by each cpu, the
+  ///        connections received by the cpus which are out of range or mapped to a negative index are hashed as usual.
+  /// @note  Must be called once all the sockets of the group are listening, linux >= 4.5 is required.
+  bool SetReusePortCpuSteering(const std::vector<int>& socket_index_of_cpu);
+
   /// @brief Set socket whether to be block
   bool SetBlock(bool block = false);
 
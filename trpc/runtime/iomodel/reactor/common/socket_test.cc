@@ -15,12 +15,15 @@
 
 #include <ifaddrs.h>
 #include <netinet/tcp.h>
+#include <poll.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <unistd.h>
 
 #include <memory>
 #include <random>
 #include <thread>
+#include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -147,6 +150,51 @@ TEST_F(SocketTest, ReusePort) {
 #endif
 }
 
+TEST_F(SocketTest, ReusePortCpuSteering) {
+#if defined(SO_REUSEPORT) && !defined(TRPC_DISABLE_REUSEPORT) && defined(SO_ATTACH_REUSEPORT_CBPF)
+  NetworkAddress addr = NetworkAddress(trpc::util::GenRandomAvailablePort(), false, NetworkAddress::IpType::kIpV4);
+  std::vector<Socket> servers;
+  for (int i = 0; i < 2; ++i) {
+    Socket server = Socket::CreateTcpSocket(false);
+    server.SetReusePort();
+    server.SetBlock(false);
+    ASSERT_TRUE(server.Bind(addr));
+    server.Listen();
+    servers.push_back(server);
+  }
+
+  // Every cpu selects the second socket.
+  std::vector<int> socket_index_of_cpu(::sysconf(_SC_NPROCESSORS_CONF), 1);
+  if (!servers[0].SetReusePortCpuSteering(socket_index_of_cpu)) {
+    // Not supported by the running kernel.
+    for (auto& server : servers) {
+      server.Close();
+    }
+    GTEST_SKIP();
+  }
+
+  for (int i = 0; i < 4; ++i) {
+    Socket client = Socket::CreateTcpSocket(false);
+    ASSERT_EQ(client.Connect(addr), 0);
+
+    pollfd fds[2] = {{servers[0].GetFd(), POLLIN, 0}, {servers[1].GetFd(), POLLIN, 0}};
+    ASSERT_EQ(::poll(fds, 2, 1000), 1);
+    ASSERT_EQ(fds[0].revents, 0);
+    ASSERT_TRUE(fds[1].revents & POLLIN);
+
+    NetworkAddress peer_addr;
+    Socket conn(servers[1].Accept(&peer_addr), AF_INET);
+    ASSERT_TRUE(conn.IsValid());
+    conn.Close();
+    client.Close();
+  }
+
+  for (auto& server : servers) {
+    server.Close();
+  }
+#endif
+}
+
 TEST_F(SocketTest, SetBlock) {
   tcp_ipv4_server_sock_->SetBlock(true);
   tcp_ipv4_server_sock_->SetBlock(false);
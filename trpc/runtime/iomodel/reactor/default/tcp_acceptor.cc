@@ -21,6 +21,7 @@
 
 #include <utility>
 
+#include "trpc/runtime/iomodel/reactor/common/listen_fd_handoff.h"
 #include "trpc/util/log/logging.h"
 
 namespace trpc {
@@ -33,6 +34,9 @@ TcpAcceptor::TcpAcceptor(Reactor* reactor, const NetworkAddress& tcp_addr)
 }
 
 TcpAcceptor::~TcpAcceptor() {
+  if (socket_.IsValid()) {
+    ListenFdHandoff::GetInstance()->RemoveListening(socket_.GetFd());
+  }
   socket_.Close();
   close(idle_fd_);
 
@@ -53,6 +57,13 @@ bool TcpAcceptor::EnableListen(int backlog) {
     return false;
   }
 
+  // Listens on the socket handed over by the process replaced if any, which is bound already.
+  int inherited_fd = ListenFdHandoff::GetInstance()->TakeInherited(tcp_addr_.ToString());
+  if (inherited_fd >= 0) {
+    socket_.Close();
+    socket_ = Socket(inherited_fd, tcp_addr_.IsIpv6() ? AF_INET6 : AF_INET);
+  }
+
   SetFd(socket_.GetFd());
 
   socket_.SetReuseAddr();
@@ -67,7 +78,7 @@ bool TcpAcceptor::EnableListen(int backlog) {
     set_socket_opt_fun(socket_);
   }
 
-  if (!socket_.Bind(tcp_addr_)) {
+  if (inherited_fd < 0 && !socket_.Bind(tcp_addr_)) {
     return false;
   }
 
@@ -75,6 +86,8 @@ bool TcpAcceptor::EnableListen(int backlog) {
     return false;
   }
 
+  ListenFdHandoff::GetInstance()->AddListening(tcp_addr_.ToString(), socket_.GetFd());
+
   EnableEvent(EventHandler::EventType::kReadEvent);
 
   Ref();
@@ -132,6 +132,9 @@ void TcpConnection::EnableReadWrite() {
 
   int events = EventHandler::EventType::kReadEvent | EventHandler::EventType::kWriteEvent;
 
+  // Reading is enabled again, e.g. on reconnection, whatever disabled it before.
+  read_disabled_ = false;
+  read_paused_ = false;
   EnableEvent(events);
 
   Ref();
@@ -162,6 +165,7 @@ void TcpConnection::DisableRead() {
     return;
   }
 
+  read_disabled_ = true;
   DisableEvent(EventHandler::EventType::kReadEvent);
   reactor_->Update(this);
   TRPC_FMT_DEBUG("TcpConnection::DisableRead ip {}, port: {}, is_client {}, Disable Read.", GetPeerIp(), GetPeerPort(),
@@ -317,6 +321,7 @@ int TcpConnection::HandleWriteEvent() {
   if (ret == 0) {
     SetConnActiveTime(trpc::time::GetMilliSeconds());
     GetConnectionHandler()->UpdateConnection();
+    UpdateReadByBackpressure();
   } else {
     HandleClose(true);
     return -1;
@@ -348,6 +353,9 @@ void TcpConnection::HandleClose(bool destroy) {
 
   read_buffer_.buffer.Clear();
   read_buffer_.builder.Clear();
+  read_buffer_.frame_block.Clear();
+  uint32_t body_offset = 0;
+  TakeRecvFrameHint(&body_offset);
 
   for (auto& msg : io_msgs_) {
     GetConnectionHandler()->NotifyMessageFailed(msg, ConnectionErrorCode::kNetworkException);
@@ -361,6 +369,8 @@ void TcpConnection::HandleClose(bool destroy) {
 
   handshake_status_ = IoHandler::HandshakeStatus::kFailed;
   send_data_size_ = 0;
+  read_paused_ = false;
+  read_disabled_ = false;
   need_direct_write_ = false;
 
   GetConnectionHandler()->ConnectionClosed();
@@ -386,6 +396,7 @@ int TcpConnection::Send(IoMessage&& msg) {
 
   send_data_size_ += msg.buffer.ByteSize();
   io_msgs_.emplace_back(std::move(msg));
+  UpdateReadByBackpressure();
 
   if (GetConnectionState() == ConnectionState::kConnecting) {
     return HandleWriteEvent();
@@ -407,6 +418,27 @@ int TcpConnection::Send(IoMessage&& msg) {
   return 0;
 }
 
+void TcpConnection::UpdateReadByBackpressure() {
+  if (TRPC_LIKELY(GetSendQueueHighWatermark() == 0) || !enable_ || read_disabled_) {
+    return;
+  }
+
+  // No more requests are read while the responses to the peer are piling up in the send queue.
+  if (!read_paused_ && send_data_size_ >= GetSendQueueHighWatermark()) {
+    read_paused_ = true;
+    DisableEvent(EventHandler::EventType::kReadEvent);
+  } else if (read_paused_ && send_data_size_ <= GetSendQueueLowWatermark()) {
+    read_paused_ = false;
+    EnableEvent(EventHandler::EventType::kReadEvent);
+  } else {
+    return;
+  }
+
+  reactor_->Update(this);
+  TRPC_FMT_DEBUG("TcpConnection::UpdateReadByBackpressure ip {}, port: {}, is_client {}, send queue size: {}, {} read.",
+                 GetPeerIp(), GetPeerPort(), IsClient(), send_data_size_, read_paused_ ? "Pause" : "Resume");
+}
+
 int TcpConnection::JudgeConnected() {
   int val = 0;
   auto len = static_cast<socklen_t>(sizeof(int));
@@ -471,13 +503,26 @@ bool TcpConnection::PreCheckOnWrite() {
 
 // return: -1, close connection
 int TcpConnection::ReadIoData(NoncontiguousBuffer& buff) {
+  // The rest of a large frame is read into a block of its own, in which its body is contiguous and aligned.
+  uint32_t body_offset = 0;
+  if (uint32_t frame_size = TakeRecvFrameHint(&body_offset); TRPC_UNLIKELY(frame_size != 0)) {
+    read_buffer_.frame_block.Start(buff, frame_size, body_offset, GetBlockMaxAvailableSize());
+  }
+
   int ret = 0;
   while (true) {
-    size_t writable_size = read_buffer_.builder.SizeAvailable();
-    int n = GetIoHandler()->Read(read_buffer_.builder.data(), writable_size);
+    bool read_frame = read_buffer_.frame_block.Active();
+    size_t writable_size = read_frame ? read_buffer_.frame_block.SizeAvailable() : read_buffer_.builder.SizeAvailable();
+    char* data = read_frame ? read_buffer_.frame_block.data() : read_buffer_.builder.data();
+    int n = GetIoHandler()->Read(data, writable_size);
     if (n > 0) {
       ret += n;
-      buff.Append(read_buffer_.builder.Seal(n));
+      if (!read_frame) {
+        buff.Append(read_buffer_.builder.Seal(n));
+      } else if (read_buffer_.frame_block.Seal(n, buff)) {
+        // The frame is complete, the data following it is read into the blocks of the pool.
+        continue;
+      }
 
       if ((size_t)n < writable_size) {
         break;
@@ -17,6 +17,7 @@
 
 #include "trpc/runtime/iomodel/reactor/common/connection.h"
 #include "trpc/runtime/iomodel/reactor/common/io_message.h"
+#include "trpc/runtime/iomodel/reactor/common/recv_frame_block.h"
 #include "trpc/runtime/iomodel/reactor/common/socket.h"
 #include "trpc/runtime/iomodel/reactor/reactor.h"
 #include "trpc/util/align.h"
@@ -60,6 +61,7 @@ class TcpConnection final : public Connection {
   void MessageWriteDone(IoMessage& msg);
   int JudgeConnected();
   bool PreCheckOnWrite();
+  void UpdateReadByBackpressure();
   int ReadIoData(NoncontiguousBuffer& buff);
 
  private:
@@ -81,6 +83,8 @@ class TcpConnection final : public Connection {
   struct alignas(hardware_destructive_interference_size) {
     BufferBuilder builder;
     NoncontiguousBuffer buffer;
+    // Block of the large frame being received, hinted by the checker.
+    RecvFrameBlock frame_block;
   } read_buffer_;
 
   // Io message send queue
@@ -89,6 +93,12 @@ class TcpConnection final : public Connection {
   // The data size of the message to be sent
   uint32_t send_data_size_{0};
 
+  // Whether read event is disabled by the watermarks of the send queue
+  bool read_paused_{false};
+
+  // Whether read event is disabled by `DisableRead`, it's not enabled by the watermarks of the send queue then
+  bool read_disabled_{false};
+
   // Whether to need write data directly
   bool need_direct_write_{false};
 
@@ -14,6 +14,7 @@
 #include "trpc/runtime/iomodel/reactor/default/tcp_connection.h"
 
 #include <algorithm>
+#include <atomic>
 #include <condition_variable>
 #include <deque>
 #include <memory>
@@ -678,4 +679,100 @@ TEST_F(TcpConnectionTest, ConnectingIoMsgLimited) {
   latch.wait();
 }
 
+// Fails the writes with EAGAIN while stalled, so the messages sent pile up in the send queue.
+class StalledIoHandler : public DefaultIoHandler {
+ public:
+  explicit StalledIoHandler(Connection* conn) : DefaultIoHandler(conn) {}
+
+  int Writev(const iovec* iov, int iovcnt) override {
+    if (stalled_) {
+      errno = EAGAIN;
+      return -1;
+    }
+    return DefaultIoHandler::Writev(iov, iovcnt);
+  }
+
+  void SetStalled(bool stalled) { stalled_ = stalled; }
+
+ private:
+  std::atomic<bool> stalled_{true};
+};
+
+// Testing the read event paused between the watermarks of the send queue.
+TEST_F(TcpConnectionTest, SendQueueBackpressure) {
+  constexpr std::size_t kDataSize = 10000;
+
+  RefPtr<TcpConnection> conn = nullptr;
+  Latch accepted(1);
+  auto&& accept_handler = [this, &conn, &accepted](AcceptConnectionInfo& connection_info) {
+    connection_info.socket.SetTcpNoDelay();
+    connection_info.socket.SetBlock(false);
+
+    conn = MakeRefCounted<TcpConnection>(this->reactor_.get(), connection_info.socket);
+    conn->SetConnId(1);
+    conn->SetConnType(ConnectionType::kTcpLong);
+    conn->SetPeerIp(connection_info.conn_info.remote_addr.Ip());
+    conn->SetPeerPort(connection_info.conn_info.remote_addr.Port());
+    conn->SetPeerIpType(connection_info.conn_info.remote_addr.Type());
+    conn->SetSendQueueWatermark(3 * kDataSize, 0);
+    conn->SetIoHandler(std::make_unique<StalledIoHandler>(conn.Get()));
+    conn->SetConnectionHandler(std::make_unique<TcpConnectionHandler>(conn.Get(), this->reactor_.get()));
+
+    conn->Established();
+    conn->StartHandshaking();
+    accepted.count_down();
+    return true;
+  };
+
+  NetworkAddress addr = NetworkAddress(trpc::util::GenRandomAvailablePort(), false, NetworkAddress::IpType::kIpV4);
+  RefPtr<TcpAcceptor> acceptor = MakeRefCounted<TcpAcceptor>(reactor_.get(), addr);
+  acceptor->SetAcceptHandleFunction(std::move(accept_handler));
+  acceptor->EnableListen();
+
+  trpc::Socket client_socket = Socket::CreateTcpSocket(addr.IsIpv6());
+  client_socket.Connect(addr);
+  accepted.wait();
+
+  auto* io_handler = static_cast<StalledIoHandler*>(conn->GetIoHandler());
+  auto send = [&conn] {
+    IoMessage io_message;
+    io_message.buffer = CreateBufferSlow(std::string(kDataSize, 'a'));
+    return conn->Send(std::move(io_message));
+  };
+  auto is_reading = [&conn] { return (conn->GetSetEvents() & EventHandler::EventType::kReadEvent) != 0; };
+
+  Latch done(1);
+  reactor_->SubmitTask([&] {
+    EXPECT_EQ(send(), 0);
+    EXPECT_EQ(send(), 0);
+    EXPECT_TRUE(is_reading());
+    // Paused on reaching the high watermark.
+    EXPECT_EQ(send(), 0);
+    EXPECT_FALSE(is_reading());
+
+    // Resumed once the send queue drains to the low watermark.
+    io_handler->SetStalled(false);
+    EXPECT_EQ(send(), 0);
+    EXPECT_TRUE(is_reading());
+
+    // Reading disabled by `DisableRead` is left disabled when the send queue drains.
+    io_handler->SetStalled(true);
+    for (int i = 0; i < 3; ++i) {
+      EXPECT_EQ(send(), 0);
+    }
+    EXPECT_FALSE(is_reading());
+    conn->DisableRead();
+    io_handler->SetStalled(false);
+    EXPECT_EQ(send(), 0);
+    EXPECT_FALSE(is_reading());
+
+    conn->DoClose(true);
+    acceptor->DisableListen();
+    done.count_down();
+  });
+  done.wait();
+
+  client_socket.Close();
+}
+
 }  // namespace trpc::testing
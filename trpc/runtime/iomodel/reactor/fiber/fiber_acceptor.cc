@@ -18,6 +18,7 @@
 
 #include <utility>
 
+#include "trpc/runtime/iomodel/reactor/common/listen_fd_handoff.h"
 #include "trpc/util/log/logging.h"
 
 namespace trpc {
@@ -39,7 +40,7 @@ FiberAcceptor::FiberAcceptor(Reactor* reactor, const UnixAddress& unix_addr)
 }
 
 FiberAcceptor::~FiberAcceptor() {
-  socket_.Close();
+  CloseSocket();
 
   if (idle_fd_ >= 0) {
     ::close(idle_fd_);
@@ -58,6 +59,13 @@ bool FiberAcceptor::Listen() {
     return false;
   }
 
+  // Listens on the socket handed over by the process replaced if any, which is bound already.
+  int inherited_fd = is_net_ ? ListenFdHandoff::GetInstance()->TakeInherited(tcp_addr_.ToString()) : -1;
+  if (inherited_fd >= 0) {
+    socket_.Close();
+    socket_ = Socket(inherited_fd, tcp_addr_.IsIpv6() ? AF_INET6 : AF_INET);
+  }
+
   SetFd(socket_.GetFd());
 
   socket_.SetReuseAddr();
@@ -71,7 +79,7 @@ bool FiberAcceptor::Listen() {
   }
 
   if (is_net_) {
-    if (!socket_.Bind(tcp_addr_)) {
+    if (inherited_fd < 0 && !socket_.Bind(tcp_addr_)) {
       return false;
     }
   } else {
@@ -84,6 +92,10 @@ bool FiberAcceptor::Listen() {
     return false;
   }
 
+  if (is_net_) {
+    ListenFdHandoff::GetInstance()->AddListening(tcp_addr_.ToString(), socket_.GetFd());
+  }
+
   EnableEvent(EventHandler::EventType::kReadEvent);
 
   AttachReactor();
@@ -211,6 +223,13 @@ void FiberAcceptor::OnError(int err) {
   }
 }
 
-void FiberAcceptor::OnCleanup(CleanupReason reason) { socket_.Close(); }
+void FiberAcceptor::OnCleanup(CleanupReason reason) { CloseSocket(); }
+
+void FiberAcceptor::CloseSocket() {
+  if (is_net_ && socket_.IsValid()) {
+    ListenFdHandoff::GetInstance()->RemoveListening(socket_.GetFd());
+  }
+  socket_.Close();
+}
 
 }  // namespace trpc
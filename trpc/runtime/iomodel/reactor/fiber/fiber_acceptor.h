@@ -55,6 +55,7 @@ class FiberAcceptor : public FiberConnection {
   void OnCleanup(CleanupReason reason) override;
   EventAction OnTcpReadable();
   EventAction OnUdsReadable();
+  void CloseSocket();
 
  private:
   Reactor* reactor_{nullptr};
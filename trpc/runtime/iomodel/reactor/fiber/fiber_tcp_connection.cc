@@ -10,11 +10,17 @@
 
 #include "trpc/runtime/iomodel/reactor/fiber/fiber_tcp_connection.h"
 
+#include <algorithm>
+#include <chrono>
 #include <deque>
 #include <limits>
+#include <mutex>
 #include <utility>
 #include <vector>
 
+#include "trpc/coroutine/fiber_timer.h"
+#include "trpc/tvar/basic_ops/reducer.h"
+#include "trpc/util/chrono/chrono.h"
 #include "trpc/util/likely.h"
 #include "trpc/util/log/logging.h"
 #include "trpc/util/time.h"
@@ -23,18 +29,43 @@ using namespace std::literals;
 
 namespace trpc {
 
+namespace {
+
+// The recv buffer of a connection is released once nothing is received by it for this long.
+constexpr std::chrono::milliseconds kReadBufferIdleTimeout = 1000ms;
+
+// Leaked on purpose, the connections may be destroyed after the static objects on exit.
+tvar::Gauge<std::int64_t>& ConnectionCount() {
+  static auto* count = new tvar::Gauge<std::int64_t>(0);
+  return *count;
+}
+
+tvar::Gauge<std::int64_t>& ReadBufferBytes() {
+  static auto* bytes = new tvar::Gauge<std::int64_t>(0);
+  return *bytes;
+}
+
+}  // namespace
+
 FiberTcpConnection::FiberTcpConnection(Reactor* reactor, const Socket& socket)
     : FiberConnection(reactor), socket_(socket) {
   TRPC_ASSERT(socket_.IsValid());
 
   SetFd(socket_.GetFd());
+  ConnectionCount().Add(1);
 }
 
 FiberTcpConnection::~FiberTcpConnection() {
   TRPC_LOG_DEBUG("~FiberTcpConnection fd:" << socket_.GetFd() << ", conn_id:" << this->GetConnId());
   TRPC_ASSERT(!socket_.IsValid());
+  ReleaseReadBuffer();
+  ConnectionCount().Subtract(1);
 }
 
+std::int64_t FiberTcpConnection::GetConnectionCount() { return ConnectionCount().GetValue(); }
+
+std::int64_t FiberTcpConnection::GetReadBufferBytes() { return ReadBufferBytes().GetValue(); }
+
 void FiberTcpConnection::Established() {
   if (IsClient()) {
     // The server's connection status are set separately before calling Established
@@ -103,8 +134,23 @@ int FiberTcpConnection::Send(IoMessage&& msg) {
     return -1;
   }
 
+  if (TRPC_UNLIKELY(backpressure_.blocked.load(std::memory_order_acquire))) {
+    if (!WaitForSendQueueDrained()) {
+      TRPC_LOG_ERROR("FiberTcpConnection::Send timeout to wait for the send queue drained, ip:"
+                     << GetPeerIp() << ", port:" << GetPeerPort() << ", is_client:" << IsClient()
+                     << ", conn_id: " << this->GetConnId());
+      return -2;
+    }
+    if (!Enabled()) {
+      return -1;
+    }
+  }
+
   auto append_status =
       writing_buffers_.Append(std::move(msg.buffer), std::move(msg), GetSendQueueCapacity(), GetSendQueueTimeout());
+  if (GetSendQueueHighWatermark() != 0 && append_status != WritingBufferList::kTimeout) {
+    BlockSendIfAboveHighWatermark();
+  }
   if (TRPC_LIKELY(append_status == WritingBufferList::kAppendHead)) {
     if (TRPC_UNLIKELY(!handshaking_state_.done.load(std::memory_order_relaxed))) {
       std::scoped_lock _(handshaking_state_.lock);
@@ -192,6 +238,11 @@ FiberConnection::EventAction FiberTcpConnection::OnReadable() {
 
   ReadStatus status;
   do {
+    // No more requests are read while the responses to the peer are piling up in the send queue.
+    if (TRPC_UNLIKELY(backpressure_.blocked.load(std::memory_order_acquire)) && SuppressReadForBackpressure()) {
+      return EventAction::kSuppress;
+    }
+
     status = ReadData();
     if (TRPC_LIKELY(status != ReadStatus::kError)) {
       SetConnActiveTime(trpc::time::GetMilliSeconds());
@@ -208,6 +259,10 @@ FiberConnection::EventAction FiberTcpConnection::OnReadable() {
   } while (status == ReadStatus::kPartialRead);
 
   if (TRPC_LIKELY(status == ReadStatus::kDrained)) {
+    // The block is reused by the following reads, it's released only after the connection turns idle.
+    if (!read_buffer_.release_timer_pending.exchange(true, std::memory_order_relaxed)) {
+      StartReadBufferReleaseTimer(kReadBufferIdleTimeout);
+    }
     return EventAction::kReady;
   } else if (status == ReadStatus::kRemoteClose) {
     TRPC_LOG_DEBUG("FiberTcpConnection::OnReadable remote close, ip:" << GetPeerIp() << ", port:" << GetPeerPort()
@@ -225,12 +280,27 @@ FiberConnection::EventAction FiberTcpConnection::OnReadable() {
 }
 
 FiberTcpConnection::ReadStatus FiberTcpConnection::ReadData() {
+  // The rest of a large frame is read into a block of its own, in which its body is contiguous and aligned.
+  uint32_t body_offset = 0;
+  if (uint32_t frame_size = TakeRecvFrameHint(&body_offset); TRPC_UNLIKELY(frame_size != 0)) {
+    read_buffer_.frame_block.Start(read_buffer_.buffer, frame_size, body_offset, GetBlockMaxAvailableSize());
+  }
+  if (TRPC_UNLIKELY(read_buffer_.frame_block.Active())) {
+    return ReadFrameData();
+  }
+
+  std::scoped_lock _(read_buffer_.builder_lock);
+  if (!read_buffer_.builder) {
+    read_buffer_.builder.emplace();
+    ReadBufferBytes().Add(GetBlockMaxAvailableSize());
+  }
+
   size_t recv_buffer_size = GetRecvBufferSize();
   size_t total_read = 0;
   while (true) {
-    size_t writable_size = read_buffer_.builder.SizeAvailable();
-    if (int n = GetIoHandler()->Read(read_buffer_.builder.data(), writable_size); n > 0) {
-      read_buffer_.buffer.Append(read_buffer_.builder.Seal(n));
+    size_t writable_size = read_buffer_.builder->SizeAvailable();
+    if (int n = GetIoHandler()->Read(read_buffer_.builder->data(), writable_size); n > 0) {
+      read_buffer_.buffer.Append(read_buffer_.builder->Seal(n));
 
       if (size_t read = n; read < writable_size) {
         return ReadStatus::kDrained;
@@ -245,6 +315,67 @@ FiberTcpConnection::ReadStatus FiberTcpConnection::ReadData() {
   }
 }
 
+FiberTcpConnection::ReadStatus FiberTcpConnection::ReadFrameData() {
+  size_t recv_buffer_size = GetRecvBufferSize();
+  size_t total_read = 0;
+  while (true) {
+    size_t writable_size = read_buffer_.frame_block.SizeAvailable();
+    if (int n = GetIoHandler()->Read(read_buffer_.frame_block.data(), writable_size); n > 0) {
+      // Once the frame is complete, it's consumed and the data following it is read into the blocks of the pool.
+      if (read_buffer_.frame_block.Seal(n, read_buffer_.buffer)) {
+        return ReadStatus::kPartialRead;
+      }
+
+      if (size_t read = n; read < writable_size) {
+        return ReadStatus::kDrained;
+      } else if (recv_buffer_size != 0 && (total_read += read) >= recv_buffer_size) {
+        return ReadStatus::kPartialRead;
+      }
+    } else if (n == 0) {
+      return ReadStatus::kRemoteClose;
+    } else {
+      return errno != EAGAIN ? ReadStatus::kError : ReadStatus::kDrained;
+    }
+  }
+}
+
+void FiberTcpConnection::ReleaseReadBuffer() {
+  if (read_buffer_.builder) {
+    // The data sealed from the block keeps it alive until consumed.
+    read_buffer_.builder.reset();
+    ReadBufferBytes().Subtract(GetBlockMaxAvailableSize());
+  }
+}
+
+void FiberTcpConnection::StartReadBufferReleaseTimer(std::chrono::milliseconds after) {
+  auto timer = CreateFiberTimer(ReadSteadyClock() + after, [this, ref = RefPtr(ref_ptr, this)](auto timer_id) {
+    KillFiberTimer(timer_id);
+    ReleaseReadBufferIfIdle();
+  });
+  EnableFiberTimer(timer);
+}
+
+void FiberTcpConnection::ReleaseReadBufferIfIdle() {
+  uint64_t now_ms = trpc::time::GetMilliSeconds();
+  uint64_t active_ms = GetConnActiveTime();
+  auto idle_time = std::chrono::milliseconds(now_ms > active_ms ? now_ms - active_ms : 0);
+  // The connection is reading if the lock is held, it's not idle.
+  std::unique_lock lock(read_buffer_.builder_lock, std::try_to_lock);
+  if (lock.owns_lock() && idle_time >= kReadBufferIdleTimeout) {
+    ReleaseReadBuffer();
+    read_buffer_.release_timer_pending.store(false, std::memory_order_relaxed);
+    return;
+  }
+  lock.unlock();
+
+  if (Enabled()) {
+    StartReadBufferReleaseTimer(std::max(kReadBufferIdleTimeout - idle_time, 1ms));
+  } else {
+    // The connection is closed, its recv buffer is released on destruction.
+    read_buffer_.release_timer_pending.store(false, std::memory_order_relaxed);
+  }
+}
+
 FiberConnection::EventAction FiberTcpConnection::ConsumeReadData() {
   if (read_buffer_.buffer.ByteSize() <= 0) {
     return EventAction::kReady;
@@ -334,6 +465,8 @@ FiberTcpConnection::FlushStatus FiberTcpConnection::FlushWritingBuffer(std::size
     ever_succeeded = true;
     bytes_quota -= written;
 
+    UnblockSendIfDrained();
+
     // Update the active time of the connection when there is a write operation on the file descriptor (fd)
     SetConnActiveTime(trpc::time::GetMilliSeconds());
     GetConnectionHandler()->UpdateConnection();
@@ -377,6 +510,12 @@ void FiberTcpConnection::OnCleanup(CleanupReason reason) {
 
   writing_buffers_.Stop();
 
+  // Wakes up the senders waiting for the send queue to drain, they'll find the connection disabled.
+  {
+    std::scoped_lock _(backpressure_.lock);
+  }
+  backpressure_.drained_cv.notify_all();
+
   {
     std::scoped_lock<std::mutex> _(mutex_);
     conn_unavailable_ = true;
@@ -386,6 +525,50 @@ void FiberTcpConnection::OnCleanup(CleanupReason reason) {
   }
 }
 
+void FiberTcpConnection::BlockSendIfAboveHighWatermark() {
+  if (writing_buffers_.Size() < GetSendQueueHighWatermark() || backpressure_.blocked.exchange(true)) {
+    return;
+  }
+
+  TRPC_LOG_DEBUG("FiberTcpConnection::BlockSendIfAboveHighWatermark ip:"
+                 << GetPeerIp() << ", port:" << GetPeerPort() << ", is_client:" << IsClient()
+                 << ", conn_id:" << this->GetConnId() << ", send queue size:" << writing_buffers_.Size()
+                 << ", pause reading and sending.");
+
+  // The queue may have been drained by the flushing side before it saw the flag.
+  UnblockSendIfDrained();
+}
+
+void FiberTcpConnection::UnblockSendIfDrained() {
+  if (!backpressure_.blocked.load() || writing_buffers_.Size() > GetSendQueueLowWatermark() ||
+      !backpressure_.blocked.exchange(false)) {
+    return;
+  }
+
+  if (backpressure_.read_suppressed.exchange(false)) {
+    RestartReadIn(0ns);
+  }
+
+  {
+    std::scoped_lock _(backpressure_.lock);
+  }
+  backpressure_.drained_cv.notify_all();
+}
+
+bool FiberTcpConnection::WaitForSendQueueDrained() {
+  std::unique_lock lock(backpressure_.lock);
+  return backpressure_.drained_cv.wait_for(lock, std::chrono::milliseconds(GetSendQueueTimeout()), [this] {
+    return !backpressure_.blocked.load(std::memory_order_acquire) || !Enabled();
+  });
+}
+
+bool FiberTcpConnection::SuppressReadForBackpressure() {
+  backpressure_.read_suppressed.store(true);
+  // If the queue is drained meanwhile, reading goes on unless the one who drained it has taken the flag and is going
+  // to restart reading, which is fine even if it comes before `kSuppress` is returned.
+  return backpressure_.blocked.load() || !backpressure_.read_suppressed.exchange(false);
+}
+
 IoHandler::HandshakeStatus FiberTcpConnection::DoHandshake(bool from_on_readable) {
   std::scoped_lock _(handshaking_state_.lock);
   if (handshaking_state_.done.load(std::memory_order_relaxed)) {
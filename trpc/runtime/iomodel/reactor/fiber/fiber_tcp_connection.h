@@ -11,11 +11,19 @@
 #pragma once
 
 #include <list>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <memory>
+#include <optional>
 
+#include "trpc/coroutine/fiber_condition_variable.h"
+#include "trpc/coroutine/fiber_mutex.h"
 #include "trpc/runtime/iomodel/reactor/common/io_handler.h"
+#include "trpc/runtime/iomodel/reactor/common/recv_frame_block.h"
 #include "trpc/runtime/iomodel/reactor/fiber/fiber_connection.h"
 #include "trpc/runtime/iomodel/reactor/fiber/writing_buffer_list.h"
+#include "trpc/util/thread/spinlock.h"
 
 namespace trpc {
 
@@ -40,6 +48,21 @@ class FiberTcpConnection final : public FiberConnection {
 
   void Join() override;
 
+  /// @brief Gets the bytes queued to be sent.
+  std::size_t GetSendQueueSize() { return writing_buffers_.Size(); }
+
+  /// @brief Whether the send queue has reached the high watermark and not drained to the low watermark yet, reading
+  ///        is paused and the senders are suspended meanwhile, see `Connection::SetSendQueueWatermark`.
+  bool IsSendQueueBlocked() const { return backpressure_.blocked.load(std::memory_order_relaxed); }
+
+  /// @brief Gets the number of the fiber tcp connections alive.
+  static std::int64_t GetConnectionCount();
+
+  /// @brief Gets the bytes of the recv buffers held by the fiber tcp connections. The recv buffer of a connection is
+  ///        allocated once it's readable and kept while it's active, it's released once nothing is received by the
+  ///        connection for a second, so the idle connections hold none.
+  static std::int64_t GetReadBufferBytes();
+
  private:
   enum class ReadStatus { kDrained, kPartialRead, kRemoteClose, kError };
 
@@ -60,6 +83,14 @@ class FiberTcpConnection final : public FiberConnection {
   FiberTcpConnection::FlushStatus FlushWritingBuffer(std::size_t max_bytes);
   FiberTcpConnection::ReadStatus ReadData();
   FiberConnection::EventAction ConsumeReadData();
+  ReadStatus ReadFrameData();
+  void ReleaseReadBuffer();
+  void StartReadBufferReleaseTimer(std::chrono::milliseconds after);
+  void ReleaseReadBufferIfIdle();
+  void BlockSendIfAboveHighWatermark();
+  void UnblockSendIfDrained();
+  bool WaitForSendQueueDrained();
+  bool SuppressReadForBackpressure();
 
  private:
   struct HandshakingState {
@@ -69,15 +100,33 @@ class FiberTcpConnection final : public FiberConnection {
     bool pending_restart_writes{false};
   };
 
+  struct BackpressureState {
+    // Whether the send queue has reached the high watermark and not drained to the low watermark yet.
+    std::atomic<bool> blocked{false};
+    // Whether reading is suppressed by `OnReadable` because of `blocked`, reading is restarted by the one clearing it.
+    std::atomic<bool> read_suppressed{false};
+    FiberMutex lock;
+    FiberConditionVariable drained_cv;
+  };
+
   Socket socket_;
 
   // Describes state of handshaking.
   HandshakingState handshaking_state_;
 
-  // Recv buffer
+  // Describes state of the backpressure of the send queue.
+  BackpressureState backpressure_;
+
+  // Recv buffer, the builder holds a block while the connection is active.
   struct alignas(hardware_destructive_interference_size) {
-    BufferBuilder builder;
+    // Guards `builder` against the timer releasing it while idle, it's taken by the reading fiber only otherwise.
+    Spinlock builder_lock;
+    std::optional<BufferBuilder> builder;
+    // Whether the timer releasing `builder` once the connection is idle is pending.
+    std::atomic<bool> release_timer_pending{false};
     NoncontiguousBuffer buffer;
+    // Block of the large frame being received, hinted by the checker.
+    RecvFrameBlock frame_block;
   } read_buffer_;
 
   // Send buffer list
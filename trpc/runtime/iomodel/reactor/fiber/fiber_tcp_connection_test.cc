@@ -21,6 +21,7 @@
 #include "gtest/gtest.h"
 
 #include "trpc/coroutine/fiber.h"
+#include "trpc/coroutine/fiber_latch.h"
 #include "trpc/runtime/fiber_runtime.h"
 #include "trpc/runtime/iomodel/reactor/common/socket.h"
 #include "trpc/runtime/iomodel/reactor/common/default_io_handler.h"
@@ -51,6 +52,7 @@ class ConnectionTestHandler : public ConnectionHandler {
     }
 
     std::cout << "data:" << FlattenSlow(in) << ",total_buff_size:" << total_buff_size << std::endl;
+    out.emplace_back(in.Cut(size_));
 
     return kPacketFull;
   }
@@ -191,6 +193,8 @@ class FiberTcpConnectionTestImpl {
 
   std::size_t GetClientReceived() { return client_received_.load(); }
 
+  RefPtr<FiberTcpConnection> GetServerConn() { return server_conn_; }
+
  protected:
   Reactor* reactor_;
   NetworkAddress addr_;
@@ -217,6 +221,8 @@ class FiberTcpConnectionTest : public ::testing::Test {
 
   std::size_t GetClientReceived() { return test_impl_.GetClientReceived(); }
 
+  RefPtr<FiberTcpConnection> GetServerConn() { return test_impl_.GetServerConn(); }
+
  protected:
   static FiberTcpConnectionTestImpl test_impl_;
 };
@@ -243,6 +249,13 @@ TEST_F(FiberTcpConnectionTest, OK) {
 
   ASSERT_EQ(GetClientReceived(), kDataSize);
 
+  // The recv buffers are kept for the following reads, and released once the connections turn idle.
+  ASSERT_GT(FiberTcpConnection::GetReadBufferBytes(), 0);
+  while (FiberTcpConnection::GetReadBufferBytes() != 0) {
+    FiberSleepFor(std::chrono::milliseconds(10));
+  }
+  ASSERT_GE(FiberTcpConnection::GetConnectionCount(), 2);
+
   client_conn->DoClose(false);
 
   client_conn->Stop();
@@ -319,6 +332,135 @@ TEST_F(FiberTcpConnectionTest, WriteError2) {
   client_conn->Join();
 }
 
+// Stalls the first write until resumed, so the messages sent meanwhile pile up in the send queue.
+class StalledIoHandler : public DefaultIoHandler {
+ public:
+  explicit StalledIoHandler(Connection* conn, bool stalled = true) : DefaultIoHandler(conn), stalled_(stalled) {}
+
+  // Stalls the next write, if the handler is not stalled on construction. It works once only.
+  void Stall() { stalled_ = true; }
+
+  int Writev(const iovec* iov, int iovcnt) override {
+    if (stalled_.exchange(false)) {
+      writing_.CountDown();
+      resumed_.Wait();
+    }
+    return DefaultIoHandler::Writev(iov, iovcnt);
+  }
+
+  void WaitForWriting() { writing_.Wait(); }
+
+  void Resume() { resumed_.CountDown(); }
+
+ private:
+  std::atomic<bool> stalled_;
+  FiberLatch writing_{1};
+  FiberLatch resumed_{1};
+};
+
+TEST_F(FiberTcpConnectionTest, SendQueueBackpressure) {
+  RefPtr<FiberTcpConnection> client_conn = CreateClientConn<StalledIoHandler>();
+  client_conn->SetSendQueueWatermark(3 * kDataSize, 0);
+  ASSERT_EQ(client_conn->GetSendQueueLowWatermark(), 3 * kDataSize / 2);
+
+  auto* io_handler = static_cast<StalledIoHandler*>(client_conn->GetIoHandler());
+  auto send = [&client_conn] {
+    IoMessage msg;
+    msg.seq_id = 0;
+    msg.buffer = CreateBufferSlow(std::string(kDataSize, 1));
+    return client_conn->Send(std::move(msg));
+  };
+  std::size_t server_received = GetServerReceived();
+
+  FiberLatch done(2);
+  StartFiberDetached([&] {
+    EXPECT_EQ(send(), 0);
+    done.CountDown();
+  });
+  io_handler->WaitForWriting();
+
+  ASSERT_EQ(send(), 0);
+  ASSERT_FALSE(client_conn->IsSendQueueBlocked());
+  ASSERT_EQ(send(), 0);
+  ASSERT_TRUE(client_conn->IsSendQueueBlocked());
+
+  // The sender is suspended until the send queue drains.
+  std::atomic<bool> sent{false};
+  StartFiberDetached([&] {
+    EXPECT_EQ(send(), 0);
+    sent = true;
+    done.CountDown();
+  });
+  FiberSleepFor(std::chrono::milliseconds(10));
+  ASSERT_FALSE(sent);
+
+  io_handler->Resume();
+  done.Wait();
+  ASSERT_FALSE(client_conn->IsSendQueueBlocked());
+
+  while (client_conn->GetSendQueueSize() != 0 || GetServerReceived() == server_received) {
+    FiberSleepFor(std::chrono::milliseconds(1));
+  }
+
+  client_conn->Stop();
+  client_conn->Join();
+}
+
+// Writes as usual until `Stall` is called.
+class LaterStalledIoHandler : public StalledIoHandler {
+ public:
+  explicit LaterStalledIoHandler(Connection* conn) : StalledIoHandler(conn, false) {}
+};
+
+TEST_F(FiberTcpConnectionTest, SendQueueBackpressureSuppressRead) {
+  RefPtr<FiberTcpConnection> client_conn = CreateClientConn<LaterStalledIoHandler>();
+  client_conn->SetSendQueueWatermark(3 * kDataSize, 0);
+
+  auto* io_handler = static_cast<StalledIoHandler*>(client_conn->GetIoHandler());
+  auto send = [](const RefPtr<FiberTcpConnection>& conn) {
+    IoMessage msg;
+    msg.seq_id = 0;
+    msg.buffer = CreateBufferSlow(std::string(kDataSize, 1));
+    return conn->Send(std::move(msg));
+  };
+
+  // A round trip first, so the server connection accepted last is the peer of the client connection.
+  std::size_t client_received = GetClientReceived();
+  ASSERT_EQ(send(client_conn), 0);
+  while (GetClientReceived() == client_received) {
+    FiberSleepFor(std::chrono::milliseconds(1));
+  }
+  RefPtr<FiberTcpConnection> server_conn = GetServerConn();
+
+  io_handler->Stall();
+  FiberLatch done(1);
+  StartFiberDetached([&] {
+    EXPECT_EQ(send(client_conn), 0);
+    done.CountDown();
+  });
+  io_handler->WaitForWriting();
+  ASSERT_EQ(send(client_conn), 0);
+  ASSERT_EQ(send(client_conn), 0);
+  ASSERT_TRUE(client_conn->IsSendQueueBlocked());
+
+  // Nothing is read from the peer while the send queue is blocked.
+  client_received = GetClientReceived();
+  ASSERT_EQ(send(server_conn), 0);
+  FiberSleepFor(std::chrono::milliseconds(50));
+  ASSERT_EQ(GetClientReceived(), client_received);
+
+  // Reading is restarted once the send queue drains.
+  io_handler->Resume();
+  done.Wait();
+  ASSERT_FALSE(client_conn->IsSendQueueBlocked());
+  while (GetClientReceived() == client_received) {
+    FiberSleepFor(std::chrono::milliseconds(1));
+  }
+
+  client_conn->Stop();
+  client_conn->Join();
+}
+
 }  // namespace testing
 
 }  // namespace trpc
@@ -47,6 +47,8 @@ std::shared_ptr<ThreadModel> CreateMergeThreadModel(const DefaultThreadModelInst
   options.enable_async_io = config.enable_async_io;
   options.io_uring_entries = config.io_uring_entries;
   options.io_uring_flags = config.io_uring_flags;
+  options.codel.target = config.queue_codel_target;
+  options.codel.interval = config.queue_codel_interval;
   options.cpu_affinitys.clear();
 
   if (!config.io_cpu_affinitys.empty()) {
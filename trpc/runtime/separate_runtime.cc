@@ -50,6 +50,9 @@ NonStealScheduling::Options CreateNonStealSchedulingOptions(const DefaultThreadM
   options.worker_thread_num = handle_thread_num;
   options.local_queue_size = config.scheduling.local_queue_size;
   options.global_queue_size = config.handle_thread_task_queue_size;
+  options.codel.target = config.queue_codel_target;
+  options.codel.interval = config.queue_codel_interval;
+  options.lifo_when_overloaded = config.queue_lifo_when_overloaded;
 
   return options;
 }
@@ -63,6 +66,8 @@ StealScheduling::Options CreateStealSchedulingOptions(const DefaultThreadModelIn
   options.group_name = config.instance_name;
   options.worker_thread_num = handle_thread_num;
   options.global_queue_size = config.handle_thread_task_queue_size;
+  options.codel.target = config.queue_codel_target;
+  options.codel.interval = config.queue_codel_interval;
 
   return options;
 }
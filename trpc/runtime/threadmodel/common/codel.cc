@@ -0,0 +1,81 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#include "trpc/runtime/threadmodel/common/codel.h"
+
+#include <cmath>
+
+#include "trpc/util/time.h"
+
+namespace trpc {
+
+bool CoDelController::OnDequeue(uint64_t enqueue_ms, uint64_t now_ms) {
+  uint64_t sojourn_ms = now_ms > enqueue_ms ? now_ms - enqueue_ms : 0;
+  if (sojourn_ms < options_.target) {
+    if (overload_ms_.load(std::memory_order_relaxed) != 0) {
+      std::scoped_lock _(mutex_);
+      overload_ms_.store(0, std::memory_order_relaxed);
+      dropping_ = false;
+    }
+    return false;
+  }
+
+  std::scoped_lock _(mutex_);
+  uint64_t overload_ms = overload_ms_.load(std::memory_order_relaxed);
+  if (overload_ms == 0) {
+    overload_ms_.store(now_ms + options_.interval, std::memory_order_relaxed);
+    return false;
+  }
+
+  if (now_ms < overload_ms) {
+    return false;
+  }
+
+  if (!dropping_) {
+    dropping_ = true;
+    // Same as the reference CoDel, the drop rate is resumed if the queue turns overloaded again soon after.
+    if (drop_count_ > 2 && now_ms < drop_next_ms_ + 8 * static_cast<uint64_t>(options_.interval)) {
+      drop_count_ -= 2;
+    } else {
+      drop_count_ = 1;
+    }
+    drop_next_ms_ = NextDropMs(now_ms);
+    return true;
+  }
+
+  if (now_ms >= drop_next_ms_) {
+    ++drop_count_;
+    drop_next_ms_ = NextDropMs(drop_next_ms_);
+    return true;
+  }
+
+  return false;
+}
+
+uint64_t CoDelController::NextDropMs(uint64_t ms) const {
+  return ms + static_cast<uint64_t>(options_.interval / std::sqrt(drop_count_));
+}
+
+void RunMsgTask(MsgTask* task, CoDelController& codel) {
+  if (task->enqueue_timestamp_ms != 0 && task->drop_handler && codel.Enabled() &&
+      codel.OnDequeue(task->enqueue_timestamp_ms, trpc::time::GetMilliSeconds())) {
+    task->drop_handler();
+  } else {
+    task->handler();
+  }
+
+  trpc::object_pool::Delete<MsgTask>(task);
+}
+
+}  // namespace trpc
@@ -0,0 +1,83 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+#include "trpc/runtime/threadmodel/common/msg_task.h"
+
+namespace trpc {
+
+/// @brief Controlled-delay(CoDel) management of a task queue, which tracks the sojourn times of the dequeued tasks.
+///        The queue turns overloaded once the sojourn times stay above `target` for `interval`, then a task waiting
+///        longer than `target` is dropped and the next drop is scheduled `interval / sqrt(count)` later, `count` being
+///        the number of drops so far, so the drop rate grows while the queue stays above `target`. A task dequeued
+///        within `target` ends the overload.
+/// @note Thread safe, the queue can be consumed by multiple threads.
+class CoDelController {
+ public:
+  struct Options {
+    /// Target sojourn time(ms) of the tasks, 0 means disabled.
+    uint32_t target{0};
+
+    /// Time(ms) the sojourn times stay above the target before the queue turns overloaded, also the initial spacing
+    /// of the drops.
+    uint32_t interval{100};
+  };
+
+  explicit CoDelController(const Options& options) : options_(options) {}
+
+  bool Enabled() const { return options_.target > 0; }
+
+  /// @brief Reports a task dequeued.
+  /// @param enqueue_ms The time the task was enqueued.
+  /// @param now_ms The time the task is dequeued.
+  /// @return Whether the task should be dropped.
+  bool OnDequeue(uint64_t enqueue_ms, uint64_t now_ms);
+
+  /// @brief Whether the queue is overloaded.
+  bool IsOverloaded(uint64_t now_ms) const {
+    uint64_t overload_ms = overload_ms_.load(std::memory_order_relaxed);
+    return overload_ms != 0 && now_ms >= overload_ms;
+  }
+
+ private:
+  uint64_t NextDropMs(uint64_t ms) const;
+
+ private:
+  Options options_;
+
+  // The time the queue turns overloaded if the sojourn times stay above the target, 0 if they are within the target.
+  // It is written with `mutex_` held, but read without it, so the tasks within the target take no lock.
+  std::atomic<uint64_t> overload_ms_{0};
+
+  std::mutex mutex_;
+
+  // Whether the tasks above the target are being dropped.
+  bool dropping_{false};
+
+  // The number of drops since the queue turned overloaded.
+  uint32_t drop_count_{0};
+
+  // The time of the next drop.
+  uint64_t drop_next_ms_{0};
+};
+
+/// @brief Runs the handler of the task, or its `drop_handler` if the task is dropped by `codel`, then deletes the task.
+void RunMsgTask(MsgTask* task, CoDelController& codel);
+
+}  // namespace trpc
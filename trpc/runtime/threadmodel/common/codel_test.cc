@@ -0,0 +1,96 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#include "trpc/runtime/threadmodel/common/codel.h"
+
+#include "gtest/gtest.h"
+
+#include "trpc/util/time.h"
+
+namespace trpc::testing {
+
+TEST(CoDelControllerTest, OnDequeue) {
+  CoDelController codel(CoDelController::Options{.target = 5, .interval = 100});
+  ASSERT_TRUE(codel.Enabled());
+
+  // Within the target.
+  ASSERT_FALSE(codel.OnDequeue(1000, 1004));
+  ASSERT_FALSE(codel.IsOverloaded(1004));
+
+  // Above the target, but not for an interval yet.
+  ASSERT_FALSE(codel.OnDequeue(1000, 1010));
+  ASSERT_FALSE(codel.OnDequeue(1050, 1100));
+  ASSERT_FALSE(codel.IsOverloaded(1100));
+
+  // Stays above the target for an interval, a task waiting longer than the target is dropped.
+  ASSERT_TRUE(codel.OnDequeue(1100, 1110));
+  ASSERT_TRUE(codel.IsOverloaded(1110));
+
+  // The next drop is an interval later.
+  ASSERT_FALSE(codel.OnDequeue(1100, 1111));
+  ASSERT_FALSE(codel.OnDequeue(1100, 1209));
+  ASSERT_TRUE(codel.OnDequeue(1100, 1210));
+
+  // Then interval / sqrt(2) later, the drops get closer while the queue stays above the target.
+  ASSERT_FALSE(codel.OnDequeue(1200, 1279));
+  ASSERT_TRUE(codel.OnDequeue(1200, 1280));
+  ASSERT_FALSE(codel.OnDequeue(1300, 1336));
+  ASSERT_TRUE(codel.OnDequeue(1300, 1337));
+
+  // A task within the target ends the overload.
+  ASSERT_FALSE(codel.OnDequeue(1338, 1340));
+  ASSERT_FALSE(codel.IsOverloaded(1340));
+  ASSERT_FALSE(codel.OnDequeue(1300, 1350));
+  ASSERT_FALSE(codel.IsOverloaded(1350));
+
+  // Overloaded again soon after, the drops resume near the previous rate: interval / sqrt(4 - 2).
+  ASSERT_TRUE(codel.OnDequeue(1400, 1450));
+  ASSERT_FALSE(codel.OnDequeue(1400, 1519));
+  ASSERT_TRUE(codel.OnDequeue(1400, 1520));
+}
+
+TEST(CoDelControllerTest, RunMsgTask) {
+  CoDelController codel(CoDelController::Options{.target = 5, .interval = 0});
+
+  int handled = 0, dropped = 0;
+  auto make_task = [&](uint64_t enqueue_timestamp_ms, bool droppable) {
+    MsgTask* task = object_pool::New<MsgTask>();
+    task->handler = [&] { ++handled; };
+    if (droppable) {
+      task->drop_handler = [&] { ++dropped; };
+    }
+    task->enqueue_timestamp_ms = enqueue_timestamp_ms;
+    return task;
+  };
+
+  uint64_t now_ms = trpc::time::GetMilliSeconds();
+  RunMsgTask(make_task(now_ms, true), codel);
+  RunMsgTask(make_task(now_ms - 1000, false), codel);
+  ASSERT_EQ(handled, 2);
+  ASSERT_EQ(dropped, 0);
+
+  // The first task above the target starts the interval.
+  RunMsgTask(make_task(now_ms - 1000, true), codel);
+  ASSERT_EQ(handled, 3);
+  RunMsgTask(make_task(now_ms - 1000, true), codel);
+  ASSERT_EQ(handled, 3);
+  ASSERT_EQ(dropped, 1);
+
+  // Disabled.
+  CoDelController disabled(CoDelController::Options{});
+  RunMsgTask(make_task(now_ms - 1000, true), disabled);
+  ASSERT_EQ(handled, 4);
+}
+
+}  // namespace trpc::testing
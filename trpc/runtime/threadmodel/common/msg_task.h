@@ -38,11 +38,22 @@ struct MsgTask {
   /// thread model for processing is selected.
   int32_t dst_thread_key = -1;
 
+  /// Priority of the task in [0, 255], the higher the more urgent. Tasks of higher priority are dispatched ahead of
+  /// the others by the fiber thread model configured with priority lanes, see `fiber_scheduling_lane_weights`.
+  int32_t priority = UINT8_MAX;
+
   /// related parameters for task processing
   void* param = nullptr;
 
   /// task processing method
   MsgTaskHandler handler;
+
+  /// Called in place of `handler` if the task is dropped by the queue management of the thread model, see
+  /// `CoDelController`. The task is never dropped if not set.
+  MsgTaskHandler drop_handler;
+
+  /// Time(ms) the task is enqueued, set by the thread models with queue management enabled.
+  uint64_t enqueue_timestamp_ms = 0;
 };
 
 namespace object_pool {
@@ -40,6 +40,7 @@ struct alignas(hardware_destructive_interference_size) FiberDesc
   std::uint64_t last_ready_tsc;
   bool scheduling_group_local;
   bool is_fiber_reactor = false;
+  std::uint8_t scheduling_lane = 0;
 
   FiberDesc();
 };
@@ -152,6 +152,9 @@ struct alignas(hardware_destructive_interference_size) FiberEntity
   // is reactor fiber
   bool is_fiber_reactor = false;
 
+  // Priority lane of the run queue this fiber is queued in whenever it becomes ready, 0 is the highest one.
+  std::uint8_t scheduling_lane = 0;
+
   // Set if there is a pending `ResumeOn`. Cleared once `ResumeOn` completes.
   Function<void()> resume_proc = nullptr;
 
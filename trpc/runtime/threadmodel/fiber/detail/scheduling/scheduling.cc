@@ -13,6 +13,7 @@
 
 #include "trpc/runtime/threadmodel/fiber/detail/scheduling/scheduling.h"
 
+#include <algorithm>
 #include <unordered_map>
 
 #include "trpc/runtime/threadmodel/fiber/detail/scheduling/v1/scheduling_impl.h"
@@ -41,6 +42,15 @@ uint32_t GetFiberRunQueueSize() {
   return trpc_fiber_run_queue_size;
 }
 
+uint8_t GetFiberSchedulingLane(int priority, std::size_t lane_count) {
+  lane_count = std::min(lane_count, kMaxFiberSchedulingLanes);
+  if (lane_count <= 1) {
+    return 0;
+  }
+  std::size_t urgency = UINT8_MAX - std::clamp(priority, 0, static_cast<int>(UINT8_MAX));
+  return static_cast<uint8_t>(urgency * lane_count / (UINT8_MAX + 1));
+}
+
 void InitSchedulingImp() {
   SchedulingCreateFunction func_v1 = []() -> std::unique_ptr<Scheduling> {
     return std::make_unique<v1::SchedulingImpl>();
@@ -18,6 +18,7 @@
 #include <memory>
 #include <mutex>
 #include <string_view>
+#include <vector>
 
 #include "trpc/util/align.h"
 #include "trpc/util/function.h"
@@ -41,8 +42,10 @@ class alignas(hardware_destructive_interference_size) Scheduling {
   /// @brief Initialize the scheduling.
   /// @param scheduling_group the scheduling group to which this scheduler belongs
   /// @param scheduling_group_size the number of worker threads in the scheduling group
-  virtual bool Init(SchedulingGroup* scheduling_group,
-                    std::size_t scheduling_group_size) noexcept = 0;
+  /// @param lane_weights weights of the priority lanes of the run queue, from the highest priority lane to the lowest
+  ///        one, a single lane if empty. The schedulings without priority lanes ignore it.
+  virtual bool Init(SchedulingGroup* scheduling_group, std::size_t scheduling_group_size,
+                    const std::vector<uint32_t>& lane_weights) noexcept = 0;
 
   /// @brief Add an foreign scheduling group for task stealing, which needs to be called before starting the fiber
   ///        worker.
@@ -118,6 +121,14 @@ void SetFiberRunQueueSize(uint32_t queue_size);
 // Get the size of the fiber's run queue.
 uint32_t GetFiberRunQueueSize();
 
+// The maximum number of the priority lanes of the fiber's run queue, the lanes are indexed by `uint8_t`.
+constexpr std::size_t kMaxFiberSchedulingLanes = 16;
+
+// Get the lane of the fiber's run queue for a request of `priority` (in [0, 255], the higher the more urgent), out of
+// `lane_count` lanes. The range of the priorities is divided evenly among the lanes, and the highest priorities go to
+// lane 0.
+uint8_t GetFiberSchedulingLane(int priority, std::size_t lane_count);
+
 using SchedulingCreateFunction = Function<std::unique_ptr<Scheduling>()>;
 
 constexpr std::string_view kSchedulingV1 = "v1";
@@ -0,0 +1,99 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/runtime/threadmodel/fiber/detail/scheduling/v1/priority_run_queue.h"
+
+#include <algorithm>
+
+namespace trpc::fiber::detail::v1 {
+
+bool PriorityRunQueue::Init(std::size_t capacity, const std::vector<uint32_t>& weights) {
+  lane_count_ = std::max<std::size_t>(weights.size(), 1);
+  lanes_ = std::make_unique<RunQueue[]>(lane_count_);
+
+  std::size_t lane_capacity = capacity;
+  if (lane_count_ > 1) {
+    lane_capacity = 2;
+    while (lane_capacity * 2 <= capacity / lane_count_) {
+      lane_capacity *= 2;
+    }
+  }
+  for (std::size_t i = 0; i != lane_count_; ++i) {
+    if (!lanes_[i].Init(lane_capacity)) {
+      return false;
+    }
+  }
+
+  // Smooth weighted round robin, so the lanes are interleaved rather than polled in bursts.
+  schedule_.clear();
+  if (lane_count_ > 1) {
+    std::vector<int64_t> lane_weights(lane_count_);
+    std::vector<int64_t> current(lane_count_, 0);
+    int64_t total = 0;
+    for (std::size_t i = 0; i != lane_count_; ++i) {
+      lane_weights[i] = std::clamp<uint32_t>(weights[i], 1, kMaxLaneWeight);
+      total += lane_weights[i];
+    }
+    for (int64_t n = 0; n != total; ++n) {
+      std::size_t selected = 0;
+      for (std::size_t i = 0; i != lane_count_; ++i) {
+        current[i] += lane_weights[i];
+        if (current[i] > current[selected]) {
+          selected = i;
+        }
+      }
+      current[selected] -= total;
+      schedule_.push_back(static_cast<uint8_t>(selected));
+    }
+  }
+
+  return true;
+}
+
+RunnableEntity* PriorityRunQueue::PopWeighted() {
+  // Each worker keeps its own position in the schedule, which saves a contended counter.
+  static thread_local std::size_t next = 0;
+
+  std::size_t first = schedule_[next++ % schedule_.size()];
+  if (auto rc = lanes_[first].Pop()) {
+    return rc;
+  }
+  for (std::size_t i = 0; i != lane_count_; ++i) {
+    if (i == first) {
+      continue;
+    }
+    if (auto rc = lanes_[i].Pop()) {
+      return rc;
+    }
+  }
+  return nullptr;
+}
+
+RunnableEntity* PriorityRunQueue::Steal() {
+  for (std::size_t i = 0; i != lane_count_; ++i) {
+    if (auto rc = lanes_[i].Steal()) {
+      return rc;
+    }
+  }
+  return nullptr;
+}
+
+std::size_t PriorityRunQueue::UnsafeSize() const {
+  std::size_t size = 0;
+  for (std::size_t i = 0; i != lane_count_; ++i) {
+    size += lanes_[i].UnsafeSize();
+  }
+  return size;
+}
+
+}  // namespace trpc::fiber::detail::v1
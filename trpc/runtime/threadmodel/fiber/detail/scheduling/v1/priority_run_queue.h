@@ -0,0 +1,85 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "trpc/runtime/threadmodel/fiber/detail/scheduling/v1/run_queue.h"
+
+namespace trpc::fiber::detail::v1 {
+
+/// @brief Run queue made up of priority lanes, each of which is a FIFO `RunQueue`.
+///        Lane 0 has the highest priority. The lanes are polled in a weighted round robin order, so the lower lanes
+///        still get their share of the workers while the higher lanes are busy, the lane polled first is skipped if
+///        it is empty and the others are polled from the highest one.
+/// @note  With a single lane, it behaves the same as `RunQueue`.
+class PriorityRunQueue {
+ public:
+  /// @brief The maximum weight of a lane, the larger ones are clamped to it so the schedule of the lanes stays small.
+  static constexpr uint32_t kMaxLaneWeight = 64;
+
+  /// @brief Initialize the lanes, which split `capacity` evenly. The capacity of each lane is rounded down to a power
+  ///        of 2, so the lanes take no more memory than a single `RunQueue` of `capacity`.
+  /// @param weights weights of the lanes from the highest priority to the lowest one, in [1, `kMaxLaneWeight`], a
+  ///        single lane if empty
+  bool Init(std::size_t capacity, const std::vector<uint32_t>& weights);
+
+  /// @brief Push a fiber into the lane, the lowest lane is used if `lane` is out of range.
+  /// @return `false` on overrun.
+  bool Push(RunnableEntity* e, std::size_t lane, bool instealable = false) {
+    return lanes_[std::min(lane, lane_count_ - 1)].Push(e, instealable);
+  }
+
+  /// @brief Push fibers in batch into the lane.
+  /// @return `false` on overrun.
+  bool BatchPush(RunnableEntity** start, RunnableEntity** end, std::size_t lane, bool instealable) {
+    return lanes_[std::min(lane, lane_count_ - 1)].BatchPush(start, end, instealable);
+  }
+
+  /// @brief Pop a fiber from the lanes.
+  /// @return `nullptr` if all the lanes are empty.
+  RunnableEntity* Pop() {
+    if (lane_count_ == 1) {
+      return lanes_[0].Pop();
+    }
+    return PopWeighted();
+  }
+
+  /// @brief Steal a fiber from the lanes, from the highest one.
+  /// @return `nullptr` if nothing can be stolen.
+  RunnableEntity* Steal();
+
+  /// @brief The number of lanes.
+  std::size_t LaneCount() const { return lane_count_; }
+
+  /// @brief The size of all the lanes. The result might be inaccurate.
+  std::size_t UnsafeSize() const;
+
+ private:
+  RunnableEntity* PopWeighted();
+
+ private:
+  std::size_t lane_count_{0};
+  std::unique_ptr<RunQueue[]> lanes_;
+
+  // Lanes polled first in turn, each lane occurs as many times as its weight.
+  std::vector<uint8_t> schedule_;
+};
+
+}  // namespace trpc::fiber::detail::v1
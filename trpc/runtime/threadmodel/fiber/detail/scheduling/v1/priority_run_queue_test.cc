@@ -0,0 +1,131 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#include "trpc/runtime/threadmodel/fiber/detail/scheduling/v1/priority_run_queue.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace trpc::fiber::detail::v1 {
+
+namespace {
+
+RunnableEntity* CreateRunnableFiber(std::size_t x) { return reinterpret_cast<RunnableEntity*>(x); }
+
+}  // namespace
+
+TEST(PriorityRunQueue, SingleLane) {
+  PriorityRunQueue queue;
+  ASSERT_TRUE(queue.Init(32, {}));
+  ASSERT_EQ(1, queue.LaneCount());
+
+  // Lanes out of range go to the only lane, in FIFO order.
+  ASSERT_TRUE(queue.Push(CreateRunnableFiber(1), 0));
+  ASSERT_TRUE(queue.Push(CreateRunnableFiber(2), 3));
+  ASSERT_EQ(2, queue.UnsafeSize());
+  ASSERT_EQ(CreateRunnableFiber(1), queue.Pop());
+  ASSERT_EQ(CreateRunnableFiber(2), queue.Pop());
+  ASSERT_EQ(nullptr, queue.Pop());
+}
+
+TEST(PriorityRunQueue, WeightedLanes) {
+  PriorityRunQueue queue;
+  ASSERT_TRUE(queue.Init(1024, {3, 1}));
+  ASSERT_EQ(2, queue.LaneCount());
+
+  for (std::size_t i = 1; i <= 400; ++i) {
+    ASSERT_TRUE(queue.Push(CreateRunnableFiber(i), i % 2));
+  }
+  ASSERT_EQ(400, queue.UnsafeSize());
+
+  // While both lanes are busy, they share the pops by their weights.
+  std::size_t high = 0;
+  for (int i = 0; i != 200; ++i) {
+    high += reinterpret_cast<std::size_t>(queue.Pop()) % 2 == 0;
+  }
+  ASSERT_EQ(150, high);
+
+  // The lower lane takes all the pops once the higher lane is empty.
+  for (int i = 0; i != 200; ++i) {
+    ASSERT_NE(nullptr, queue.Pop());
+  }
+  ASSERT_EQ(nullptr, queue.Pop());
+}
+
+TEST(PriorityRunQueue, ClampedWeights) {
+  PriorityRunQueue queue;
+  ASSERT_TRUE(queue.Init(1024, {UINT32_MAX, 0}));
+
+  for (std::size_t i = 1; i <= 200; ++i) {
+    ASSERT_TRUE(queue.Push(CreateRunnableFiber(i), i % 2));
+  }
+
+  // The weights are clamped to [1, kMaxLaneWeight].
+  std::size_t high = 0;
+  for (uint32_t i = 0; i != PriorityRunQueue::kMaxLaneWeight + 1; ++i) {
+    high += reinterpret_cast<std::size_t>(queue.Pop()) % 2 == 0;
+  }
+  ASSERT_EQ(PriorityRunQueue::kMaxLaneWeight, high);
+}
+
+TEST(PriorityRunQueue, SplitCapacity) {
+  PriorityRunQueue queue;
+  ASSERT_TRUE(queue.Init(64, {1, 1, 1}));
+
+  // Each of the 3 lanes gets 16 slots, 64 / 3 rounded down to a power of 2.
+  for (std::size_t i = 1; i <= 16; ++i) {
+    ASSERT_TRUE(queue.Push(CreateRunnableFiber(i), 0));
+  }
+  ASSERT_FALSE(queue.Push(CreateRunnableFiber(17), 0));
+  ASSERT_TRUE(queue.Push(CreateRunnableFiber(17), 2));
+
+  for (std::size_t i = 1; i <= 17; ++i) {
+    ASSERT_NE(nullptr, queue.Pop());
+  }
+  ASSERT_EQ(nullptr, queue.Pop());
+}
+
+TEST(PriorityRunQueue, Steal) {
+  PriorityRunQueue queue;
+  ASSERT_TRUE(queue.Init(32, {1, 1}));
+
+  ASSERT_TRUE(queue.Push(CreateRunnableFiber(1), 1));
+  ASSERT_TRUE(queue.Push(CreateRunnableFiber(2), 0, true));
+  ASSERT_TRUE(queue.Push(CreateRunnableFiber(3), 0));
+
+  // The higher lane is stolen first, unless its first fiber is instealable.
+  ASSERT_EQ(CreateRunnableFiber(1), queue.Steal());
+  ASSERT_EQ(nullptr, queue.Steal());
+
+  RunnableEntity* batch[] = {CreateRunnableFiber(4), CreateRunnableFiber(5)};
+  ASSERT_TRUE(queue.BatchPush(batch, batch + 2, 1, false));
+  ASSERT_EQ(4, queue.UnsafeSize());
+}
+
+TEST(PriorityRunQueue, SchedulingLane) {
+  ASSERT_EQ(0, GetFiberSchedulingLane(0, 0));
+  ASSERT_EQ(0, GetFiberSchedulingLane(0, 1));
+
+  ASSERT_EQ(0, GetFiberSchedulingLane(255, 3));
+  ASSERT_EQ(0, GetFiberSchedulingLane(300, 3));
+  ASSERT_EQ(1, GetFiberSchedulingLane(128, 3));
+  ASSERT_EQ(2, GetFiberSchedulingLane(0, 3));
+  ASSERT_EQ(2, GetFiberSchedulingLane(-1, 3));
+
+  // The lanes beyond `kMaxFiberSchedulingLanes` are not used.
+  ASSERT_EQ(kMaxFiberSchedulingLanes - 1, GetFiberSchedulingLane(0, 100));
+}
+
+}  // namespace trpc::fiber::detail::v1
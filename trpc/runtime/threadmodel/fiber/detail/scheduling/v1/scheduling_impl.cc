@@ -63,12 +63,12 @@ void SchedulingImpl::WaitSlot::PersistentWake() noexcept {
 FiberEntity* const kSchedulingGroupShuttingDown = reinterpret_cast<FiberEntity*>(0x1);
 thread_local std::size_t SchedulingImpl::worker_index_ = kUninitializedWorkerIndex;
 
-bool SchedulingImpl::Init(SchedulingGroup* scheduling_group,
-                          std::size_t scheduling_group_size) noexcept {
+bool SchedulingImpl::Init(SchedulingGroup* scheduling_group, std::size_t scheduling_group_size,
+                          const std::vector<uint32_t>& lane_weights) noexcept {
   scheduling_group_ = scheduling_group;
   group_size_ = scheduling_group_size;
 
-  TRPC_ASSERT(run_queue_.Init(GetFiberRunQueueSize()));
+  TRPC_ASSERT(run_queue_.Init(GetFiberRunQueueSize(), lane_weights));
 
   wait_slots_ = std::make_unique<WaitSlot[]>(group_size_);
 
@@ -321,7 +321,7 @@ FiberEntity* SchedulingImpl::GetOrInstantiateFiber(RunnableEntity* entity) noexc
 
 bool SchedulingImpl::StartFiber(FiberDesc* desc) noexcept {
   desc->last_ready_tsc = ReadTsc();
-  return QueueRunnableEntity(desc, desc->scheduling_group_local);
+  return QueueRunnableEntity(desc, desc->scheduling_lane, desc->scheduling_group_local);
 }
 
 void SchedulingImpl::StartFibers(FiberDesc** start, FiberDesc** end) noexcept {
@@ -334,12 +334,14 @@ void SchedulingImpl::StartFibers(FiberDesc** start, FiberDesc** end) noexcept {
     (*iter)->last_ready_tsc = tsc;
   }
 
+  // The fibers started in batch are queued in the lane of the first one.
+  auto lane = (*start)->scheduling_lane;
   auto s1 = reinterpret_cast<RunnableEntity**>(start),
        s2 = reinterpret_cast<RunnableEntity**>(end);
-  if (TRPC_UNLIKELY(!run_queue_.BatchPush(s1, s2, false))) {
+  if (TRPC_UNLIKELY(!run_queue_.BatchPush(s1, s2, lane, false))) {
     auto since = ReadSteadyClock();
 
-    while (!run_queue_.BatchPush(s1, s2, false)) {
+    while (!run_queue_.BatchPush(s1, s2, lane, false)) {
       TRPC_FMT_INFO_EVERY_SECOND(
           "Run queue overflow. Too many ready fibers to run. If you're still "
           "not overloaded, consider increasing `trpc_fiber_run_queue_size`.");
@@ -354,15 +356,15 @@ void SchedulingImpl::StartFibers(FiberDesc** start, FiberDesc** end) noexcept {
   WakeUpWorkers(end - start);
 }
 
-bool SchedulingImpl::QueueRunnableEntity(RunnableEntity* entity,
+bool SchedulingImpl::QueueRunnableEntity(RunnableEntity* entity, std::size_t lane,
                                          bool sg_local, bool wait) noexcept {
   TRPC_DCHECK(!stopped_.load(std::memory_order_relaxed), "The scheduling group has been stopped.");
 
   // Push the fiber into run queue and (optionally) wake up a worker.
-  if (TRPC_UNLIKELY(!run_queue_.Push(entity, sg_local))) {
+  if (TRPC_UNLIKELY(!run_queue_.Push(entity, lane, sg_local))) {
     auto since = ReadSteadyClock();
 
-    while (!run_queue_.Push(entity, sg_local)) {
+    while (!run_queue_.Push(entity, lane, sg_local)) {
       TRPC_FMT_INFO_EVERY_SECOND(
           "Run queue overflow. Too many ready fibers to run. If you're still "
           "not overloaded, consider increasing `trpc_fiber_run_queue_size`.");
@@ -461,7 +463,7 @@ void SchedulingImpl::PostResume(FiberEntity* fiber) noexcept {
     fiber->last_ready_tsc = ReadTsc();
   }
 
-  QueueRunnableEntity(fiber, fiber->scheduling_group_local, true);
+  QueueRunnableEntity(fiber, fiber->scheduling_lane, fiber->scheduling_group_local, true);
 }
 
 void SchedulingImpl::Yield(FiberEntity* self) noexcept {
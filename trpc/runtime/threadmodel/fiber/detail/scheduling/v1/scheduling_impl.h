@@ -20,7 +20,7 @@
 #include <utility>
 #include <vector>
 
-#include "trpc/runtime/threadmodel/fiber/detail/scheduling/v1/run_queue.h"
+#include "trpc/runtime/threadmodel/fiber/detail/scheduling/v1/priority_run_queue.h"
 #include "trpc/runtime/threadmodel/fiber/detail/scheduling/scheduling.h"
 #include "trpc/runtime/threadmodel/fiber/detail/scheduling_group.h"
 #include "trpc/util/align.h"
@@ -38,8 +38,8 @@ class alignas(hardware_destructive_interference_size) SchedulingImpl final : pub
 
   ~SchedulingImpl() override = default;
 
-  bool Init(SchedulingGroup* scheduling_group,
-            std::size_t scheduling_group_size) noexcept override;
+  bool Init(SchedulingGroup* scheduling_group, std::size_t scheduling_group_size,
+            const std::vector<uint32_t>& lane_weights) noexcept override;
 
   void AddForeignSchedulingGroup(std::size_t worker_index, SchedulingGroup* sg,
                                  std::uint64_t steal_every_n) noexcept override;
@@ -80,7 +80,7 @@ class alignas(hardware_destructive_interference_size) SchedulingImpl final : pub
   bool WakeUpOneSpinningWorker() noexcept;
   bool WakeUpOneDeepSleepingWorker() noexcept;
   FiberEntity* GetOrInstantiateFiber(RunnableEntity* entity) noexcept;
-  bool QueueRunnableEntity(RunnableEntity* entity, bool sg_local, bool wait = false) noexcept;
+  bool QueueRunnableEntity(RunnableEntity* entity, std::size_t lane, bool sg_local, bool wait = false) noexcept;
   bool Push(RunnableEntity* entity, bool sg_local, bool wait) noexcept;
   void PostResume(FiberEntity* fiber) noexcept;
 
@@ -123,8 +123,8 @@ class alignas(hardware_destructive_interference_size) SchedulingImpl final : pub
   // Exposes internal state.
   // DelayedInit<tvar::PassiveStatus<std::string>> spinning_workers_var_, sleeping_workers_var_;
 
-  // Ready fibers are put here.
-  RunQueue run_queue_;
+  // Ready fibers are put here, in the priority lane of each fiber.
+  PriorityRunQueue run_queue_;
 
   // Fiber workers sleep on this.
   std::unique_ptr<WaitSlot[]> wait_slots_{nullptr};
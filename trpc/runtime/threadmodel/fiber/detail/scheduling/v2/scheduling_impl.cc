@@ -43,7 +43,8 @@ FiberEntity* kSchedulingGroupShuttingDown = reinterpret_cast<FiberEntity*>(0x1);
 
 thread_local std::size_t SchedulingImpl::worker_index_ = kUninitializedWorkerIndex;
 
-bool SchedulingImpl::Init(SchedulingGroup* scheduling_group, std::size_t scheduling_group_size) noexcept {
+bool SchedulingImpl::Init(SchedulingGroup* scheduling_group, std::size_t scheduling_group_size,
+                          const std::vector<uint32_t>& lane_weights) noexcept {
   TRPC_CHECK_LE(scheduling_group_size, std::size_t(64),
                 "We only support up to 64 workers in each scheduling group. "
                 "Use more scheduling groups if you want more concurrency.");
@@ -53,7 +53,8 @@ namespace trpc::fiber::detail::v2 {
 ///        queue, which would cause the worker thread to be unable to sleep and result in 100% CPU usage.
 class alignas(hardware_destructive_interference_size) SchedulingImpl final : public trpc::fiber::detail::Scheduling {
  public:
-  bool Init(SchedulingGroup* scheduling_group, std::size_t scheduling_group_size) noexcept override;
+  bool Init(SchedulingGroup* scheduling_group, std::size_t scheduling_group_size,
+            const std::vector<uint32_t>& lane_weights) noexcept override;
 
   void Enter(std::size_t index) noexcept override;
 
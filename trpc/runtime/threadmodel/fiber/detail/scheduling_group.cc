@@ -26,7 +26,8 @@ std::once_flag init_flag;
 
 SchedulingGroup::SchedulingGroup(const std::vector<unsigned>& affinity,
                                  uint8_t size,
-                                 std::string_view scheduling_name)
+                                 std::string_view scheduling_name,
+                                 const std::vector<uint32_t>& lane_weights)
     : group_size_(size), affinity_(affinity) {
   TRPC_CHECK_LE(group_size_, 64,
                 "We only support up to 64 workers in each scheduling group. "
@@ -35,7 +36,7 @@ SchedulingGroup::SchedulingGroup(const std::vector<unsigned>& affinity,
   std::call_once(init_flag, InitSchedulingImp);
 
   scheduling_ = CreateScheduling(scheduling_name);
-  TRPC_ASSERT(scheduling_->Init(this, group_size_));
+  TRPC_ASSERT(scheduling_->Init(this, group_size_, lane_weights));
 }
 
 void SchedulingGroup::EnterGroup(std::size_t index) {
@@ -37,8 +37,10 @@ class alignas(hardware_destructive_interference_size) SchedulingGroup {
   /// @param affinity the CPU affinity of threads.
   /// @param size number of fiber worker threads
   /// @param scheduling_name name of scheduling
+  /// @param lane_weights weights of the priority lanes of the run queue, a single lane if empty
   /// @note the 'size' does not include the TimerWorker thread.
-  SchedulingGroup(const std::vector<unsigned>& affinity, uint8_t size, std::string_view scheduling_name);
+  SchedulingGroup(const std::vector<unsigned>& affinity, uint8_t size, std::string_view scheduling_name,
+                  const std::vector<uint32_t>& lane_weights = {});
 
   ~SchedulingGroup() = default;
 
@@ -83,6 +83,13 @@ FiberThreadModel::FiberThreadModel(Options&& options) : options_(std::move(optio
 
 void FiberThreadModel::Start() noexcept {
   fiber::detail::SetFiberRunQueueSize(options_.run_queue_size);
+  if (options_.scheduling_name != fiber::detail::kSchedulingV1 && !options_.scheduling_lane_weights.empty()) {
+    TRPC_FMT_WARN("Priority lanes of the fiber run queue only apply to the v1 scheduler, ignored.");
+    options_.scheduling_lane_weights.clear();
+  }
+  if (options_.scheduling_lane_weights.size() > fiber::detail::kMaxFiberSchedulingLanes) {
+    options_.scheduling_lane_weights.resize(fiber::detail::kMaxFiberSchedulingLanes);
+  }
   fiber::detail::SetFiberStackSize(options_.stack_size);
   fiber::detail::SetFiberPoolNumByMmap(options_.pool_num_by_mmap);
   fiber::detail::SetFiberStackEnableGuardPage(options_.stack_enable_guard_page);
@@ -210,6 +217,8 @@ bool FiberThreadModel::SubmitHandleTask(MsgTask* handle_task) noexcept {
   desc->start_proc = std::move(handle_task->handler);
   TRPC_CHECK(!desc->exit_barrier);
   desc->scheduling_group_local = false;
+  desc->scheduling_lane =
+      fiber::detail::GetFiberSchedulingLane(handle_task->priority, options_.scheduling_lane_weights.size());
 
   return sg->StartFiber(desc);
 }
@@ -243,7 +252,8 @@ std::unique_ptr<FiberThreadModel::FullyFledgedSchedulingGroup> FiberThreadModel:
   auto rc = std::make_unique<FullyFledgedSchedulingGroup>();
   rc->node_id = node_id;
   rc->scheduling_group =
-      std::make_unique<detail::SchedulingGroup>(tmp_affinity, scheduling_group_size, options_.scheduling_name);
+      std::make_unique<detail::SchedulingGroup>(tmp_affinity, scheduling_group_size, options_.scheduling_name,
+                                                options_.scheduling_lane_weights);
   rc->scheduling_group->SetSchedulingGroupId(sg_id);
   rc->scheduling_group->SetNodeId(node_id);
   rc->scheduling_group->SetThreadModelId(options_.group_id);
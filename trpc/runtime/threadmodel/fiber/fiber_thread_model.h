@@ -69,6 +69,11 @@ class FiberThreadModel final : public ThreadModel {
     /// Recommended to be equal or slightly larger than the number of fibers that can be allocated by the system.
     uint32_t run_queue_size{131072};
 
+    /// Weights of the priority lanes of the fiber run queue, from the highest priority lane to the lowest one,
+    /// currently only applicable to the v1 scheduler. The lanes split `run_queue_size` evenly, and share the workers
+    /// in proportion to their weights while all of them are busy. A single lane if empty, at most 16 lanes.
+    std::vector<uint32_t> scheduling_lane_weights;
+
     /// Fiber stack size. If a large amount of stack resources need to be allocated, adjust this value
     uint32_t stack_size{131072};
 
@@ -17,10 +17,11 @@
 #include "trpc/util/log/logging.h"
 #include "trpc/util/object_pool/object_pool.h"
 #include "trpc/util/random.h"
+#include "trpc/util/time.h"
 
 namespace trpc {
 
-MergeThreadModel::MergeThreadModel(Options&& options) : options_(std::move(options)) {
+MergeThreadModel::MergeThreadModel(Options&& options) : options_(std::move(options)), codel_(options_.codel) {
   std::size_t io_cup_size = options_.cpu_affinitys.size();
   if (io_cup_size && options_.disallow_cpu_migration) {
     TRPC_ASSERT(io_cup_size >= options_.worker_thread_num);
@@ -106,10 +107,11 @@ bool MergeThreadModel::SubmitMsgTask(MsgTask* task) noexcept {
 
   Reactor* reactor = worker_threads_[id]->GetReactor();
 
-  bool ret = reactor->SubmitTask([task]() {
-    task->handler();
-    object_pool::Delete<MsgTask>(task);
-  });
+  if (codel_.Enabled()) {
+    task->enqueue_timestamp_ms = trpc::time::GetMilliSeconds();
+  }
+
+  bool ret = reactor->SubmitTask([this, task]() { RunMsgTask(task, codel_); });
 
   if (!ret) {
     object_pool::Delete<MsgTask>(task);
@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "trpc/runtime/iomodel/reactor/reactor.h"
+#include "trpc/runtime/threadmodel/common/codel.h"
 #include "trpc/runtime/threadmodel/common/msg_task.h"
 #include "trpc/runtime/threadmodel/thread_model.h"
 #include "trpc/runtime/threadmodel/merge/merge_worker_thread.h"
@@ -55,6 +56,9 @@ class MergeThreadModel final : public ThreadModel {
 
     /// bind cpu core strictly or not
     bool disallow_cpu_migration{false};
+
+    /// controlled-delay management of the tasks queued to the worker threads
+    CoDelController::Options codel;
   };
 
   explicit MergeThreadModel(Options&& options);
@@ -98,6 +102,8 @@ class MergeThreadModel final : public ThreadModel {
   Options options_;
 
   std::vector<std::unique_ptr<MergeWorkerThread>> worker_threads_;
+
+  CoDelController codel_;
 };
 
 }  // namespace trpc
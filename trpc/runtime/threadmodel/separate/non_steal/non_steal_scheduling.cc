@@ -20,7 +20,8 @@
 
 namespace trpc::separate {
 
-NonStealScheduling::NonStealScheduling(Options&& options) : options_(std::move(options)) {
+NonStealScheduling::NonStealScheduling(Options&& options)
+    : options_(std::move(options)), codel_(options_.codel) {
   TRPC_ASSERT(options_.worker_thread_num > 0);
   TRPC_ASSERT(options_.global_queue_size > 0);
   TRPC_ASSERT(options_.local_queue_size > 0);
@@ -68,6 +69,11 @@ void NonStealScheduling::ExecuteTask(std::size_t worker_index) noexcept {
 }
 
 void NonStealScheduling::HandleMsgTask(std::size_t worker_index) noexcept {
+  if (options_.lifo_when_overloaded && codel_.IsOverloaded(trpc::time::GetMilliSeconds())) {
+    HandleMsgTaskNewestFirst(worker_index);
+    return;
+  }
+
   uint32_t execute_count = 100;
   while (execute_count > 0) {
     // report its own heartbeat information before each task execution.
@@ -75,9 +81,7 @@ void NonStealScheduling::HandleMsgTask(std::size_t worker_index) noexcept {
 
     MsgTask* task = Pop(worker_index);
     if (task) {
-      task->handler();
-
-      trpc::object_pool::Delete<MsgTask>(task);
+      RunMsgTask(task, codel_);
     } else {
       break;
     }
@@ -86,6 +90,37 @@ void NonStealScheduling::HandleMsgTask(std::size_t worker_index) noexcept {
   }
 }
 
+void NonStealScheduling::HandleMsgTaskNewestFirst(std::size_t worker_index) noexcept {
+  constexpr std::size_t kBatchSize = 32;
+  thread_local std::vector<MsgTask*> tasks;
+
+  HeartBeat(Size(worker_index));
+
+  // The local queue holds the tasks routed by `dst_thread_key`, which are run in order as usual.
+  MsgTask* task{nullptr};
+  for (std::size_t i = 0; i < kBatchSize && local_task_queues_[worker_index].Size() > 0; ++i) {
+    if (!local_task_queues_[worker_index].Pop(task)) {
+      break;
+    }
+    RunMsgTask(task, codel_);
+  }
+
+  // The global queue holds the unkeyed tasks only. It is a lock-free FIFO queue, so the tasks are taken in batches and
+  // run from the newest. The older tasks of a batch wait longer and are likely dropped by `codel_`, which keeps the
+  // fresh requests served under overload.
+  while (tasks.size() < kBatchSize && global_task_queue_.Size() > 0) {
+    if (!global_task_queue_.Pop(task)) {
+      break;
+    }
+    tasks.push_back(task);
+  }
+
+  for (auto it = tasks.rbegin(); it != tasks.rend(); ++it) {
+    RunMsgTask(*it, codel_);
+  }
+  tasks.clear();
+}
+
 void NonStealScheduling::HandleTimerTask(std::size_t worker_index) noexcept {
   timer_queues_[worker_index]->RunExpiredTimers(trpc::time::GetMilliSeconds());
 }
@@ -175,6 +210,10 @@ uint32_t NonStealScheduling::Capacity(std::size_t worker_index) const {
 }
 
 bool NonStealScheduling::Push(MsgTask* task) noexcept {
+  if (codel_.Enabled()) {
+    task->enqueue_timestamp_ms = trpc::time::GetMilliSeconds();
+  }
+
   if (task->dst_thread_key < 0) {
     switch (task->task_type) {
       case trpc::runtime::kParallelTask:
@@ -13,7 +13,10 @@
 
 #pragma once
 
+#include <vector>
+
 #include "trpc/runtime/iomodel/reactor/default/timer_queue.h"
+#include "trpc/runtime/threadmodel/common/codel.h"
 #include "trpc/runtime/threadmodel/common/msg_task.h"
 #include "trpc/runtime/threadmodel/common/timer_task.h"
 #include "trpc/runtime/threadmodel/separate/separate_scheduling.h"
@@ -38,6 +41,13 @@ class NonStealScheduling final : public SeparateScheduling {
 
     /// @brief size of the current thread's local queue
     uint32_t local_queue_size = 50000;
+
+    /// @brief controlled-delay management of the queued tasks
+    CoDelController::Options codel;
+
+    /// @brief whether to run the newest unkeyed tasks of the global queue first while the queues are overloaded, see
+    ///        `CoDelController`, the tasks routed by `dst_thread_key` are always run in order
+    bool lifo_when_overloaded = false;
   };
 
   explicit NonStealScheduling(Options&& options);
@@ -70,6 +80,7 @@ class NonStealScheduling final : public SeparateScheduling {
 
  private:
   void HandleMsgTask(std::size_t worker_index) noexcept;
+  void HandleMsgTaskNewestFirst(std::size_t worker_index) noexcept;
   bool Push(MsgTask* task) noexcept;
   MsgTask* Pop(std::size_t worker_index) noexcept;
   uint32_t Size(std::size_t worker_index) const;
@@ -97,6 +108,8 @@ class NonStealScheduling final : public SeparateScheduling {
   std::unique_ptr<BoundedMPMCQueue<MsgTask*>[]> local_task_queues_;
 
   std::vector<std::unique_ptr<TimerQueue>> timer_queues_;
+
+  CoDelController codel_;
 };
 
 }  // namespace trpc::separate
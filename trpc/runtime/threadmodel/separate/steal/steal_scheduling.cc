@@ -26,7 +26,10 @@
 namespace trpc::separate {
 
 StealScheduling::StealScheduling(Options&& options)
-    : options_(std::move(options)), notifier_{options_.worker_thread_num}, rdvtm_(0, options_.worker_thread_num - 1) {
+    : options_(std::move(options)),
+      notifier_{options_.worker_thread_num},
+      rdvtm_(0, options_.worker_thread_num - 1),
+      codel_(options_.codel) {
   TRPC_ASSERT(options_.worker_thread_num > 0);
   TRPC_ASSERT(options_.global_queue_size > 0);
 
@@ -68,8 +71,7 @@ void StealScheduling::Schedule() noexcept {
       }
 
       while (task) {
-        task->handler();
-        trpc::object_pool::Delete<MsgTask>(task);
+        RunMsgTask(task, codel_);
         task = local_task_queues_[worker_index].Pop();
 
         HandleTimerTask(worker_index);
@@ -183,8 +185,7 @@ void StealScheduling::ExploreTask(MsgTask*& t) noexcept {
 
 void StealScheduling::ExecuteTask(std::size_t worker_index) noexcept {
   if (auto t = local_task_queues_[worker_index].Pop(); t) {
-    t->handler();
-    trpc::object_pool::Delete<MsgTask>(t);
+    RunMsgTask(t, codel_);
   } else {
     if ((worker_index == vtm_[worker_index])) {
       global_task_queue_.Pop(t);
@@ -193,8 +194,7 @@ void StealScheduling::ExecuteTask(std::size_t worker_index) noexcept {
     }
 
     if (t) {
-      t->handler();
-      trpc::object_pool::Delete<MsgTask>(t);
+      RunMsgTask(t, codel_);
     } else {
       vtm_[worker_index] = rdvtm_(rdgen_);
     }
@@ -287,6 +287,10 @@ uint32_t StealScheduling::Size(std::size_t worker_index) {
 }
 
 bool StealScheduling::Push(MsgTask* task) noexcept {
+  if (codel_.Enabled()) {
+    task->enqueue_timestamp_ms = trpc::time::GetMilliSeconds();
+  }
+
   std::size_t worker_index = GetCurrentWorkerIndex();
   if (worker_index != static_cast<std::size_t>(-1)) {
     local_task_queues_[worker_index].Push(task);
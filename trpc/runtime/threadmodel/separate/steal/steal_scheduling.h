@@ -22,6 +22,7 @@
 #include <vector>
 
 #include "trpc/runtime/iomodel/reactor/default/timer_queue.h"
+#include "trpc/runtime/threadmodel/common/codel.h"
 #include "trpc/runtime/threadmodel/common/msg_task.h"
 #include "trpc/runtime/threadmodel/common/timer_task.h"
 #include "trpc/runtime/threadmodel/separate/separate_scheduling.h"
@@ -55,6 +56,9 @@ class StealScheduling final : public SeparateScheduling {
 
     /// @brief size of the global queue
     uint32_t global_queue_size = 50000;
+
+    /// @brief controlled-delay management of the queued tasks
+    CoDelController::Options codel;
   };
 
   explicit StealScheduling(Options&& options);
@@ -118,6 +122,8 @@ class StealScheduling final : public SeparateScheduling {
   std::vector<size_t> vtm_;
   std::uniform_int_distribution<size_t> rdvtm_;
   std::default_random_engine rdgen_{std::random_device{}()};  // NOLINT
+
+  CoDelController codel_;
 };
 
 }  // namespace trpc::separate
@@ -53,4 +53,27 @@ TEST(FbsSerializationTest, FbsSerializationTest) {
   ASSERT_EQ(request.GetRoot()->message()->str(), request_deserialize.GetRoot()->message()->str());
 }
 
+TEST(FbsSerializationTest, DeserializeNoncontiguousBuffer) {
+  FbsSerialization fbs_serialization;
+
+  flatbuffers::trpc::PoolMessageBuilder mb;
+  auto name_offset = mb.CreateString("fb req test");
+  mb.Finish(trpc::test::helloworld::CreateFbRequest(mb, name_offset));
+  auto request = mb.ReleaseMessage<trpc::test::helloworld::FbRequest>();
+
+  NoncontiguousBuffer buffer;
+  ASSERT_TRUE(fbs_serialization.Serialize(kFlatBuffers, &request, &buffer));
+  ASSERT_EQ(reinterpret_cast<const uint8_t*>(buffer.FirstContiguous().data()), request.data());
+
+  std::string data = FlattenSlow(buffer);
+  NoncontiguousBuffer blocks;
+  for (std::size_t pos = 0; pos < data.size(); pos += 7) {
+    blocks.Append(CreateBufferSlow(data.substr(pos, 7)));
+  }
+
+  flatbuffers::trpc::Message<trpc::test::helloworld::FbRequest> request_deserialize;
+  ASSERT_TRUE(fbs_serialization.Deserialize(&blocks, kFlatBuffers, &request_deserialize));
+  ASSERT_EQ(request_deserialize.GetRoot()->message()->str(), "fb req test");
+}
+
 }  // namespace trpc::testing
@@ -13,16 +13,14 @@
 
 #include "trpc/serialization/json/json_serialization.h"
 
-#include <string>
-
 #include "rapidjson/document.h"
 #include "rapidjson/error/en.h"
-#include "rapidjson/stringbuffer.h"
 #include "rapidjson/writer.h"
 
+#include "trpc/util/buffer/json_stream.h"
 #include "trpc/util/likely.h"
 #include "trpc/util/log/logging.h"
-#include "trpc/util/pb2json.h"
+#include "trpc/util/pb_json_transcoder.h"
 
 namespace trpc::serialization {
 
@@ -32,23 +30,22 @@ bool JsonSerialization::Serialize(DataType in_type, void* in, NoncontiguousBuffe
     case kRapidJson: {
       rapidjson::Document* rapidjson_doc = static_cast<rapidjson::Document*>(in);
       if (!rapidjson_doc->IsNull()) {
-        rapidjson::StringBuffer buffer;
-        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+        NoncontiguousBufferBuilder builder;
+        NoncontiguousBufferJsonOutputStream os(&builder);
+        rapidjson::Writer<NoncontiguousBufferJsonOutputStream> writer(os);
         rapidjson_doc->Accept(writer);
 
-        std::string_view data(buffer.GetString(), buffer.GetSize());
-
-        *out = CreateBufferSlow(data);
+        *out = builder.DestructiveGet();
       }
 
       ret = true;
     } break;
     case kPbMessage: {
       google::protobuf::Message* pb = static_cast<google::protobuf::Message*>(in);
-      std::string json;
-      ret = Pb2Json::PbToJson(*pb, &json);
+      NoncontiguousBufferBuilder builder;
+      ret = PbJsonTranscoder::PbToJson(*pb, &builder);
       if (ret) {
-        *out = CreateBufferSlow(json);
+        *out = builder.DestructiveGet();
       } else {
         TRPC_LOG_ERROR("PbToJson Failed.");
       }
@@ -62,24 +59,24 @@ bool JsonSerialization::Serialize(DataType in_type, void* in, NoncontiguousBuffe
 }
 
 bool JsonSerialization::Deserialize(NoncontiguousBuffer* in, DataType out_type, void* out) {
-  std::string buffer = FlattenSlow(*in);
   bool ret = false;
 
   switch (out_type) {
     case kRapidJson: {
       rapidjson::Document* rapidjson_doc = static_cast<rapidjson::Document*>(out);
-      rapidjson_doc->Parse(buffer.c_str(), buffer.size());
-      if (!buffer.empty() && rapidjson_doc->HasParseError()) {
+      // Parses the blocks in place rather than flattening them.
+      NoncontiguousBufferJsonInputStream is(*in);
+      rapidjson_doc->ParseStream(is);
+      if (!in->Empty() && rapidjson_doc->HasParseError()) {
         TRPC_LOG_ERROR("JsonParse Failed:" << rapidjson::GetParseError_En(rapidjson_doc->GetParseError()));
       } else {
         ret = true;
       }
     } break;
     case kPbMessage: {
-      auto request_data = std::string_view(buffer.c_str(), buffer.size());
       google::protobuf::Message* pb = static_cast<google::protobuf::Message*>(out);
 
-      ret = Pb2Json::JsonToPb(request_data, pb);
+      ret = PbJsonTranscoder::JsonToPb(*in, pb);
       if (!ret) {
         TRPC_LOG_ERROR("JsonToPb Failed.");
       }
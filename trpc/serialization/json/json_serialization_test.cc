@@ -113,4 +113,28 @@ TEST(JsonSerializationTest, JsonSerializationPbTest) {
   ASSERT_EQ(request.msg(), request_deserialize.msg());
 }
 
+TEST(JsonSerializationTest, JsonDeserializationNoncontiguousTest) {
+  std::unique_ptr<JsonSerialization> json_serialization(new JsonSerialization());
+
+  HelloRequest request{};
+  request.set_msg(std::string(1024, 'a'));
+
+  std::string json;
+  ASSERT_TRUE(trpc::Pb2Json::PbToJson(request, &json));
+
+  // Splits the json into small blocks, they are parsed without being flattened.
+  NoncontiguousBuffer noncontiguous_buffer;
+  for (std::size_t pos = 0; pos < json.size(); pos += 7) {
+    noncontiguous_buffer.Append(CreateBufferSlow(json.substr(pos, 7)));
+  }
+
+  HelloRequest request_deserialize{};
+  ASSERT_TRUE(json_serialization->Deserialize(&noncontiguous_buffer, kPbMessage, &request_deserialize));
+  ASSERT_EQ(request.msg(), request_deserialize.msg());
+
+  rapidjson::Document document{};
+  ASSERT_TRUE(json_serialization->Deserialize(&noncontiguous_buffer, kRapidJson, &document));
+  ASSERT_EQ(request.msg(), document["msg"].GetString());
+}
+
 }  // namespace trpc::testing
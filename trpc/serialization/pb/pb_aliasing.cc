@@ -0,0 +1,288 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/serialization/pb/pb_aliasing.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+#include "google/protobuf/descriptor.h"
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/wire_format_lite.h"
+
+#include "trpc/util/buffer/zero_copy_stream.h"
+#include "trpc/util/likely.h"
+#include "trpc/util/log/logging.h"
+
+namespace trpc::serialization {
+
+namespace {
+
+using FieldDescriptor = google::protobuf::FieldDescriptor;
+using WireFormatLite = google::protobuf::internal::WireFormatLite;
+
+// Location of an aliased field in the serialized bytes.
+struct AliasedRange {
+  int field_number;
+  // Offset of the tag.
+  std::size_t begin;
+  // Size of tag and length prefix.
+  std::size_t header_size;
+  // Size of the payload.
+  std::size_t payload_size;
+};
+
+// Reads the blocks of a `NoncontiguousBuffer` without consuming them.
+class WireCursor {
+ public:
+  explicit WireCursor(const NoncontiguousBuffer& buffer) : iter_(buffer.begin()), total_(buffer.ByteSize()) {}
+
+  std::size_t Position() const { return position_; }
+
+  bool AtEnd() const { return position_ == total_; }
+
+  bool ReadVarint(uint64_t* value) {
+    uint64_t result = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      uint8_t byte;
+      if (TRPC_UNLIKELY(!ReadByte(&byte))) {
+        return false;
+      }
+      result |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if (!(byte & 0x80)) {
+        *value = result;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool Skip(std::size_t bytes) {
+    if (TRPC_UNLIKELY(total_ - position_ < bytes)) {
+      return false;
+    }
+    position_ += bytes;
+    while (bytes > 0) {
+      std::size_t left = iter_->size() - offset_;
+      if (bytes < left) {
+        offset_ += bytes;
+        break;
+      }
+      bytes -= left;
+      ++iter_;
+      offset_ = 0;
+    }
+    return true;
+  }
+
+ private:
+  bool ReadByte(uint8_t* byte) {
+    if (TRPC_UNLIKELY(AtEnd())) {
+      return false;
+    }
+    while (offset_ == iter_->size()) {
+      ++iter_;
+      offset_ = 0;
+    }
+    *byte = static_cast<uint8_t>(iter_->data()[offset_++]);
+    ++position_;
+    return true;
+  }
+
+ private:
+  NoncontiguousBuffer::const_iterator iter_;
+  std::size_t offset_{0};
+  std::size_t position_{0};
+  std::size_t total_;
+};
+
+// Skips the value of a field whose tag has been read, returns the payload size of length-delimited field.
+bool SkipField(WireCursor* cursor, uint64_t tag, std::size_t* payload_size, int depth = 0) {
+  switch (WireFormatLite::GetTagWireType(static_cast<uint32_t>(tag))) {
+    case WireFormatLite::WIRETYPE_VARINT: {
+      uint64_t value;
+      return cursor->ReadVarint(&value);
+    }
+    case WireFormatLite::WIRETYPE_FIXED64:
+      return cursor->Skip(8);
+    case WireFormatLite::WIRETYPE_FIXED32:
+      return cursor->Skip(4);
+    case WireFormatLite::WIRETYPE_LENGTH_DELIMITED: {
+      uint64_t size;
+      if (TRPC_UNLIKELY(!cursor->ReadVarint(&size))) {
+        return false;
+      }
+      *payload_size = size;
+      return cursor->Skip(size);
+    }
+    case WireFormatLite::WIRETYPE_START_GROUP: {
+      // Same limit as the default recursion limit of protobuf.
+      if (TRPC_UNLIKELY(depth >= 100)) {
+        return false;
+      }
+      while (!cursor->AtEnd()) {
+        uint64_t inner_tag;
+        if (TRPC_UNLIKELY(!cursor->ReadVarint(&inner_tag))) {
+          return false;
+        }
+        if (WireFormatLite::GetTagWireType(static_cast<uint32_t>(inner_tag)) == WireFormatLite::WIRETYPE_END_GROUP) {
+          return (inner_tag >> 3) == (tag >> 3);
+        }
+        std::size_t ignored;
+        if (TRPC_UNLIKELY(!SkipField(cursor, inner_tag, &ignored, depth + 1))) {
+          return false;
+        }
+      }
+      return false;
+    }
+    default:
+      return false;
+  }
+}
+
+// Finds the locations of the aliased fields.
+bool ScanAliasedRanges(const NoncontiguousBuffer& in, const std::vector<int>& field_numbers,
+                       std::vector<AliasedRange>* ranges) {
+  WireCursor cursor(in);
+  while (!cursor.AtEnd()) {
+    std::size_t begin = cursor.Position();
+    uint64_t tag;
+    if (TRPC_UNLIKELY(!cursor.ReadVarint(&tag) || (tag >> 3) == 0 || tag > UINT32_MAX)) {
+      return false;
+    }
+    std::size_t payload_size = 0;
+    if (TRPC_UNLIKELY(!SkipField(&cursor, tag, &payload_size))) {
+      return false;
+    }
+
+    int field_number = static_cast<int>(tag >> 3);
+    if (WireFormatLite::GetTagWireType(static_cast<uint32_t>(tag)) == WireFormatLite::WIRETYPE_LENGTH_DELIMITED &&
+        std::find(field_numbers.begin(), field_numbers.end(), field_number) != field_numbers.end()) {
+      std::size_t header_size = cursor.Position() - begin - payload_size;
+      ranges->push_back(AliasedRange{field_number, begin, header_size, payload_size});
+    }
+  }
+  return true;
+}
+
+// Only `bytes` fields out of any oneof can be aliased: the payloads of `string` fields need the UTF-8 check, and a
+// member of oneof would not be cleared when another member is set.
+const FieldDescriptor* FindAliasedField(const google::protobuf::Message& message, int field_number) {
+  const FieldDescriptor* field = message.GetDescriptor()->FindFieldByNumber(field_number);
+  if (TRPC_UNLIKELY(field == nullptr || field->type() != FieldDescriptor::TYPE_BYTES ||
+                    field->containing_oneof() != nullptr)) {
+    TRPC_FMT_ERROR("field {} of {} can not be aliased, only `bytes` fields out of oneof can be", field_number,
+                   message.GetDescriptor()->full_name());
+    return nullptr;
+  }
+  return field;
+}
+
+}  // namespace
+
+bool ParsePbWithAliasedFields(NoncontiguousBuffer* in, PbAliasedMessage* out) {
+  TRPC_ASSERT(out->message);
+
+  for (int field_number : out->aliased_field_numbers) {
+    if (TRPC_UNLIKELY(FindAliasedField(*out->message, field_number) == nullptr)) {
+      return false;
+    }
+  }
+  out->aliased_fields.clear();
+
+  std::vector<AliasedRange> ranges;
+  if (TRPC_UNLIKELY(!ScanAliasedRanges(*in, out->aliased_field_numbers, &ranges))) {
+    TRPC_LOG_ERROR("pb deserialize failed, malformed wire format");
+    return false;
+  }
+
+  // Cuts the aliased payloads out, the remaining bytes (which are cut without copying as well) are parsed as usual.
+  NoncontiguousBuffer rest;
+  std::size_t consumed = 0;
+  for (const auto& range : ranges) {
+    rest.Append(in->Cut(range.begin - consumed));
+    in->Skip(range.header_size);
+    auto& payloads = out->aliased_fields[range.field_number];
+    // Same as protobuf, the last one wins if a singular field appears more than once.
+    if (!out->message->GetDescriptor()->FindFieldByNumber(range.field_number)->is_repeated()) {
+      payloads.clear();
+    }
+    payloads.emplace_back(in->Cut(range.payload_size));
+    consumed = range.begin + range.header_size + range.payload_size;
+  }
+  rest.Append(std::move(*in));
+  in->Clear();
+
+  NoncontiguousBufferInputStream nbis(&rest);
+  if (TRPC_UNLIKELY(!out->message->ParsePartialFromZeroCopyStream(&nbis))) {
+    TRPC_LOG_ERROR("pb deserialize failed");
+    return false;
+  }
+  nbis.Flush();
+
+  return true;
+}
+
+bool SerializePbWithAliasedFields(PbAliasedMessage* in, NoncontiguousBuffer* out) {
+  TRPC_ASSERT(in->message);
+
+  for (const auto& [field_number, payloads] : in->aliased_fields) {
+    const FieldDescriptor* field = FindAliasedField(*in->message, field_number);
+    if (TRPC_UNLIKELY(field == nullptr)) {
+      return false;
+    }
+    if (TRPC_UNLIKELY(!field->is_repeated() && payloads.size() > 1)) {
+      TRPC_FMT_ERROR("singular field {} of {} has {} payloads", field_number, in->message->GetDescriptor()->full_name(),
+                     payloads.size());
+      return false;
+    }
+  }
+
+  NoncontiguousBufferBuilder builder;
+  {
+    NoncontiguousBufferOutputStream nbos(&builder);
+    if (TRPC_UNLIKELY(!in->message->SerializePartialToZeroCopyStream(&nbos))) {
+      TRPC_LOG_ERROR("pb serialize failed");
+      return false;
+    }
+    nbos.Flush();
+  }
+
+  // Field order on the wire does not matter, but keeps the output deterministic.
+  std::vector<int> field_numbers;
+  field_numbers.reserve(in->aliased_fields.size());
+  for (const auto& [field_number, _] : in->aliased_fields) {
+    field_numbers.push_back(field_number);
+  }
+  std::sort(field_numbers.begin(), field_numbers.end());
+
+  // Tag and length prefix, each of them takes at most 5 bytes.
+  uint8_t header[10];
+  for (int field_number : field_numbers) {
+    for (auto& payload : in->aliased_fields[field_number]) {
+      uint8_t* ptr = google::protobuf::io::CodedOutputStream::WriteVarint32ToArray(
+          WireFormatLite::MakeTag(field_number, WireFormatLite::WIRETYPE_LENGTH_DELIMITED), header);
+      ptr = google::protobuf::io::CodedOutputStream::WriteVarint32ToArray(static_cast<uint32_t>(payload.ByteSize()),
+                                                                          ptr);
+      builder.Append(header, ptr - header);
+      builder.Append(std::move(payload));
+    }
+  }
+  in->aliased_fields.clear();
+
+  *out = builder.DestructiveGet();
+  return true;
+}
+
+}  // namespace trpc::serialization
@@ -0,0 +1,111 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "google/protobuf/message.h"
+
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+
+namespace trpc::serialization {
+
+/// @brief A protobuf message whose large `bytes` fields are not copied into the message but referenced from the
+/// received buffer.
+///
+/// The aliased fields keep a reference to the blocks of the received buffer, so they stay valid even after the
+/// buffer itself is released. Only top-level `bytes` fields out of any oneof can be aliased, parsing or serializing
+/// fails if the field numbers do not refer to such fields.
+///
+/// Usage:
+///
+/// BlobRequest req;
+/// PbAliasedMessage aliased{&req, {BlobRequest::kDataFieldNumber}};
+/// TRPC_ASSERT(ParsePbWithAliasedFields(&buffer, &aliased));
+/// NoncontiguousBuffer& data = aliased.aliased_fields[BlobRequest::kDataFieldNumber].back();
+///
+struct PbAliasedMessage {
+  /// @brief The message holds the non-aliased fields.
+  google::protobuf::Message* message{nullptr};
+
+  /// @brief Field numbers of the fields to be aliased.
+  std::vector<int> aliased_field_numbers;
+
+  /// @brief Field number -> payloads of the aliased field, in the order they appear on the wire. A singular field has
+  /// one payload(the last one wins if it appears more than once on the wire), a repeated field may have several.
+  std::unordered_map<int, std::vector<NoncontiguousBuffer>> aliased_fields;
+};
+
+/// @brief Parses the bytes in |in| into |out|, the aliased fields are cut from |in| without copying.
+/// @param[in] in is the serialized bytes, it is consumed.
+/// @param[out] out holds the parsed message and the aliased fields, the previous aliased fields are cleared.
+/// @return Returns true on success, false if the bytes are malformed or the aliased fields are invalid.
+bool ParsePbWithAliasedFields(NoncontiguousBuffer* in, PbAliasedMessage* out);
+
+/// @brief Serializes |in| into |out|, the payloads of the aliased fields are appended to |out| without copying.
+/// @param[in] in holds the message and the aliased fields(they are moved into |out|).
+/// @param[out] out saves the serialized bytes.
+/// @return Returns true on success, false if the aliased fields are invalid or a singular one has several payloads.
+bool SerializePbWithAliasedFields(PbAliasedMessage* in, NoncontiguousBuffer* out);
+
+/// @brief A `PbAliasedMessage` which owns a message of type |T| and aliases the fields |kFieldNumbers|. It can be used
+/// as the request or response type of the rpc method handlers and the rpc service proxies, which serialize it as
+/// `kPbAliasedMessage` with the pb serialization.
+///
+/// Usage:
+///
+/// using AliasedBlobRequest = PbAliased<BlobRequest, BlobRequest::kDataFieldNumber>;
+/// Status Upload(ServerContextPtr context, const AliasedBlobRequest* req, BlobReply* rsp) {
+///   const NoncontiguousBuffer& data = req->aliased_fields.at(BlobRequest::kDataFieldNumber).back();
+///   ...
+/// }
+///
+template <class T, int... kFieldNumbers>
+class PbAliased : public PbAliasedMessage {
+ public:
+  PbAliased() : PbAliasedMessage{&pb_, {kFieldNumbers...}, {}} {}
+
+  PbAliased(const PbAliased& other) : PbAliasedMessage(other), pb_(other.pb_) { message = &pb_; }
+
+  PbAliased(PbAliased&& other) noexcept : PbAliasedMessage(std::move(other)), pb_(std::move(other.pb_)) {
+    message = &pb_;
+  }
+
+  PbAliased& operator=(const PbAliased& other) {
+    if (this != &other) {
+      aliased_fields = other.aliased_fields;
+      pb_ = other.pb_;
+    }
+    return *this;
+  }
+
+  PbAliased& operator=(PbAliased&& other) noexcept {
+    if (this != &other) {
+      aliased_fields = std::move(other.aliased_fields);
+      pb_ = std::move(other.pb_);
+    }
+    return *this;
+  }
+
+  /// @brief The message holds the non-aliased fields.
+  T& Pb() { return pb_; }
+  const T& Pb() const { return pb_; }
+
+ private:
+  T pb_;
+};
+
+}  // namespace trpc::serialization
@@ -0,0 +1,191 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/serialization/pb/pb_aliasing.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "trpc/serialization/testing/test_serialization.pb.h"
+#include "trpc/util/buffer/buffer.h"
+
+namespace trpc::testing {
+
+using namespace trpc::serialization;
+
+using BlobMessage = trpc::test::serialization::BlobMessage;
+
+namespace {
+
+BlobMessage MakeBlobMessage() {
+  BlobMessage msg;
+  msg.set_name("blob");
+  msg.set_data(std::string(64 * 1024, 'd'));
+  msg.add_chunks("chunk1");
+  msg.add_chunks(std::string(8 * 1024, 'c'));
+  msg.set_id(12345);
+  return msg;
+}
+
+// Splits the serialized bytes into small blocks so that fields span several blocks.
+NoncontiguousBuffer SerializeToBlocks(const BlobMessage& msg, std::size_t block_size) {
+  std::string bytes = msg.SerializeAsString();
+  NoncontiguousBuffer buffer;
+  for (std::size_t pos = 0; pos < bytes.size(); pos += block_size) {
+    buffer.Append(CreateBufferSlow(bytes.substr(pos, block_size)));
+  }
+  return buffer;
+}
+
+}  // namespace
+
+TEST(PbAliasingTest, ParseWithAliasedFields) {
+  BlobMessage expected = MakeBlobMessage();
+
+  for (std::size_t block_size : {1, 7, 4096, 1024 * 1024}) {
+    NoncontiguousBuffer buffer = SerializeToBlocks(expected, block_size);
+
+    BlobMessage msg;
+    PbAliasedMessage aliased{&msg, {BlobMessage::kDataFieldNumber, BlobMessage::kChunksFieldNumber}};
+    ASSERT_TRUE(ParsePbWithAliasedFields(&buffer, &aliased));
+
+    ASSERT_EQ(msg.name(), expected.name());
+    ASSERT_EQ(msg.id(), expected.id());
+    ASSERT_TRUE(msg.data().empty());
+    ASSERT_EQ(msg.chunks_size(), 0);
+
+    ASSERT_EQ(aliased.aliased_fields[BlobMessage::kDataFieldNumber].size(), 1);
+    ASSERT_EQ(FlattenSlow(aliased.aliased_fields[BlobMessage::kDataFieldNumber][0]), expected.data());
+    ASSERT_EQ(aliased.aliased_fields[BlobMessage::kChunksFieldNumber].size(), 2);
+    ASSERT_EQ(FlattenSlow(aliased.aliased_fields[BlobMessage::kChunksFieldNumber][0]), expected.chunks(0));
+    ASSERT_EQ(FlattenSlow(aliased.aliased_fields[BlobMessage::kChunksFieldNumber][1]), expected.chunks(1));
+  }
+}
+
+TEST(PbAliasingTest, ParseWithoutAliasedFields) {
+  BlobMessage expected = MakeBlobMessage();
+  NoncontiguousBuffer buffer = SerializeToBlocks(expected, 100);
+
+  BlobMessage msg;
+  PbAliasedMessage aliased{&msg, {}};
+  ASSERT_TRUE(ParsePbWithAliasedFields(&buffer, &aliased));
+  ASSERT_TRUE(aliased.aliased_fields.empty());
+  ASSERT_EQ(msg.SerializeAsString(), expected.SerializeAsString());
+}
+
+TEST(PbAliasingTest, ParseMalformed) {
+  BlobMessage expected = MakeBlobMessage();
+  std::string bytes = expected.SerializeAsString();
+  NoncontiguousBuffer buffer = CreateBufferSlow(bytes.substr(0, bytes.size() - 1));
+
+  BlobMessage msg;
+  PbAliasedMessage aliased{&msg, {BlobMessage::kDataFieldNumber}};
+  ASSERT_FALSE(ParsePbWithAliasedFields(&buffer, &aliased));
+}
+
+TEST(PbAliasingTest, SerializeWithAliasedFields) {
+  BlobMessage expected = MakeBlobMessage();
+
+  BlobMessage msg;
+  msg.set_name(expected.name());
+  msg.set_id(expected.id());
+  PbAliasedMessage aliased{&msg, {}};
+  aliased.aliased_fields[BlobMessage::kDataFieldNumber].emplace_back(CreateBufferSlow(expected.data()));
+  aliased.aliased_fields[BlobMessage::kChunksFieldNumber].emplace_back(CreateBufferSlow(expected.chunks(0)));
+  aliased.aliased_fields[BlobMessage::kChunksFieldNumber].emplace_back(CreateBufferSlow(expected.chunks(1)));
+
+  NoncontiguousBuffer out;
+  ASSERT_TRUE(SerializePbWithAliasedFields(&aliased, &out));
+  ASSERT_TRUE(aliased.aliased_fields.empty());
+
+  BlobMessage parsed;
+  ASSERT_TRUE(parsed.ParseFromString(FlattenSlow(out)));
+  ASSERT_EQ(parsed.SerializeAsString(), expected.SerializeAsString());
+}
+
+TEST(PbAliasingTest, ParseSingularLastOneWins) {
+  BlobMessage first;
+  first.set_data("first");
+  first.add_chunks("chunk1");
+  BlobMessage second;
+  second.set_data("second");
+  second.add_chunks("chunk2");
+  // Concatenated messages are merged, the singular field appears twice.
+  NoncontiguousBuffer buffer = CreateBufferSlow(first.SerializeAsString() + second.SerializeAsString());
+
+  BlobMessage msg;
+  PbAliasedMessage aliased{&msg, {BlobMessage::kDataFieldNumber, BlobMessage::kChunksFieldNumber}};
+  aliased.aliased_fields[BlobMessage::kDataFieldNumber].emplace_back(CreateBufferSlow("stale"));
+  ASSERT_TRUE(ParsePbWithAliasedFields(&buffer, &aliased));
+
+  ASSERT_EQ(aliased.aliased_fields[BlobMessage::kDataFieldNumber].size(), 1);
+  ASSERT_EQ(FlattenSlow(aliased.aliased_fields[BlobMessage::kDataFieldNumber][0]), "second");
+  ASSERT_EQ(aliased.aliased_fields[BlobMessage::kChunksFieldNumber].size(), 2);
+  ASSERT_EQ(FlattenSlow(aliased.aliased_fields[BlobMessage::kChunksFieldNumber][0]), "chunk1");
+  ASSERT_EQ(FlattenSlow(aliased.aliased_fields[BlobMessage::kChunksFieldNumber][1]), "chunk2");
+}
+
+TEST(PbAliasingTest, InvalidAliasedFields) {
+  BlobMessage expected = MakeBlobMessage();
+
+  // Not a `bytes` field, or not a field at all.
+  for (int field_number : std::vector<int>{BlobMessage::kNameFieldNumber, BlobMessage::kIdFieldNumber, 100}) {
+    NoncontiguousBuffer buffer = SerializeToBlocks(expected, 100);
+    BlobMessage msg;
+    PbAliasedMessage aliased{&msg, {field_number}};
+    ASSERT_FALSE(ParsePbWithAliasedFields(&buffer, &aliased));
+
+    PbAliasedMessage to_serialize{&msg, {}};
+    to_serialize.aliased_fields[field_number].emplace_back(CreateBufferSlow("payload"));
+    NoncontiguousBuffer out;
+    ASSERT_FALSE(SerializePbWithAliasedFields(&to_serialize, &out));
+  }
+
+  // Several payloads of a singular field.
+  BlobMessage msg;
+  PbAliasedMessage aliased{&msg, {}};
+  aliased.aliased_fields[BlobMessage::kDataFieldNumber].emplace_back(CreateBufferSlow("data1"));
+  aliased.aliased_fields[BlobMessage::kDataFieldNumber].emplace_back(CreateBufferSlow("data2"));
+  NoncontiguousBuffer out;
+  ASSERT_FALSE(SerializePbWithAliasedFields(&aliased, &out));
+}
+
+TEST(PbAliasingTest, PbAliased) {
+  using AliasedBlobMessage = PbAliased<BlobMessage, BlobMessage::kDataFieldNumber>;
+
+  AliasedBlobMessage aliased;
+  ASSERT_EQ(aliased.message, &aliased.Pb());
+  ASSERT_EQ(aliased.aliased_field_numbers, std::vector<int>{BlobMessage::kDataFieldNumber});
+  aliased.Pb().set_name("blob");
+  aliased.aliased_fields[BlobMessage::kDataFieldNumber].emplace_back(CreateBufferSlow("data"));
+
+  AliasedBlobMessage copied(aliased);
+  ASSERT_EQ(copied.message, &copied.Pb());
+  ASSERT_EQ(copied.Pb().name(), "blob");
+  ASSERT_EQ(FlattenSlow(copied.aliased_fields[BlobMessage::kDataFieldNumber][0]), "data");
+
+  AliasedBlobMessage moved(std::move(copied));
+  ASSERT_EQ(moved.message, &moved.Pb());
+  ASSERT_EQ(moved.Pb().name(), "blob");
+
+  AliasedBlobMessage assigned;
+  assigned = moved;
+  ASSERT_EQ(assigned.message, &assigned.Pb());
+  ASSERT_EQ(assigned.Pb().name(), "blob");
+  ASSERT_EQ(FlattenSlow(assigned.aliased_fields[BlobMessage::kDataFieldNumber][0]), "data");
+}
+
+}  // namespace trpc::testing
@@ -17,6 +17,7 @@
 
 #include "google/protobuf/message.h"
 
+#include "trpc/serialization/pb/pb_aliasing.h"
 #include "trpc/util/buffer/zero_copy_stream.h"
 #include "trpc/util/likely.h"
 #include "trpc/util/log/logging.h"
@@ -49,6 +50,11 @@ bool PbSerialization::Serialize(DataType in_type, void* in, NoncontiguousBuffer*
 
       break;
     }
+    case kPbAliasedMessage: {
+      ret = SerializePbWithAliasedFields(static_cast<PbAliasedMessage*>(in), out);
+
+      break;
+    }
     default: {
       TRPC_LOG_ERROR("serialization datatype:" << static_cast<int>(in_type)
                                                << " has not implement.");
@@ -59,6 +65,10 @@ bool PbSerialization::Serialize(DataType in_type, void* in, NoncontiguousBuffer*
 }
 
 bool PbSerialization::Deserialize(NoncontiguousBuffer* in, DataType out_type, void* out) {
+  if (out_type == kPbAliasedMessage) {
+    return ParsePbWithAliasedFields(in, static_cast<PbAliasedMessage*>(out));
+  }
+
   TRPC_ASSERT(out_type == kPbMessage);
 
   google::protobuf::Message* pb = static_cast<google::protobuf::Message*>(out);
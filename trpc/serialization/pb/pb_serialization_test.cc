@@ -18,6 +18,7 @@
 
 #include "gtest/gtest.h"
 
+#include "trpc/serialization/pb/pb_aliasing.h"
 #include "trpc/serialization/testing/test_serialization.pb.h"
 
 namespace trpc::testing {
@@ -26,6 +27,7 @@ using namespace trpc::serialization;
 
 using HelloRequest = trpc::test::serialization::HelloRequest;
 using HelloReply = trpc::test::serialization::HelloReply;
+using BlobMessage = trpc::test::serialization::BlobMessage;
 
 TEST(PbSerializationTest, PbSerializationTest) {
   std::unique_ptr<PbSerialization> pb_serialization(new PbSerialization());
@@ -62,4 +64,28 @@ TEST(PbSerializationTest, PbSerializationTest) {
   ASSERT_EQ(request.msg(), request_deserialize.msg());
 }
 
+TEST(PbSerializationTest, PbAliasedMessageTest) {
+  PbSerialization pb_serialization;
+  using AliasedBlobMessage = PbAliased<BlobMessage, BlobMessage::kDataFieldNumber>;
+
+  AliasedBlobMessage request;
+  request.Pb().set_name("blob");
+  request.aliased_fields[BlobMessage::kDataFieldNumber].emplace_back(CreateBufferSlow("data"));
+
+  NoncontiguousBuffer buffer;
+  ASSERT_TRUE(pb_serialization.Serialize(kPbAliasedMessage, static_cast<PbAliasedMessage*>(&request), &buffer));
+
+  BlobMessage plain;
+  ASSERT_TRUE(plain.ParseFromString(FlattenSlow(buffer)));
+  ASSERT_EQ(plain.name(), "blob");
+  ASSERT_EQ(plain.data(), "data");
+
+  AliasedBlobMessage request_deserialize;
+  ASSERT_TRUE(
+      pb_serialization.Deserialize(&buffer, kPbAliasedMessage, static_cast<PbAliasedMessage*>(&request_deserialize)));
+  ASSERT_EQ(request_deserialize.Pb().name(), "blob");
+  ASSERT_TRUE(request_deserialize.Pb().data().empty());
+  ASSERT_EQ(FlattenSlow(request_deserialize.aliased_fields[BlobMessage::kDataFieldNumber].back()), "data");
+}
+
 }  // namespace trpc::testing
@@ -66,6 +66,9 @@ const DataType kHttpType = 7;
 /// @brief Data sturct: thrift
 const DataType kThrift = 8;
 
+/// @brief Data struct: PbAliasedMessage, a protobuf message whose large bytes fields reference the received buffer
+const DataType kPbAliasedMessage = 9;
+
 /// @brief Max value of data struct
 const DataType kMaxDataType = 255;
 
@@ -0,0 +1,161 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "trpc/coroutine/fiber.h"
+#include "trpc/coroutine/fiber_condition_variable.h"
+#include "trpc/coroutine/fiber_mutex.h"
+#include "trpc/server/rpc/unary_rpc_method_handler.h"
+#include "trpc/util/chrono/chrono.h"
+
+namespace trpc {
+
+/// @brief Options of the batching of `BatchRpcMethodHandler`.
+struct BatchRpcMethodOptions {
+  /// Max requests of a batch, a full batch is invoked at once.
+  uint32_t max_batch_size{32};
+
+  /// Max time(us) the first request of a batch waits for the others.
+  uint32_t max_delay_us{1000};
+};
+
+/// @brief Rpc method handler which collects the concurrent requests of the method into batches, the user is invoked
+///        once per batch with all the requests and responses of it.
+///
+/// The first request of a batch waits for the others until the batch is full or `max_delay_us` passes, then invokes
+/// the batch in its fiber. The first request is responded as usual, the others are responded asynchronously through
+/// their contexts. The status returned by the user is set to the requests of the batch, except the ones whose status
+/// has been set to an error by the user, so a request of the batch can fail alone.
+/// @note Batching works in fiber runtime only, each request is invoked as a batch of one otherwise.
+template <class RequestType, class ResponseType>
+class BatchRpcMethodHandler : public UnaryRpcMethodHandler<RequestType, ResponseType> {
+ public:
+  using BatchRpcMethodFunction =
+      std::function<Status(const std::vector<ServerContextPtr>&, const std::vector<const RequestType*>&,
+                           const std::vector<ResponseType*>&)>;
+
+  using UnaryRpcMethodHandler<RequestType, ResponseType>::PreExecute;
+  using UnaryRpcMethodHandler<RequestType, ResponseType>::PostExecute;
+  using UnaryRpcMethodHandler<RequestType, ResponseType>::EncodeResponse;
+
+  explicit BatchRpcMethodHandler(const BatchRpcMethodFunction& func, const BatchRpcMethodOptions& options = {})
+      : func_(func), options_(options) {
+    options_.max_batch_size = std::max(options_.max_batch_size, 1u);
+  }
+
+  void Execute(const ServerContextPtr& context, NoncontiguousBuffer&& req_body,
+               NoncontiguousBuffer& rsp_body) noexcept override {
+    if (PreExecute(context, std::move(req_body))) {
+      std::vector<ServerContextPtr> batch;
+      if (!Collect(context, &batch)) {
+        // The request has joined the batch of another request, which responds to it once the batch is invoked.
+        return;
+      }
+      Invoke(batch);
+    } else if (IsDecodeError(context)) {
+      // if decoding error, no need to execute PostExecute
+      return;
+    }
+
+    PostExecute(context, rsp_body);
+  }
+
+ private:
+  void Execute(const ServerContextPtr& context) noexcept override { TRPC_ASSERT(false && "Unreachable"); }
+
+  bool IsDecodeError(const ServerContextPtr& context) {
+    return context->GetStatus().GetFrameworkRetCode() ==
+           context->GetServerCodec()->GetProtocolRetCode(codec::ServerRetCode::DECODE_ERROR);
+  }
+
+  // Adds the request to the pending batch, or starts a new batch and waits for it if there is none.
+  // Returns true with the requests of the batch if the request started it, false if it joined another one.
+  bool Collect(const ServerContextPtr& context, std::vector<ServerContextPtr>* batch) {
+    if (options_.max_batch_size == 1 || !IsRunningInFiberWorker()) {
+      batch->push_back(context);
+      return true;
+    }
+
+    std::unique_lock<FiberMutex> lock(mutex_);
+    if (pending_) {
+      // Set before the request is visible to the first request, which may respond to it at any time after.
+      context->SetResponse(false);
+      pending_->push_back(context);
+      if (pending_->size() >= options_.max_batch_size) {
+        pending_ = nullptr;
+        cv_.notify_all();
+      }
+      return false;
+    }
+
+    batch->reserve(options_.max_batch_size);
+    batch->push_back(context);
+    pending_ = batch;
+    auto deadline = ReadSteadyClock() + std::chrono::microseconds(options_.max_delay_us);
+    cv_.wait_until(lock, deadline, [&] { return pending_ != batch; });
+    if (pending_ == batch) {
+      pending_ = nullptr;
+    }
+    return true;
+  }
+
+  void Invoke(const std::vector<ServerContextPtr>& batch) {
+    std::vector<const RequestType*> reqs;
+    std::vector<ResponseType*> rsps;
+    reqs.reserve(batch.size());
+    rsps.reserve(batch.size());
+    for (const auto& context : batch) {
+      reqs.push_back(static_cast<const RequestType*>(context->GetRequestData()));
+      rsps.push_back(static_cast<ResponseType*>(context->GetResponseData()));
+    }
+
+    Status status = func_(batch, reqs, rsps);
+    for (const auto& context : batch) {
+      if (context->GetStatus().OK()) {
+        context->SetStatus(status);
+      }
+    }
+
+    // The first request is responded by the framework once `Execute` returns.
+    for (std::size_t i = 1; i < batch.size(); ++i) {
+      NoncontiguousBuffer rsp_body;
+      EncodeResponse(batch[i], rsp_body);
+      Status rsp_status = batch[i]->GetStatus();
+      batch[i]->SendTransparentResponse(rsp_status, std::move(rsp_body));
+    }
+  }
+
+ private:
+  BatchRpcMethodFunction func_;
+
+  BatchRpcMethodOptions options_;
+
+  FiberMutex mutex_;
+
+  FiberConditionVariable cv_;
+
+  // Requests of the batch waiting for more requests, owned by the first request of it.
+  std::vector<ServerContextPtr>* pending_{nullptr};
+};
+
+}  // namespace trpc
@@ -0,0 +1,173 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#include "trpc/server/rpc/batch_rpc_method_handler.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "trpc/codec/codec_manager.h"
+#include "trpc/codec/trpc/testing/trpc_protocol_testing.h"
+#include "trpc/coroutine/fiber.h"
+#include "trpc/coroutine/fiber_latch.h"
+#include "trpc/coroutine/testing/fiber_runtime.h"
+#include "trpc/proto/testing/helloworld.pb.h"
+#include "trpc/serialization/trpc_serialization.h"
+#include "trpc/server/rpc/rpc_service_impl.h"
+#include "trpc/server/testing/mock_server_transport.h"
+#include "trpc/server/testing/server_context_testing.h"
+
+namespace trpc::testing {
+
+using HelloRequest = trpc::test::helloworld::HelloRequest;
+using HelloReply = trpc::test::helloworld::HelloReply;
+
+class BatchRpcMethodHandlerTest : public ::testing::Test {
+ public:
+  static void SetUpTestCase() {
+    codec::Init();
+    serialization::Init();
+  }
+
+  static void TearDownTestCase() {
+    codec::Destroy();
+    serialization::Destroy();
+  }
+
+ protected:
+  void SetUp() override {
+    service_ = std::make_shared<RpcServiceImpl>();
+    service_->SetServerTransport(&transport_);
+  }
+
+  // Registers the batched method, which echoes the requests and counts the batches with their sizes.
+  void AddMethod(const BatchRpcMethodOptions& options) {
+    service_->AddRpcServiceMethod(new RpcServiceMethod(
+        "SayHello", MethodType::UNARY,
+        new BatchRpcMethodHandler<HelloRequest, HelloReply>(
+            [this](const std::vector<ServerContextPtr>& contexts, const std::vector<const HelloRequest*>& reqs,
+                   const std::vector<HelloReply*>& rsps) {
+              EXPECT_EQ(contexts.size(), reqs.size());
+              EXPECT_EQ(contexts.size(), rsps.size());
+              for (std::size_t i = 0; i < reqs.size(); ++i) {
+                if (reqs[i]->msg() == "fail") {
+                  contexts[i]->SetStatus(Status(-1, "failed alone"));
+                }
+                rsps[i]->set_msg(reqs[i]->msg());
+              }
+              batch_sizes_.push_back(reqs.size());
+              return kSuccStatus;
+            },
+            options)));
+  }
+
+  ServerContextPtr MakeContext(const std::string& msg) {
+    DummyTrpcProtocol req_data;
+    req_data.func = "SayHello";
+    HelloRequest hello_req;
+    hello_req.set_msg(msg);
+    NoncontiguousBuffer req_bin_data;
+    EXPECT_TRUE(PackTrpcRequest(req_data, static_cast<void*>(&hello_req), req_bin_data));
+    return MakeTestServerContext("trpc", service_.get(), std::move(req_bin_data));
+  }
+
+  // Dispatches the requests concurrently, returns the number of requests responded synchronously.
+  int Dispatch(const std::vector<ServerContextPtr>& contexts) {
+    std::atomic<int> sync_responses{0};
+    FiberLatch latch(contexts.size());
+    for (const auto& context : contexts) {
+      StartFiberDetached([&, context] {
+        service_->Dispatch(context, context->GetRequestMsg(), context->GetResponseMsg());
+        if (context->IsResponse()) {
+          ++sync_responses;
+        }
+        latch.CountDown();
+      });
+    }
+    latch.Wait();
+    return sync_responses;
+  }
+
+ protected:
+  MockServerTransport transport_;
+  std::shared_ptr<RpcServiceImpl> service_;
+  std::vector<std::size_t> batch_sizes_;
+};
+
+TEST_F(BatchRpcMethodHandlerTest, FullBatch) {
+  RunAsFiber([&] {
+    AddMethod(BatchRpcMethodOptions{.max_batch_size = 4, .max_delay_us = 10000000});
+
+    std::vector<ServerContextPtr> contexts;
+    for (int i = 0; i < 4; ++i) {
+      contexts.push_back(MakeContext(std::to_string(i)));
+    }
+    contexts[3] = MakeContext("fail");
+
+    EXPECT_CALL(transport_, SendMsg(::testing::_, ::testing::_)).Times(3).WillRepeatedly(::testing::Return(0));
+
+    // The batch is invoked once it is full, long before the delay.
+    ASSERT_EQ(Dispatch(contexts), 1);
+    ASSERT_EQ(batch_sizes_, std::vector<std::size_t>{4});
+
+    // A request of the batch fails alone.
+    for (int i = 0; i < 3; ++i) {
+      ASSERT_TRUE(contexts[i]->GetStatus().OK());
+    }
+    ASSERT_EQ(contexts[3]->GetStatus().ErrorMessage(), "failed alone");
+
+    // The first request is responded synchronously with its own response.
+    for (int i = 0; i < 3; ++i) {
+      if (contexts[i]->IsResponse()) {
+        ASSERT_TRUE(contexts[i]->GetStatus().OK());
+        HelloReply hello_rsp;
+        DummyTrpcProtocol req_data;
+        NoncontiguousBuffer rsp_bin_data = contexts[i]->GetResponseMsg()->GetNonContiguousProtocolBody();
+        ASSERT_TRUE(UnPackTrpcResponseBody(rsp_bin_data, req_data, &hello_rsp));
+        ASSERT_EQ(hello_rsp.msg(), std::to_string(i));
+      }
+    }
+  });
+}
+
+TEST_F(BatchRpcMethodHandlerTest, DelayedBatch) {
+  RunAsFiber([&] {
+    AddMethod(BatchRpcMethodOptions{.max_batch_size = 8, .max_delay_us = 10000});
+
+    EXPECT_CALL(transport_, SendMsg(::testing::_, ::testing::_)).Times(1).WillOnce(::testing::Return(0));
+
+    // The batch is invoked once the delay passes, though it is not full.
+    ASSERT_EQ(Dispatch({MakeContext("a"), MakeContext("b")}), 1);
+    ASSERT_EQ(batch_sizes_, std::vector<std::size_t>{2});
+  });
+}
+
+TEST_F(BatchRpcMethodHandlerTest, NotInFiber) {
+  AddMethod(BatchRpcMethodOptions{});
+
+  ServerContextPtr context = MakeContext("hello");
+  service_->Dispatch(context, context->GetRequestMsg(), context->GetResponseMsg());
+
+  ASSERT_TRUE(context->IsResponse());
+  ASSERT_TRUE(context->GetStatus().OK());
+  ASSERT_EQ(batch_sizes_, std::vector<std::size_t>{1});
+}
+
+}  // namespace trpc::testing
@@ -13,20 +13,29 @@
 
 #include "trpc/server/rpc/rpc_service_impl.h"
 
+#include <chrono>
 #include <iostream>
 #include <memory>
 #include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
 #include "trpc/codec/codec_manager.h"
 #include "trpc/codec/trpc/testing/trpc_protocol_testing.h"
+#include "trpc/common/config/trpc_config.h"
 #include "trpc/coroutine/fiber_latch.h"
 #include "trpc/coroutine/testing/fiber_runtime.h"
+#include "trpc/filter/filter.h"
 #include "trpc/proto/testing/helloworld.pb.h"
 #include "trpc/proto/testing/helloworld_generated.h"
+#include "trpc/runtime/common/stats/frame_stats.h"
+#include "trpc/runtime/iomodel/reactor/testing/mock_connection_testing.h"
+#include "trpc/runtime/merge_runtime.h"
+#include "trpc/runtime/separate_runtime.h"
 #include "trpc/serialization/trpc_serialization.h"
 #include "trpc/server/rpc/rpc_method_handler.h"
 #include "trpc/server/rpc/stream_rpc_method_handler.h"
@@ -36,6 +45,7 @@
 #include "trpc/stream/testing/mock_stream_handler.h"
 #include "trpc/stream/testing/mock_stream_provider.h"
 #include "trpc/util/flatbuffers/trpc_fbs.h"
+#include "trpc/util/thread/latch.h"
 
 namespace trpc::testing {
 
@@ -80,6 +90,13 @@ class Greeter {
     return trpc::Status(0, "");
   }
 
+  trpc::Status PbToStringSayHello(trpc::ServerContextPtr context, const trpc::test::helloworld::HelloRequest* request,
+                                  std::string* reply) {
+    context->SetRspEncodeType(TrpcContentEncodeType::TRPC_NOOP_ENCODE);
+    *reply = request->msg();
+    return trpc::Status(0, "");
+  }
+
   trpc::Status NoncontiguousBufferSayHello(trpc::ServerContextPtr context, const trpc::NoncontiguousBuffer* request,
                                            trpc::NoncontiguousBuffer* reply) {
     *reply = *request;
@@ -149,6 +166,7 @@ static const char* Greeter_method_names[] = {
     "/trpc.test.helloworld.Greeter/ServerStreamSayHello",         // 5
     "/trpc.test.helloworld.Greeter/ClientStreamSayHello",         // 6
     "/trpc.test.helloworld.Greeter/BidiStreamSayHello",           // 7
+    "/trpc.test.helloworld.Greeter/PbToStringSayHello",           // 8
 };
 
 TEST_F(RpcServiceImplTest, PbMessage) {
@@ -220,6 +238,116 @@ TEST_F(RpcServiceImplTest, NotFoundFunc) {
   ASSERT_TRUE(context->GetStatus().ErrorMessage() == "SayHello not found");
 }
 
+TEST_F(RpcServiceImplTest, FullLinkTimeoutExpired) {
+  RunAsFiber([] {
+    std::shared_ptr<RpcServiceImpl> test_rpc_server_impl = std::make_shared<RpcServiceImpl>();
+    auto service_adapter = std::make_unique<ServiceAdapter>(CreateServiceAdapterOption());
+    FillServiceAdapter(service_adapter.get(), "trpc.test.helloworld.Greeter", test_rpc_server_impl);
+
+    // Only the service's own timeout(2000ms) is passed, the caller carried no timeout.
+    ServerContextPtr context = ::trpc::MakeServerContext();
+    context->SetService(test_rpc_server_impl.get());
+    context->SetRecvTimestampUs(1000 * 1000);
+    context->SetRealTimeout();
+    ASSERT_EQ(context->GetTimeout(), 2000);
+    ASSERT_FALSE(context->IsFullLinkTimeoutExpired(1000 + 5000));
+
+    // The service's timeout is shorter than the caller's, only the caller's one counts.
+    context = ::trpc::MakeServerContext();
+    context->SetService(test_rpc_server_impl.get());
+    context->SetRecvTimestampUs(1000 * 1000);
+    context->SetTimeout(3000);
+    context->SetRealTimeout();
+    ASSERT_EQ(context->GetTimeout(), 2000);
+    ASSERT_EQ(context->GetFullLinkTimeout(), 3000);
+    ASSERT_FALSE(context->IsFullLinkTimeoutExpired(1000 + 2999));
+    ASSERT_TRUE(context->IsFullLinkTimeoutExpired(1000 + 3000));
+
+    // Nothing expires once the request timeout of the service is disabled.
+    trpc::ServiceAdapterOption option = CreateServiceAdapterOption();
+    option.disable_request_timeout = true;
+    auto disabled_service_adapter = std::make_unique<ServiceAdapter>(std::move(option));
+    FillServiceAdapter(disabled_service_adapter.get(), "trpc.test.helloworld.Greeter", test_rpc_server_impl);
+    ASSERT_FALSE(context->IsFullLinkTimeoutExpired(1000 + 3000));
+  });
+}
+
+// Delays the requests at SERVER_PRE_SCHED_RECV_MSG so that their full-link timeouts expire before they are handled,
+// and records the status seen by SERVER_POST_SCHED_RECV_MSG.
+class ExpiredRequestFilter : public MessageServerFilter {
+ public:
+  std::string Name() override { return "expired_request_filter"; }
+
+  std::vector<FilterPoint> GetFilterPoint() override {
+    return {FilterPoint::SERVER_PRE_SCHED_RECV_MSG, FilterPoint::SERVER_POST_SCHED_RECV_MSG};
+  }
+
+  void operator()(FilterStatus& status, FilterPoint point, const ServerContextPtr& context) override {
+    status = FilterStatus::CONTINUE;
+    if (point == FilterPoint::SERVER_PRE_SCHED_RECV_MSG) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      return;
+    }
+    post_sched_ret_code_ = context->GetStatus().GetFrameworkRetCode();
+    post_sched_done_.count_down();
+  }
+
+  int WaitForPostSched() {
+    post_sched_done_.wait();
+    return post_sched_ret_code_;
+  }
+
+ private:
+  int post_sched_ret_code_{0};
+  Latch post_sched_done_{1};
+};
+
+// Sends a request with 1ms full-link timeout to the service handled by the thread model, it expires before handled.
+void TestDiscardExpiredRequest(const std::string& threadmodel_instance_name) {
+  std::shared_ptr<RpcServiceImpl> test_rpc_server_impl = std::make_shared<RpcServiceImpl>();
+  auto filter = std::make_shared<ExpiredRequestFilter>();
+  test_rpc_server_impl->GetFilterController().AddMessageServerFilter(filter);
+
+  trpc::ServiceAdapterOption option = CreateServiceAdapterOption();
+  option.threadmodel_instance_name = threadmodel_instance_name;
+  auto service_adapter = std::make_unique<ServiceAdapter>(std::move(option));
+  FillServiceAdapter(service_adapter.get(), "trpc.test.helloworld.Greeter", test_rpc_server_impl);
+
+  DummyTrpcProtocol req_data;
+  req_data.func = Greeter_method_names[0];
+  req_data.timeout = 1;
+  trpc::test::helloworld::HelloRequest hello_req;
+  hello_req.set_msg("Expired");
+  NoncontiguousBuffer req_bin_data;
+  ASSERT_TRUE(PackTrpcRequest(req_data, static_cast<void*>(&hello_req), req_bin_data));
+
+  uint64_t expired_count = FrameStats::GetInstance()->GetServerStats().GetTotalExpiredReqCount();
+  ConnectionPtr conn = MakeRefCounted<MockConnection>();
+  std::deque<std::any> msg;
+  msg.emplace_back(std::move(req_bin_data));
+  ASSERT_TRUE(service_adapter->HandleMessage(conn, msg));
+
+  // The status is set before SERVER_POST_SCHED_RECV_MSG, and the request is dropped without a response.
+  int expected_ret_code =
+      ServerCodecFactory::GetInstance()->Get("trpc")->GetProtocolRetCode(codec::ServerRetCode::FULL_LINK_TIMEOUT_ERROR);
+  ASSERT_EQ(filter->WaitForPostSched(), expected_ret_code);
+  ASSERT_EQ(FrameStats::GetInstance()->GetServerStats().GetTotalExpiredReqCount(), expired_count + 1);
+}
+
+TEST_F(RpcServiceImplTest, DiscardExpiredRequestInMergeThreadModel) {
+  ASSERT_EQ(TrpcConfig::GetInstance()->Init("trpc/runtime/threadmodel/testing/merge.yaml"), 0);
+  merge::StartRuntime();
+  TestDiscardExpiredRequest(merge::RandomGetMergeThreadModel()->GroupName());
+  merge::TerminateRuntime();
+}
+
+TEST_F(RpcServiceImplTest, DiscardExpiredRequestInSeparateThreadModel) {
+  ASSERT_EQ(TrpcConfig::GetInstance()->Init("trpc/runtime/threadmodel/testing/separate.yaml"), 0);
+  separate::StartRuntime();
+  TestDiscardExpiredRequest(separate::RandomGetSeparateThreadModel()->GroupName());
+  separate::TerminateRuntime();
+}
+
 TEST_F(RpcServiceImplTest, FbsMessage) {
   flatbuffers::trpc::Message<trpc::test::helloworld::FbRequest> hello_req;
   flatbuffers::trpc::MessageBuilder req_mb;
@@ -302,6 +430,44 @@ TEST_F(RpcServiceImplTest, StringMessage) {
   ASSERT_TRUE(hello_rsp == hello_req);
 }
 
+// The response is serialized by its own type, which differs from the type of the request.
+TEST_F(RpcServiceImplTest, ResponseTypeDifferentFromRequestType) {
+  DummyTrpcProtocol req_data;
+  req_data.func = Greeter_method_names[8];
+
+  trpc::test::helloworld::HelloRequest hello_req;
+  hello_req.set_msg("hello world");
+
+  NoncontiguousBuffer req_bin_data;
+
+  ASSERT_TRUE(PackTrpcRequest(req_data, static_cast<void*>(&hello_req), req_bin_data));
+
+  std::shared_ptr<RpcServiceImpl> test_rpc_server_impl = std::make_shared<RpcServiceImpl>();
+
+  ServerContextPtr context = MakeTestServerContext("trpc", test_rpc_server_impl.get(), std::move(req_bin_data));
+
+  Greeter greeter;
+
+  test_rpc_server_impl->AddRpcServiceMethod(new trpc::RpcServiceMethod(
+      Greeter_method_names[8], trpc::MethodType::UNARY,
+      new trpc::RpcMethodHandler<trpc::test::helloworld::HelloRequest, std::string>(std::bind(
+          &Greeter::PbToStringSayHello, &greeter, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3))));
+
+  test_rpc_server_impl->Dispatch(context, context->GetRequestMsg(), context->GetResponseMsg());
+
+  ASSERT_TRUE(context->GetStatus().OK());
+
+  DummyTrpcProtocol rsp_data;
+  rsp_data.data_type = serialization::kStringNoop;
+  rsp_data.content_type = TrpcContentEncodeType::TRPC_NOOP_ENCODE;
+
+  std::string hello_rsp;
+  NoncontiguousBuffer rsp_bin_data = context->GetResponseMsg()->GetNonContiguousProtocolBody();
+  ASSERT_TRUE(UnPackTrpcResponseBody(rsp_bin_data, rsp_data, &hello_rsp));
+
+  ASSERT_EQ(hello_rsp, hello_req.msg());
+}
+
 TEST_F(RpcServiceImplTest, NoncontiguousBufferMessage) {
   NoncontiguousBuffer hello_req = CreateBufferSlow("hello world");
 
@@ -21,6 +21,7 @@
 
 #include "trpc/codec/trpc/trpc.pb.h"
 #include "trpc/compressor/trpc_compressor.h"
+#include "trpc/serialization/pb/pb_aliasing.h"
 #include "trpc/serialization/serialization_factory.h"
 #include "trpc/server/method_handler.h"
 #include "trpc/server/server_context.h"
@@ -29,6 +30,7 @@
 #include "trpc/util/flatbuffers/message_fbs.h"
 #include "trpc/util/log/logging.h"
 #include "trpc/util/pb2json.h"
+#include "trpc/util/pb_json_transcoder.h"
 
 namespace trpc {
 
@@ -36,6 +38,16 @@ namespace trpc {
 template <class RequestType, class ResponseType>
 class UnaryRpcMethodHandler : public RpcMethodHandlerInterface {
  public:
+  UnaryRpcMethodHandler() {
+    // The json transcoding plans are compiled when the method is registered, instead of by the first json request.
+    if constexpr (std::is_base_of_v<google::protobuf::Message, RequestType>) {
+      PbJsonTranscoder::Precompile(RequestType::descriptor());
+    }
+    if constexpr (std::is_base_of_v<google::protobuf::Message, ResponseType>) {
+      PbJsonTranscoder::Precompile(ResponseType::descriptor());
+    }
+  }
+
   void DestroyReqObj(ServerContext* context) override {
 #ifdef TRPC_PROTO_USE_ARENA
     if constexpr (IsEnablePbArena()) {
@@ -113,6 +125,12 @@ class UnaryRpcMethodHandler : public RpcMethodHandlerInterface {
   void PostExecute(const ServerContextPtr& context, NoncontiguousBuffer& rsp_body) {
     TRPC_CHECK(context->IsResponse());
 
+    EncodeResponse(context, rsp_body);
+  }
+
+  /// @brief Runs the post-invoke filters and encodes the response object of the context into `rsp_body`, which is
+  ///        what `PostExecute` does for the synchronous responses, also used by the responses sent asynchronously.
+  void EncodeResponse(const ServerContextPtr& context, NoncontiguousBuffer& rsp_body) {
     auto& filter_controller = context->GetFilterController();
     filter_controller.RunMessageServerFilters(FilterPoint::SERVER_POST_RPC_INVOKE, context);
 
@@ -200,15 +218,18 @@ class UnaryRpcMethodHandler : public RpcMethodHandlerInterface {
  private:
   bool Serialize(serialization::Serialization* serialization, void* rsp, NoncontiguousBuffer& buff) {
     serialization::DataType type;
-    if constexpr (std::is_convertible_v<RequestType*, google::protobuf::MessageLite*>) {
+    if constexpr (std::is_convertible_v<ResponseType*, google::protobuf::MessageLite*>) {
       type = serialization::kPbMessage;
-    } else if constexpr (std::is_convertible_v<RequestType*, rapidjson::Document*>) {
+    } else if constexpr (std::is_convertible_v<ResponseType*, serialization::PbAliasedMessage*>) {
+      type = serialization::kPbAliasedMessage;
+      rsp = static_cast<serialization::PbAliasedMessage*>(static_cast<ResponseType*>(rsp));
+    } else if constexpr (std::is_convertible_v<ResponseType*, rapidjson::Document*>) {
       type = serialization::kRapidJson;
-    } else if constexpr (std::is_convertible_v<RequestType*, flatbuffers::trpc::MessageFbs*>) {
+    } else if constexpr (std::is_convertible_v<ResponseType*, flatbuffers::trpc::MessageFbs*>) {
       type = serialization::kFlatBuffers;
-    } else if constexpr (std::is_convertible_v<RequestType*, NoncontiguousBuffer*>) {
+    } else if constexpr (std::is_convertible_v<ResponseType*, NoncontiguousBuffer*>) {
       type = serialization::kNonContiguousBufferNoop;
-    } else if constexpr (std::is_convertible_v<RequestType*, std::string*>) {
+    } else if constexpr (std::is_convertible_v<ResponseType*, std::string*>) {
       type = serialization::kStringNoop;
     } else {
       return false;
@@ -221,6 +242,9 @@ class UnaryRpcMethodHandler : public RpcMethodHandlerInterface {
     serialization::DataType type;
     if constexpr (std::is_convertible_v<RequestType*, google::protobuf::MessageLite*>) {
       type = serialization::kPbMessage;
+    } else if constexpr (std::is_convertible_v<RequestType*, serialization::PbAliasedMessage*>) {
+      type = serialization::kPbAliasedMessage;
+      req = static_cast<serialization::PbAliasedMessage*>(static_cast<RequestType*>(req));
     } else if constexpr (std::is_convertible_v<RequestType*, rapidjson::Document*>) {
       type = serialization::kRapidJson;
     } else if constexpr (std::is_convertible_v<RequestType*, flatbuffers::trpc::MessageFbs*>) {
@@ -245,6 +245,15 @@ void ServerContext::SetRealTimeout() {
   SetStateFlag(use_fulllink, kIsUseFulllinkTimeoutMask);
 }
 
+bool ServerContext::IsFullLinkTimeoutExpired(uint64_t now_ms) const {
+  if (invoke_info_.full_link_timeout == UINT32_MAX ||
+      (service_ && service_->GetServiceAdapterOption().disable_request_timeout)) {
+    return false;
+  }
+
+  return GetRecvTimestamp() + invoke_info_.full_link_timeout <= now_ms;
+}
+
 bool ServerContext::CheckHandleTimeout() {
   uint64_t nowms = trpc::time::GetMilliSeconds();
   if (GetRecvTimestamp() + GetTimeout() <= nowms) {
@@ -33,6 +33,7 @@
 #include "trpc/common/status.h"
 #include "trpc/compressor/compressor_type.h"
 #include "trpc/filter/server_filter_controller.h"
+#include "trpc/serialization/pb/pb_aliasing.h"
 #include "trpc/serialization/serialization_type.h"
 #include "trpc/server/method_handler.h"
 #include "trpc/stream/stream_provider.h"
@@ -289,9 +290,18 @@ class ServerContext : public RefCounted<ServerContext> {
   void SetTimeout(uint32_t timeout) {
     if (timeout > 0) {
       invoke_info_.timeout = timeout;
+      invoke_info_.full_link_timeout = timeout;
     }
   }
 
+  /// @brief Get the full link timeout carried in the request by the caller, UINT32_MAX if the caller carried none.
+  uint32_t GetFullLinkTimeout() const { return invoke_info_.full_link_timeout; }
+
+  /// @brief Whether the full link timeout carried in the request has passed, i.e. the caller has given up on it.
+  ///        It's always false if the caller carried no timeout or the request timeout of the service is disabled, the
+  ///        timeout of the service itself is checked by `CheckHandleTimeout`.
+  bool IsFullLinkTimeoutExpired(uint64_t now_ms) const;
+
   /// @brief Whether the server timeout time is the full link timeout time.
   bool IsUseFullLinkTimeout() const { return GetStateFlag(kIsUseFulllinkTimeoutMask); }
 
@@ -515,6 +525,9 @@ class ServerContext : public RefCounted<ServerContext> {
   void SendUnaryResponse(const Status& status, T& biz_rsp) {
     if constexpr (std::is_convertible_v<T*, google::protobuf::MessageLite*>) {
       SendUnaryResponse(status, static_cast<google::protobuf::MessageLite*>(&biz_rsp));
+    } else if constexpr (std::is_convertible_v<T*, serialization::PbAliasedMessage*>) {
+      SendUnaryResponse(status, static_cast<serialization::PbAliasedMessage*>(&biz_rsp),
+                        serialization::kPbAliasedMessage);
     } else if constexpr (std::is_convertible_v<T*, rapidjson::Document*>) {
       SendUnaryResponse(status, static_cast<rapidjson::Document*>(&biz_rsp));
     } else if constexpr (std::is_convertible_v<T*, flatbuffers::trpc::MessageFbs*>) {
@@ -659,6 +672,9 @@ class ServerContext : public RefCounted<ServerContext> {
     // request timeout(ms)
     uint32_t timeout{UINT32_MAX};
 
+    // full link timeout(ms) carried in the request
+    uint32_t full_link_timeout{UINT32_MAX};
+
     // use bits to represent some status flags in the request processing process,
     // from low to high in order:
     // 1. after the rpc interface processing is completed,
@@ -24,9 +24,14 @@
 #include "trpc/coroutine/fiber.h"
 #include "trpc/coroutine/fiber_execution_context.h"
 #include "trpc/filter/server_filter_manager.h"
+#ifdef TRPC_BUILD_INCLUDE_OVERLOAD_CONTROL
+#include "trpc/overload_control/common/request_priority.h"
+#include "trpc/overload_control/overload_control_defs.h"
+#endif
 #include "trpc/runtime/fiber_runtime.h"
 #include "trpc/runtime/init_runtime.h"
 #include "trpc/runtime/iomodel/reactor/fiber/fiber_connection.h"
+#include "trpc/runtime/common/stats/frame_stats.h"
 #include "trpc/runtime/merge_runtime.h"
 #include "trpc/runtime/separate_runtime.h"
 #include "trpc/runtime/threadmodel/merge/merge_thread_model.h"
@@ -77,6 +82,18 @@ FilterStatus RunIoFilters(FilterPoint filter_point, const std::any& msg) noexcep
   }
 }
 
+#ifdef TRPC_BUILD_INCLUDE_OVERLOAD_CONTROL
+// Only the requests tagged with a priority are dispatched by it. The untagged ones keep the default priority of the
+// framework fibers, rather than being taken as the least urgent ones.
+int GetHandleTaskPriority(const ServerContextPtr& context, int default_priority) {
+  const auto& trans_info = context->GetPbReqTransInfo();
+  if (trans_info.find(overload_control::kTransinfoKeyTrpcPriority) == trans_info.end()) {
+    return default_priority;
+  }
+  return overload_control::GetServerPriority(context);
+}
+#endif
+
 }  // namespace
 
 ServiceAdapter::ServiceAdapter(ServiceAdapterOption&& option) : option_(std::move(option)) {
@@ -269,6 +286,25 @@ Service* ServiceAdapter::ChooseService(Protocol* protocol) const {
   return it->second.get();
 }
 
+bool ServiceAdapter::DiscardExpiredRequest(const ServerContextPtr& context) {
+  // Only the full-link timeout carried in the request means that the caller has given up on the request. The request
+  // is dropped without a response, which is done for the protocols not responding to the undecodable requests either,
+  // the others are responded with a timeout error by `CheckTimeoutBeforeProcess` as before.
+  if (!context->GetStatus().OK() || context->NeedResponseWhenDecodeFail() ||
+      !context->IsFullLinkTimeoutExpired(trpc::time::GetMilliSeconds())) {
+    return false;
+  }
+
+  context->GetStatus().SetFrameworkRetCode(
+      server_codec_->GetProtocolRetCode(codec::ServerRetCode::FULL_LINK_TIMEOUT_ERROR));
+  context->GetStatus().SetErrorMessage("request full-link timeout before process, discarded.");
+  FrameStats::GetInstance()->GetServerStats().AddExpiredReqCount();
+
+  TRPC_FMT_ERROR_EVERY_SECOND("request full-link timeout before process, discarded, ip: {}, timeout: {}",
+                              context->GetIp(), context->GetFullLinkTimeout());
+  return true;
+}
+
 bool ServiceAdapter::HandleMessage(const ConnectionPtr& conn, std::deque<std::any>& msg) {
   if (TRPC_UNLIKELY(!service_)) {
     TRPC_FMT_ERROR("handle message failed, service not existed");
@@ -292,8 +328,16 @@ bool ServiceAdapter::HandleMessage(const ConnectionPtr& conn, std::deque<std::an
 
       context->SetBeginTimestampUs(trpc::time::GetMicroSeconds());
 
+      // The error status is set before the filters run, so that they release what they acquired for the request.
+      bool discarded = DiscardExpiredRequest(context);
       RunServerFilters(FilterPoint::SERVER_POST_SCHED_RECV_MSG, req_msg);
 
+      if (discarded) {
+        trpc::object_pool::Delete(req_msg);
+        SetLocalServerContext(nullptr);
+        return;
+      }
+
       STransportRspMsg* send = nullptr;
       Service* service = context->GetService();
       service->HandleTransportMessage(req_msg, &send);
@@ -315,6 +359,21 @@ bool ServiceAdapter::HandleMessage(const ConnectionPtr& conn, std::deque<std::an
 
     MsgTask* task = object_pool::New<MsgTask>();
     task->handler = std::move(msg_handler);
+    task->drop_handler = [this, req_msg]() {
+      // The request waits too long in the overloaded queue of the thread model, so it is rejected as overloaded, the
+      // same as the one failed to be submitted.
+      Status& status = req_msg->context->GetStatus();
+      if (status.OK()) {
+        status.SetFrameworkRetCode(TrpcRetCode::TRPC_SERVER_OVERLOAD_ERR);
+        status.SetErrorMessage("request dropped by the queue management of thread model.");
+      }
+
+      TRPC_FMT_ERROR_EVERY_SECOND("request dropped by the queue management of thread model, service name: {}",
+                                  req_msg->context->GetService()->GetName());
+      RunServerFilters(FilterPoint::SERVER_POST_SCHED_RECV_MSG, req_msg);
+
+      trpc::object_pool::Delete(req_msg);
+    };
     task->group_id = thread_model_->GroupId();
 
     Service* service = req_msg->context->GetService();
@@ -322,6 +381,9 @@ bool ServiceAdapter::HandleMessage(const ConnectionPtr& conn, std::deque<std::an
     if (dispatcher) {
       task->dst_thread_key = dispatcher(req_msg);
     }
+#ifdef TRPC_BUILD_INCLUDE_OVERLOAD_CONTROL
+    task->priority = GetHandleTaskPriority(req_msg->context, task->priority);
+#endif
 
     if (!thread_model_->SubmitHandleTask(task)) {
       auto& context = req_msg->context;
@@ -366,7 +428,16 @@ bool ServiceAdapter::HandleFiberMessage(const ConnectionPtr& conn, std::deque<st
       auto& context = req_msg->context;
       context->SetBeginTimestampUs(trpc::time::GetMicroSeconds());
 
+      // The error status is set before the filters run, so that they release what they acquired for the request.
+      bool discarded = DiscardExpiredRequest(context);
       RunServerFilters(FilterPoint::SERVER_POST_SCHED_RECV_MSG, req_msg);
+
+      if (discarded) {
+        trpc::object_pool::Delete(req_msg);
+        conn->Deref();
+        return;
+      }
+
       SetLocalServerContext(req_msg->context);
 
       STransportRspMsg* send = nullptr;
@@ -405,6 +476,9 @@ bool ServiceAdapter::HandleFiberMessage(const ConnectionPtr& conn, std::deque<st
     if (dispatcher) {
       task->dst_thread_key = dispatcher(req_msg);
     }
+#ifdef TRPC_BUILD_INCLUDE_OVERLOAD_CONTROL
+    task->priority = GetHandleTaskPriority(req_msg->context, task->priority);
+#endif
 
     bool result = thread_model_->SubmitHandleTask(task);
     if (!result) {
@@ -463,7 +537,10 @@ void ServiceAdapter::FillBindInfo(trpc::BindInfo& bind_info) {
   bind_info.recv_buffer_size = option_.recv_buffer_size;
   bind_info.send_queue_capacity = option_.send_queue_capacity;
   bind_info.send_queue_timeout = option_.send_queue_timeout;
+  bind_info.send_queue_high_watermark = option_.send_queue_high_watermark;
+  bind_info.send_queue_low_watermark = option_.send_queue_low_watermark;
   bind_info.accept_thread_num = option_.accept_thread_num;
+  bind_info.reuseport_cpu_steering = option_.reuseport_cpu_steering;
   bind_info.accept_function = service_->GetAcceptConnectionFunction();
   bind_info.dispatch_accept_function = service_->GetDispatchAcceptConnectionFunction();
   bind_info.conn_establish_function = service_->GetConnectionEstablishFunction();
@@ -108,6 +108,7 @@ class ServiceAdapter {
   STransportReqMsg* CreateSTransportReqMsg(const ConnectionPtr& conn, uint64_t recv_timestamp_us,
                                            std::any&& msg);
   Service* ChooseService(Protocol* protocol) const;
+  bool DiscardExpiredRequest(const ServerContextPtr& context);
   void AddServiceFilter(ServerFilterController& filter_controller, const MessageServerFilterPtr& filter);
 
  private:
@@ -86,9 +86,21 @@ struct ServiceAdapterOption {
   /// Use in fiber runtime
   uint32_t send_queue_timeout{3000};
 
+  /// The data(bytes) cached in the io-send queue of a connection to pause reading from it and suspend the senders
+  /// If set 0, not enabled
+  uint32_t send_queue_high_watermark{0};
+
+  /// The data(bytes) the io-send queue drains to for resuming the connection
+  /// If set 0, half of `send_queue_high_watermark` is used
+  uint32_t send_queue_low_watermark{0};
+
   /// The number of threads(fibers) listening on the port
   uint32_t accept_thread_num{1};
 
+  /// Whether to steer the new connections to the acceptors running on the cpu receiving them
+  /// Use in fiber runtime
+  bool reuseport_cpu_steering{false};
+
   /// The thread model type use by service, deprecated.
   std::string threadmodel_type;
 
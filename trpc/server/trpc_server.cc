@@ -24,6 +24,7 @@
 #include "trpc/coroutine/fiber.h"
 #include "trpc/runtime/common/heartbeat/heartbeat_report.h"
 #include "trpc/runtime/common/stats/frame_stats.h"
+#include "trpc/runtime/iomodel/reactor/common/listen_fd_handoff.h"
 #include "trpc/runtime/runtime.h"
 #include "trpc/runtime/threadmodel/thread_model.h"
 #include "trpc/util/chrono/time.h"
@@ -70,7 +71,10 @@ void TrpcServer::BuildServiceAdapterOption(const ServiceConfig& config, ServiceA
   option.recv_buffer_size = config.recv_buffer_size;
   option.send_queue_capacity = config.send_queue_capacity;
   option.send_queue_timeout = config.send_queue_timeout;
+  option.send_queue_high_watermark = config.send_queue_high_watermark;
+  option.send_queue_low_watermark = config.send_queue_low_watermark;
   option.accept_thread_num = config.accept_thread_num;
+  option.reuseport_cpu_steering = config.reuseport_cpu_steering;
   option.threadmodel_type = config.threadmodel_type;
   option.threadmodel_instance_name = config.threadmodel_instance_name;
   option.stream_read_timeout = config.stream_read_timeout;
@@ -161,10 +165,18 @@ ServiceAdapterPtr TrpcServer::BuildServiceAdapter(const ServiceConfig& config) {
 }
 
 bool TrpcServer::Start() {
+  const std::string& handoff_path = server_config_.listen_fd_handoff_path;
+  bool inherited = false;
+  if (!handoff_path.empty()) {
+    // Takes over the listening sockets from the process being replaced, which stops gracefully once acknowledged.
+    inherited = ListenFdHandoff::GetInstance()->Receive(handoff_path) >= 0;
+  }
+
   for (const auto& iter : service_adapters_) {
     if (iter.second->IsAutoStart()) {
       TRPC_FMT_INFO("Service {} auto-start to listen ...", iter.first);
       if (!iter.second->Listen()) {
+        ListenFdHandoff::GetInstance()->Abandon();
         return false;
       }
 
@@ -174,6 +186,14 @@ bool TrpcServer::Start() {
     }
   }
 
+  if (!handoff_path.empty()) {
+    ListenFdHandoff::GetInstance()->CloseInherited();
+    // The process replaced keeps serving on the path if it gave up waiting, it's left to hand the sockets over next.
+    if (!inherited || ListenFdHandoff::GetInstance()->Acknowledge()) {
+      ListenFdHandoff::GetInstance()->Serve(handoff_path, [this] { listen_fds_handed_off_ = true; });
+    }
+  }
+
   state_ = ServerState::kStart;
 
   return true;
@@ -196,6 +216,11 @@ void TrpcServer::WaitForShutdown() {
         terminate_ = true;
       }
     }
+
+    if (listen_fds_handed_off_.load(std::memory_order_acquire)) {
+      TRPC_LOG_INFO("listening sockets handed over, stop gracefully.");
+      terminate_ = true;
+    }
   }
 
   Stop();
@@ -204,12 +229,16 @@ void TrpcServer::WaitForShutdown() {
 }
 
 void TrpcServer::Stop() {
+  ListenFdHandoff::GetInstance()->StopServe();
+
   if (TrpcConfig::GetInstance()->GetGlobalConfig().heartbeat_config.enable_heartbeat) {
     HeartBeatReport::GetInstance()->Stop();
   }
 
+  // The process taking the listening sockets over is registered on the same addresses, which are kept registered.
+  bool handed_off = listen_fds_handed_off_.load(std::memory_order_acquire);
   for (const auto& iter : service_adapters_) {
-    if (!server_config_.registry_name.empty()) {
+    if (!server_config_.registry_name.empty() && !handed_off) {
       TRPC_LOG_DEBUG(iter.first << " start to UnregisterName...");
       UnregisterName(iter.second);
     }
@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -157,6 +158,9 @@ class TrpcServer {
 
   ServerState state_{ServerState::kUnInitialize};
 
+  // whether the listening sockets are handed over to the process replacing it on hot restart
+  std::atomic<bool> listen_fds_handed_off_{false};
+
   // the function to stop the server
   ServerTerminateFunction terminate_function_;
 
@@ -16,6 +16,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include "trpc/future/future.h"
 #include "trpc/runtime/threadmodel/thread_model.h"
@@ -74,6 +75,12 @@ class ClientTransport {
   virtual bool ReleaseFixedConnector(uint64_t connector_id) { return false; }
 
   virtual void Disconnect(const std::string& target_ip) {}
+
+  /// @brief Establish the connections to the nodes ahead of the requests, and keep at least so many connections to
+  ///        each node open when the idle connections are closed, it does not wait for the connections established
+  /// @param nodes The nodes added to the callee
+  /// @param conn_num The number of connections to each node
+  virtual void Prewarm(const std::vector<NodeAddr>& nodes, uint32_t conn_num) {}
 };
 
 }  // namespace trpc
@@ -22,7 +22,7 @@ bool FiberBackupRequestRetry::IsReplyReady() {
 }
 
 bool FiberBackupRequestRetry::IsFailedCountUpToAll() {
-  return (failed_count_.fetch_add(1, std::memory_order_relaxed) == (retry_times_ - 1));
+  return (failed_count_.fetch_add(1, std::memory_order_acq_rel) == (retry_times_ - 1));
 }
 
 bool FiberBackupRequestRetry::IsFinished() { return is_finished_; }
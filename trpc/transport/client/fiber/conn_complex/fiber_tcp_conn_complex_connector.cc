@@ -276,6 +276,7 @@ bool FiberTcpConnComplexConnector::SaveCallContext(CTransportReqMsg* req_msg, CT
   ctx->request_id = request_id;
   ctx->backup_request_retry_info = req_msg->context->GetBackupRequestRetryInfo();
   ctx->on_completion_function = std::move(cb);
+  inflight_count_.fetch_add(1, std::memory_order_relaxed);
 
   ctx->timeout_timer = CreateTimer(request_id, req_msg->context->GetTimeout());
   EnableFiberTimer(ctx->timeout_timer);
@@ -308,6 +309,7 @@ void FiberTcpConnComplexConnector::DispatchException(uint32_t request_id, int re
   if (auto t = std::exchange(ctx->timeout_timer, 0)) {
     KillFiberTimer(t);
   }
+  inflight_count_.fetch_sub(1, std::memory_order_relaxed);
 
   TRPC_ASSERT(UnsafeRefCount() > 0);
   err_msg += ", request_id: ";
@@ -323,6 +325,7 @@ void FiberTcpConnComplexConnector::DispatchException(object_pool::LwUniquePtr<Ca
   if (auto t = std::exchange(ctx->timeout_timer, 0)) {
     KillFiberTimer(t);
   }
+  inflight_count_.fetch_sub(1, std::memory_order_relaxed);
   ctx->on_completion_function(ret, std::move(err_msg));
 }
 
@@ -330,6 +333,7 @@ void FiberTcpConnComplexConnector::DispatchResponse(object_pool::LwUniquePtr<Cal
   if (auto t = std::exchange(ctx->timeout_timer, 0)) {
     KillFiberTimer(t);
   }
+  inflight_count_.fetch_sub(1, std::memory_order_relaxed);
 
   if (options_.trans_info->run_client_filters_function) {
     options_.trans_info->run_client_filters_function(FilterPoint::CLIENT_PRE_SCHED_RECV_MSG, ctx->req_msg);
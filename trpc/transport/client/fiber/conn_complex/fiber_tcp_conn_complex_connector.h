@@ -69,6 +69,12 @@ class FiberTcpConnComplexConnector final : public RefCounted<FiberTcpConnComplex
 
   Connection* GetConnection() { return connection_.Get(); }
 
+  /// @brief Gets the number of the requests waiting for their responses.
+  uint32_t GetInflightCount() const { return inflight_count_.load(std::memory_order_relaxed); }
+
+  /// @brief Gets the bytes of the requests queued to be sent.
+  std::size_t GetSendQueueSize() const { return connection_ != nullptr ? connection_->GetSendQueueSize() : 0; }
+
  private:
   bool MessageHandleFunction(const ConnectionPtr& conn, std::deque<std::any>& rsp_list);
   void ConnectionCleanFunction(Connection* conn);
@@ -92,6 +98,8 @@ class FiberTcpConnComplexConnector final : public RefCounted<FiberTcpConnComplex
   RefPtr<FiberTcpConnection> connection_;
 
   RefPtr<CallMap> call_map_;
+
+  std::atomic<uint32_t> inflight_count_{0};
 };
 
 }  // namespace trpc
@@ -166,8 +166,21 @@ stream::StreamReaderWriterProviderPtr FiberTcpConnComplexConnectorGroup::CreateS
 
 RefPtr<FiberTcpConnComplexConnector> FiberTcpConnComplexConnectorGroup::GetOrCreate() {
   size_t index = index_.fetch_add(1, std::memory_order_relaxed);
-  size_t uid = index % max_conn_num_;
+  size_t uid = SelectLessLoaded(index % max_conn_num_, max_conn_num_, [this](size_t i) { return GetLoad(i); });
 
+  return GetOrCreate(uid);
+}
+
+std::pair<uint32_t, size_t> FiberTcpConnComplexConnectorGroup::GetLoad(size_t uid) {
+  Hazptr hazptr;
+  auto ptr = hazptr.Keep(&(conn_impl_[uid].impl));
+  if (ptr == nullptr || ptr->tcp_conn == nullptr || !ptr->tcp_conn->IsHealthy()) {
+    return {0, 0};
+  }
+  return {ptr->tcp_conn->GetInflightCount(), ptr->tcp_conn->GetSendQueueSize()};
+}
+
+RefPtr<FiberTcpConnComplexConnector> FiberTcpConnComplexConnectorGroup::GetOrCreate(size_t uid) {
   RefPtr<FiberTcpConnComplexConnector> connector{nullptr};
   {
     Hazptr hazptr;
@@ -16,10 +16,12 @@
 #include <atomic>
 #include <memory>
 #include <mutex>
+#include <utility>
 #include <vector>
 
 #include "trpc/transport/client/fiber/conn_complex/fiber_tcp_conn_complex_connector.h"
 #include "trpc/transport/client/fiber/fiber_connector_group.h"
+#include "trpc/util/algorithm/random.h"
 #include "trpc/util/hazptr/hazptr.h"
 #include "trpc/util/hazptr/hazptr_object.h"
 #include "trpc/util/ref_ptr.h"
@@ -56,8 +58,27 @@ class FiberTcpConnComplexConnectorGroup final : public FiberConnectorGroup {
 
   bool DelConnector(FiberTcpConnComplexConnector* connector);
 
+  /// @brief Selects the less loaded of two among `conn_num` connections, the one in turn `uid` and a random other one,
+  ///        so that a connection slowed down by a slow stream or a large request gets less requests.
+  /// @param get_load Gets the comparable load of a connection by its index.
+  /// @return The index of the selected connection, `uid` if the loads are equal or it is the only connection.
+  template <class GetLoadFunction>
+  static size_t SelectLessLoaded(size_t uid, size_t conn_num, GetLoadFunction&& get_load) {
+    if (conn_num <= 1) {
+      return uid;
+    }
+
+    size_t other_uid = (uid + trpc::Random<size_t>(1, conn_num - 1)) % conn_num;
+    return get_load(other_uid) < get_load(uid) ? other_uid : uid;
+  }
+
  private:
   RefPtr<FiberTcpConnComplexConnector> GetOrCreate();
+  RefPtr<FiberTcpConnComplexConnector> GetOrCreate(size_t uid);
+
+  // The load of a connection by its inflight requests first and then its bytes queued to be sent.
+  // The load of an unavailable connection is zero, so it is recreated once selected.
+  std::pair<uint32_t, size_t> GetLoad(size_t uid);
   RefPtr<FiberTcpConnComplexConnector> CreateTcpConnComplexConnector(uint64_t conn_id);
 
  private:
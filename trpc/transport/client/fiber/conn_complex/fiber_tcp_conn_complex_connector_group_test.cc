@@ -0,0 +1,74 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#include "trpc/transport/client/fiber/conn_complex/fiber_tcp_conn_complex_connector_group.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace trpc::testing {
+
+using Load = std::pair<uint32_t, size_t>;
+
+TEST(FiberTcpConnComplexConnectorGroupTest, SelectLessLoaded) {
+  // The loads of the connections, by the inflight requests first and then the bytes to be sent.
+  std::vector<Load> loads{{3, 0}, {0, 0}, {1, 100}, {1, 0}};
+  auto get_load = [&loads](size_t uid) { return loads[uid]; };
+
+  for (int i = 0; i < 100; ++i) {
+    // The idle connection is always chosen, whichever the random other one is.
+    ASSERT_EQ(FiberTcpConnComplexConnectorGroup::SelectLessLoaded(1, loads.size(), get_load), 1);
+
+    // The connection in turn is replaced by a less loaded one, which is never the busiest.
+    size_t uid = FiberTcpConnComplexConnectorGroup::SelectLessLoaded(0, loads.size(), get_load);
+    ASSERT_NE(uid, 0);
+
+    uid = FiberTcpConnComplexConnectorGroup::SelectLessLoaded(2, loads.size(), get_load);
+    ASSERT_LE(loads[uid], loads[2]);
+  }
+
+  // With two connections the other one is known.
+  std::vector<Load> two_loads{{2, 0}, {1, 0}};
+  auto get_two_loads = [&two_loads](size_t uid) { return two_loads[uid]; };
+  ASSERT_EQ(FiberTcpConnComplexConnectorGroup::SelectLessLoaded(0, two_loads.size(), get_two_loads), 1);
+  ASSERT_EQ(FiberTcpConnComplexConnectorGroup::SelectLessLoaded(1, two_loads.size(), get_two_loads), 1);
+
+  // The bytes to be sent break the tie of the inflight requests.
+  two_loads = {{1, 100}, {1, 0}};
+  ASSERT_EQ(FiberTcpConnComplexConnectorGroup::SelectLessLoaded(0, two_loads.size(), get_two_loads), 1);
+
+  // The connection in turn is kept on a tie.
+  two_loads = {{1, 0}, {1, 0}};
+  ASSERT_EQ(FiberTcpConnComplexConnectorGroup::SelectLessLoaded(0, two_loads.size(), get_two_loads), 0);
+  ASSERT_EQ(FiberTcpConnComplexConnectorGroup::SelectLessLoaded(1, two_loads.size(), get_two_loads), 1);
+}
+
+TEST(FiberTcpConnComplexConnectorGroupTest, SelectSingleConnection) {
+  int get_load_count = 0;
+  auto get_load = [&get_load_count](size_t) {
+    ++get_load_count;
+    return Load{0, 0};
+  };
+
+  // The only connection is used without comparing the loads.
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_EQ(FiberTcpConnComplexConnectorGroup::SelectLessLoaded(0, 1, get_load), 0);
+  }
+  ASSERT_EQ(get_load_count, 0);
+}
+
+}  // namespace trpc::testing
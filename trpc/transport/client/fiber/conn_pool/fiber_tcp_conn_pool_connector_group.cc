@@ -13,11 +13,15 @@
 
 #include "trpc/transport/client/fiber/conn_pool/fiber_tcp_conn_pool_connector_group.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
 
 #include "trpc/coroutine/fiber_event.h"
+#include "trpc/coroutine/fiber_timer.h"
 #include "trpc/stream/stream.h"
 #include "trpc/transport/client/fiber/common/fiber_client_connection_handler.h"
+#include "trpc/util/chrono/chrono.h"
 #include "trpc/util/log/logging.h"
 
 namespace trpc {
@@ -31,6 +35,15 @@ FiberTcpConnPoolConnectorGroup::FiberTcpConnPoolConnectorGroup(const FiberConnec
 FiberTcpConnPoolConnectorGroup::~FiberTcpConnPoolConnectorGroup() {}
 
 void FiberTcpConnPoolConnectorGroup::Stop() {
+  {
+    std::scoped_lock _(reap_state_->mutex);
+    reap_state_->stopped = true;
+    if (reap_state_->timer_id != 0) {
+      KillFiberTimer(reap_state_->timer_id);
+      reap_state_->timer_id = 0;
+    }
+  }
+
   for (uint32_t i = 0; i != options_.trans_info->fiber_connpool_shards; ++i) {
     auto&& shard = conn_shards_[i];
 
@@ -229,7 +242,8 @@ RefPtr<FiberTcpConnPoolConnector> FiberTcpConnPoolConnectorGroup::GetOrCreate()
         shard.tcp_conns.pop_back();
 
         if (connector->IsHealthy()) {
-          if (!connector->IsConnIdleTimeout()) {
+          if (!connector->IsConnIdleTimeout() ||
+              long_conn_num_.load(std::memory_order_relaxed) <= options_.trans_info->min_conn_num) {
             return connector;
           } else {
             idle_connector = connector;
@@ -243,7 +257,9 @@ RefPtr<FiberTcpConnPoolConnector> FiberTcpConnPoolConnectorGroup::GetOrCreate()
     }
 
     if (idle_connector != nullptr) {
+      long_conn_num_.fetch_sub(1, std::memory_order_relaxed);
       idle_connector->CloseConnection();
+      idle_connector = nullptr;
     }
 
     --retry_num;
@@ -267,18 +283,107 @@ void FiberTcpConnPoolConnectorGroup::Reclaim(int ret, RefPtr<FiberTcpConnPoolCon
     uint32_t shard_id = (connector->GetConnId() >> 32);
     auto& shard = conn_shards_[shard_id % options_.trans_info->fiber_connpool_shards];
 
-    std::scoped_lock _(shard.lock);
-    if ((shard.tcp_conns.size() <= max_conn_per_shard_) &&
-        (long_conn_num_.load(std::memory_order_relaxed) <= options_.trans_info->max_conn_num)) {
+    RefPtr<FiberTcpConnPoolConnector> idle_connector{nullptr};
+    {
+      std::scoped_lock _(shard.lock);
+      if ((shard.tcp_conns.size() > max_conn_per_shard_) ||
+          (long_conn_num_.load(std::memory_order_relaxed) > options_.trans_info->max_conn_num)) {
+        long_conn_num_.fetch_sub(1, std::memory_order_relaxed);
+        connector->CloseConnection();
+        return;
+      }
+
       shard.tcp_conns.push_back(std::move(connector));
-      return;
+
+      // The connections are taken from the back, so the front one is the least recently used, reap it if idle.
+      auto& front = shard.tcp_conns.front();
+      if (shard.tcp_conns.size() > 1 && front->IsConnIdleTimeout() &&
+          long_conn_num_.load(std::memory_order_relaxed) > options_.trans_info->min_conn_num) {
+        idle_connector = std::move(front);
+        shard.tcp_conns.pop_front();
+        long_conn_num_.fetch_sub(1, std::memory_order_relaxed);
+      }
     }
+
+    if (idle_connector != nullptr) {
+      idle_connector->CloseConnection();
+    }
+    return;
   }
 
   long_conn_num_.fetch_sub(1, std::memory_order_relaxed);
   connector->CloseConnection();
 }
 
+void FiberTcpConnPoolConnectorGroup::Prewarm(uint32_t conn_num) {
+  if (options_.trans_info->conn_type == ConnectionType::kTcpShort) {
+    return;
+  }
+
+  StartReapTimer();
+
+  conn_num = std::min(conn_num, options_.trans_info->max_conn_num);
+  uint32_t num = long_conn_num_.load(std::memory_order_relaxed);
+  while (num < conn_num) {
+    // Counts the connection before it is established, so that the concurrent prewarming does not overshoot.
+    if (!long_conn_num_.compare_exchange_weak(num, num + 1, std::memory_order_relaxed)) {
+      continue;
+    }
+
+    RefPtr<FiberTcpConnPoolConnector> connector = CreateTcpConnPoolConnector(shard_id_gen_.fetch_add(1));
+    if (!connector->Init()) {
+      long_conn_num_.fetch_sub(1, std::memory_order_relaxed);
+      TRPC_FMT_ERROR("Prewarm connection failed, peer addr: {}", options_.peer_addr.ToString());
+      return;
+    }
+
+    Reclaim(0, std::move(connector));
+    num = long_conn_num_.load(std::memory_order_relaxed);
+  }
+}
+
+void FiberTcpConnPoolConnectorGroup::StartReapTimer() {
+  uint32_t idle_timeout = options_.trans_info->connection_idle_timeout;
+  if (idle_timeout == 0) {
+    return;
+  }
+
+  std::scoped_lock _(reap_state_->mutex);
+  if (reap_state_->stopped || reap_state_->timer_id != 0) {
+    return;
+  }
+
+  // Without it, the idle connections are reaped only when the connections are given back.
+  auto interval = std::chrono::milliseconds(idle_timeout);
+  reap_state_->timer_id = SetFiberTimer(ReadSteadyClock() + interval, interval, [this, state = reap_state_]() {
+    std::scoped_lock _(state->mutex);
+    if (!state->stopped) {
+      ReapIdleConnections();
+    }
+  });
+}
+
+void FiberTcpConnPoolConnectorGroup::ReapIdleConnections() {
+  for (uint32_t i = 0; i != options_.trans_info->fiber_connpool_shards; ++i) {
+    auto& shard = conn_shards_[i];
+
+    std::list<RefPtr<FiberTcpConnPoolConnector>> idle_conns;
+    {
+      std::scoped_lock _(shard.lock);
+      // The connections are taken from the back, so the least recently used ones are at the front.
+      while (!shard.tcp_conns.empty() && shard.tcp_conns.front()->IsConnIdleTimeout() &&
+             long_conn_num_.load(std::memory_order_relaxed) > options_.trans_info->min_conn_num) {
+        idle_conns.splice(idle_conns.end(), shard.tcp_conns, shard.tcp_conns.begin());
+        long_conn_num_.fetch_sub(1, std::memory_order_relaxed);
+      }
+    }
+
+    for (const auto& connector : idle_conns) {
+      connector->CloseConnection();
+    }
+  }
+}
+
 RefPtr<FiberTcpConnPoolConnector> FiberTcpConnPoolConnectorGroup::CreateTcpConnPoolConnector(uint32_t shard_id) {
   uint64_t conn_id = static_cast<uint64_t>(shard_id) << 32;
   conn_id |= connector_id_gen_.fetch_add(1, std::memory_order_relaxed);
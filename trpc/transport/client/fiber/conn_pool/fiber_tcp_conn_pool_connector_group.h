@@ -13,10 +13,12 @@
 
 #pragma once
 
+#include <cstdint>
 #include <list>
 #include <memory>
 #include <mutex>
 
+#include "trpc/coroutine/fiber_mutex.h"
 #include "trpc/transport/client/fiber/conn_pool/fiber_tcp_conn_pool_connector.h"
 #include "trpc/transport/client/fiber/fiber_connector_group.h"
 #include "trpc/util/ref_ptr.h"
@@ -51,10 +53,14 @@ class FiberTcpConnPoolConnectorGroup final : public FiberConnectorGroup {
 
   stream::StreamReaderWriterProviderPtr CreateStream(stream::StreamOptions&& stream_options) override;
 
+  void Prewarm(uint32_t conn_num) override;
+
  private:
   RefPtr<FiberTcpConnPoolConnector> GetOrCreate();
   RefPtr<FiberTcpConnPoolConnector> CreateTcpConnPoolConnector(uint32_t shard_id);
   void Reclaim(int ret, RefPtr<FiberTcpConnPoolConnector>&& connector);
+  void StartReapTimer();
+  void ReapIdleConnections();
 
  private:
   FiberConnectorGroup::Options options_;
@@ -72,7 +78,18 @@ class FiberTcpConnPoolConnectorGroup final : public FiberConnectorGroup {
   std::atomic<uint32_t> shard_id_gen_{0};
   std::atomic<uint32_t> connector_id_gen_{0};
 
+  // The number of long connections, not less than `min_conn_num` of the trans info once prewarmed, the idle ones
+  // beyond it are closed when they are found at the least recently used end of a shard.
   std::atomic<uint32_t> long_conn_num_{0};
+
+  // The timer which reaps the idle connections of the prewarmed group. Its callbacks may run after the group is
+  // stopped, so they share the state and check it under the lock.
+  struct ReapState {
+    FiberMutex mutex;
+    bool stopped{false};
+    uint64_t timer_id{0};
+  };
+  std::shared_ptr<ReapState> reap_state_{std::make_shared<ReapState>()};
 };
 
 }  // namespace trpc
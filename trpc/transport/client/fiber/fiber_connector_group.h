@@ -65,6 +65,10 @@ class FiberConnectorGroup {
     TRPC_FMT_ERROR("stream is not implement.");
     return nullptr;
   }
+
+  /// @brief Establishes connections until the number of connections reaches `conn_num`, supported by the connection
+  ///        pool only.
+  virtual void Prewarm(uint32_t conn_num) {}
 };
 
 }  // namespace trpc
@@ -13,8 +13,11 @@
 
 #include "trpc/transport/client/fiber/fiber_transport.h"
 
+#include <mutex>
+#include <shared_mutex>
 #include <string>
 
+#include "trpc/client/request_budget.h"
 #include "trpc/coroutine/fiber.h"
 #include "trpc/runtime/fiber_runtime.h"
 // #include "trpc/stream/fiber_stream_connection_handler.h"
@@ -31,6 +34,11 @@ int FiberTransport::Init(Options&& params) {
 }
 
 void FiberTransport::Stop() {
+  {
+    std::unique_lock lock(prewarm_state_->mutex);
+    prewarm_state_->stopped = true;
+  }
+
   if (connector_group_manager_) {
     connector_group_manager_->Stop();
   }
@@ -79,6 +87,7 @@ int FiberTransport::SendRecvFromOutSide(CTransportReqMsg* req_msg, CTransportRsp
 
 int FiberTransport::SendRecvForBackupRequest(CTransportReqMsg* req_msg, CTransportRspMsg* rsp_msg) {
   int ret_code = TrpcRetCode::TRPC_INVOKE_UNKNOWN_ERR;
+  int first_ret_code = TrpcRetCode::TRPC_INVOKE_UNKNOWN_ERR;
 
   BackupRequestRetryInfo* backup_info = req_msg->context->GetBackupRequestRetryInfo();
   backup_info->IncrCount();
@@ -94,7 +103,7 @@ int FiberTransport::SendRecvForBackupRequest(CTransportReqMsg* req_msg, CTranspo
   NoncontiguousBuffer buff_back(req_msg->send_data);
 
   for (int i = 0; i < 2; ++i) {
-    auto cb = [&ret_code, i, backup_info, sync_retry](int err_code, std::string&& err_msg) {
+    auto cb = [&ret_code, &first_ret_code, i, backup_info, sync_retry](int err_code, std::string&& err_msg) {
       if (sync_retry->IsFinished()) {
         return;
       }
@@ -104,6 +113,9 @@ int FiberTransport::SendRecvForBackupRequest(CTransportReqMsg* req_msg, CTranspo
         backup_info->succ_rsp_node_index = i;
         sync_retry->SetFinished();
       } else {
+        if (i == 0) {
+          first_ret_code = err_code;
+        }
         if (sync_retry->IsFailedCountUpToAll()) {
           ret_code = err_code;
           backup_info->succ_rsp_node_index = -1;
@@ -130,6 +142,18 @@ int FiberTransport::SendRecvForBackupRequest(CTransportReqMsg* req_msg, CTranspo
         req_msg->context->SetTimeout(timeout - backup_info->delay);
         req_msg->send_data = std::move(buff_back);
       }
+
+      // Out of the budget of the backup requests, the backup request is counted as failed without being sent, and the
+      // response of the first request is waited for only.
+      if (backup_info->budget && !backup_info->budget->TryAcquire()) {
+        if (sync_retry->IsFailedCountUpToAll()) {
+          ret_code = first_ret_code;
+          backup_info->succ_rsp_node_index = -1;
+          sync_retry->SetFinished();
+        }
+        sync_retry->Wait();
+        return ret_code;
+      }
       backup_info->resend_count += 1;
     } else {
       sync_retry->Wait();
@@ -232,4 +256,27 @@ stream::StreamReaderWriterProviderPtr FiberTransport::CreateStream(const NodeAdd
   return nullptr;
 }
 
+void FiberTransport::Prewarm(const std::vector<NodeAddr>& nodes, uint32_t conn_num) {
+  if (conn_num == 0) {
+    return;
+  }
+
+  bool start_ret = StartFiberDetached([this, state = prewarm_state_, nodes, conn_num]() {
+    for (const auto& node : nodes) {
+      std::shared_lock lock(state->mutex);
+      if (state->stopped) {
+        return;
+      }
+
+      FiberConnectorGroup* connector_group = connector_group_manager_->Get(node);
+      if (connector_group) {
+        connector_group->Prewarm(conn_num);
+      }
+    }
+  });
+  if (!start_ret) {
+    TRPC_FMT_ERROR("Prewarm {} backends failed.", nodes.size());
+  }
+}
+
 }  // namespace trpc
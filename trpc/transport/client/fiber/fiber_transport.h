@@ -15,7 +15,9 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "trpc/coroutine/fiber_shared_mutex.h"
 #include "trpc/stream/stream.h"
 #include "trpc/transport/client/client_transport.h"
 #include "trpc/transport/client/fiber/fiber_connector_group_manager.h"
@@ -70,6 +72,11 @@ class FiberTransport final : public ClientTransport {
   stream::StreamReaderWriterProviderPtr CreateStream(const NodeAddr& addr,
                                                      stream::StreamOptions&& stream_options) override;
 
+  /// @brief Establish connections to the nodes in a detached fiber, see `ClientTransport::Prewarm`.
+  /// @note The fiber gives up the remaining nodes once the transport is stopped, and `Stop` waits for the node being
+  ///       prewarmed.
+  void Prewarm(const std::vector<NodeAddr>& nodes, uint32_t conn_num) override;
+
  private:
   int SendRecvFromOutSide(CTransportReqMsg* req_msg, CTransportRspMsg* rsp_msg);
   Future<CTransportRspMsg> AsyncSendRecvFromOutSide(CTransportReqMsg* req_msg);
@@ -78,6 +85,14 @@ class FiberTransport final : public ClientTransport {
 
  private:
   std::unique_ptr<FiberConnectorGroupManager> connector_group_manager_;
+
+  // The prewarming fibers may outlive the transport, so they share the state, they hold the shared lock while using
+  // the connector groups, and `Stop` takes the exclusive lock.
+  struct PrewarmState {
+    FiberSharedMutex mutex;
+    bool stopped{false};
+  };
+  std::shared_ptr<PrewarmState> prewarm_state_{std::make_shared<PrewarmState>()};
 };
 
 }  // namespace trpc
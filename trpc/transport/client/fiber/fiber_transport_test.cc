@@ -19,6 +19,7 @@
 
 #include "gtest/gtest.h"
 
+#include "trpc/client/request_budget.h"
 #include "trpc/client/testing/client_context_testing.h"
 #include "trpc/codec/client_codec_factory.h"
 #include "trpc/codec/codec_manager.h"
@@ -261,6 +262,22 @@ TEST_F(FiberTransportFixture, testSendRecv_normal) {
   SendRecv(udp_pool_transport);
 }
 
+// Test that all the requests go through the only connection of a tcp-conn-complex transport
+TEST_F(FiberTransportFixture, testSendRecv_single_conn_complex) {
+  FiberTransport::Options single_conn_opt;
+  single_conn_opt.trans_info = MakeTransInfo(true);
+  single_conn_opt.trans_info.max_conn_num = 1;
+  auto single_conn_transport = std::make_unique<FiberTransport>();
+  single_conn_transport->Init(std::move(single_conn_opt));
+
+  for (int i = 0; i < 10; ++i) {
+    SendRecv(single_conn_transport);
+  }
+
+  single_conn_transport->Stop();
+  single_conn_transport->Destroy();
+}
+
 // Test the test cases for sending and receiving packets normally on non-fiber worker threads
 // under different connection modes of transport
 TEST_F(FiberTransportFixture, testSendRecv_normal_outside) {
@@ -839,6 +856,83 @@ TEST_F(FiberTransportFixture, testBackupRequest_first_fail) {
   BackupRequestWhenFirstFailed(tcp_pipeline_transport);
 }
 
+void BackupRequestWhenOutOfBudget(std::unique_ptr<FiberTransport>& transport, bool first_failed) {
+  uint32_t seq_id = FiberTransportFixture::id_gen.fetch_add(1);
+  ClientContextPtr context = trpc::testing::MakeTestClientContext(seq_id, 1000,
+      FiberTransportFixture::fake_server->GetServerAddr());
+
+  std::vector<NodeAddr> backup_addrs;
+  if (first_failed) {
+    trpc::NodeAddr addr;
+    addr.addr_type = trpc::NodeAddr::AddrType::kIpV4;
+    addr.ip = "127.0.0.1";
+    addr.port = 16008;
+    backup_addrs.push_back(addr);
+  } else {
+    backup_addrs.push_back(FiberTransportFixture::fake_server->GetServerNodeAddr());
+  }
+  backup_addrs.push_back(FiberTransportFixture::fake_backup_server->GetServerNodeAddr());
+
+  context->SetBackupRequestDelay(10);
+  context->SetBackupRequestAddrs(backup_addrs);
+
+  RequestBudget budget(0);
+  while (budget.TryAcquire()) {
+  }
+  context->GetBackupRequestRetryInfo()->budget = &budget;
+
+  trpc::CTransportReqMsg req_msg;
+  req_msg.context = context;
+
+  trpc::testing::TestProtocol out;
+  out.req_id_ = seq_id;
+  out.body_ = "backup request sleep";
+
+  trpc::NoncontiguousBuffer buff;
+  out.ZeroCopyEncode(buff);
+
+  req_msg.send_data = std::move(buff);
+
+  trpc::CTransportRspMsg rsp_msg;
+
+  int ret = transport->SendRecv(&req_msg, &rsp_msg);
+
+  ASSERT_EQ(0, context->GetBackupRequestRetryInfo()->resend_count);
+  if (first_failed) {
+    ASSERT_NE(ret, 0);
+    ASSERT_EQ(-1, context->GetBackupRequestRetryInfo()->succ_rsp_node_index);
+    return;
+  }
+
+  ASSERT_EQ(ret, 0);
+
+  auto rsp_protocol = std::any_cast<trpc::ProtocolPtr&&>(std::move(rsp_msg.msg));
+  auto* rsp = static_cast<trpc::testing::TestProtocol*>(rsp_protocol.get());
+
+  ASSERT_EQ("hello", rsp->body_);
+  ASSERT_EQ(0, context->GetBackupRequestRetryInfo()->succ_rsp_node_index);
+}
+
+// Test the test case of sending and receiving packets on the fiber worker thread
+// and enabling backuprequest in different connection modes of transport
+// The backup request is not sent as the budget runs out, and the response of the first request is returned
+TEST_F(FiberTransportFixture, testBackupRequest_out_of_budget) {
+  std::cout << "tcp_complex_transport" << std::endl;
+
+  BackupRequestWhenOutOfBudget(tcp_complex_transport, false);
+  BackupRequestWhenOutOfBudget(tcp_complex_transport, true);
+
+  std::cout << "tcp_pool_transport" << std::endl;
+
+  BackupRequestWhenOutOfBudget(tcp_pool_transport, false);
+  BackupRequestWhenOutOfBudget(tcp_pool_transport, true);
+
+  std::cout << "tcp_pipeline_transport" << std::endl;
+
+  BackupRequestWhenOutOfBudget(tcp_pipeline_transport, false);
+  BackupRequestWhenOutOfBudget(tcp_pipeline_transport, true);
+}
+
 void BackupRequestWhenBothFailed(std::unique_ptr<FiberTransport>& transport) {
   uint32_t seq_id = FiberTransportFixture::id_gen.fetch_add(1);
   ClientContextPtr context = trpc::testing::MakeTestClientContext(seq_id, 1000,
@@ -31,6 +31,8 @@ struct FutureConnectorGroupOptions {
   NetworkAddress::IpType ip_type;
   // Which manager belongs to.
   FutureConnectorGroupManager* conn_group_manager = nullptr;
+  // Number of io threads, each of them has its own connector group to the backend.
+  uint32_t io_thread_num = 1;
 };
 
 /// @brief Atributes of future connector.
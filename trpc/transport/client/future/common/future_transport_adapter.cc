@@ -24,6 +24,7 @@ FutureTransportAdapter::FutureTransportAdapter(const Options& options) : options
   FutureConnectorGroupManager::Options manager_options;
   manager_options.reactor = options_.reactor;
   manager_options.trans_info = options_.trans_info;
+  manager_options.io_thread_num = options_.io_thread_num;
   if (options_.trans_info->conn_type != ConnectionType::kUdp) {
     group_manager_ = std::make_unique<FutureTcpConnectorGroupManager>(manager_options);
   } else {
@@ -102,4 +103,28 @@ void FutureTransportAdapter::Disconnect(const std::string& target_ip) {
   }
 }
 
+void FutureTransportAdapter::Prewarm(const std::vector<NodeAddr>& nodes, uint32_t conn_num) {
+  if (group_manager_ == nullptr) {
+    return;
+  }
+
+  Reactor::Task task = [this, nodes, conn_num]() {
+    if (transport_state_.load(std::memory_order_acquire) != ClientTransportState::kInitialized) {
+      return;
+    }
+
+    for (const auto& node : nodes) {
+      FutureConnectorGroup* connector_group = group_manager_->GetConnectorGroup(node);
+      if (connector_group) {
+        connector_group->Prewarm(conn_num);
+      }
+    }
+  };
+
+  bool ret = options_.reactor->SubmitTask2(std::move(task));
+  if (!ret) {
+    TRPC_FMT_ERROR("Prewarm {} backends failed.", nodes.size());
+  }
+}
+
 }  // namespace trpc
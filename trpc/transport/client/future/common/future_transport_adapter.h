@@ -14,6 +14,8 @@
 #pragma once
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "trpc/runtime/iomodel/reactor/reactor.h"
 #include "trpc/transport/client/common/client_transport_state.h"
@@ -29,6 +31,8 @@ class FutureTransportAdapter {
   struct Options {
     Reactor* reactor{nullptr};
     TransInfo* trans_info{nullptr};
+    // Number of io threads, each of them has its own adapter.
+    uint32_t io_thread_num{1};
   };
 
   /// @brief Constructor.
@@ -58,6 +62,11 @@ class FutureTransportAdapter {
   /// @param target_ip Target ip.
   void Disconnect(const std::string& target_ip);
 
+  /// @brief Establish the connections to the backends on the io thread.
+  /// @param nodes Target backends.
+  /// @param conn_num Number of connections to each backend.
+  void Prewarm(const std::vector<NodeAddr>& nodes, uint32_t conn_num);
+
  private:
   // Adapter options.
   Options options_;
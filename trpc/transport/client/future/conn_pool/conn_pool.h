@@ -30,6 +30,9 @@
 namespace trpc {
 
 /// @brief Connection pool to manage a group of connectors.
+/// @note The connector ids are allocated on demand up to the max connection number, and the recycled ones are reused
+///       first, so the pool grows with the concurrency rather than the max connection number, and the connections
+///       recycled earliest are left idle to be closed.
 template <typename T>
 class ConnPool {
  public:
@@ -82,10 +85,10 @@ class ConnPool {
 
   /// @brief Check there is no established connection in connection pool or not.
   /// @return true: no established connection, false: at least one established connection.
-  bool IsEmpty() { return max_conn_num_ == free_.size(); }
+  bool IsEmpty() { return connectors_.size() == free_.size(); }
 
-  /// @brief Get the number of free connector.
-  int SizeOfFree() { return free_.size(); }
+  /// @brief Get the number of free connector, including those not allocated yet.
+  int SizeOfFree() { return free_.size() + (max_conn_num_ - connectors_.size()); }
 
   /// @brief Add request message into pending timeout queue.
   /// @param req_msg Request message.
@@ -108,7 +111,7 @@ class ConnPool {
   // Max connector number.
   uint64_t max_conn_num_;
 
-  // Queue of connector id.
+  // Queue of the recycled connector ids, the last recycled one is reused first.
   std::deque<uint64_t> free_;
 
   // Whether specialized connector id is inside free_ queue.
@@ -122,23 +125,13 @@ class ConnPool {
   // Function for request timeout handling in pending queue.
   Function<void(const internal::SmallCacheTimingWheelTimeoutQueue::DataIterator&)> timeout_handle_function_;
 
-  // All the connectors.
+  // All the connectors, indexed by the connector ids allocated so far.
   std::vector<std::unique_ptr<T>> connectors_;
 };
 
 template <typename T>
 ConnPool<T>::ConnPool(const FutureConnectorGroupOptions& options)
     : options_(options), max_conn_num_(options.trans_info->max_conn_num) {
-  connectors_.resize(max_conn_num_);
-  is_in_.resize(max_conn_num_);
-
-  // Connector id starts from 0.
-  for (uint64_t i = 0; i < max_conn_num_; ++i) {
-    connectors_[i] = nullptr;
-    free_.push_back(i);
-    is_in_[i] = true;
-  }
-
   timeout_handle_function_ = [this](const internal::SmallCacheTimingWheelTimeoutQueue::DataIterator& iter) {
     CTransportReqMsg* msg = this->pending_queue_.GetAndPop(iter);
 
@@ -164,9 +157,17 @@ ConnPool<T>::ConnPool(const FutureConnectorGroupOptions& options)
 
 template <typename T>
 uint64_t ConnPool<T>::GenAvailConnectorId() {
-  // All the connector ids is assigned.
   if (free_.empty()) {
-    return kInvalidConnId;
+    // All the connector ids is assigned.
+    if (connectors_.size() >= max_conn_num_) {
+      return kInvalidConnId;
+    }
+
+    // Connector id starts from 0.
+    uint64_t conn_id = connectors_.size();
+    connectors_.emplace_back(nullptr);
+    is_in_.push_back(false);
+    return conn_id;
   }
 
   uint64_t conn_id = *(free_.rbegin());
@@ -266,7 +267,7 @@ void ConnPool<T>::Stop() {
                               options_.trans_info->rsp_dispatch_function);
   }
 
-  for (uint64_t i = 0; i < max_conn_num_; ++i) {
+  for (uint64_t i = 0; i < connectors_.size(); ++i) {
     if (connectors_[i]) {
       connectors_[i]->Stop();
     }
@@ -275,7 +276,7 @@ void ConnPool<T>::Stop() {
 
 template <typename T>
 void ConnPool<T>::Destroy() {
-  for (uint64_t i = 0; i < max_conn_num_; ++i) {
+  for (uint64_t i = 0; i < connectors_.size(); ++i) {
     if (connectors_[i]) {
       connectors_[i]->Destroy();
       connectors_[i] = nullptr;
@@ -71,20 +71,22 @@ TransInfo ConnPoolFixture::trans_info_;
 std::unique_ptr<ReactorImpl> ConnPoolFixture::reactor_ = nullptr;
 
 TEST_F(ConnPoolFixture, FlowTest) {
-  EXPECT_TRUE(conn_pool_->GetConnectors().size() >= trans_info_.max_conn_num);
+  // The connector slots are allocated on demand.
+  EXPECT_TRUE(conn_pool_->GetConnectors().empty());
   EXPECT_EQ(conn_pool_->SizeOfFree(), trans_info_.max_conn_num);
   EXPECT_TRUE(conn_pool_->IsEmpty());
 
   // Add a connection to the connection pool.
   uint64_t conn_id1 = conn_pool_->GenAvailConnectorId();
-  EXPECT_EQ(conn_id1, 1);
+  EXPECT_EQ(conn_id1, 0);
+  EXPECT_EQ(conn_pool_->GetConnectors().size(), 1);
   auto mock_conn1 = std::make_unique<TestFutureConnector>(FutureConnectorOptions{});
   EXPECT_TRUE(conn_pool_->AddConnector(conn_id1, std::move(mock_conn1)));
   EXPECT_TRUE(conn_pool_->GetConnector(conn_id1) != nullptr);
 
   // Add a connection to the connection pool again.
   uint64_t conn_id2 = conn_pool_->GenAvailConnectorId();
-  EXPECT_EQ(conn_id2, 0);
+  EXPECT_EQ(conn_id2, 1);
   auto mock_conn2 = std::make_unique<TestFutureConnector>(FutureConnectorOptions{});
   EXPECT_TRUE(conn_pool_->AddConnector(conn_id2, std::move(mock_conn2)));
   EXPECT_TRUE(conn_pool_->GetConnector(conn_id2) != nullptr);
@@ -104,6 +106,10 @@ TEST_F(ConnPoolFixture, FlowTest) {
   conn_pool_->DelConnector(conn_id1);
   conn_pool_->DelConnector(conn_id2);
   EXPECT_EQ(conn_pool_->SizeOfFree(), 2);
+  EXPECT_TRUE(conn_pool_->IsEmpty());
+
+  // The last recycled connector id is reused first.
+  EXPECT_EQ(conn_pool_->GenAvailConnectorId(), conn_id2);
 }
 
 TEST_F(ConnPoolFixture, PendingQueue) {
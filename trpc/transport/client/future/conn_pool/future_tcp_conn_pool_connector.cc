@@ -83,17 +83,19 @@ void FutureTcpConnPoolConnector::HandleSendQueueTimeout(CTransportReqMsg* req_ms
 
 void FutureTcpConnPoolConnector::HandlePendingQueueTimeout() { msg_timeout_handler_.HandlePendingQueueTimeout(); }
 
-void FutureTcpConnPoolConnector::HandleIdleConnection(uint64_t now_ms) {
+bool FutureTcpConnPoolConnector::HandleIdleConnection(uint64_t now_ms) {
   if (connection_ == nullptr || options_.group_options->trans_info->connection_idle_timeout == 0) {
-    return;
+    return false;
   }
 
   if (now_ms > connection_->GetConnActiveTime() &&
       now_ms - connection_->GetConnActiveTime() >= options_.group_options->trans_info->connection_idle_timeout) {
     if (msg_timeout_handler_.IsSendQueueEmpty()) {
       connection_->DoClose(true);
+      return true;
     }
   }
+  return false;
 }
 
 int FutureTcpConnPoolConnector::SendReqMsgImpl(CTransportReqMsg* req_msg) {
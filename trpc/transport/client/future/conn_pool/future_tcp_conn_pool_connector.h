@@ -62,7 +62,8 @@ class FutureTcpConnPoolConnector : public FutureConnector {
   void HandlePendingQueueTimeout();
 
   /// @brief Handle function when connection idle for a certain time.
-  void HandleIdleConnection(uint64_t now_ms);
+  /// @return true: the connection is closed, false: the connection is kept.
+  bool HandleIdleConnection(uint64_t now_ms);
 
   /// @brief Check connection idle or not.
   bool IsConnectionIdle() {
@@ -13,6 +13,8 @@
 
 #include "trpc/transport/client/future/conn_pool/future_tcp_conn_pool_connector_group.h"
 
+#include <algorithm>
+
 #include "trpc/transport/client/fixed_connector_id.h"
 #include "trpc/transport/client/future/future_connector_group_manager.h"
 #include "trpc/util/object_pool/object_pool_ptr.h"
@@ -234,11 +236,21 @@ void FutureTcpConnPoolConnectorGroup::HandleIdleConnection() {
 
   uint32_t alive_connector_num = 0;
   const auto& connectors = conn_pool_.GetConnectors();
-  uint64_t now_ms = trpc::time::GetMilliSeconds();
   for (auto& conn : connectors) {
     if (conn) {
       alive_connector_num++;
-      conn->HandleIdleConnection(now_ms);
+    }
+  }
+
+  // Keep at least the share of `min_conn_num` of this io thread, even if they are idle. Prewarming spreads them over
+  // the io threads, and the share is rounded up so none of the prewarmed ones is closed.
+  uint32_t io_thread_num = std::max(options_.io_thread_num, 1u);
+  uint32_t min_conn_num = (options_.trans_info->min_conn_num + io_thread_num - 1) / io_thread_num;
+  uint32_t closable_num = alive_connector_num > min_conn_num ? alive_connector_num - min_conn_num : 0;
+  uint64_t now_ms = trpc::time::GetMilliSeconds();
+  for (std::size_t i = 0; i < connectors.size() && closable_num > 0; ++i) {
+    if (connectors[i] && connectors[i]->HandleIdleConnection(now_ms)) {
+      closable_num--;
     }
   }
 
@@ -250,6 +262,39 @@ void FutureTcpConnPoolConnectorGroup::HandleIdleConnection() {
   }
 }
 
+void FutureTcpConnPoolConnectorGroup::Prewarm(uint32_t conn_num) {
+  uint32_t alive_connector_num = 0;
+  for (auto& conn : conn_pool_.GetConnectors()) {
+    if (conn) {
+      alive_connector_num++;
+    }
+  }
+
+  // Hold the allocated ids until the end, so that the connected ones reused are not counted twice.
+  std::vector<uint64_t> conn_ids;
+  while (alive_connector_num < conn_num) {
+    uint64_t conn_id = conn_pool_.GenAvailConnectorId();
+    if (conn_id == TcpConnPool::kInvalidConnId) {
+      break;
+    }
+
+    conn_ids.push_back(conn_id);
+    if (conn_pool_.GetConnector(conn_id) != nullptr) {
+      continue;
+    }
+
+    if (GetOrCreateConnector(conn_id) == nullptr) {
+      TRPC_FMT_ERROR("Prewarm connection failed, target: {}", options_.peer_addr.ToString());
+      break;
+    }
+    alive_connector_num++;
+  }
+
+  for (uint64_t conn_id : conn_ids) {
+    conn_pool_.RecycleConnectorId(conn_id);
+  }
+}
+
 stream::StreamReaderWriterProviderPtr FutureTcpConnPoolConnectorGroup::CreateStream(
     stream::StreamOptions&& stream_options) {
   uint64_t conn_id = conn_pool_.GenAvailConnectorId();
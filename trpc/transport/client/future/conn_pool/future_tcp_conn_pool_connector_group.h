@@ -56,6 +56,9 @@ class FutureTcpConnPoolConnectorGroup : public FutureConnectorGroup {
   /// @brief Create stream.
   stream::StreamReaderWriterProviderPtr CreateStream(stream::StreamOptions&& stream_options) override;
 
+  /// @brief Establish connections until the number of connections reaches `conn_num`.
+  void Prewarm(uint32_t conn_num) override;
+
  private:
   /// @brief Get connector by connector id, create if necessary.
   FutureTcpConnPoolConnector* GetOrCreateConnector(uint64_t conn_id);
@@ -70,6 +70,11 @@ class FutureConnectorGroup {
   /// @note Will retry if send failed.
   virtual int SendOnly(CTransportReqMsg* req_msg) = 0;
 
+  /// @brief Establish connections ahead of the requests, and keep at least so many open when closing idle ones.
+  /// @param conn_num Number of connections.
+  /// @note Only supported by the connection pool.
+  virtual void Prewarm(uint32_t conn_num) {}
+
  protected:
   // Group options.
   FutureConnectorGroupOptions options_;
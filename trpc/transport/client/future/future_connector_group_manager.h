@@ -27,6 +27,8 @@ class FutureConnectorGroupManager {
   struct Options {
     Reactor* reactor{nullptr};
     TransInfo* trans_info{nullptr};
+    // Number of io threads, each of them has its own manager.
+    uint32_t io_thread_num{1};
   };
 
   /// @brief Constructor.
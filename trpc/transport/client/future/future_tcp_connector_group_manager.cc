@@ -94,6 +94,7 @@ FutureConnectorGroup* FutureTcpConnectorGroupManager::GetConnectorGroup(const No
     FutureConnectorGroupOptions connector_group_options;
     connector_group_options.reactor = options_.reactor;
     connector_group_options.trans_info = options_.trans_info;
+    connector_group_options.io_thread_num = options_.io_thread_num;
     connector_group_options.peer_addr =
         NetworkAddress(std::string_view(node_addr.ip), node_addr.port,
                        node_addr.addr_type == NodeAddr::AddrType::kIpV6 ? NetworkAddress::IpType::kIpV6
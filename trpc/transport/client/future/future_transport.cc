@@ -17,6 +17,7 @@
 #include <tuple>
 #include <utility>
 
+#include "trpc/client/request_budget.h"
 #include "trpc/future/future_utility.h"
 #include "trpc/runtime/merge_runtime.h"
 #include "trpc/runtime/separate_runtime.h"
@@ -48,6 +49,7 @@ int FutureTransport::Init(Options&& options) {
     FutureTransportAdapter::Options transport_adapter_option;
     transport_adapter_option.reactor = reactor;
     transport_adapter_option.trans_info = &(options_.trans_info);
+    transport_adapter_option.io_thread_num = reactors.size();
 
     adapters_.emplace_back(std::make_unique<FutureTransportAdapter>(std::move(transport_adapter_option)));
   }
@@ -195,6 +197,19 @@ void FutureTransport::Disconnect(const std::string& target_ip) {
   }
 }
 
+void FutureTransport::Prewarm(const std::vector<NodeAddr>& nodes, uint32_t conn_num) {
+  if (adapters_.empty() || conn_num == 0) {
+    return;
+  }
+
+  // Each io thread owns its connections to a backend, so they are spread over the io threads.
+  uint32_t adapter_num = adapters_.size();
+  for (uint32_t i = 0; i < adapter_num && i < conn_num; ++i) {
+    uint32_t adapter_conn_num = conn_num / adapter_num + (i < conn_num % adapter_num ? 1 : 0);
+    adapters_[i]->Prewarm(nodes, adapter_conn_num);
+  }
+}
+
 stream::StreamReaderWriterProviderPtr FutureTransport::CreateStream(const NodeAddr& addr,
                                                                     stream::StreamOptions&& stream_options) {
   auto current_thread = WorkerThread::GetCurrentWorkerThread();
@@ -403,6 +418,20 @@ Future<CTransportRspMsg> FutureTransport::AsyncSendRecvForBackupRequest(CTranspo
       return MakeReadyFuture<>();
     }
 
+    // Out of the budget of the backup requests, the response of the first request is waited for only.
+    RequestBudget* budget = msg_context->GetBackupRequestRetryInfo()->budget;
+    if (budget && !budget->TryAcquire()) {
+      return res_fut_first.Then([final_promise = std::move(final_promise)](Future<CTransportRspMsg>&& fut) mutable {
+        if (fut.IsReady()) {
+          final_promise.SetValue(fut.GetValue0());
+        } else {
+          final_promise.SetException(fut.GetException());
+        }
+
+        return MakeReadyFuture<>();
+      });
+    }
+
     bool first_failed = res_fut_first.IsFailed();
     auto vecs = SendBackupRequest(msg_context, std::move(res_fut_first), id, is_blocking_invoke, std::move(send_data));
     return WhenAnyWithoutException(vecs.begin(), vecs.end())
@@ -76,6 +76,11 @@ class FutureTransport final : public ClientTransport {
   /// @param target_ip Target ip.
   void Disconnect(const std::string& target_ip) override;
 
+  /// @brief Establish the connections to the nodes, spread over the io threads.
+  /// @param nodes Target backends.
+  /// @param conn_num Number of connections to each backend.
+  void Prewarm(const std::vector<NodeAddr>& nodes, uint32_t conn_num) override;
+
   /// @brief Create stream.
   /// @param node_addr Backend address.
   /// @param stream_options Options of stream.
@@ -21,6 +21,7 @@
 #include "gtest/gtest.h"
 
 #include "trpc/client/client_context.h"
+#include "trpc/client/request_budget.h"
 #include "trpc/common/future/future_utility.h"
 #include "trpc/stream/stream_handler_manager.h"
 #include "trpc/transport/client/future/testing/fake_trpc_server.h"
@@ -154,12 +155,14 @@ class FutureTransportImplTest : public ::testing::Test {
   void BackupRequestSecondSuccessWithResend(std::unique_ptr<FutureTransport>& transport);
   // Responses for both requests have returned.
   void BackupRequestBothSuccessWithResend(std::unique_ptr<FutureTransport>& transport);
+  // No backup request is sent as the budget of the backup requests runs out.
+  void BackupRequestOutOfBudget(std::unique_ptr<FutureTransport>& transport);
   // Implementation of the backup request calling process, which is used by the above interface. The first parameter
   // returned is the number of retries for the backup request, and the second parameter is the index of the successful
   // request (0 or 1). If the second parameter is 0, it means the first request succeeded, and if it is 1, it means the
   // backup request succeeded.
   std::pair<uint32_t, int> BackupRequestSuccess(std::unique_ptr<FutureTransport>& transport,
-                                                const std::string& request_msg);
+                                                const std::string& request_msg, RequestBudget* budget = nullptr);
 
   // Called the wrong backend node.
   void BackupRequestBothFailedWhenEndpointError(std::unique_ptr<FutureTransport>& transport);
@@ -552,7 +555,8 @@ void FutureTransportImplTest::DisConnect(bool is_complex_conn, bool support_pipe
 }
 
 std::pair<uint32_t, int> FutureTransportImplTest::BackupRequestSuccess(std::unique_ptr<FutureTransport>& transport,
-                                                                       const std::string& request_msg) {
+                                                                       const std::string& request_msg,
+                                                                       RequestBudget* budget) {
   ExtendNodeAddr first_extend_addr;
   NodeAddr first_node = fake_trpc_server.GetBindAddr();
   first_extend_addr.addr = first_node;
@@ -573,6 +577,7 @@ std::pair<uint32_t, int> FutureTransportImplTest::BackupRequestSuccess(std::uniq
       EncodeTrpcRequestProtocol(first_node, request_msg, request_id);
   construct_req_msg->context->SetBackupRequestDelay(20);
   construct_req_msg->context->SetBackupRequestAddrsByNaming(std::move(extend_addrs));
+  construct_req_msg->context->GetBackupRequestRetryInfo()->budget = budget;
   auto context = construct_req_msg->context;
   auto future = transport->AsyncSendRecv(construct_req_msg.Leak())
                     .Then([&request_msg, request_id](Future<CTransportRspMsg>&& fut) {
@@ -686,6 +691,18 @@ void FutureTransportImplTest::BackupRequestBothSuccessWithResend(std::unique_ptr
   EXPECT_EQ(success_index, 0);
 }
 
+// The first request did not succeed within the resend time, but the budget of the backup requests runs out, so the
+// response of the first request is waited for only.
+void FutureTransportImplTest::BackupRequestOutOfBudget(std::unique_ptr<FutureTransport>& transport) {
+  RequestBudget budget(0);
+  while (budget.TryAcquire()) {
+  }
+
+  auto [resend_count, success_index] = BackupRequestSuccess(transport, kBothSuccessWithResend, &budget);
+  EXPECT_EQ(resend_count, 0);
+  EXPECT_EQ(success_index, 0);
+}
+
 // Call the wrong backend nodes.
 void FutureTransportImplTest::BackupRequestBothFailedWhenEndpointError(std::unique_ptr<FutureTransport>& transport) {
   auto [resend_count, success_index] = BackupRequestBothFailed(transport, kBothRequestFailWithResend, true);
@@ -1007,6 +1024,18 @@ TEST_F(FutureTransportImplTest, testBackupRequest_both_success_with_resend) {
   BackupRequestFirstSuccessWithResend(tcp_pipeline_transport);
 }
 
+// The first request did not succeed within the resend time, but no backup request was sent as the budget ran out.
+TEST_F(FutureTransportImplTest, testBackupRequest_out_of_budget) {
+  COUT << "tcp_complex_transport" << std::endl;
+  BackupRequestOutOfBudget(tcp_complex_transport);
+
+  COUT << "tcp_pool_transport" << std::endl;
+  BackupRequestOutOfBudget(tcp_pool_transport);
+
+  COUT << "tcp_pipeline_transport" << std::endl;
+  BackupRequestOutOfBudget(tcp_pipeline_transport);
+}
+
 // The request failed as it called two incorrect nodes.
 TEST_F(FutureTransportImplTest, testBackupRequest_both_failed_when_endpoint_error) {
   COUT << "tcp_complex_transport" << std::endl;
@@ -26,6 +26,8 @@
 
 namespace trpc {
 
+class RequestBudget;
+
 // @brief An interface representing the ability to issue a synchronous backup request (retry).
 class BackupRequestRetryBase {
  public:
@@ -61,6 +63,10 @@ struct alignas(8) BackupRequestRetryInfo : public object_pool::EnableLwSharedFro
 
   // A controller who issues synchronous backup requests.
   BackupRequestRetryBase* retry{nullptr};
+
+  // Budget of the backup requests, which is taken right before the backup request is sent, and the backup request is
+  // not sent if it runs out. Unlimited if null.
+  RequestBudget* budget{nullptr};
 };
 
 namespace object_pool {
@@ -56,6 +56,10 @@ struct TransInfo {
   /// Max connection num
   uint32_t max_conn_num = 64;
 
+  /// Min connection num kept to each backend by the connection pool, the idle connections beyond it are closed.
+  /// The connections are established in advance when the backend is discovered if greater than 0.
+  uint32_t min_conn_num = 0;
+
   /// Whether to use connection multiplexing
   bool is_complex_conn = true;
 
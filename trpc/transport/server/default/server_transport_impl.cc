@@ -273,6 +273,7 @@ bool ServerTransportImpl::AcceptConnection(AcceptConnectionInfo& connection_info
     conn->SetConnId(conn_id);
     conn->SetConnType(ConnectionType::kTcpLong);
     conn->SetMaxPacketSize(bind_info_.max_packet_size);
+    conn->SetSendQueueWatermark(bind_info_.send_queue_high_watermark, bind_info_.send_queue_low_watermark);
     conn->SetPeerIp(connection_info.conn_info.remote_addr.Ip());
     conn->SetPeerPort(connection_info.conn_info.remote_addr.Port());
     conn->SetPeerIpType(connection_info.conn_info.remote_addr.Type());
@@ -62,6 +62,9 @@ class FiberBindAdapter : public RefCounted<FiberBindAdapter> {
 
   FiberServerTransportImpl* GetTransport() { return transport_; }
 
+  /// @brief Get the tcp acceptors, in the order of listening
+  const std::vector<RefPtr<FiberAcceptor>>& GetAcceptors() const { return acceptors_; }
+
  private:
   RefPtr<FiberTcpConnection> GetConnection(uint64_t conn_id);
   bool BindTcp();
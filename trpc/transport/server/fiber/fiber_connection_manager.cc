@@ -45,6 +45,9 @@ void FiberConnectionManager::Add(uint64_t conn_id, const RefPtr<FiberTcpConnecti
   (void)it;  // Suppresses compilation warnings.
 
   TRPC_ASSERT(inserted && "insert FiberConnectionManager with Duplicate conn_id");
+
+  // Checked by the next idle check, which re-arms it to its deadline.
+  shard.idle_wheel.Arm(conn_id, conn->GetConnActiveTime());
 }
 
 RefPtr<FiberTcpConnection> FiberConnectionManager::Del(uint64_t conn_id) {
@@ -76,18 +79,27 @@ RefPtr<FiberTcpConnection> FiberConnectionManager::Get(uint64_t conn_id) {
 void FiberConnectionManager::GetIdles(uint32_t idle_timeout, std::vector<RefPtr<FiberTcpConnection>>& idle_conns) {
   TRPC_ASSERT(conn_shards_ && "conn_shards_ is null");
   uint64_t current_time = trpc::time::GetMilliSeconds();
+  std::vector<uint64_t> due_conn_ids;
 
   for (size_t i = 0; i < kShards; ++i) {
     auto&& shard = conn_shards_[i];
 
     std::scoped_lock _(shard.lock);
-    auto it = shard.map.begin();
-    while (it != shard.map.end()) {
-      if (it->second->GetConnActiveTime() + idle_timeout < current_time) {
+    due_conn_ids.clear();
+    shard.idle_wheel.Expire(current_time, due_conn_ids);
+    for (uint64_t conn_id : due_conn_ids) {
+      auto it = shard.map.find(conn_id);
+      if (it == shard.map.end()) {
+        // Removed since it was armed.
+        continue;
+      }
+
+      uint64_t deadline = it->second->GetConnActiveTime() + idle_timeout;
+      if (deadline < current_time) {
         idle_conns.emplace_back(std::move(it->second));
-        it = shard.map.erase(it);
+        shard.map.erase(it);
       } else {
-        ++it;
+        shard.idle_wheel.Arm(conn_id, deadline);
       }
     }
   }
@@ -114,6 +126,7 @@ void FiberConnectionManager::Stop() {
     {
       std::scoped_lock _(shard.lock);
       shard.map.swap(temp);
+      shard.idle_wheel.Clear();
     }
     auto it = temp.begin();
     while (it != temp.end()) {
@@ -135,6 +148,7 @@ void FiberConnectionManager::Destroy() {
     {
       std::scoped_lock _(shard.lock);
       shard.map.swap(temp);
+      shard.idle_wheel.Clear();
     }
     auto it = temp.begin();
     while (it != temp.end()) {
@@ -19,6 +19,7 @@
 #include <vector>
 
 #include "trpc/runtime/iomodel/reactor/fiber/fiber_tcp_connection.h"
+#include "trpc/transport/server/fiber/idle_connection_wheel.h"
 #include "trpc/util/align.h"
 #include "trpc/util/ref_ptr.h"
 
@@ -36,6 +37,8 @@ class FiberConnectionManager {
 
   RefPtr<FiberTcpConnection> Get(uint64_t conn_id);
 
+  /// @brief Takes the connections idle for more than `idle_timeout`(ms). Only the connections due in the idle wheels
+  /// are visited, those active since they were armed are re-armed to their deadline.
   void GetIdles(uint32_t idle_timeout, std::vector<RefPtr<FiberTcpConnection>>& idle_conns);
 
   void Stop();
@@ -48,6 +51,7 @@ class FiberConnectionManager {
   struct alignas(hardware_destructive_interference_size) ConnectionShard {
     std::mutex lock;
     std::unordered_map<uint64_t, RefPtr<FiberTcpConnection>> map;
+    IdleConnectionWheel idle_wheel;
   };
 
   constexpr static size_t kShards = 128;
@@ -17,9 +17,11 @@
 #include <cstddef>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "trpc/runtime/common/stats/frame_stats.h"
 #include "trpc/runtime/fiber_runtime.h"
+#include "trpc/runtime/iomodel/reactor/common/socket.h"
 #include "trpc/runtime/iomodel/reactor/fiber/fiber_acceptor.h"
 #include "trpc/runtime/iomodel/reactor/fiber/fiber_reactor.h"
 #include "trpc/runtime/iomodel/reactor/fiber/fiber_tcp_connection.h"
@@ -62,9 +64,65 @@ bool FiberServerTransportImpl::Listen() {
 #endif
   }
 
+#if defined(SO_REUSEPORT) && !defined(TRPC_DISABLE_REUSEPORT)
+  if (bind_info_.reuseport_cpu_steering) {
+    SetReusePortCpuSteering();
+  }
+#endif
+
   return true;
 }
 
+void FiberServerTransportImpl::SetReusePortCpuSteering() {
+  // The acceptors join the reuseport group in the order of listening. Each cpu bound to a scheduling group selects the
+  // acceptors of the group in turn, the cpus shared by several groups or not bound are left to the kernel's hash.
+  constexpr int kShared = -2;
+  std::vector<int> socket_index_of_cpu;
+  std::vector<int> group_of_cpu;
+  int socket_index = 0;
+  int listen_fd = -1;
+  for (std::size_t i = 0; i < bind_adapters_.size(); ++i) {
+    const auto& acceptors = bind_adapters_[i]->GetAcceptors();
+    if (acceptors.empty()) {
+      continue;
+    }
+    if (listen_fd < 0) {
+      listen_fd = acceptors.front()->GetFd();
+    }
+
+    const std::vector<unsigned>& affinity = fiber::GetSchedulingGroupAffinity(i);
+    for (std::size_t j = 0; j < affinity.size(); ++j) {
+      std::size_t cpu = affinity[j];
+      if (cpu >= socket_index_of_cpu.size()) {
+        socket_index_of_cpu.resize(cpu + 1, -1);
+        group_of_cpu.resize(cpu + 1, -1);
+      }
+      if (group_of_cpu[cpu] >= 0 && group_of_cpu[cpu] != static_cast<int>(i)) {
+        group_of_cpu[cpu] = kShared;
+      }
+      if (group_of_cpu[cpu] == kShared) {
+        socket_index_of_cpu[cpu] = -1;
+        continue;
+      }
+      group_of_cpu[cpu] = static_cast<int>(i);
+      socket_index_of_cpu[cpu] = socket_index + static_cast<int>(j % acceptors.size());
+    }
+    socket_index += static_cast<int>(acceptors.size());
+  }
+
+  if (std::none_of(socket_index_of_cpu.begin(), socket_index_of_cpu.end(), [](int index) { return index >= 0; })) {
+    TRPC_FMT_WARN("reuseport_cpu_steering of {}:{} ignored, the scheduling groups are not bound to distinct cpus.",
+                  bind_info_.ip, bind_info_.port);
+    return;
+  }
+
+  Socket listen_socket(listen_fd, bind_info_.is_ipv6 ? AF_INET6 : AF_INET);
+  if (!listen_socket.SetReusePortCpuSteering(socket_index_of_cpu)) {
+    TRPC_FMT_WARN("reuseport_cpu_steering of {}:{} failed, connections are dispatched by hash.", bind_info_.ip,
+                  bind_info_.port);
+  }
+}
+
 void FiberServerTransportImpl::Stop() {
   for (auto& adapter : bind_adapters_) {
     adapter->Stop();
@@ -148,6 +206,7 @@ bool FiberServerTransportImpl::AcceptConnection(AcceptConnectionInfo& connection
   conn->SetRecvBufferSize(bind_info_.recv_buffer_size);
   conn->SetSendQueueCapacity(bind_info_.send_queue_capacity);
   conn->SetSendQueueTimeout(bind_info_.send_queue_timeout);
+  conn->SetSendQueueWatermark(bind_info_.send_queue_high_watermark, bind_info_.send_queue_low_watermark);
   conn->SetPeerIp(connection_info.conn_info.remote_addr.Ip());
   conn->SetPeerPort(connection_info.conn_info.remote_addr.Port());
   conn->SetPeerIpType(connection_info.conn_info.remote_addr.Type());
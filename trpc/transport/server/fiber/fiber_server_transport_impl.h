@@ -54,6 +54,9 @@ class FiberServerTransportImpl final : public ServerTransport {
 
   void DoClose(const CloseConnectionInfo& close_connection_info) override;
 
+ private:
+  void SetReusePortCpuSteering();
+
  private:
   std::vector<RefPtr<FiberBindAdapter>> bind_adapters_;
 
@@ -0,0 +1,48 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#include "trpc/transport/server/fiber/idle_connection_wheel.h"
+
+#include <algorithm>
+
+namespace trpc {
+
+void IdleConnectionWheel::Arm(uint64_t conn_id, uint64_t deadline_ms) {
+  uint64_t tick = std::clamp(deadline_ms / tick_ms_, next_tick_, next_tick_ + kSlots - 1);
+  slots_[tick % kSlots].push_back(conn_id);
+}
+
+void IdleConnectionWheel::Expire(uint64_t now_ms, std::vector<uint64_t>& conn_ids) {
+  uint64_t end = now_ms / tick_ms_ + 1;
+  if (end <= next_tick_) {
+    return;
+  }
+
+  // Catches up with the ticks passed since the last call, a full turn visits every slot.
+  uint64_t begin = std::max(next_tick_, end > kSlots ? end - kSlots : 0);
+  for (uint64_t tick = begin; tick != end; ++tick) {
+    auto& slot = slots_[tick % kSlots];
+    conn_ids.insert(conn_ids.end(), slot.begin(), slot.end());
+    slot.clear();
+  }
+  next_tick_ = end;
+}
+
+void IdleConnectionWheel::Clear() {
+  for (auto& slot : slots_) {
+    slot.clear();
+  }
+}
+
+}  // namespace trpc
@@ -0,0 +1,56 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace trpc {
+
+/// @brief Coarse-grained timing wheel of the idle deadlines of connections, so the idle check only visits the
+/// connections whose deadline is due instead of all of them.
+///
+/// The connections are re-armed lazily: reads and writes only update the active time of a connection, and the owner
+/// re-arms a due connection to its actual deadline if it has been active since it was armed.
+/// @note Not thread safe, guarded by the owner.
+class IdleConnectionWheel {
+ public:
+  /// Slots of the wheel. Deadlines beyond a full turn are armed to the last slot and re-armed once due.
+  static constexpr std::size_t kSlots = 64;
+
+  /// @param tick_ms Granularity(ms) of the deadlines.
+  explicit IdleConnectionWheel(uint64_t tick_ms = 1000) : tick_ms_(tick_ms) {}
+
+  /// @brief Arms the connection to be due at the tick of `deadline_ms`, or at the next tick if that has passed.
+  void Arm(uint64_t conn_id, uint64_t deadline_ms);
+
+  /// @brief Takes the connections due by `now_ms`, and moves the wheel to the next tick.
+  void Expire(uint64_t now_ms, std::vector<uint64_t>& conn_ids);
+
+  /// @brief Removes all the connections.
+  void Clear();
+
+ private:
+  uint64_t tick_ms_;
+
+  // The first tick not expired yet.
+  uint64_t next_tick_{0};
+
+  std::array<std::vector<uint64_t>, kSlots> slots_;
+};
+
+}  // namespace trpc
@@ -0,0 +1,78 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#include "trpc/transport/server/fiber/idle_connection_wheel.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace trpc::testing {
+
+TEST(IdleConnectionWheelTest, ArmAndExpire) {
+  IdleConnectionWheel wheel(1000);
+  std::vector<uint64_t> conn_ids;
+
+  wheel.Expire(10'000, conn_ids);
+  ASSERT_TRUE(conn_ids.empty());
+
+  wheel.Arm(1, 12'500);
+  wheel.Arm(2, 13'000);
+  // Armed to the next tick, as its deadline has passed.
+  wheel.Arm(3, 5'000);
+
+  wheel.Expire(11'000, conn_ids);
+  ASSERT_EQ(conn_ids, std::vector<uint64_t>{3});
+
+  conn_ids.clear();
+  wheel.Expire(12'999, conn_ids);
+  ASSERT_EQ(conn_ids, std::vector<uint64_t>{1});
+
+  // Expiring the same tick again finds nothing.
+  conn_ids.clear();
+  wheel.Expire(12'999, conn_ids);
+  ASSERT_TRUE(conn_ids.empty());
+
+  wheel.Expire(13'000, conn_ids);
+  ASSERT_EQ(conn_ids, std::vector<uint64_t>{2});
+}
+
+TEST(IdleConnectionWheelTest, FarDeadlineAndCatchUp) {
+  IdleConnectionWheel wheel(1000);
+  std::vector<uint64_t> conn_ids;
+  wheel.Expire(0, conn_ids);
+
+  // Beyond a full turn, armed to the last slot.
+  wheel.Arm(1, 1000 * 1000);
+  wheel.Expire(IdleConnectionWheel::kSlots * 1000 - 1, conn_ids);
+  ASSERT_TRUE(conn_ids.empty());
+  wheel.Expire(IdleConnectionWheel::kSlots * 1000, conn_ids);
+  ASSERT_EQ(conn_ids, std::vector<uint64_t>{1});
+
+  // Long after the last call, every slot is visited once.
+  conn_ids.clear();
+  for (uint64_t i = 0; i != IdleConnectionWheel::kSlots; ++i) {
+    wheel.Arm(i, (IdleConnectionWheel::kSlots + i) * 1000);
+  }
+  wheel.Expire(1000 * 1000, conn_ids);
+  ASSERT_EQ(conn_ids.size(), IdleConnectionWheel::kSlots);
+
+  wheel.Arm(1, 1000 * 1001);
+  wheel.Clear();
+  conn_ids.clear();
+  wheel.Expire(1000 * 2000, conn_ids);
+  ASSERT_TRUE(conn_ids.empty());
+}
+
+}  // namespace trpc::testing
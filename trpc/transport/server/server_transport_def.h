@@ -56,9 +56,13 @@ struct BindInfo {
   uint32_t recv_buffer_size{8192};
   uint32_t send_queue_capacity{0};
   uint32_t send_queue_timeout{3000};
+  uint32_t send_queue_high_watermark{0};
+  uint32_t send_queue_low_watermark{0};
   uint32_t max_conn_num{10000};
   uint32_t idle_time{60000};
   uint32_t accept_thread_num{1};
+  // Whether to steer the new connections to the acceptors by the cpu receiving them, see `ServiceConfig`
+  bool reuseport_cpu_steering{false};
 
   // Whether the upper-layer business processing methods has stream rpc methods
   bool has_stream_rpc = false;
@@ -0,0 +1,127 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <cstddef>
+
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+#include "trpc/util/likely.h"
+#include "trpc/util/log/logging.h"
+
+namespace trpc {
+
+/// @brief Rapidjson input stream which reads the blocks of `NoncontiguousBuffer` in place, so the json can be parsed
+/// without flattening the buffer.
+///
+/// The buffer is not consumed, and it must not be changed while the stream is in use. In-situ parsing is not
+/// supported.
+///
+/// Usage:
+///
+/// NoncontiguousBufferJsonInputStream is(buffer);
+/// rapidjson::Document doc;
+/// doc.ParseStream(is);
+///
+class NoncontiguousBufferJsonInputStream {
+ public:
+  using Ch = char;
+
+  explicit NoncontiguousBufferJsonInputStream(const NoncontiguousBuffer& buffer)
+      : iter_(buffer.begin()), unloaded_(buffer.ByteSize()) {
+    LoadNextBlock();
+  }
+
+  Ch Peek() const { return TRPC_LIKELY(current_ != end_) ? *current_ : '\0'; }
+
+  Ch Take() {
+    if (TRPC_UNLIKELY(current_ == end_)) {
+      return '\0';
+    }
+    Ch c = *current_++;
+    ++read_;
+    if (TRPC_UNLIKELY(current_ == end_)) {
+      LoadNextBlock();
+    }
+    return c;
+  }
+
+  std::size_t Tell() const { return read_; }
+
+  Ch* PutBegin() {
+    TRPC_ASSERT(false && "Unreachable");
+    return nullptr;
+  }
+
+  void Put(Ch) { TRPC_ASSERT(false && "Unreachable"); }
+
+  void Flush() { TRPC_ASSERT(false && "Unreachable"); }
+
+  std::size_t PutEnd(Ch*) {
+    TRPC_ASSERT(false && "Unreachable");
+    return 0;
+  }
+
+ private:
+  void LoadNextBlock() {
+    current_ = end_ = nullptr;
+    // The blocks are counted by bytes, as the iterator of the buffer can not be compared with `end()`.
+    while (unloaded_ > 0) {
+      const char* data = iter_->data();
+      std::size_t size = iter_->size();
+      ++iter_;
+      if (size > 0) {
+        current_ = data;
+        end_ = data + size;
+        unloaded_ -= size;
+        return;
+      }
+    }
+  }
+
+ private:
+  NoncontiguousBuffer::const_iterator iter_;
+  std::size_t unloaded_;
+  const char* current_{nullptr};
+  const char* end_{nullptr};
+  std::size_t read_{0};
+};
+
+/// @brief Rapidjson output stream which writes the json into the blocks of `NoncontiguousBufferBuilder` directly.
+///
+/// Usage:
+///
+/// NoncontiguousBufferBuilder builder;
+/// NoncontiguousBufferJsonOutputStream os(&builder);
+/// rapidjson::Writer<NoncontiguousBufferJsonOutputStream> writer(os);
+/// doc.Accept(writer);
+/// NoncontiguousBuffer json = builder.DestructiveGet();
+///
+/// @note The stream only carries the bytes, the strings are escaped by the writer. `rapidjson::Writer` escapes only
+///       what json requires, unlike protobuf json util which escapes '<', '>', U+2028, U+2029 and more, use
+///       `PbJsonTranscoder` for the json of pb messages.
+class NoncontiguousBufferJsonOutputStream {
+ public:
+  using Ch = char;
+
+  explicit NoncontiguousBufferJsonOutputStream(NoncontiguousBufferBuilder* builder) : builder_(builder) {}
+
+  void Put(Ch c) { builder_->Append(c); }
+
+  void Flush() {}
+
+ private:
+  NoncontiguousBufferBuilder* builder_;
+};
+
+}  // namespace trpc
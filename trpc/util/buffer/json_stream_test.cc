@@ -0,0 +1,72 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/util/buffer/json_stream.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+#include "rapidjson/document.h"
+#include "rapidjson/writer.h"
+
+#include "trpc/util/buffer/buffer.h"
+
+namespace trpc::testing {
+
+TEST(NoncontiguousBufferJsonInputStream, ReadBlocks) {
+  NoncontiguousBuffer buffer;
+  buffer.Append(CreateBufferSlow("ab"));
+  buffer.Append(CreateBufferSlow(""));
+  buffer.Append(CreateBufferSlow("c"));
+
+  NoncontiguousBufferJsonInputStream is(buffer);
+  ASSERT_EQ(is.Peek(), 'a');
+  ASSERT_EQ(is.Take(), 'a');
+  ASSERT_EQ(is.Take(), 'b');
+  ASSERT_EQ(is.Peek(), 'c');
+  ASSERT_EQ(is.Take(), 'c');
+  ASSERT_EQ(is.Tell(), 3);
+  ASSERT_EQ(is.Peek(), '\0');
+  ASSERT_EQ(is.Take(), '\0');
+  ASSERT_EQ(is.Tell(), 3);
+  ASSERT_EQ(buffer.ByteSize(), 3);
+}
+
+TEST(NoncontiguousBufferJsonInputStream, EmptyBuffer) {
+  NoncontiguousBuffer buffer;
+  NoncontiguousBufferJsonInputStream is(buffer);
+  ASSERT_EQ(is.Peek(), '\0');
+  ASSERT_EQ(is.Tell(), 0);
+}
+
+TEST(NoncontiguousBufferJsonStream, ParseAndWrite) {
+  std::string json = R"({"name":"json","values":[1,2,3]})";
+  NoncontiguousBuffer buffer;
+  for (char c : json) {
+    buffer.Append(CreateBufferSlow(std::string(1, c)));
+  }
+
+  NoncontiguousBufferJsonInputStream is(buffer);
+  rapidjson::Document doc;
+  doc.ParseStream(is);
+  ASSERT_FALSE(doc.HasParseError());
+  ASSERT_STREQ(doc["name"].GetString(), "json");
+
+  NoncontiguousBufferBuilder builder;
+  NoncontiguousBufferJsonOutputStream os(&builder);
+  rapidjson::Writer<NoncontiguousBufferJsonOutputStream> writer(os);
+  doc.Accept(writer);
+  ASSERT_EQ(FlattenSlow(builder.DestructiveGet()), json);
+}
+
+}  // namespace trpc::testing
@@ -17,6 +17,12 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+
 namespace flatbuffers {
 namespace trpc {
 
@@ -44,6 +50,26 @@ class MessageFbs {
 
   /// @brief Deserialize binary data into a message object.
   virtual bool ParseFromArray(const char* arr, uint32_t len) = 0;
+
+  /// @brief Appends the binary data of the message to `buffer`. By default the data is copied, implementations may
+  ///        share their memory with `buffer` instead.
+  virtual bool SerializeToBuffer(::trpc::NoncontiguousBuffer* buffer) const {
+    uint32_t len = ByteSizeLong();
+    if (len == 0) {
+      return false;
+    }
+    ::trpc::NoncontiguousBufferBuilder builder;
+    builder.Append(data(), len);
+    buffer->Append(builder.DestructiveGet());
+    return true;
+  }
+
+  /// @brief Deserialize binary data held by `buffer` into a message object. By default the data is flattened and
+  ///        copied, implementations may refer to the memory of `buffer` instead.
+  virtual bool ParseFromBuffer(const ::trpc::NoncontiguousBuffer& buffer) {
+    std::string flatten = ::trpc::FlattenSlow(buffer);
+    return ParseFromArray(flatten.data(), flatten.size());
+  }
 };
 
 }  // namespace trpc
@@ -73,5 +73,45 @@ uint8_t* MessageBuilder::ReleaseRaw(size_t& size, size_t& offset, ::trpc::Buffer
   slice_allocator_.CreateBuffer(nullptr, 0);
   return buf;
 }
+
+// PoolAllocator
+uint8_t* PoolAllocator::allocate(size_t size) {
+  TRPC_ASSERT(block_.Empty());
+  block_ = AllocateBlock(size);
+  return GetData();
+}
+
+void PoolAllocator::deallocate(uint8_t* p, size_t size) {
+  TRPC_ASSERT(p == GetData());
+  TRPC_ASSERT(size == block_.ByteSize());
+  block_.Clear();
+}
+
+uint8_t* PoolAllocator::reallocate_downward(uint8_t* old_p, size_t old_size, size_t new_size, size_t in_use_back,
+                                            size_t in_use_front) {
+  TRPC_ASSERT(old_p == GetData());
+  TRPC_ASSERT(old_size == block_.ByteSize());
+  TRPC_ASSERT(new_size > old_size);
+  ::trpc::NoncontiguousBuffer new_block = AllocateBlock(new_size);
+  uint8_t* new_p = reinterpret_cast<uint8_t*>(new_block.begin()->data());
+  memcpy_downward(old_p, old_size, new_p, new_size, in_use_back, in_use_front);
+  block_ = std::move(new_block);
+  return new_p;
+}
+
+::trpc::NoncontiguousBuffer PoolAllocator::AllocateBlock(size_t size) {
+  auto block = ::trpc::object_pool::MakeLwUnique<::trpc::BufferBlock>();
+  if (size <= ::trpc::GetBlockMaxAvailableSize()) {
+    block->Reset(0, size, ::trpc::MakeBlockRef(::trpc::memory_pool::Allocate()));
+  } else {
+    auto slice = ::trpc::MakeRefCounted<::trpc::Buffer>(size);
+    slice->AddWriteLen(size);
+    block->WrapUp(std::move(slice));
+  }
+  ::trpc::NoncontiguousBuffer buffer;
+  buffer.Append(std::move(block));
+  return buffer;
+}
+
 }  // namespace trpc
 }  // namespace flatbuffers
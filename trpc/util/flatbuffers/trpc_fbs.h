@@ -19,6 +19,7 @@
 // Helper functionality to glue FlatBuffers and TRPC.
 
 #include <assert.h>
+#include <cstdint>
 #include <memory>
 #include <utility>
 
@@ -28,6 +29,7 @@
 
 #include "trpc/util/buffer/buffer.h"
 #include "trpc/util/buffer/contiguous_buffer.h"
+#include "trpc/util/buffer/memory_pool/memory_pool.h"
 #include "trpc/util/buffer/noncontiguous_buffer.h"
 #include "trpc/util/likely.h"
 #include "trpc/util/ref_ptr.h"
@@ -35,10 +37,17 @@
 namespace flatbuffers {
 namespace trpc {
 
+class MessageBuilder;
+class PoolMessageBuilder;
+
 /// @brief  Message is a typed wrapper around a buffer that manages the underlying
 /// `slice` and also provides flatbuffers-specific helpers such as `Verify`
 /// and `GetRoot`. Since it is backed by a `slice`, the underlying buffer
 /// is ref-counted and ownership is be managed automatically.
+///
+/// The data is either held by `slice`, or is a single block of `NoncontiguousBuffer` shared with the received buffer
+/// (see `ParseFromBuffer`) or with the memory pool (see `PoolMessageBuilder`). `BorrowSlice` returns an empty slice
+/// in the latter case.
 template <class T>
 class Message : public MessageFbs {
  public:
@@ -46,34 +55,45 @@ class Message : public MessageFbs {
 
   explicit Message(::trpc::BufferPtr& buff) : slice_(buff) {}
 
-  Message(const Message& other) { slice_ = other.slice_; }
+  Message(const Message& other) {
+    slice_ = other.slice_;
+    block_ = other.block_;
+  }
 
   Message& operator=(const Message& other) {
-    if (slice_.Get() == other.slice_.Get()) {
+    if (this == &other) {
       return *this;
     }
     slice_ = other.slice_;
+    block_ = other.block_;
     return *this;
   }
 
   Message(Message&& other) {
     slice_ = std::move(other.slice_);
+    block_ = std::move(other.block_);
     other.slice_ = ::trpc::MakeRefCounted<::trpc::Buffer>(0);
   }
 
   Message& operator=(Message&& other) {
     if (this != &other) {
       slice_ = std::move(other.slice_);
+      block_ = std::move(other.block_);
       other.slice_ = ::trpc::MakeRefCounted<::trpc::Buffer>(0);
     }
     return *this;
   }
 
-  const uint8_t* mutable_data() const override { return reinterpret_cast<const uint8_t*>(slice_->GetReadPtr()); }
+  const uint8_t* mutable_data() const override { return data(); }
 
-  const uint8_t* data() const override { return reinterpret_cast<const uint8_t*>(slice_->GetReadPtr()); }
+  const uint8_t* data() const override {
+    if (TRPC_LIKELY(block_.Empty())) {
+      return reinterpret_cast<const uint8_t*>(slice_->GetReadPtr());
+    }
+    return reinterpret_cast<const uint8_t*>(block_.FirstContiguous().data());
+  }
 
-  size_t size() const override { return slice_->ReadableSize(); }
+  size_t size() const override { return TRPC_LIKELY(block_.Empty()) ? slice_->ReadableSize() : block_.ByteSize(); }
 
   // For compatibility (trpc:rpc_method_handler.h:109:38).
   uint32_t ByteSizeLong() const override { return size(); }
@@ -102,18 +122,75 @@ class Message : public MessageFbs {
   }
 
   bool ParseFromArray(const char* arr, uint32_t len) override {
-    bool ret = true;
-    slice_->Resize(len);
+    // A new slice, as the old one may be shared with copies of the message or with a buffer being sent.
+    slice_ = ::trpc::MakeRefCounted<::trpc::Buffer>(len);
+    block_.Clear();
     memcpy(slice_->GetWritePtr(), arr, len);
     slice_->AddWriteLen(len);
+    return AutoVerify();
+  }
+
+  /// @brief Shares the binary data with `buffer` appended to, without copying it.
+  bool SerializeToBuffer(::trpc::NoncontiguousBuffer* buffer) const override {
+    if (TRPC_UNLIKELY(size() == 0)) {
+      return false;
+    }
+    if (!block_.Empty()) {
+      buffer->Append(block_);
+      return true;
+    }
+    ::trpc::BufferPtr slice = slice_;
+    auto block = ::trpc::object_pool::MakeLwUnique<::trpc::BufferBlock>();
+    block->WrapUp(std::move(slice));
+    buffer->Append(std::move(block));
+    return true;
+  }
+
+  /// @brief Deserializes the binary data held by `buffer` with at most one copy, into an aligned contiguous slice.
+  /// @note  The data is accessed in place if `buffer` is a single block aligned for flatbuffers. The tcp connections
+  ///        read a trpc frame larger than a block of the memory pool into one block sized from the frame length, with
+  ///        the body aligned (see `RecvFrameBlock`), so such a body is in place. Smaller frames are read into the
+  ///        fixed-size blocks of the pool, and are copied unless they happen to be aligned.
+  bool ParseFromBuffer(const ::trpc::NoncontiguousBuffer& buffer) override {
+    if (buffer.size() == 1 && IsAligned(buffer.FirstContiguous().data())) {
+      block_ = buffer;
+    } else {
+      std::size_t len = buffer.ByteSize();
+      slice_ = ::trpc::MakeRefCounted<::trpc::Buffer>(len);
+      block_.Clear();
+      if (len > 0) {
+        ::trpc::FlattenToSlow(buffer, slice_->GetWritePtr(), len);
+        slice_->AddWriteLen(len);
+      }
+    }
+    return AutoVerify();
+  }
+
+ private:
+  friend class PoolMessageBuilder;
+
+  // Takes a single block holding the data.
+  explicit Message(::trpc::NoncontiguousBuffer&& block) : block_(std::move(block)) {
+    slice_ = ::trpc::MakeRefCounted<::trpc::Buffer>(0);
+  }
+
+  bool AutoVerify() const {
 #ifndef FLATBUFFERS_TRPC_DISABLE_AUTO_VERIFICATION
-    ret = Verify();
+    return Verify();
+#else
+    return true;
 #endif
-    return ret;
+  }
+
+  // Scalars of flatbuffers are accessed in place, so the data must be aligned to the largest scalar.
+  static bool IsAligned(const char* p) {
+    return reinterpret_cast<std::uintptr_t>(p) % alignof(::flatbuffers::largest_scalar_t) == 0;
   }
 
  private:
   ::trpc::BufferPtr slice_;
+  // Non-empty if the data is a block shared with other buffers.
+  ::trpc::NoncontiguousBuffer block_;
 };
 
 class MessageBuilder;
@@ -268,11 +345,85 @@ class MessageBuilder : private detail::SliceAllocatorMember, public FlatBufferBu
     return msg;
   }
 
+  /// @brief Releases the buffer into a `Message<T>`, the message takes over the slice instead of copying the data.
   template <class T>
   Message<T> ReleaseMessage() {
-    Message<T> msg = GetMessage<T>();
-    Reset();
-    return msg;
+    slice_allocator_.CheckSlice(buf_.scratch_data(), buf_.capacity());
+    size_t size = 0;
+    size_t offset = 0;
+    ::trpc::BufferPtr slice;
+    ReleaseRaw(size, offset, slice);
+    slice->AddReadLen(offset);
+    return Message<T>(slice);
+  }
+};
+
+/// @brief PoolAllocator is an allocator backed by the memory pool of the framework: buffers fitting in a memory block
+/// are taken from the pool, larger ones are allocated from the heap.
+/// @private For internal use purpose only.
+class PoolAllocator : public Allocator {
+ public:
+  PoolAllocator() = default;
+
+  PoolAllocator(const PoolAllocator& other) = delete;
+  PoolAllocator& operator=(const PoolAllocator& other) = delete;
+
+  uint8_t* allocate(size_t size) override;
+
+  void deallocate(uint8_t* p, size_t size) override;
+
+  uint8_t* reallocate_downward(uint8_t* old_p, size_t old_size, size_t new_size, size_t in_use_back,
+                               size_t in_use_front) override;
+
+ private:
+  static ::trpc::NoncontiguousBuffer AllocateBlock(size_t size);
+
+  uint8_t* GetData() { return reinterpret_cast<uint8_t*>(block_.begin()->data()); }
+
+ private:
+  // A single block holding the buffer, empty if nothing is allocated.
+  ::trpc::NoncontiguousBuffer block_;
+
+  friend class PoolMessageBuilder;
+};
+
+namespace detail {
+// @brief Same as `SliceAllocatorMember`, ensures the allocator is constructed before the FlatBufferBuilder.
+struct PoolAllocatorMember {
+  PoolAllocator pool_allocator_;
+};
+}  // namespace detail
+
+/// @brief PoolMessageBuilder is a FlatBufferBuilder allocating its buffer from the memory pool. The released message
+/// shares the buffer, and so does the `NoncontiguousBuffer` it is serialized into, so no data is copied from building
+/// a message to sending it.
+///
+/// Usage:
+///
+/// flatbuffers::trpc::PoolMessageBuilder mb;
+/// auto name_offset = mb.CreateString("name");
+/// mb.Finish(CreateHelloReply(mb, name_offset));
+/// *reply = mb.ReleaseMessage<HelloReply>();
+///
+class PoolMessageBuilder : private detail::PoolAllocatorMember, public FlatBufferBuilder {
+ public:
+  explicit PoolMessageBuilder(uoffset_t initial_size = 1024)
+      : FlatBufferBuilder(initial_size, &pool_allocator_, false) {}
+
+  PoolMessageBuilder(const PoolMessageBuilder& other) = delete;
+  PoolMessageBuilder& operator=(const PoolMessageBuilder& other) = delete;
+
+  /// @brief Releases the buffer into a `Message<T>` without copying the data, the builder can be reused afterwards.
+  template <class T>
+  Message<T> ReleaseMessage() {
+    size_t size = 0;
+    size_t offset = 0;
+    uint8_t* buf = ReleaseRaw(size, offset);
+    TRPC_ASSERT(buf == pool_allocator_.GetData());
+    TRPC_ASSERT(size == pool_allocator_.block_.ByteSize());
+    ::trpc::NoncontiguousBuffer block = std::move(pool_allocator_.block_);
+    block.Skip(offset);
+    return Message<T>(std::move(block));
   }
 };
 
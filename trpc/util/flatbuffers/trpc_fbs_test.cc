@@ -14,6 +14,7 @@
 #include "trpc/util/flatbuffers/trpc_fbs.h"
 
 #include <iostream>
+#include <string>
 
 #include "gtest/gtest.h"
 
@@ -151,4 +152,77 @@ TEST(MessageBuilder, TestOk) {
   ASSERT_TRUE(buf);
 }
 
+TEST(Message, ReleaseMessageWithoutCopy) {
+  trpc::MessageBuilder mb;
+  auto name_offset = mb.CreateString("reply");
+  mb.Finish(::trpc::test::helloworld::CreateHelloReply(mb, name_offset));
+  const uint8_t* data = mb.GetBufferPointer();
+  auto message = mb.ReleaseMessage<::trpc::test::helloworld::HelloReply>();
+  ASSERT_EQ(message.data(), data);
+  ASSERT_TRUE(message.Verify());
+  ASSERT_EQ(message.GetRoot()->message()->str(), "reply");
+}
+
+TEST(Message, SerializeAndParseBuffer) {
+  trpc::Message<::trpc::test::helloworld::HelloReply> message;
+  ConstructMessage(message, "buffer");
+
+  // The buffer shares the data of the message.
+  ::trpc::NoncontiguousBuffer buffer;
+  ASSERT_TRUE(message.SerializeToBuffer(&buffer));
+  ASSERT_EQ(buffer.size(), 1);
+  ASSERT_EQ(reinterpret_cast<const uint8_t*>(buffer.FirstContiguous().data()), message.data());
+
+  // A single aligned block is accessed in place.
+  trpc::Message<::trpc::test::helloworld::HelloReply> in_place;
+  ASSERT_TRUE(in_place.ParseFromBuffer(buffer));
+  ASSERT_EQ(in_place.data(), message.data());
+  ASSERT_EQ(in_place.GetRoot()->message()->str(), "buffer");
+  ASSERT_TRUE(in_place.BorrowSlice()->ReadableSize() == 0);
+
+  // Multiple blocks are gathered.
+  std::string flatten = ::trpc::FlattenSlow(buffer);
+  ::trpc::NoncontiguousBuffer blocks;
+  blocks.Append(::trpc::CreateBufferSlow(flatten.substr(0, 5)));
+  blocks.Append(::trpc::CreateBufferSlow(flatten.substr(5)));
+  trpc::Message<::trpc::test::helloworld::HelloReply> gathered;
+  ASSERT_TRUE(gathered.ParseFromBuffer(blocks));
+  ASSERT_NE(gathered.data(), message.data());
+  ASSERT_EQ(gathered.size(), message.size());
+  ASSERT_EQ(gathered.GetRoot()->message()->str(), "buffer");
+
+  // Copies share the data.
+  auto copied = in_place;
+  ASSERT_EQ(copied.data(), in_place.data());
+  auto moved = std::move(copied);
+  ASSERT_EQ(moved.data(), in_place.data());
+  ASSERT_EQ(copied.size(), 0);
+
+  ASSERT_FALSE(gathered.ParseFromBuffer(::trpc::NoncontiguousBuffer()));
+}
+
+TEST(PoolMessageBuilder, TestOk) {
+  for (const std::string& name : {std::string("pool"), std::string(10000, 'x')}) {
+    trpc::PoolMessageBuilder mb(64);
+    auto name_offset = mb.CreateString(name.c_str());
+    mb.Finish(::trpc::test::helloworld::CreateHelloReply(mb, name_offset));
+    const uint8_t* data = mb.GetBufferPointer();
+    size_t size = mb.GetSize();
+    auto message = mb.ReleaseMessage<::trpc::test::helloworld::HelloReply>();
+    ASSERT_EQ(message.data(), data);
+    ASSERT_EQ(message.size(), size);
+    ASSERT_TRUE(message.Verify());
+    ASSERT_EQ(message.GetRoot()->message()->str(), name);
+
+    ::trpc::NoncontiguousBuffer buffer;
+    ASSERT_TRUE(message.SerializeToBuffer(&buffer));
+    ASSERT_EQ(reinterpret_cast<const uint8_t*>(buffer.FirstContiguous().data()), data);
+
+    // The builder is reusable.
+    name_offset = mb.CreateString("again");
+    mb.Finish(::trpc::test::helloworld::CreateHelloReply(mb, name_offset));
+    ASSERT_EQ(mb.ReleaseMessage<::trpc::test::helloworld::HelloReply>().GetRoot()->message()->str(), "again");
+  }
+}
+
 }  // namespace flatbuffers::testing
@@ -0,0 +1,1130 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/util/pb_json_transcoder.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "google/protobuf/stubs/strutil.h"
+#include "rapidjson/reader.h"
+#include "rapidjson/writer.h"
+
+#include "trpc/util/buffer/json_stream.h"
+#include "trpc/util/likely.h"
+#include "trpc/util/pb2json.h"
+
+namespace trpc {
+
+namespace {
+
+using google::protobuf::Descriptor;
+using google::protobuf::FieldDescriptor;
+using google::protobuf::Message;
+using google::protobuf::Reflection;
+
+using JsonWriter = rapidjson::Writer<NoncontiguousBufferJsonOutputStream>;
+
+// Value types having different json mappings.
+enum class ValueKind { kInt32, kUint32, kInt64, kUint64, kFloat, kDouble, kBool, kEnum, kString, kBytes, kMessage };
+
+ValueKind GetValueKind(const FieldDescriptor* field) {
+  switch (field->cpp_type()) {
+    case FieldDescriptor::CPPTYPE_INT32:
+      return ValueKind::kInt32;
+    case FieldDescriptor::CPPTYPE_UINT32:
+      return ValueKind::kUint32;
+    case FieldDescriptor::CPPTYPE_INT64:
+      return ValueKind::kInt64;
+    case FieldDescriptor::CPPTYPE_UINT64:
+      return ValueKind::kUint64;
+    case FieldDescriptor::CPPTYPE_FLOAT:
+      return ValueKind::kFloat;
+    case FieldDescriptor::CPPTYPE_DOUBLE:
+      return ValueKind::kDouble;
+    case FieldDescriptor::CPPTYPE_BOOL:
+      return ValueKind::kBool;
+    case FieldDescriptor::CPPTYPE_ENUM:
+      return ValueKind::kEnum;
+    case FieldDescriptor::CPPTYPE_STRING:
+      return field->type() == FieldDescriptor::TYPE_BYTES ? ValueKind::kBytes : ValueKind::kString;
+    default:
+      return ValueKind::kMessage;
+  }
+}
+
+// A scalar json value.
+struct JsonScalar {
+  enum class Type { kNull, kBool, kInt64, kUint64, kDouble, kString };
+
+  Type type{Type::kNull};
+  bool bool_value{false};
+  int64_t int64_value{0};
+  uint64_t uint64_value{0};
+  double double_value{0};
+  std::string_view string_value;
+};
+
+struct MessageTable;
+struct FieldEntry;
+
+// Writes the element at |index| of a repeated field, |index| is ignored for singular fields.
+using WriteElementFn = bool (*)(const Message& message, const FieldDescriptor* field, int index,
+                                const MessageTable* message_table, JsonWriter* writer);
+// Writes the whole value of a field.
+using WriteFieldFn = bool (*)(const Message& message, const FieldEntry& entry, JsonWriter* writer);
+// Sets a singular field, or adds an element to a repeated field.
+using SetElementFn = bool (*)(Message* message, const FieldDescriptor* field, const JsonScalar& scalar);
+
+// Compiled plan of a field: the handlers are chosen once by the field type, so the conversion loops neither switch on
+// types nor look up descriptors.
+struct FieldEntry {
+  const FieldDescriptor* field{nullptr};
+  ValueKind kind;
+  bool is_repeated{false};
+  bool is_map{false};
+  // Members of oneof and singular message fields are printed only if they are set, other fields are always printed.
+  bool print_if_set{false};
+  // Key and value fields of the map entry.
+  const FieldDescriptor* map_key{nullptr};
+  const FieldDescriptor* map_value{nullptr};
+  ValueKind map_value_kind;
+  // Table of the message field, or of the message value of the map field.
+  const MessageTable* message_table{nullptr};
+
+  WriteFieldFn write_field{nullptr};
+  // Handlers of the elements of repeated fields, the values of singular fields, or the values of map fields.
+  WriteElementFn write_element{nullptr};
+  SetElementFn set_element{nullptr};
+  SetElementFn set_map_key{nullptr};
+};
+
+// Open addressing hash table from the names of fields to fields.
+class FieldNameIndex {
+ public:
+  void Build(const std::vector<FieldEntry>& fields) {
+    std::vector<std::pair<std::string_view, const FieldEntry*>> names;
+    for (const auto& entry : fields) {
+      names.emplace_back(entry.field->name(), &entry);
+      if (entry.field->json_name() != entry.field->name()) {
+        names.emplace_back(entry.field->json_name(), &entry);
+      }
+    }
+
+    // At most half full, so the probe sequences are short and always end at an empty slot.
+    std::size_t capacity = 4;
+    while (capacity < names.size() * 2) {
+      capacity *= 2;
+    }
+    slots_.assign(capacity, Slot{});
+    mask_ = capacity - 1;
+    for (const auto& [name, entry] : names) {
+      uint64_t hash = Hash(name);
+      std::size_t i = hash & mask_;
+      while (slots_[i].entry != nullptr) {
+        i = (i + 1) & mask_;
+      }
+      slots_[i] = Slot{hash, name, entry};
+    }
+  }
+
+  const FieldEntry* Find(std::string_view name) const {
+    uint64_t hash = Hash(name);
+    for (std::size_t i = hash & mask_;; i = (i + 1) & mask_) {
+      const Slot& slot = slots_[i];
+      if (slot.entry == nullptr) {
+        return nullptr;
+      }
+      if (slot.hash == hash && slot.name == name) {
+        return slot.entry;
+      }
+    }
+  }
+
+ private:
+  // FNV-1a
+  static uint64_t Hash(std::string_view name) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (char c : name) {
+      hash = (hash ^ static_cast<uint8_t>(c)) * 1099511628211ULL;
+    }
+    return hash;
+  }
+
+ private:
+  struct Slot {
+    uint64_t hash{0};
+    std::string_view name;
+    const FieldEntry* entry{nullptr};
+  };
+
+  std::vector<Slot> slots_;
+  std::size_t mask_{0};
+};
+
+// Compiled plan of a message type.
+struct MessageTable {
+  // Whether the message can be converted by the transcoder, `Pb2Json` is used otherwise.
+  bool supported{true};
+  // In the order of `Pb2Json` output.
+  std::vector<FieldEntry> fields;
+  // Both the proto name and the json name are accepted when parsing.
+  FieldNameIndex fields_by_name;
+};
+
+// pb -> json
+
+// Same format as protobuf json util: the shortest of `FLT_DIG`/`DBL_DIG` digits if it round-trips, otherwise enough
+// digits to round-trip.
+template <typename T>
+void WriteFloatingPoint(T value, JsonWriter* writer) {
+  if (std::isnan(value)) {
+    writer->String("NaN", 3);
+    return;
+  }
+  if (std::isinf(value)) {
+    value > 0 ? writer->String("Infinity", 8) : writer->String("-Infinity", 9);
+    return;
+  }
+
+  constexpr bool kIsFloat = std::is_same_v<T, float>;
+  constexpr int kDigits = kIsFloat ? FLT_DIG : DBL_DIG;
+  constexpr int kRoundTripDigits = kIsFloat ? FLT_DIG + 3 : DBL_DIG + 2;
+
+  char buffer[32];
+  int size = snprintf(buffer, sizeof(buffer), "%.*g", kDigits, static_cast<double>(value));
+  T parsed = kIsFloat ? strtof(buffer, nullptr) : strtod(buffer, nullptr);
+  if (parsed != value) {
+    size = snprintf(buffer, sizeof(buffer), "%.*g", kRoundTripDigits, static_cast<double>(value));
+  }
+  writer->RawValue(buffer, size, rapidjson::kNumberType);
+}
+
+// Decodes the code point at the beginning of `s`, rejecting overlong forms, surrogates and the code points beyond
+// U+10FFFF. Returns its length in bytes, or 0 if `s` does not start with valid UTF-8.
+std::size_t DecodeUtf8(const unsigned char* s, std::size_t size, uint32_t* code_point) {
+  unsigned char lead = s[0];
+  if (lead < 0x80) {
+    *code_point = lead;
+    return 1;
+  }
+
+  std::size_t length = 0;
+  uint32_t min_code_point = 0;
+  if (lead < 0xc2) {
+    return 0;
+  } else if (lead < 0xe0) {
+    length = 2;
+    *code_point = lead & 0x1f;
+    min_code_point = 0x80;
+  } else if (lead < 0xf0) {
+    length = 3;
+    *code_point = lead & 0x0f;
+    min_code_point = 0x800;
+  } else if (lead < 0xf5) {
+    length = 4;
+    *code_point = lead & 0x07;
+    min_code_point = 0x10000;
+  } else {
+    return 0;
+  }
+  if (size < length) {
+    return 0;
+  }
+  for (std::size_t i = 1; i != length; ++i) {
+    if ((s[i] & 0xc0) != 0x80) {
+      return 0;
+    }
+    *code_point = (*code_point << 6) | (s[i] & 0x3f);
+  }
+  if (*code_point < min_code_point || *code_point > 0x10ffff || (*code_point >= 0xd800 && *code_point <= 0xdfff)) {
+    return 0;
+  }
+  return length;
+}
+
+// The code points escaped by protobuf json util: besides '"', '\\' and the control characters required by json, '<'
+// and '>' for html, and the invisible format characters such as U+2028 and U+2029 for javascript.
+bool NeedsEscape(uint32_t cp) {
+  if (cp < 0x80) {
+    return cp < 0x20 || cp == '"' || cp == '\\' || cp == '<' || cp == '>' || cp == 0x7f;
+  }
+  return cp <= 0x9f || cp == 0xad || (cp >= 0x600 && cp <= 0x603) || cp == 0x6dd || cp == 0x70f || cp == 0x17b4 ||
+         cp == 0x17b5 || (cp >= 0x200b && cp <= 0x200f) || (cp >= 0x2028 && cp <= 0x202e) ||
+         (cp >= 0x2060 && cp <= 0x2064) || (cp >= 0x206a && cp <= 0x206f) || cp == 0xfeff ||
+         (cp >= 0xfff9 && cp <= 0xfffb) || cp == 0xe0001 || (cp >= 0xe0020 && cp <= 0xe007f);
+}
+
+void AppendUnicodeEscape(uint32_t unit, std::string* out) {
+  static constexpr char kHexDigits[] = "0123456789abcdef";
+  char escaped[6] = {'\\', 'u', kHexDigits[(unit >> 12) & 0xf], kHexDigits[(unit >> 8) & 0xf],
+                     kHexDigits[(unit >> 4) & 0xf], kHexDigits[unit & 0xf]};
+  out->append(escaped, sizeof(escaped));
+}
+
+// Quotes and escapes `value` the same as protobuf json util, rapidjson escapes only what json requires.
+// Returns false if `value` is not valid UTF-8, protobuf json util has its own handling of it.
+bool QuoteJsonString(std::string_view value, std::string* out) {
+  const auto* s = reinterpret_cast<const unsigned char*>(value.data());
+  std::size_t size = value.size();
+  out->reserve(out->size() + size + 2);
+  out->push_back('"');
+  std::size_t i = 0;
+  while (i != size) {
+    uint32_t cp = 0;
+    std::size_t length = DecodeUtf8(s + i, size - i, &cp);
+    if (TRPC_UNLIKELY(length == 0)) {
+      return false;
+    }
+    if (TRPC_LIKELY(!NeedsEscape(cp))) {
+      out->append(value.data() + i, length);
+    } else if (cp == '"' || cp == '\\') {
+      out->push_back('\\');
+      out->push_back(static_cast<char>(cp));
+    } else if (cp == '\b') {
+      out->append("\\b", 2);
+    } else if (cp == '\t') {
+      out->append("\\t", 2);
+    } else if (cp == '\n') {
+      out->append("\\n", 2);
+    } else if (cp == '\f') {
+      out->append("\\f", 2);
+    } else if (cp == '\r') {
+      out->append("\\r", 2);
+    } else if (cp <= 0xffff) {
+      AppendUnicodeEscape(cp, out);
+    } else {
+      cp -= 0x10000;
+      AppendUnicodeEscape(0xd800 + (cp >> 10), out);
+      AppendUnicodeEscape(0xdc00 + (cp & 0x3ff), out);
+    }
+    i += length;
+  }
+  out->push_back('"');
+  return true;
+}
+
+// Writes a string value, or a key, escaped the same as protobuf json util.
+bool WriteString(std::string_view value, JsonWriter* writer) {
+  thread_local std::string quoted;
+  quoted.clear();
+  if (TRPC_UNLIKELY(!QuoteJsonString(value, &quoted))) {
+    return false;
+  }
+  return writer->RawValue(quoted.data(), quoted.size(), rapidjson::kStringType);
+}
+
+bool WriteMessage(const Message& message, const MessageTable& table, JsonWriter* writer);
+
+template <ValueKind kKind, bool kRepeated>
+bool WriteElement(const Message& message, const FieldDescriptor* field, int index, const MessageTable* message_table,
+                  JsonWriter* writer) {
+  const Reflection* reflection = message.GetReflection();
+  if constexpr (kKind == ValueKind::kInt32) {
+    writer->Int(kRepeated ? reflection->GetRepeatedInt32(message, field, index) : reflection->GetInt32(message, field));
+  } else if constexpr (kKind == ValueKind::kUint32) {
+    writer->Uint(kRepeated ? reflection->GetRepeatedUInt32(message, field, index)
+                           : reflection->GetUInt32(message, field));
+  } else if constexpr (kKind == ValueKind::kInt64) {
+    // 64-bit integers are quoted as they may not fit into the number of javascript.
+    std::string value = std::to_string(kRepeated ? reflection->GetRepeatedInt64(message, field, index)
+                                                 : reflection->GetInt64(message, field));
+    writer->String(value.data(), static_cast<rapidjson::SizeType>(value.size()));
+  } else if constexpr (kKind == ValueKind::kUint64) {
+    std::string value = std::to_string(kRepeated ? reflection->GetRepeatedUInt64(message, field, index)
+                                                 : reflection->GetUInt64(message, field));
+    writer->String(value.data(), static_cast<rapidjson::SizeType>(value.size()));
+  } else if constexpr (kKind == ValueKind::kFloat) {
+    WriteFloatingPoint(kRepeated ? reflection->GetRepeatedFloat(message, field, index)
+                                 : reflection->GetFloat(message, field),
+                       writer);
+  } else if constexpr (kKind == ValueKind::kDouble) {
+    WriteFloatingPoint(kRepeated ? reflection->GetRepeatedDouble(message, field, index)
+                                 : reflection->GetDouble(message, field),
+                       writer);
+  } else if constexpr (kKind == ValueKind::kBool) {
+    writer->Bool(kRepeated ? reflection->GetRepeatedBool(message, field, index) : reflection->GetBool(message, field));
+  } else if constexpr (kKind == ValueKind::kEnum) {
+    writer->Int(kRepeated ? reflection->GetRepeatedEnumValue(message, field, index)
+                          : reflection->GetEnumValue(message, field));
+  } else if constexpr (kKind == ValueKind::kString || kKind == ValueKind::kBytes) {
+    std::string scratch;
+    const std::string& value = kRepeated ? reflection->GetRepeatedStringReference(message, field, index, &scratch)
+                                         : reflection->GetStringReference(message, field, &scratch);
+    if constexpr (kKind == ValueKind::kBytes) {
+      std::string encoded;
+      google::protobuf::Base64Escape(value, &encoded);
+      writer->String(encoded.data(), static_cast<rapidjson::SizeType>(encoded.size()));
+    } else {
+      return WriteString(value, writer);
+    }
+  } else {
+    return WriteMessage(kRepeated ? reflection->GetRepeatedMessage(message, field, index)
+                                  : reflection->GetMessage(message, field),
+                        *message_table, writer);
+  }
+  return true;
+}
+
+bool WriteSingularField(const Message& message, const FieldEntry& entry, JsonWriter* writer) {
+  return entry.write_element(message, entry.field, 0, entry.message_table, writer);
+}
+
+// protobuf json util prints the unset proto2 bytes field having a declared default with the C-escaped text of the
+// default, rather than the default bytes.
+bool WriteBytesWithDefaultField(const Message& message, const FieldEntry& entry, JsonWriter* writer) {
+  if (message.GetReflection()->HasField(message, entry.field)) {
+    return WriteSingularField(message, entry, writer);
+  }
+  std::string encoded;
+  google::protobuf::Base64Escape(google::protobuf::CEscape(entry.field->default_value_string()), &encoded);
+  writer->String(encoded.data(), static_cast<rapidjson::SizeType>(encoded.size()));
+  return true;
+}
+
+bool WriteRepeatedField(const Message& message, const FieldEntry& entry, JsonWriter* writer) {
+  writer->StartArray();
+  int size = message.GetReflection()->FieldSize(message, entry.field);
+  for (int i = 0; i < size; ++i) {
+    if (!entry.write_element(message, entry.field, i, entry.message_table, writer)) {
+      return false;
+    }
+  }
+  writer->EndArray();
+  return true;
+}
+
+bool WriteMapField(const Message& message, const FieldEntry& entry, JsonWriter* writer) {
+  const Reflection* reflection = message.GetReflection();
+  std::string scratch;
+  writer->StartObject();
+  int size = reflection->FieldSize(message, entry.field);
+  for (int i = 0; i < size; ++i) {
+    const Message& map_entry = reflection->GetRepeatedMessage(message, entry.field, i);
+    const Reflection* entry_reflection = map_entry.GetReflection();
+    std::string key;
+    switch (entry.map_key->cpp_type()) {
+      case FieldDescriptor::CPPTYPE_STRING:
+        key = entry_reflection->GetStringReference(map_entry, entry.map_key, &scratch);
+        break;
+      case FieldDescriptor::CPPTYPE_BOOL:
+        key = entry_reflection->GetBool(map_entry, entry.map_key) ? "true" : "false";
+        break;
+      case FieldDescriptor::CPPTYPE_INT32:
+        key = std::to_string(entry_reflection->GetInt32(map_entry, entry.map_key));
+        break;
+      case FieldDescriptor::CPPTYPE_INT64:
+        key = std::to_string(entry_reflection->GetInt64(map_entry, entry.map_key));
+        break;
+      case FieldDescriptor::CPPTYPE_UINT32:
+        key = std::to_string(entry_reflection->GetUInt32(map_entry, entry.map_key));
+        break;
+      case FieldDescriptor::CPPTYPE_UINT64:
+        key = std::to_string(entry_reflection->GetUInt64(map_entry, entry.map_key));
+        break;
+      default:
+        return false;
+    }
+    if (!WriteString(key, writer) ||
+        !entry.write_element(map_entry, entry.map_value, 0, entry.message_table, writer)) {
+      return false;
+    }
+  }
+  writer->EndObject();
+  return true;
+}
+
+bool WriteMessage(const Message& message, const MessageTable& table, JsonWriter* writer) {
+  if (TRPC_UNLIKELY(!table.supported)) {
+    return false;
+  }
+
+  const Reflection* reflection = message.GetReflection();
+  writer->StartObject();
+  for (const auto& entry : table.fields) {
+    if (entry.print_if_set && !reflection->HasField(message, entry.field)) {
+      continue;
+    }
+    const std::string& name = entry.field->name();
+    writer->Key(name.data(), static_cast<rapidjson::SizeType>(name.size()));
+    if (!entry.write_field(message, entry, writer)) {
+      return false;
+    }
+  }
+  writer->EndObject();
+  return true;
+}
+
+template <bool kRepeated>
+WriteElementFn SelectWriteElement(ValueKind kind) {
+  switch (kind) {
+    case ValueKind::kInt32:
+      return &WriteElement<ValueKind::kInt32, kRepeated>;
+    case ValueKind::kUint32:
+      return &WriteElement<ValueKind::kUint32, kRepeated>;
+    case ValueKind::kInt64:
+      return &WriteElement<ValueKind::kInt64, kRepeated>;
+    case ValueKind::kUint64:
+      return &WriteElement<ValueKind::kUint64, kRepeated>;
+    case ValueKind::kFloat:
+      return &WriteElement<ValueKind::kFloat, kRepeated>;
+    case ValueKind::kDouble:
+      return &WriteElement<ValueKind::kDouble, kRepeated>;
+    case ValueKind::kBool:
+      return &WriteElement<ValueKind::kBool, kRepeated>;
+    case ValueKind::kEnum:
+      return &WriteElement<ValueKind::kEnum, kRepeated>;
+    case ValueKind::kString:
+      return &WriteElement<ValueKind::kString, kRepeated>;
+    case ValueKind::kBytes:
+      return &WriteElement<ValueKind::kBytes, kRepeated>;
+    default:
+      return &WriteElement<ValueKind::kMessage, kRepeated>;
+  }
+}
+
+// json -> pb
+
+bool ParseDouble(std::string_view str, double* value) {
+  if (str == "NaN") {
+    *value = std::numeric_limits<double>::quiet_NaN();
+  } else if (str == "Infinity") {
+    *value = std::numeric_limits<double>::infinity();
+  } else if (str == "-Infinity") {
+    *value = -std::numeric_limits<double>::infinity();
+  } else {
+    std::string copy(str);
+    char* end = nullptr;
+    *value = strtod(copy.c_str(), &end);
+    return !copy.empty() && end == copy.c_str() + copy.size();
+  }
+  return true;
+}
+
+bool ToInt64(const JsonScalar& scalar, int64_t* value) {
+  switch (scalar.type) {
+    case JsonScalar::Type::kInt64:
+      *value = scalar.int64_value;
+      return true;
+    case JsonScalar::Type::kUint64:
+      *value = static_cast<int64_t>(scalar.uint64_value);
+      return scalar.uint64_value <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+    case JsonScalar::Type::kDouble:
+      *value = static_cast<int64_t>(scalar.double_value);
+      return std::trunc(scalar.double_value) == scalar.double_value && scalar.double_value >= -0x1p63 &&
+             scalar.double_value < 0x1p63;
+    case JsonScalar::Type::kString: {
+      const char* end = scalar.string_value.data() + scalar.string_value.size();
+      auto result = std::from_chars(scalar.string_value.data(), end, *value);
+      return result.ec == std::errc() && result.ptr == end;
+    }
+    default:
+      return false;
+  }
+}
+
+bool ToUint64(const JsonScalar& scalar, uint64_t* value) {
+  switch (scalar.type) {
+    case JsonScalar::Type::kInt64:
+      *value = static_cast<uint64_t>(scalar.int64_value);
+      return scalar.int64_value >= 0;
+    case JsonScalar::Type::kUint64:
+      *value = scalar.uint64_value;
+      return true;
+    case JsonScalar::Type::kDouble:
+      *value = static_cast<uint64_t>(scalar.double_value);
+      return std::trunc(scalar.double_value) == scalar.double_value && scalar.double_value >= 0 &&
+             scalar.double_value < 0x1p64;
+    case JsonScalar::Type::kString: {
+      const char* end = scalar.string_value.data() + scalar.string_value.size();
+      auto result = std::from_chars(scalar.string_value.data(), end, *value);
+      return result.ec == std::errc() && result.ptr == end;
+    }
+    default:
+      return false;
+  }
+}
+
+bool ToDouble(const JsonScalar& scalar, double* value) {
+  switch (scalar.type) {
+    case JsonScalar::Type::kInt64:
+      *value = static_cast<double>(scalar.int64_value);
+      return true;
+    case JsonScalar::Type::kUint64:
+      *value = static_cast<double>(scalar.uint64_value);
+      return true;
+    case JsonScalar::Type::kDouble:
+      *value = scalar.double_value;
+      return true;
+    case JsonScalar::Type::kString:
+      return ParseDouble(scalar.string_value, value);
+    default:
+      return false;
+  }
+}
+
+template <ValueKind kKind, bool kAdd>
+bool SetElement(Message* message, const FieldDescriptor* field, const JsonScalar& scalar) {
+  const Reflection* reflection = message->GetReflection();
+  if constexpr (kKind == ValueKind::kInt32) {
+    int64_t value;
+    if (!ToInt64(scalar, &value) || value < std::numeric_limits<int32_t>::min() ||
+        value > std::numeric_limits<int32_t>::max()) {
+      return false;
+    }
+    kAdd ? reflection->AddInt32(message, field, value) : reflection->SetInt32(message, field, value);
+  } else if constexpr (kKind == ValueKind::kUint32) {
+    uint64_t value;
+    if (!ToUint64(scalar, &value) || value > std::numeric_limits<uint32_t>::max()) {
+      return false;
+    }
+    kAdd ? reflection->AddUInt32(message, field, value) : reflection->SetUInt32(message, field, value);
+  } else if constexpr (kKind == ValueKind::kInt64) {
+    int64_t value;
+    if (!ToInt64(scalar, &value)) {
+      return false;
+    }
+    kAdd ? reflection->AddInt64(message, field, value) : reflection->SetInt64(message, field, value);
+  } else if constexpr (kKind == ValueKind::kUint64) {
+    uint64_t value;
+    if (!ToUint64(scalar, &value)) {
+      return false;
+    }
+    kAdd ? reflection->AddUInt64(message, field, value) : reflection->SetUInt64(message, field, value);
+  } else if constexpr (kKind == ValueKind::kFloat) {
+    double value;
+    if (!ToDouble(scalar, &value) || (std::isfinite(value) && std::fabs(value) > FLT_MAX)) {
+      return false;
+    }
+    kAdd ? reflection->AddFloat(message, field, static_cast<float>(value))
+         : reflection->SetFloat(message, field, static_cast<float>(value));
+  } else if constexpr (kKind == ValueKind::kDouble) {
+    double value;
+    if (!ToDouble(scalar, &value)) {
+      return false;
+    }
+    kAdd ? reflection->AddDouble(message, field, value) : reflection->SetDouble(message, field, value);
+  } else if constexpr (kKind == ValueKind::kBool) {
+    if (scalar.type != JsonScalar::Type::kBool) {
+      return false;
+    }
+    kAdd ? reflection->AddBool(message, field, scalar.bool_value)
+         : reflection->SetBool(message, field, scalar.bool_value);
+  } else if constexpr (kKind == ValueKind::kEnum) {
+    int value;
+    if (scalar.type == JsonScalar::Type::kString) {
+      const auto* enum_value = field->enum_type()->FindValueByName(std::string(scalar.string_value));
+      if (enum_value == nullptr) {
+        // Unknown enum names are ignored like unknown fields.
+        return true;
+      }
+      value = enum_value->number();
+    } else {
+      int64_t number;
+      if (!ToInt64(scalar, &number) || number < std::numeric_limits<int32_t>::min() ||
+          number > std::numeric_limits<int32_t>::max()) {
+        return false;
+      }
+      value = static_cast<int>(number);
+    }
+    kAdd ? reflection->AddEnumValue(message, field, value) : reflection->SetEnumValue(message, field, value);
+  } else if constexpr (kKind == ValueKind::kString || kKind == ValueKind::kBytes) {
+    if (scalar.type != JsonScalar::Type::kString) {
+      return false;
+    }
+    std::string value;
+    if constexpr (kKind == ValueKind::kBytes) {
+      // Both standard and url-safe alphabets are accepted.
+      google::protobuf::StringPiece encoded(scalar.string_value.data(), scalar.string_value.size());
+      if (!google::protobuf::Base64Unescape(encoded, &value) &&
+          !google::protobuf::WebSafeBase64Unescape(encoded, &value)) {
+        return false;
+      }
+    } else {
+      value.assign(scalar.string_value);
+    }
+    kAdd ? reflection->AddString(message, field, std::move(value))
+         : reflection->SetString(message, field, std::move(value));
+  } else {
+    // Messages are filled by the nested json objects.
+    return false;
+  }
+  return true;
+}
+
+template <bool kAdd>
+SetElementFn SelectSetElement(ValueKind kind) {
+  switch (kind) {
+    case ValueKind::kInt32:
+      return &SetElement<ValueKind::kInt32, kAdd>;
+    case ValueKind::kUint32:
+      return &SetElement<ValueKind::kUint32, kAdd>;
+    case ValueKind::kInt64:
+      return &SetElement<ValueKind::kInt64, kAdd>;
+    case ValueKind::kUint64:
+      return &SetElement<ValueKind::kUint64, kAdd>;
+    case ValueKind::kFloat:
+      return &SetElement<ValueKind::kFloat, kAdd>;
+    case ValueKind::kDouble:
+      return &SetElement<ValueKind::kDouble, kAdd>;
+    case ValueKind::kBool:
+      return &SetElement<ValueKind::kBool, kAdd>;
+    case ValueKind::kEnum:
+      return &SetElement<ValueKind::kEnum, kAdd>;
+    case ValueKind::kString:
+      return &SetElement<ValueKind::kString, kAdd>;
+    case ValueKind::kBytes:
+      return &SetElement<ValueKind::kBytes, kAdd>;
+    default:
+      return &SetElement<ValueKind::kMessage, kAdd>;
+  }
+}
+
+// Map keys are always json strings.
+bool SetMapKey(Message* map_entry, const FieldEntry& entry, std::string_view key) {
+  JsonScalar scalar;
+  if (entry.map_key->cpp_type() == FieldDescriptor::CPPTYPE_BOOL) {
+    if (key != "true" && key != "false") {
+      return false;
+    }
+    scalar.type = JsonScalar::Type::kBool;
+    scalar.bool_value = key == "true";
+  } else {
+    scalar.type = JsonScalar::Type::kString;
+    scalar.string_value = key;
+  }
+  return entry.set_map_key(map_entry, entry.map_key, scalar);
+}
+
+// Plans are compiled once per message type and never released, as descriptors live as long as the process.
+class MessageTableCache {
+ public:
+  static MessageTableCache* GetInstance() {
+    static MessageTableCache instance;
+    return &instance;
+  }
+
+  const MessageTable* Get(const Descriptor* descriptor) {
+    {
+      std::shared_lock lock(mutex_);
+      auto it = tables_.find(descriptor);
+      if (TRPC_LIKELY(it != tables_.end())) {
+        return it->second.get();
+      }
+    }
+
+    std::unique_lock lock(mutex_);
+    return Build(descriptor);
+  }
+
+ private:
+  // Builds the tables of |descriptor| and the message types it references. The table of a recursive message type may
+  // be referenced before it is completed, so `supported` of the referencing tables is only a hint, nested unsupported
+  // messages are still detected during conversion.
+  MessageTable* Build(const Descriptor* descriptor) {
+    auto [it, inserted] = tables_.try_emplace(descriptor);
+    if (!inserted) {
+      return it->second.get();
+    }
+    it->second = std::make_unique<MessageTable>();
+    MessageTable* table = it->second.get();
+
+    if (!IsSupported(descriptor)) {
+      table->supported = false;
+      return table;
+    }
+
+    table->fields.reserve(descriptor->field_count());
+    for (int i = 0; i < descriptor->field_count(); ++i) {
+      const FieldDescriptor* field = descriptor->field(i);
+
+      FieldEntry entry;
+      entry.field = field;
+      entry.kind = GetValueKind(field);
+      entry.is_repeated = field->is_repeated();
+      entry.is_map = field->is_map();
+      entry.print_if_set =
+          field->containing_oneof() != nullptr || (!entry.is_repeated && entry.kind == ValueKind::kMessage);
+
+      if (entry.is_map) {
+        entry.map_key = field->message_type()->FindFieldByNumber(1);
+        entry.map_value = field->message_type()->FindFieldByNumber(2);
+        entry.map_value_kind = GetValueKind(entry.map_value);
+        if (entry.map_value_kind == ValueKind::kMessage) {
+          entry.message_table = Build(entry.map_value->message_type());
+        }
+        entry.write_field = &WriteMapField;
+        entry.write_element = SelectWriteElement<false>(entry.map_value_kind);
+        entry.set_element = SelectSetElement<false>(entry.map_value_kind);
+        entry.set_map_key = SelectSetElement<false>(GetValueKind(entry.map_key));
+      } else {
+        if (entry.kind == ValueKind::kMessage) {
+          entry.message_table = Build(field->message_type());
+        }
+        entry.write_field = entry.is_repeated ? &WriteRepeatedField : &WriteSingularField;
+        entry.write_element =
+            entry.is_repeated ? SelectWriteElement<true>(entry.kind) : SelectWriteElement<false>(entry.kind);
+        entry.set_element =
+            entry.is_repeated ? SelectSetElement<true>(entry.kind) : SelectSetElement<false>(entry.kind);
+        if (!entry.is_repeated && field->type() == FieldDescriptor::TYPE_BYTES && field->has_default_value()) {
+          entry.write_field = &WriteBytesWithDefaultField;
+        }
+      }
+
+      if (entry.message_table && !entry.message_table->supported) {
+        table->supported = false;
+      }
+      table->fields.push_back(entry);
+    }
+
+    // Same order as `Pb2Json`: fields in declaration order, followed by members of oneof in field number order.
+    std::stable_sort(table->fields.begin(), table->fields.end(), [](const FieldEntry& a, const FieldEntry& b) {
+      bool a_in_oneof = a.field->containing_oneof() != nullptr;
+      bool b_in_oneof = b.field->containing_oneof() != nullptr;
+      if (a_in_oneof != b_in_oneof) {
+        return b_in_oneof;
+      }
+      return a_in_oneof && a.field->number() < b.field->number();
+    });
+    table->fields_by_name.Build(table->fields);
+    return table;
+  }
+
+  static bool IsSupported(const Descriptor* descriptor) {
+    // Well-known types have their own json mapping.
+    if (descriptor->file()->package() == "google.protobuf") {
+      return false;
+    }
+    if (descriptor->extension_range_count() > 0) {
+      return false;
+    }
+    for (int i = 0; i < descriptor->field_count(); ++i) {
+      if (descriptor->field(i)->type() == FieldDescriptor::TYPE_GROUP) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  std::shared_mutex mutex_;
+  std::unordered_map<const Descriptor*, std::unique_ptr<MessageTable>> tables_;
+};
+
+// SAX handler filling the message with the json events.
+class JsonToPbHandler {
+ public:
+  JsonToPbHandler(Message* message, const MessageTable* table) : root_(message), root_table_(table) {}
+
+  // Whether the conversion failed because of a nested message which is not supported by the transcoder.
+  bool Unsupported() const { return unsupported_; }
+
+  bool Null() { return OnScalar(JsonScalar{}); }
+
+  bool Bool(bool value) {
+    JsonScalar scalar;
+    scalar.type = JsonScalar::Type::kBool;
+    scalar.bool_value = value;
+    return OnScalar(scalar);
+  }
+
+  bool Int(int value) { return Int64(value); }
+
+  bool Uint(unsigned value) { return Int64(value); }
+
+  bool Int64(int64_t value) {
+    JsonScalar scalar;
+    scalar.type = JsonScalar::Type::kInt64;
+    scalar.int64_value = value;
+    return OnScalar(scalar);
+  }
+
+  bool Uint64(uint64_t value) {
+    JsonScalar scalar;
+    scalar.type = JsonScalar::Type::kUint64;
+    scalar.uint64_value = value;
+    return OnScalar(scalar);
+  }
+
+  bool Double(double value) {
+    JsonScalar scalar;
+    scalar.type = JsonScalar::Type::kDouble;
+    scalar.double_value = value;
+    return OnScalar(scalar);
+  }
+
+  bool RawNumber(const char*, rapidjson::SizeType, bool) {
+    // `kParseNumbersAsStringsFlag` is not used.
+    return false;
+  }
+
+  bool String(const char* str, rapidjson::SizeType length, bool) {
+    JsonScalar scalar;
+    scalar.type = JsonScalar::Type::kString;
+    scalar.string_value = std::string_view(str, length);
+    return OnScalar(scalar);
+  }
+
+  bool StartObject() {
+    if (stack_.empty()) {
+      stack_.push_back(Frame{FrameType::kMessage, root_, root_table_});
+      return true;
+    }
+
+    Frame& top = stack_.back();
+    switch (top.type) {
+      case FrameType::kSkip:
+        ++top.skip_depth;
+        return true;
+      case FrameType::kMessage: {
+        const FieldEntry* entry = top.field;
+        if (entry == nullptr) {
+          stack_.push_back(Frame{FrameType::kSkip});
+          return true;
+        }
+        if (entry->is_map) {
+          stack_.push_back(Frame{FrameType::kMap, top.message, nullptr, entry});
+          return true;
+        }
+        if (entry->is_repeated || entry->kind != ValueKind::kMessage) {
+          return false;
+        }
+        return PushMessage(top.message->GetReflection()->MutableMessage(top.message, entry->field),
+                           entry->message_table);
+      }
+      case FrameType::kRepeated: {
+        const FieldEntry* entry = top.field;
+        if (entry->kind != ValueKind::kMessage) {
+          return false;
+        }
+        return PushMessage(top.message->GetReflection()->AddMessage(top.message, entry->field), entry->message_table);
+      }
+      case FrameType::kMap: {
+        const FieldEntry* entry = top.field;
+        if (entry->map_value_kind != ValueKind::kMessage) {
+          return false;
+        }
+        Message* map_entry = top.message->GetReflection()->AddMessage(top.message, entry->field);
+        if (!SetMapKey(map_entry, *entry, top.map_key)) {
+          return false;
+        }
+        return PushMessage(map_entry->GetReflection()->MutableMessage(map_entry, entry->map_value),
+                           entry->message_table);
+      }
+    }
+    return false;
+  }
+
+  bool Key(const char* str, rapidjson::SizeType length, bool) {
+    Frame& top = stack_.back();
+    switch (top.type) {
+      case FrameType::kSkip:
+        return true;
+      case FrameType::kMessage: {
+        // Unknown fields are ignored.
+        top.field = top.table->fields_by_name.Find(std::string_view(str, length));
+        return true;
+      }
+      case FrameType::kMap:
+        top.map_key.assign(str, length);
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  bool EndObject(rapidjson::SizeType) { return PopFrame(); }
+
+  bool StartArray() {
+    if (stack_.empty()) {
+      return false;
+    }
+
+    Frame& top = stack_.back();
+    switch (top.type) {
+      case FrameType::kSkip:
+        ++top.skip_depth;
+        return true;
+      case FrameType::kMessage: {
+        const FieldEntry* entry = top.field;
+        if (entry == nullptr) {
+          stack_.push_back(Frame{FrameType::kSkip});
+          return true;
+        }
+        if (!entry->is_repeated || entry->is_map) {
+          return false;
+        }
+        stack_.push_back(Frame{FrameType::kRepeated, top.message, nullptr, entry});
+        return true;
+      }
+      default:
+        return false;
+    }
+  }
+
+  bool EndArray(rapidjson::SizeType) { return PopFrame(); }
+
+ private:
+  enum class FrameType { kMessage, kRepeated, kMap, kSkip };
+
+  struct Frame {
+    FrameType type;
+    // kMessage: the message to fill. kRepeated/kMap: the message owning the field.
+    Message* message{nullptr};
+    // kMessage: table of the message.
+    const MessageTable* table{nullptr};
+    // kMessage: the field of the last key, nullptr for unknown fields. kRepeated/kMap: the repeated/map field.
+    const FieldEntry* field{nullptr};
+    // kMap: the last key.
+    std::string map_key;
+    // kSkip: nesting depth of the skipped value.
+    int skip_depth{1};
+  };
+
+  bool PushMessage(Message* message, const MessageTable* table) {
+    if (TRPC_UNLIKELY(!table->supported)) {
+      unsupported_ = true;
+      return false;
+    }
+    stack_.push_back(Frame{FrameType::kMessage, message, table});
+    return true;
+  }
+
+  bool PopFrame() {
+    Frame& top = stack_.back();
+    if (top.type == FrameType::kSkip && --top.skip_depth > 0) {
+      return true;
+    }
+    stack_.pop_back();
+    return true;
+  }
+
+  bool OnScalar(const JsonScalar& scalar) {
+    if (TRPC_UNLIKELY(stack_.empty())) {
+      // The root has to be an object.
+      return false;
+    }
+
+    Frame& top = stack_.back();
+    bool is_null = scalar.type == JsonScalar::Type::kNull;
+    switch (top.type) {
+      case FrameType::kSkip:
+        return true;
+      case FrameType::kMessage: {
+        const FieldEntry* entry = top.field;
+        // Null means the default value.
+        if (entry == nullptr || is_null) {
+          return true;
+        }
+        if (entry->is_repeated || entry->kind == ValueKind::kMessage) {
+          return false;
+        }
+        return entry->set_element(top.message, entry->field, scalar);
+      }
+      case FrameType::kRepeated: {
+        const FieldEntry* entry = top.field;
+        if (is_null || entry->kind == ValueKind::kMessage) {
+          return false;
+        }
+        return entry->set_element(top.message, entry->field, scalar);
+      }
+      case FrameType::kMap: {
+        const FieldEntry* entry = top.field;
+        if (is_null || entry->map_value_kind == ValueKind::kMessage) {
+          return false;
+        }
+        Message* map_entry = top.message->GetReflection()->AddMessage(top.message, entry->field);
+        return SetMapKey(map_entry, *entry, top.map_key) && entry->set_element(map_entry, entry->map_value, scalar);
+      }
+    }
+    return false;
+  }
+
+ private:
+  Message* root_;
+  const MessageTable* root_table_;
+  std::vector<Frame> stack_;
+  bool unsupported_{false};
+};
+
+}  // namespace
+
+void PbJsonTranscoder::Precompile(const google::protobuf::Descriptor* descriptor) {
+  MessageTableCache::GetInstance()->Get(descriptor);
+}
+
+bool PbJsonTranscoder::PbToJson(const google::protobuf::Message& message, NoncontiguousBufferBuilder* output) {
+  // Missing required fields of proto2 fail the conversion of `Pb2Json`, it is checked before the fallback as well.
+  if (TRPC_UNLIKELY(!message.IsInitialized())) {
+    return false;
+  }
+
+  const MessageTable* table = MessageTableCache::GetInstance()->Get(message.GetDescriptor());
+  if (TRPC_LIKELY(table->supported)) {
+    // Written into a separate builder, so nothing is left in |output| if it falls back to `Pb2Json`.
+    NoncontiguousBufferBuilder builder;
+    NoncontiguousBufferJsonOutputStream os(&builder);
+    JsonWriter writer(os);
+    if (TRPC_LIKELY(WriteMessage(message, *table, &writer))) {
+      output->Append(builder.DestructiveGet());
+      return true;
+    }
+  }
+
+  std::string json;
+  if (!Pb2Json::PbToJson(message, &json)) {
+    return false;
+  }
+  output->Append(json);
+  return true;
+}
+
+bool PbJsonTranscoder::JsonToPb(const NoncontiguousBuffer& json, google::protobuf::Message* message) {
+  const MessageTable* table = MessageTableCache::GetInstance()->Get(message->GetDescriptor());
+  // Empty input is left to `Pb2Json` to keep its behavior.
+  if (TRPC_LIKELY(table->supported && !json.Empty())) {
+    message->Clear();
+
+    NoncontiguousBufferJsonInputStream is(json);
+    JsonToPbHandler handler(message, table);
+    rapidjson::Reader reader;
+    // Invalid UTF-8 is rejected, as protobuf json util does.
+    rapidjson::ParseResult result =
+        reader.Parse<rapidjson::kParseFullPrecisionFlag | rapidjson::kParseValidateEncodingFlag>(is, handler);
+    if (TRPC_LIKELY(!result.IsError())) {
+      // Same as `Pb2Json`, json missing required fields of proto2 is rejected.
+      return message->IsInitialized();
+    }
+    if (!handler.Unsupported()) {
+      return false;
+    }
+  }
+
+  return Pb2Json::JsonToPb(FlattenSlow(json), message);
+}
+
+}  // namespace trpc
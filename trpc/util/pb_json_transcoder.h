@@ -0,0 +1,56 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include "google/protobuf/message.h"
+
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+
+namespace trpc {
+
+/// @brief Streaming conversion between pb and json.
+///
+/// Unlike `Pb2Json`, no intermediate string is built: the json is written into the blocks of
+/// `NoncontiguousBufferBuilder` directly, and is parsed by a SAX reader over the blocks of `NoncontiguousBuffer`.
+///
+/// Each message type is compiled once into a plan: the fields in output order, a hashed index of field names, and the
+/// type handlers of each field. The conversion is a loop over the plan, without the per-field type dispatch and the
+/// name lookups of reflection based conversion. Plans are compiled on first use, or ahead of time by `Precompile`.
+///
+/// The json is the same as the one of `Pb2Json`: proto field names are preserved, enums are printed as ints, primitive
+/// fields are always printed, unknown json fields are ignored and missing required fields of proto2 fail the
+/// conversion. Strings are escaped the same as well, e.g. '<', '>', U+2028 and U+2029 are escaped, and json of invalid
+/// UTF-8 is rejected. Messages using well-known types(`google.protobuf.*`), groups or extensions, or holding strings
+/// of invalid UTF-8, are converted by `Pb2Json`.
+class PbJsonTranscoder {
+ public:
+  /// @brief Compiles the plans of the message type and the message types it references, so the first conversion does
+  ///        not pay for it. It is thread-safe and does nothing if the plans are compiled already.
+  /// @param descriptor is the descriptor of the message type.
+  static void Precompile(const google::protobuf::Descriptor* descriptor);
+
+  /// @brief pb to json
+  /// @param message is the message to convert.
+  /// @param[out] output is the builder the json is appended to.
+  /// @return Returns true on success.
+  static bool PbToJson(const google::protobuf::Message& message, NoncontiguousBufferBuilder* output);
+
+  /// @brief json to pb
+  /// @param json is the json to convert, it is not consumed.
+  /// @param[out] message saves the converted message.
+  /// @return Returns true on success.
+  static bool JsonToPb(const NoncontiguousBuffer& json, google::protobuf::Message* message);
+};
+
+}  // namespace trpc
@@ -0,0 +1,204 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+// Compares `PbJsonTranscoder` with `Pb2Json` over a set of generated message types, and checks that they produce the
+// same results. The timings are printed only, they are not asserted.
+
+#include <chrono>
+#include <cstdio>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "google/protobuf/descriptor.h"
+#include "google/protobuf/descriptor.pb.h"
+#include "google/protobuf/dynamic_message.h"
+#include "google/protobuf/util/message_differencer.h"
+#include "gtest/gtest.h"
+
+#include "trpc/util/buffer/buffer.h"
+#include "trpc/util/pb2json.h"
+#include "trpc/util/pb_json_transcoder.h"
+
+namespace trpc::testing {
+
+namespace {
+
+using google::protobuf::FieldDescriptor;
+using google::protobuf::FieldDescriptorProto;
+using google::protobuf::Message;
+
+constexpr int kMessageTypes = 50;
+constexpr int kIterations = 200;
+
+// Builds message types `M0`...`M49` with 4 to 20 fields of mixed types, each type `Mi` (i > 0) also has a singular and
+// a repeated field of type `M(i-1)`.
+class MessageTypes {
+ public:
+  MessageTypes() {
+    google::protobuf::FileDescriptorProto file;
+    file.set_name("pb_json_transcoder_benchmark.proto");
+    file.set_package("trpc.benchmark");
+    file.set_syntax("proto3");
+
+    const FieldDescriptorProto::Type kScalarTypes[] = {
+        FieldDescriptorProto::TYPE_INT32,  FieldDescriptorProto::TYPE_INT64,  FieldDescriptorProto::TYPE_UINT32,
+        FieldDescriptorProto::TYPE_UINT64, FieldDescriptorProto::TYPE_DOUBLE, FieldDescriptorProto::TYPE_FLOAT,
+        FieldDescriptorProto::TYPE_BOOL,   FieldDescriptorProto::TYPE_STRING, FieldDescriptorProto::TYPE_BYTES,
+    };
+    for (int i = 0; i < kMessageTypes; ++i) {
+      auto* type = file.add_message_type();
+      type->set_name("M" + std::to_string(i));
+      int field_count = 4 + i % 17;
+      int number = 1;
+      for (int j = 0; j < field_count; ++j, ++number) {
+        auto* field = type->add_field();
+        field->set_name("field_" + std::to_string(number));
+        field->set_number(number);
+        field->set_type(kScalarTypes[(i + j) % std::size(kScalarTypes)]);
+        field->set_label(j % 4 == 3 ? FieldDescriptorProto::LABEL_REPEATED : FieldDescriptorProto::LABEL_OPTIONAL);
+      }
+      if (i > 0) {
+        for (auto label : {FieldDescriptorProto::LABEL_OPTIONAL, FieldDescriptorProto::LABEL_REPEATED}) {
+          auto* field = type->add_field();
+          field->set_name("child_" + std::to_string(number));
+          field->set_number(number++);
+          field->set_type(FieldDescriptorProto::TYPE_MESSAGE);
+          field->set_type_name(".trpc.benchmark.M" + std::to_string(i - 1));
+          field->set_label(label);
+        }
+      }
+    }
+
+    const auto* file_descriptor = pool_.BuildFile(file);
+    for (int i = 0; i < kMessageTypes; ++i) {
+      // Children are filled at most two levels deep, so the sizes of messages stay moderate.
+      auto message = std::unique_ptr<Message>(factory_.GetPrototype(file_descriptor->message_type(i))->New());
+      Fill(message.get(), i % 3);
+      messages_.push_back(std::move(message));
+    }
+  }
+
+  const std::vector<std::unique_ptr<Message>>& Messages() const { return messages_; }
+
+ private:
+  static void Fill(Message* message, int depth) {
+    const auto* reflection = message->GetReflection();
+    const auto* descriptor = message->GetDescriptor();
+    for (int i = 0; i < descriptor->field_count(); ++i) {
+      const FieldDescriptor* field = descriptor->field(i);
+      int count = field->is_repeated() ? 3 : 1;
+      for (int k = 0; k < count; ++k) {
+        bool add = field->is_repeated();
+        switch (field->cpp_type()) {
+          case FieldDescriptor::CPPTYPE_INT32:
+            add ? reflection->AddInt32(message, field, -12345 - k) : reflection->SetInt32(message, field, -12345);
+            break;
+          case FieldDescriptor::CPPTYPE_INT64:
+            add ? reflection->AddInt64(message, field, -1234567890123 - k)
+                : reflection->SetInt64(message, field, -1234567890123);
+            break;
+          case FieldDescriptor::CPPTYPE_UINT32:
+            add ? reflection->AddUInt32(message, field, 4000000000U - k)
+                : reflection->SetUInt32(message, field, 4000000000U);
+            break;
+          case FieldDescriptor::CPPTYPE_UINT64:
+            add ? reflection->AddUInt64(message, field, 12345678901234567890ULL - k)
+                : reflection->SetUInt64(message, field, 12345678901234567890ULL);
+            break;
+          case FieldDescriptor::CPPTYPE_DOUBLE:
+            add ? reflection->AddDouble(message, field, 3.14159265358979 + k)
+                : reflection->SetDouble(message, field, 3.14159265358979);
+            break;
+          case FieldDescriptor::CPPTYPE_FLOAT:
+            add ? reflection->AddFloat(message, field, 0.1f + k) : reflection->SetFloat(message, field, 0.1f);
+            break;
+          case FieldDescriptor::CPPTYPE_BOOL:
+            add ? reflection->AddBool(message, field, k % 2) : reflection->SetBool(message, field, true);
+            break;
+          case FieldDescriptor::CPPTYPE_STRING:
+            add ? reflection->AddString(message, field, "value of a string field")
+                : reflection->SetString(message, field, "value of a string field");
+            break;
+          case FieldDescriptor::CPPTYPE_MESSAGE:
+            if (depth > 0) {
+              Fill(add ? reflection->AddMessage(message, field) : reflection->MutableMessage(message, field),
+                   depth - 1);
+            }
+            break;
+          default:
+            break;
+        }
+      }
+    }
+  }
+
+ private:
+  google::protobuf::DescriptorPool pool_;
+  google::protobuf::DynamicMessageFactory factory_;
+  std::vector<std::unique_ptr<Message>> messages_;
+};
+
+template <typename F>
+double MeasureNsPerOp(F&& f) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kIterations; ++i) {
+    f();
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  return std::chrono::duration<double, std::nano>(elapsed).count() / kIterations;
+}
+
+}  // namespace
+
+TEST(PbJsonTranscoderBenchmark, CompareWithPb2Json) {
+  MessageTypes types;
+
+  double pb2json_to_json = 0, transcoder_to_json = 0;
+  double pb2json_to_pb = 0, transcoder_to_pb = 0;
+  for (const auto& message : types.Messages()) {
+    PbJsonTranscoder::Precompile(message->GetDescriptor());
+
+    std::string expected;
+    ASSERT_TRUE(Pb2Json::PbToJson(*message, &expected));
+    NoncontiguousBufferBuilder builder;
+    ASSERT_TRUE(PbJsonTranscoder::PbToJson(*message, &builder));
+    NoncontiguousBuffer json = builder.DestructiveGet();
+    ASSERT_EQ(FlattenSlow(json), expected);
+
+    std::unique_ptr<Message> parsed(message->New());
+    ASSERT_TRUE(PbJsonTranscoder::JsonToPb(json, parsed.get()));
+    ASSERT_TRUE(google::protobuf::util::MessageDifferencer::Equals(*parsed, *message));
+
+    pb2json_to_json += MeasureNsPerOp([&] {
+      std::string output;
+      Pb2Json::PbToJson(*message, &output);
+    });
+    transcoder_to_json += MeasureNsPerOp([&] {
+      NoncontiguousBufferBuilder output;
+      PbJsonTranscoder::PbToJson(*message, &output);
+      output.DestructiveGet();
+    });
+    pb2json_to_pb += MeasureNsPerOp([&] { Pb2Json::JsonToPb(expected, parsed.get()); });
+    transcoder_to_pb += MeasureNsPerOp([&] { PbJsonTranscoder::JsonToPb(json, parsed.get()); });
+  }
+
+  printf("%d message types, average ns/op:\n", kMessageTypes);
+  printf("  pb -> json: Pb2Json %.0f, PbJsonTranscoder %.0f\n", pb2json_to_json / kMessageTypes,
+         transcoder_to_json / kMessageTypes);
+  printf("  json -> pb: Pb2Json %.0f, PbJsonTranscoder %.0f\n", pb2json_to_pb / kMessageTypes,
+         transcoder_to_pb / kMessageTypes);
+}
+
+}  // namespace trpc::testing
@@ -0,0 +1,283 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/util/pb_json_transcoder.h"
+
+#include <string>
+
+#include "google/protobuf/timestamp.pb.h"
+#include "google/protobuf/util/message_differencer.h"
+#include "gtest/gtest.h"
+
+#include "trpc/util/buffer/buffer.h"
+#include "trpc/util/pb2json.h"
+#include "trpc/util/testing/testjson.pb.h"
+#include "trpc/util/testing/testjson_proto2.pb.h"
+
+namespace trpc::testing {
+
+using google::protobuf::util::MessageDifferencer;
+
+namespace {
+
+trpc::test::TestComplexMessage MakeComplexMessage() {
+  trpc::test::TestComplexMessage msg;
+  msg.set_i32(-32);
+  msg.set_i64(-6400000000);
+  msg.set_u32(4000000000);
+  msg.set_u64(18000000000000000000ULL);
+  msg.set_s32(-5);
+  msg.set_f64(64);
+  msg.set_f(0.1f);
+  msg.set_d(3.1415926);
+  msg.set_b(true);
+  msg.set_s("hello \"json\"\n");
+  msg.set_bs(std::string("\0\1\2bytes", 8));
+  msg.set_color(trpc::test::BLUE);
+  msg.mutable_nested()->set_name("nested");
+  msg.mutable_nested()->set_value(1);
+  msg.add_ri32(1);
+  msg.add_ri32(-1);
+  msg.add_rs("a");
+  msg.add_rs("b");
+  msg.add_rnested()->set_name("r1");
+  msg.add_rnested()->set_value(2);
+  msg.set_choice_i(20);
+  msg.mutable_child()->set_s("child");
+  msg.mutable_child()->mutable_child()->set_d(1e100);
+  return msg;
+}
+
+std::string ToJson(const google::protobuf::Message& msg) {
+  NoncontiguousBufferBuilder builder;
+  EXPECT_TRUE(PbJsonTranscoder::PbToJson(msg, &builder));
+  return FlattenSlow(builder.DestructiveGet());
+}
+
+NoncontiguousBuffer SplitToBlocks(const std::string& data, std::size_t block_size) {
+  NoncontiguousBuffer buffer;
+  for (std::size_t pos = 0; pos < data.size(); pos += block_size) {
+    buffer.Append(CreateBufferSlow(data.substr(pos, block_size)));
+  }
+  return buffer;
+}
+
+}  // namespace
+
+TEST(PbJsonTranscoderTest, PbToJson) {
+  trpc::test::TestComplexMessage empty;
+  trpc::test::TestComplexMessage complex = MakeComplexMessage();
+
+  for (const auto* msg : {&empty, &complex}) {
+    std::string expected;
+    ASSERT_TRUE(Pb2Json::PbToJson(*msg, &expected));
+    ASSERT_EQ(ToJson(*msg), expected);
+  }
+}
+
+TEST(PbJsonTranscoderTest, MapToJson) {
+  trpc::test::TestComplexMessage msg;
+  (*msg.mutable_msi())["key"] = 1;
+  (*msg.mutable_mln())[-1].set_name("value");
+
+  std::string expected;
+  ASSERT_TRUE(Pb2Json::PbToJson(msg, &expected));
+  ASSERT_EQ(ToJson(msg), expected);
+}
+
+TEST(PbJsonTranscoderTest, EscapeSameAsProtobuf) {
+  // Quote, backslash, control characters, html characters, C1 controls, invisible format characters such as U+2028
+  // and U+2029(a surrogate pair for the ones beyond the BMP), the characters left as they are, and invalid UTF-8.
+  const char* strings[] = {"\"\\/\b\f\n\r\t\x01\x1f",
+                           "<a href='x'>&amp;</a>",
+                           "\x7f\xc2\x80\xc2\x9f\xc2\xa0\xc2\xad",
+                           "\xe2\x80\x8b\xe2\x80\xa8\xe2\x80\xa9\xe2\x80\xaf",
+                           "\xef\xbb\xbf\xf3\xa0\x80\x81",
+                           "\xe6\x97\xa5\xf0\x9f\x98\x80",
+                           "a\xff",
+                           "\xc0\xaf",
+                           "\xed\xa0\x80"};
+  for (const char* s : strings) {
+    trpc::test::TestComplexMessage msg;
+    msg.set_s(s);
+    msg.add_rs(s);
+    (*msg.mutable_msi())[s] = 1;
+
+    std::string expected;
+    ASSERT_TRUE(Pb2Json::PbToJson(msg, &expected));
+    ASSERT_EQ(ToJson(msg), expected);
+  }
+}
+
+TEST(PbJsonTranscoderTest, EnumsAsIntsSameAsPb2Json) {
+  trpc::test::TestComplexMessage msg;
+  msg.set_color(static_cast<trpc::test::TestColor>(100));
+  msg.add_ri32(1);
+
+  std::string expected;
+  ASSERT_TRUE(Pb2Json::PbToJson(msg, &expected));
+  ASSERT_EQ(ToJson(msg), expected);
+  ASSERT_NE(expected.find(R"("color":100)"), std::string::npos) << expected;
+}
+
+TEST(PbJsonTranscoderTest, Proto2PbToJsonSameAsPb2Json) {
+  // Unset fields are printed with the declared defaults, except the unset messages and oneof members.
+  trpc::test::TestProto2Message unset;
+  unset.set_id(1);
+
+  // Fields set to the zero values, which differ from the declared defaults.
+  trpc::test::TestProto2Message zero;
+  zero.set_id(0);
+  zero.set_i32(0);
+  zero.set_i64(0);
+  zero.set_u64(0);
+  zero.set_f(0);
+  zero.set_d(0);
+  zero.set_b(false);
+  zero.set_s("");
+  zero.set_bs("");
+  zero.set_color(trpc::test::P2_RED);
+  zero.mutable_nested();
+  zero.set_choice_i(0);
+
+  // Fields set to the declared defaults explicitly.
+  trpc::test::TestProto2Message defaults;
+  defaults.set_id(1);
+  defaults.set_i64(-7);
+  defaults.set_b(true);
+  defaults.set_s("default \"s\"");
+  defaults.set_color(trpc::test::P2_BLUE);
+  defaults.mutable_nested()->set_value(3);
+  defaults.add_ri32(0);
+  defaults.add_rcolor(trpc::test::P2_GREEN);
+  (*defaults.mutable_mnested())["k"];
+  defaults.set_choice_s("");
+
+  for (const auto* msg : {&unset, &zero, &defaults}) {
+    std::string expected;
+    ASSERT_TRUE(Pb2Json::PbToJson(*msg, &expected));
+    ASSERT_EQ(ToJson(*msg), expected);
+  }
+
+  // Missing required fields fail the conversion, `Pb2Json` fails the check of serialization on them.
+  trpc::test::TestProto2Message missing_required;
+  missing_required.set_i32(1);
+  NoncontiguousBufferBuilder builder;
+  ASSERT_FALSE(PbJsonTranscoder::PbToJson(missing_required, &builder));
+  ASSERT_TRUE(builder.DestructiveGet().Empty());
+}
+
+TEST(PbJsonTranscoderTest, Proto2JsonToPbSameAsPb2Json) {
+  for (const auto* json : {R"({"id": 1})", R"({"id": 1, "i64": 0, "b": false, "color": 1, "nested": {}})",
+                           R"({"id": 1, "s": "default \"s\"", "color": "P2_GREEN", "choice_i": 9})",
+                           R"({"id": 1, "rcolor": [1, 5], "mnested": {"k": {"value": 0}}})",
+                           R"({"id": 1, "i32": null})", R"({"i32": 1})", R"({})"}) {
+    trpc::test::TestProto2Message expected;
+    bool expected_ok = Pb2Json::JsonToPb(std::string(json), &expected);
+
+    trpc::test::TestProto2Message msg;
+    ASSERT_EQ(PbJsonTranscoder::JsonToPb(CreateBufferSlow(json), &msg), expected_ok) << json;
+    if (expected_ok) {
+      ASSERT_TRUE(MessageDifferencer::Equals(msg, expected)) << json << ": " << msg.DebugString();
+      // Presence of the fields parsed is kept, so the fields set to the zero values are printed as set.
+      ASSERT_EQ(ToJson(msg), ToJson(expected));
+    }
+  }
+}
+
+TEST(PbJsonTranscoderTest, JsonToPb) {
+  trpc::test::TestComplexMessage expected = MakeComplexMessage();
+  (*expected.mutable_msi())["k1"] = 1;
+  (*expected.mutable_msi())["k2"] = 2;
+  (*expected.mutable_mln())[100].set_name("v1");
+  (*expected.mutable_mln())[-100].set_value(2);
+
+  std::string json;
+  ASSERT_TRUE(Pb2Json::PbToJson(expected, &json));
+
+  for (std::size_t block_size : {1, 3, 4096}) {
+    trpc::test::TestComplexMessage msg;
+    msg.set_choice_s("to be cleared");
+    ASSERT_TRUE(PbJsonTranscoder::JsonToPb(SplitToBlocks(json, block_size), &msg));
+    ASSERT_TRUE(MessageDifferencer::Equals(msg, expected)) << msg.DebugString();
+  }
+}
+
+TEST(PbJsonTranscoderTest, JsonToPbCompatible) {
+  std::string json = R"({
+    "choiceS": "json name",
+    "unknown": {"a": [1, {"b": [2]}], "c": null},
+    "i64": "123",
+    "u32": "7",
+    "color": "GREEN",
+    "f": "NaN",
+    "d": -1e300,
+    "bs": "aGVsbG8",
+    "nested": null,
+    "ri32": [1, 2.0, "3"],
+    "msi": {"k": 1}
+  })";
+
+  trpc::test::TestComplexMessage msg;
+  ASSERT_TRUE(PbJsonTranscoder::JsonToPb(CreateBufferSlow(json), &msg));
+  ASSERT_EQ(msg.choice_s(), "json name");
+  ASSERT_EQ(msg.i64(), 123);
+  ASSERT_EQ(msg.u32(), 7);
+  ASSERT_EQ(msg.color(), trpc::test::GREEN);
+  ASSERT_TRUE(std::isnan(msg.f()));
+  ASSERT_EQ(msg.d(), -1e300);
+  ASSERT_EQ(msg.bs(), "hello");
+  ASSERT_FALSE(msg.has_nested());
+  ASSERT_EQ(msg.ri32_size(), 3);
+  ASSERT_EQ(msg.ri32(2), 3);
+  ASSERT_EQ(msg.msi().at("k"), 1);
+}
+
+TEST(PbJsonTranscoderTest, JsonToPbInvalid) {
+  for (const auto* json : {R"({"i32": "abc"})", R"({"i32": 2147483648})", R"({"i32": 1.5})", R"({"u64": -1})",
+                           R"({"ri32": 1})", R"({"ri32": [null]})", R"({"nested": 1})", R"({"b": "true"})",
+                           R"({"mln": {"key": {}}})", R"([1])", R"({"i32": 1)"}) {
+    trpc::test::TestComplexMessage msg;
+    ASSERT_FALSE(PbJsonTranscoder::JsonToPb(CreateBufferSlow(json), &msg)) << json;
+  }
+}
+
+TEST(PbJsonTranscoderTest, Precompile) {
+  PbJsonTranscoder::Precompile(trpc::test::TestComplexMessage::descriptor());
+  PbJsonTranscoder::Precompile(trpc::test::TestComplexMessage::descriptor());
+
+  trpc::test::TestComplexMessage msg = MakeComplexMessage();
+  std::string expected;
+  ASSERT_TRUE(Pb2Json::PbToJson(msg, &expected));
+  ASSERT_EQ(ToJson(msg), expected);
+
+  trpc::test::TestComplexMessage parsed;
+  ASSERT_TRUE(PbJsonTranscoder::JsonToPb(CreateBufferSlow(expected), &parsed));
+  ASSERT_TRUE(MessageDifferencer::Equals(msg, parsed));
+}
+
+TEST(PbJsonTranscoderTest, WellKnownTypes) {
+  google::protobuf::Timestamp timestamp;
+  timestamp.set_seconds(1);
+
+  std::string expected;
+  ASSERT_TRUE(Pb2Json::PbToJson(timestamp, &expected));
+  std::string json = ToJson(timestamp);
+  ASSERT_EQ(json, expected);
+
+  google::protobuf::Timestamp parsed;
+  ASSERT_TRUE(PbJsonTranscoder::JsonToPb(CreateBufferSlow(json), &parsed));
+  ASSERT_EQ(parsed.seconds(), 1);
+}
+
+}  // namespace trpc::testing